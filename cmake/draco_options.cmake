@@ -127,6 +127,10 @@ macro(draco_set_default_options)
     NAME DRACO_TRANSCODER_SUPPORTED
     HELPSTRING "Enable the Draco transcoder."
     VALUE OFF)
+  draco_option(
+    NAME DRACO_TRACING
+    HELPSTRING "Enable tracing spans in the decoder pipeline."
+    VALUE OFF)
   draco_option(
     NAME DRACO_DEBUG_COMPILER_WARNINGS
     HELPSTRING "Turn on more warnings."
@@ -240,6 +244,10 @@ macro(draco_set_optional_features)
     draco_enable_feature(FEATURE "DRACO_TRANSCODER_SUPPORTED")
   endif()
 
+  if(DRACO_TRACING)
+    draco_enable_feature(FEATURE "DRACO_TRACING_SUPPORTED")
+  endif()
+
 
 endmacro()
 
@@ -37,27 +37,38 @@ list(
     "${draco_src_root}/animation/keyframe_animation_encoding_test.cc"
     "${draco_src_root}/animation/keyframe_animation_test.cc"
     "${draco_src_root}/attributes/point_attribute_test.cc"
+    "${draco_src_root}/compression/attributes/index_attribute_encoding_test.cc"
     "${draco_src_root}/compression/attributes/point_d_vector_test.cc"
     "${draco_src_root}/compression/attributes/prediction_schemes/prediction_scheme_normal_octahedron_canonicalized_transform_test.cc"
     "${draco_src_root}/compression/attributes/prediction_schemes/prediction_scheme_normal_octahedron_transform_test.cc"
+    "${draco_src_root}/compression/attributes/sequential_float_attribute_encoding_test.cc"
     "${draco_src_root}/compression/attributes/sequential_integer_attribute_encoding_test.cc"
     "${draco_src_root}/compression/bit_coders/rans_coding_test.cc"
     "${draco_src_root}/compression/decode_test.cc"
     "${draco_src_root}/compression/encode_test.cc"
     "${draco_src_root}/compression/entropy/shannon_entropy_test.cc"
     "${draco_src_root}/compression/entropy/symbol_coding_test.cc"
+    "${draco_src_root}/compression/incremental_decoder_test.cc"
     "${draco_src_root}/compression/mesh/mesh_edgebreaker_encoding_test.cc"
     "${draco_src_root}/compression/mesh/mesh_encoder_test.cc"
     "${draco_src_root}/compression/point_cloud/point_cloud_kd_tree_encoding_test.cc"
     "${draco_src_root}/compression/point_cloud/point_cloud_sequential_encoding_test.cc"
+    "${draco_src_root}/compression/encoding_stats_test.cc"
+    "${draco_src_root}/compression/rate_control_test.cc"
+    "${draco_src_root}/compression/sequence/persistent_segment_test.cc"
+    "${draco_src_root}/compression/sequence/sequence_container_test.cc"
+    "${draco_src_root}/compression/sequence/sequence_quantization_analyzer_test.cc"
     "${draco_src_root}/core/buffer_bit_coding_test.cc"
+    "${draco_src_root}/core/flat_hash_index_table_test.cc"
     "${draco_src_root}/core/math_utils_test.cc"
     "${draco_src_root}/core/quantization_utils_test.cc"
     "${draco_src_root}/core/status_test.cc"
+    "${draco_src_root}/core/trace_test.cc"
     "${draco_src_root}/core/vector_d_test.cc"
     "${draco_src_root}/io/file_reader_test_common.h"
     "${draco_src_root}/io/file_utils_test.cc"
     "${draco_src_root}/io/file_writer_utils_test.cc"
+    "${draco_src_root}/io/gaussian_attribute_utils_test.cc"
     "${draco_src_root}/io/stdio_file_reader_test.cc"
     "${draco_src_root}/io/stdio_file_writer_test.cc"
     "${draco_src_root}/io/obj_decoder_test.cc"
@@ -70,6 +81,7 @@ list(
     "${draco_src_root}/mesh/corner_table_test.cc"
     "${draco_src_root}/mesh/mesh_are_equivalent_test.cc"
     "${draco_src_root}/mesh/mesh_cleanup_test.cc"
+    "${draco_src_root}/mesh/streaming_triangle_soup_mesh_builder_test.cc"
     "${draco_src_root}/mesh/triangle_soup_mesh_builder_test.cc"
     "${draco_src_root}/metadata/metadata_encoder_test.cc"
     "${draco_src_root}/metadata/metadata_test.cc"
@@ -14,13 +14,10 @@
 //
 #include "draco/attributes/point_attribute.h"
 
-#include <tuple>
-#include <unordered_map>
-using std::unordered_map;
+#include <array>
+#include <cstring>
 
-// Shortcut for typed conditionals.
-template <bool B, class T, class F>
-using conditional_t = typename std::conditional<B, T, F>::type;
+#include "draco/core/flat_hash_index_table.h"
 
 namespace draco {
 
@@ -149,50 +146,31 @@ AttributeValueIndex::ValueType PointAttribute::DeduplicateTypedValues(
 template <typename T, int num_components_t>
 AttributeValueIndex::ValueType PointAttribute::DeduplicateFormattedValues(
     const GeometryAttribute &in_att, AttributeValueIndex in_att_offset) {
-  // We want to detect duplicates using a hash map but we cannot hash floating
-  // point numbers directly so bit-copy floats to the same sized integers and
-  // hash them.
-
-  // First we need to determine which int type to use (1, 2, 4 or 8 bytes).
-  // Note, this is done at compile time using std::conditional struct.
-  // Conditional is in form <bool-expression, true, false>. If bool-expression
-  // is true the "true" branch is used and vice versa. All at compile time.
-  typedef conditional_t<sizeof(T) == 1, uint8_t,
-                        conditional_t<sizeof(T) == 2, uint16_t,
-                                      conditional_t<sizeof(T) == 4, uint32_t,
-                                                    /*else*/ uint64_t>>>
-      HashType;
-
-  AttributeValueIndex unique_vals(0);
+  // Values are compared and hashed by their bit patterns so that floating
+  // point values can be deduplicated as well.
   typedef std::array<T, num_components_t> AttributeValue;
-  typedef std::array<HashType, num_components_t> AttributeHashableValue;
-  typedef unordered_map<AttributeHashableValue, AttributeValueIndex,
-                        HashArray<AttributeHashableValue>>
-      ValueToIndexMap;
 
-  // Hash map storing index of the first attribute with a given value.
-  ValueToIndexMap value_to_index_map;
+  // Hash table storing index of the first attribute value with a given bit
+  // pattern. The unique values are written to the beginning of this attribute
+  // so the table only needs to store their indices.
+  FlatHashIndexTable value_table;
+  value_table.Init(num_unique_entries_);
+  AttributeValueIndex unique_vals(0);
   AttributeValue att_value;
-  AttributeHashableValue hashable_value;
   IndexTypeVector<AttributeValueIndex, AttributeValueIndex> value_map(
       num_unique_entries_);
   for (AttributeValueIndex i(0); i < num_unique_entries_; ++i) {
     const AttributeValueIndex att_pos = i + in_att_offset;
     att_value = in_att.GetValue<T, num_components_t>(att_pos);
-    // Convert the value to hashable type. Bit-copy real attributes to integers.
-    memcpy(&(hashable_value[0]), &(att_value[0]), sizeof(att_value));
-
-    typename ValueToIndexMap::iterator it;
-    bool inserted;
-    std::tie(it, inserted) = value_to_index_map.insert(
-        std::pair<AttributeHashableValue, AttributeValueIndex>(hashable_value,
-                                                               unique_vals));
-
-    // Try to update the hash map with a new entry pointing to the latest unique
-    // vertex index.
-    if (!inserted) {
+    const uint32_t unique_index = value_table.FindOrInsert(
+        HashBytes(att_value.data(), sizeof(att_value)), unique_vals.value(),
+        [&](uint32_t index) {
+          return memcmp(GetAddress(AttributeValueIndex(index)),
+                        att_value.data(), sizeof(att_value)) == 0;
+        });
+    if (unique_index != unique_vals.value()) {
       // Duplicated value found. Update index mapping.
-      value_map[i] = it->second;
+      value_map[i] = AttributeValueIndex(unique_index);
     } else {
       // New unique value.
       SetAttributeValue(unique_vals, &att_value);
@@ -20,6 +20,7 @@
 #include "draco/compression/attributes/attributes_decoder_interface.h"
 #include "draco/compression/point_cloud/point_cloud_decoder.h"
 #include "draco/core/decoder_buffer.h"
+#include "draco/core/trace.h"
 #include "draco/draco_features.h"
 #include "draco/point_cloud/point_cloud.h"
 
@@ -53,18 +54,33 @@ class AttributesDecoder : public AttributesDecoderInterface {
 
   // Decodes attribute data from the source buffer.
   bool DecodeAttributes(DecoderBuffer *in_buffer) override {
-    if (!DecodePortableAttributes(in_buffer)) {
-      return false;
+    {
+      DRACO_TRACE_SPAN("DecodePortableAttributes");
+      if (!DecodePortableAttributes(in_buffer)) {
+        return false;
+      }
     }
-    if (!DecodeDataNeededByPortableTransforms(in_buffer)) {
-      return false;
+    {
+      DRACO_TRACE_SPAN("DecodeDataNeededByPortableTransforms");
+      if (!DecodeDataNeededByPortableTransforms(in_buffer)) {
+        return false;
+      }
+    }
+    if (point_cloud_decoder_->defer_attribute_reconstruction()) {
+      return true;  // The transform is done in ReconstructAttributes().
     }
+    DRACO_TRACE_SPAN("TransformAttributesToOriginalFormat");
     if (!TransformAttributesToOriginalFormat()) {
       return false;
     }
     return true;
   }
 
+  bool ReconstructAttributes() override {
+    DRACO_TRACE_SPAN("TransformAttributesToOriginalFormat");
+    return TransformAttributesToOriginalFormat();
+  }
+
  protected:
   int32_t GetLocalIdForPointAttribute(int32_t point_attribute_id) const {
     const int id_map_size =
@@ -44,6 +44,29 @@ class AttributesDecoderInterface {
   // the derived classes.
   virtual bool DecodeAttributes(DecoderBuffer *in_buffer) = 0;
 
+  // Returns the number of chunks of the attribute data when the attributes are
+  // stored in chunks, see ATTRIBUTE_CHUNKS_FLAG_MASK. There is either a single
+  // chunk with all attributes or one chunk for each attribute. Valid after
+  // DecodeAttributesDecoderData().
+  virtual int GetNumChunks() const { return 1; }
+
+  // Decodes chunk |chunk_id| of the attribute data. All chunks are decoded in
+  // order instead of calling DecodeAttributes().
+  virtual bool DecodeChunk(int /* chunk_id */, DecoderBuffer *in_buffer) {
+    return DecodeAttributes(in_buffer);
+  }
+
+  // Finishes decoding of the attributes when their reconstruction was deferred
+  // by the PointCloudDecoder (see
+  // PointCloudDecoder::defer_attribute_reconstruction()). Called after the
+  // data of all attributes was read from the source buffer and after all
+  // attributes returned by GetParentAttributeIds() were reconstructed.
+  virtual bool ReconstructAttributes() { return true; }
+
+  // Returns ids of parent attributes whose portable data is used to predict
+  // the attributes of this decoder. Valid after DecodeAttributes().
+  virtual std::vector<int32_t> GetParentAttributeIds() const { return {}; }
+
   virtual int32_t GetAttributeId(int i) const = 0;
   virtual int32_t GetNumAttributes() const = 0;
   virtual PointCloudDecoder *GetDecoder() const = 0;
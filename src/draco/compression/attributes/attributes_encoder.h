@@ -63,6 +63,17 @@ class AttributesEncoder {
     return true;
   }
 
+  // Returns the number of chunks of the attribute data when the attributes are
+  // encoded in chunks, see ATTRIBUTE_CHUNKS_FLAG_MASK. There is either a single
+  // chunk with all attributes or one chunk for each attribute.
+  virtual int NumChunks() const { return 1; }
+
+  // Encodes chunk |chunk_id| of the attribute data. All chunks are encoded in
+  // order instead of calling EncodeAttributes().
+  virtual bool EncodeChunk(int /* chunk_id */, EncoderBuffer *out_buffer) {
+    return EncodeAttributes(out_buffer);
+  }
+
   // Returns the number of attributes that need to be encoded before the
   // specified attribute is encoded.
   // Note that the attribute is specified by its point attribute id.
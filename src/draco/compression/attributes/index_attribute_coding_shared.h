@@ -0,0 +1,76 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_ATTRIBUTES_INDEX_ATTRIBUTE_CODING_SHARED_H_
+#define DRACO_COMPRESSION_ATTRIBUTES_INDEX_ATTRIBUTE_CODING_SHARED_H_
+
+#include "draco/attributes/geometry_attribute.h"
+#include "draco/core/bit_utils.h"
+
+namespace draco {
+
+// Shared definitions of the coding of vector quantization (VQ) index
+// attributes such as SH_DC_IDX. The values of these attributes are indices
+// into codebooks that have no numeric locality, so instead of predicting them
+// from their neighbors, each component is coded as follows:
+//
+//   1. Indices are replaced by their rank in the list of unique indices sorted
+//      by decreasing frequency. The list is stored in the bitstream.
+//   2. Each rank is coded relative to the rank of the previous point, which is
+//      usually a spatial neighbor. Symbol 0 means that the rank is equal to
+//      the previous rank and other ranks are shifted so that the alphabet
+//      stays dense.
+//   3. Symbols are split into contexts by the magnitude of the previous rank
+//      and each context is entropy coded with its own rANS probability table.
+
+// Number of contexts per attribute component.
+constexpr int kNumIndexAttributeContexts = 8;
+
+// Returns true when the values of |att| can be coded as VQ indices.
+inline bool IsIndexAttribute(const GeometryAttribute &att) {
+  switch (att.attribute_type()) {
+    case GeometryAttribute::SH_DC_IDX:
+    case GeometryAttribute::SH_REST_IDX:
+    case GeometryAttribute::SCALE_IDX:
+    case GeometryAttribute::ROTATION_IDX:
+      break;
+    default:
+      return false;
+  }
+  switch (att.data_type()) {
+    case DT_UINT8:
+    case DT_INT8:
+    case DT_UINT16:
+    case DT_INT16:
+    case DT_UINT32:
+    case DT_INT32:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the context of a symbol that follows a point with |prev_rank|.
+inline int GetIndexAttributeContext(uint32_t prev_rank) {
+  if (prev_rank == 0) {
+    return 0;
+  }
+  const int context = MostSignificantBit(prev_rank) + 1;
+  return context < kNumIndexAttributeContexts ? context
+                                              : kNumIndexAttributeContexts - 1;
+}
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ATTRIBUTES_INDEX_ATTRIBUTE_CODING_SHARED_H_
@@ -0,0 +1,143 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/index_attribute_decoding.h"
+
+#include <vector>
+
+#include "draco/compression/attributes/index_attribute_coding_shared.h"
+#include "draco/compression/entropy/symbol_decoding.h"
+#include "draco/core/varint_decoding.h"
+
+namespace draco {
+
+namespace {
+
+// Stores |values| to the first entries of |att|.
+template <typename T>
+void StoreValues(const std::vector<uint32_t> &values, PointAttribute *att) {
+  T *const out = reinterpret_cast<T *>(att->GetAddress(AttributeValueIndex(0)));
+  for (size_t i = 0; i < values.size(); ++i) {
+    out[i] = static_cast<T>(values[i]);
+  }
+}
+
+bool StoreValues(const std::vector<uint32_t> &values, PointAttribute *att) {
+  switch (att->data_type()) {
+    case DT_UINT8:
+      StoreValues<uint8_t>(values, att);
+      return true;
+    case DT_INT8:
+      StoreValues<int8_t>(values, att);
+      return true;
+    case DT_UINT16:
+      StoreValues<uint16_t>(values, att);
+      return true;
+    case DT_INT16:
+      StoreValues<int16_t>(values, att);
+      return true;
+    case DT_UINT32:
+      StoreValues<uint32_t>(values, att);
+      return true;
+    case DT_INT32:
+      StoreValues<int32_t>(values, att);
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+bool DecodeIndexAttribute(uint32_t num_values, DecoderBuffer *in_buffer,
+                          PointAttribute *att) {
+  const int num_components = att->num_components();
+  if (!IsIndexAttribute(*att) || num_components <= 0) {
+    return false;
+  }
+  const uint64_t num_components_total =
+      static_cast<uint64_t>(num_values) * num_components;
+  if (att->buffer() == nullptr ||
+      att->buffer()->data_size() < num_values * att->byte_stride() ||
+      att->byte_stride() != num_components * DataTypeLength(att->data_type())) {
+    return false;
+  }
+
+  // Values of each component sorted by their frequency rank.
+  std::vector<std::vector<uint32_t>> rank_tables(num_components);
+  for (int c = 0; c < num_components; ++c) {
+    uint32_t table_size;
+    if (!DecodeVarint(&table_size, in_buffer) || table_size > num_values) {
+      return false;
+    }
+    rank_tables[c].resize(table_size);
+    if (table_size > 0 &&
+        !DecodeSymbols(table_size, 1, in_buffer, rank_tables[c].data())) {
+      return false;
+    }
+  }
+
+  std::vector<std::vector<uint32_t>> streams(num_components *
+                                             kNumIndexAttributeContexts);
+  uint64_t num_symbols = 0;
+  for (std::vector<uint32_t> &stream : streams) {
+    uint32_t stream_size;
+    if (!DecodeVarint(&stream_size, in_buffer) || stream_size > num_values) {
+      return false;
+    }
+    num_symbols += stream_size;
+    if (num_symbols > num_components_total) {
+      return false;
+    }
+    stream.resize(stream_size);
+    if (stream_size > 0 &&
+        !DecodeSymbols(stream_size, 1, in_buffer, stream.data())) {
+      return false;
+    }
+  }
+  if (num_symbols != num_components_total) {
+    return false;
+  }
+
+  // Walk the points in the encoding order and pick each symbol from the
+  // stream selected by the rank of the previous point.
+  std::vector<uint32_t> stream_positions(streams.size(), 0);
+  std::vector<uint32_t> prev_ranks(num_components, 0);
+  std::vector<uint32_t> values(num_components_total);
+  uint32_t *out = values.data();
+  for (uint32_t p = 0; p < num_values; ++p) {
+    for (int c = 0; c < num_components; ++c) {
+      const uint32_t prev_rank = prev_ranks[c];
+      const int stream_id = c * kNumIndexAttributeContexts +
+                            GetIndexAttributeContext(prev_rank);
+      const std::vector<uint32_t> &stream = streams[stream_id];
+      uint32_t &position = stream_positions[stream_id];
+      if (position >= stream.size()) {
+        return false;
+      }
+      const uint32_t symbol = stream[position++];
+      const uint32_t rank =
+          symbol == 0 ? prev_rank
+                      : (symbol <= prev_rank ? symbol - 1 : symbol);
+      if (rank >= rank_tables[c].size()) {
+        return false;
+      }
+      *out++ = rank_tables[c][rank];
+      prev_ranks[c] = rank;
+    }
+  }
+  return StoreValues(values, att);
+}
+
+}  // namespace draco
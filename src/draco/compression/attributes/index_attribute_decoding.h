@@ -0,0 +1,32 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_ATTRIBUTES_INDEX_ATTRIBUTE_DECODING_H_
+#define DRACO_COMPRESSION_ATTRIBUTES_INDEX_ATTRIBUTE_DECODING_H_
+
+#include "draco/attributes/point_attribute.h"
+#include "draco/core/decoder_buffer.h"
+
+namespace draco {
+
+// Decodes |num_values| values of a VQ index attribute encoded by
+// EncodeIndexAttribute() and stores them to the first |num_values| entries of
+// |att|. The buffer of |att| must be large enough to hold all the values.
+// Returns false on error.
+bool DecodeIndexAttribute(uint32_t num_values, DecoderBuffer *in_buffer,
+                          PointAttribute *att);
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ATTRIBUTES_INDEX_ATTRIBUTE_DECODING_H_
@@ -0,0 +1,166 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/index_attribute_encoding.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "draco/compression/attributes/index_attribute_coding_shared.h"
+#include "draco/compression/entropy/symbol_encoding.h"
+#include "draco/core/varint_encoding.h"
+
+namespace draco {
+
+namespace {
+
+// Copies the components of |att| for all |point_ids| to |out_values| as
+// 32-bit patterns. Signed values are sign extended.
+template <typename T>
+void GetValues(const PointAttribute &att,
+               const std::vector<PointIndex> &point_ids,
+               std::vector<uint32_t> *out_values) {
+  const int num_components = att.num_components();
+  out_values->resize(point_ids.size() * num_components);
+  uint32_t *out = out_values->data();
+  for (const PointIndex &pi : point_ids) {
+    const T *const value =
+        reinterpret_cast<const T *>(att.GetAddressOfMappedIndex(pi));
+    for (int c = 0; c < num_components; ++c) {
+      *out++ = static_cast<uint32_t>(value[c]);
+    }
+  }
+}
+
+bool GetValues(const PointAttribute &att,
+               const std::vector<PointIndex> &point_ids,
+               std::vector<uint32_t> *out_values) {
+  switch (att.data_type()) {
+    case DT_UINT8:
+      GetValues<uint8_t>(att, point_ids, out_values);
+      return true;
+    case DT_INT8:
+      GetValues<int8_t>(att, point_ids, out_values);
+      return true;
+    case DT_UINT16:
+      GetValues<uint16_t>(att, point_ids, out_values);
+      return true;
+    case DT_INT16:
+      GetValues<int16_t>(att, point_ids, out_values);
+      return true;
+    case DT_UINT32:
+      GetValues<uint32_t>(att, point_ids, out_values);
+      return true;
+    case DT_INT32:
+      GetValues<int32_t>(att, point_ids, out_values);
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+bool EncodeIndexAttribute(const PointAttribute &att,
+                          const std::vector<PointIndex> &point_ids,
+                          const Options *options, EncoderBuffer *out_buffer) {
+  if (!IsIndexAttribute(att)) {
+    return false;
+  }
+  std::vector<uint32_t> values;
+  if (!GetValues(att, point_ids, &values)) {
+    return false;
+  }
+  const int num_components = att.num_components();
+  const size_t num_points = point_ids.size();
+
+  // Replace the values of each component by their frequency ranks.
+  std::vector<uint32_t> column(num_points);
+  std::vector<uint32_t> unique_values;
+  // Pairs of the number of occurrences and the index of a unique value.
+  std::vector<std::pair<uint32_t, uint32_t>> counts;
+  std::vector<uint32_t> rank_table;
+  // Rank of each unique value.
+  std::vector<uint32_t> ranks;
+  for (int c = 0; c < num_components; ++c) {
+    for (size_t p = 0; p < num_points; ++p) {
+      column[p] = values[p * num_components + c];
+    }
+    std::sort(column.begin(), column.end());
+    unique_values.clear();
+    counts.clear();
+    for (size_t p = 0; p < num_points;) {
+      size_t run_end = p + 1;
+      while (run_end < num_points && column[run_end] == column[p]) {
+        ++run_end;
+      }
+      counts.push_back(std::make_pair(static_cast<uint32_t>(run_end - p),
+                                      static_cast<uint32_t>(
+                                          unique_values.size())));
+      unique_values.push_back(column[p]);
+      p = run_end;
+    }
+    // Most frequent values first. Ties are broken by the value.
+    std::stable_sort(counts.begin(), counts.end(),
+                     [](const std::pair<uint32_t, uint32_t> &a,
+                        const std::pair<uint32_t, uint32_t> &b) {
+                       return a.first > b.first;
+                     });
+    rank_table.resize(counts.size());
+    ranks.resize(counts.size());
+    for (uint32_t r = 0; r < counts.size(); ++r) {
+      rank_table[r] = unique_values[counts[r].second];
+      ranks[counts[r].second] = r;
+    }
+    EncodeVarint(static_cast<uint32_t>(rank_table.size()), out_buffer);
+    if (!rank_table.empty() &&
+        !EncodeSymbols(rank_table.data(), static_cast<int>(rank_table.size()),
+                       1, options, out_buffer)) {
+      return false;
+    }
+    for (size_t p = 0; p < num_points; ++p) {
+      uint32_t &value = values[p * num_components + c];
+      value = ranks[std::lower_bound(unique_values.begin(),
+                                     unique_values.end(), value) -
+                    unique_values.begin()];
+    }
+  }
+
+  // Split the ranks into context streams.
+  std::vector<std::vector<uint32_t>> streams(num_components *
+                                             kNumIndexAttributeContexts);
+  for (size_t p = 0; p < num_points; ++p) {
+    for (int c = 0; c < num_components; ++c) {
+      const uint32_t prev_rank =
+          p > 0 ? values[(p - 1) * num_components + c] : 0;
+      const uint32_t rank = values[p * num_components + c];
+      const uint32_t symbol =
+          rank == prev_rank ? 0 : (rank < prev_rank ? rank + 1 : rank);
+      streams[c * kNumIndexAttributeContexts +
+              GetIndexAttributeContext(prev_rank)]
+          .push_back(symbol);
+    }
+  }
+  for (const std::vector<uint32_t> &stream : streams) {
+    EncodeVarint(static_cast<uint32_t>(stream.size()), out_buffer);
+    if (!stream.empty() &&
+        !EncodeSymbols(stream.data(), static_cast<int>(stream.size()), 1,
+                       options, out_buffer)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace draco
@@ -0,0 +1,36 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_ATTRIBUTES_INDEX_ATTRIBUTE_ENCODING_H_
+#define DRACO_COMPRESSION_ATTRIBUTES_INDEX_ATTRIBUTE_ENCODING_H_
+
+#include <vector>
+
+#include "draco/attributes/point_attribute.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/options.h"
+
+namespace draco {
+
+// Encodes values of the VQ index attribute |att| for points |point_ids| in
+// the given order (see index_attribute_coding_shared.h). |att| must satisfy
+// IsIndexAttribute(). |options| are passed to EncodeSymbols() and can be
+// nullptr. Returns false on error.
+bool EncodeIndexAttribute(const PointAttribute &att,
+                          const std::vector<PointIndex> &point_ids,
+                          const Options *options, EncoderBuffer *out_buffer);
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ATTRIBUTES_INDEX_ATTRIBUTE_ENCODING_H_
@@ -0,0 +1,231 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/index_attribute_encoding.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "draco/compression/attributes/index_attribute_decoding.h"
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/compression/point_cloud/point_cloud_decoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/vector_d.h"
+#include "draco/point_cloud/point_cloud_builder.h"
+
+namespace draco {
+
+namespace {
+
+constexpr int kGridSize = 64;
+
+// Returns a codebook index that is constant within blocks of the grid so that
+// neighboring points mostly share their index.
+uint16_t GetDcIndex(int x, int y) {
+  return static_cast<uint16_t>(((x / 8) * 8 + y / 8) * 37 % 4096);
+}
+
+// Returns a pair of codebook indices where a few values dominate.
+VectorD<uint32_t, 2> GetRotationIndex(int point) {
+  return VectorD<uint32_t, 2>(point % 7 == 0 ? point * 13 : 3, point % 3);
+}
+
+// Creates a point cloud with positions on a grid and VQ index attributes.
+std::unique_ptr<PointCloud> CreatePointCloud(bool with_positions) {
+  PointCloudBuilder builder;
+  builder.Start(kGridSize * kGridSize);
+  const int pos_att_id =
+      with_positions
+          ? builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32)
+          : -1;
+  const int dc_att_id =
+      builder.AddAttribute(GeometryAttribute::SH_DC_IDX, 1, DT_UINT16);
+  const int rot_att_id =
+      builder.AddAttribute(GeometryAttribute::ROTATION_IDX, 2, DT_UINT32);
+  for (int y = 0; y < kGridSize; ++y) {
+    for (int x = 0; x < kGridSize; ++x) {
+      const PointIndex pi(y * kGridSize + x);
+      if (with_positions) {
+        const Vector3f pos(static_cast<float>(x), static_cast<float>(y), 0.f);
+        builder.SetAttributeValueForPoint(pos_att_id, pi, pos.data());
+      }
+      const uint16_t dc_index = GetDcIndex(x, y);
+      builder.SetAttributeValueForPoint(dc_att_id, pi, &dc_index);
+      builder.SetAttributeValueForPoint(rot_att_id, pi,
+                                        GetRotationIndex(pi.value()).data());
+    }
+  }
+  return builder.Finalize(false);
+}
+
+// Encodes |pc| with the given encoding speed.
+void EncodePointCloud(const PointCloud &pc, int speed, bool vq_index_coding,
+                      EncoderBuffer *buffer) {
+  Encoder encoder;
+  encoder.SetSpeedOptions(speed, speed);
+  encoder.SetAttributeQuantization(GeometryAttribute::POSITION, 14);
+  encoder.SetVqIndexCoding(vq_index_coding);
+  ASSERT_TRUE(encoder.EncodePointCloudToBuffer(pc, buffer).ok());
+}
+
+}  // namespace
+
+class IndexAttributeEncodingTest : public ::testing::Test {};
+
+TEST_F(IndexAttributeEncodingTest, TestStandaloneRoundTrip) {
+  // Tests that values are decoded in the order of the encoded point ids.
+  const std::unique_ptr<PointCloud> pc = CreatePointCloud(false);
+  ASSERT_NE(pc, nullptr);
+  const PointAttribute *const att =
+      pc->GetNamedAttribute(GeometryAttribute::ROTATION_IDX);
+  std::vector<PointIndex> point_ids(pc->num_points());
+  std::iota(point_ids.begin(), point_ids.end(), PointIndex(0));
+  std::reverse(point_ids.begin(), point_ids.end());
+
+  EncoderBuffer out_buffer;
+  ASSERT_TRUE(EncodeIndexAttribute(*att, point_ids, nullptr, &out_buffer));
+
+  PointAttribute decoded_att;
+  decoded_att.Init(att->attribute_type(), att->num_components(),
+                   att->data_type(), false, point_ids.size());
+  DecoderBuffer in_buffer;
+  in_buffer.Init(out_buffer.data(), out_buffer.size());
+  in_buffer.set_bitstream_version(kDracoPointCloudBitstreamVersion);
+  ASSERT_TRUE(DecodeIndexAttribute(point_ids.size(), &in_buffer, &decoded_att));
+  for (uint32_t i = 0; i < point_ids.size(); ++i) {
+    VectorD<uint32_t, 2> expected, decoded;
+    att->GetMappedValue(point_ids[i], &expected[0]);
+    decoded_att.GetValue(AttributeValueIndex(i), &decoded[0]);
+    ASSERT_EQ(decoded, expected);
+  }
+
+  // Truncated data must be rejected.
+  in_buffer.Init(out_buffer.data(), out_buffer.size() / 2);
+  ASSERT_FALSE(
+      DecodeIndexAttribute(point_ids.size(), &in_buffer, &decoded_att));
+}
+
+TEST_F(IndexAttributeEncodingTest, TestPointCloudRoundTrip) {
+  // Tests that the VQ indices stay attached to their points with both the
+  // sequential (speed 10) and the kd-tree encoders.
+  const std::unique_ptr<PointCloud> pc = CreatePointCloud(true);
+  ASSERT_NE(pc, nullptr);
+  for (const int speed : {10, 5, 0}) {
+    EncoderBuffer buffer;
+    EncodePointCloud(*pc, speed, true, &buffer);
+    DecoderBuffer in_buffer;
+    in_buffer.Init(buffer.data(), buffer.size());
+    Decoder decoder;
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<PointCloud> decoded_pc,
+                           decoder.DecodePointCloudFromBuffer(&in_buffer));
+    ASSERT_EQ(decoded_pc->num_points(), pc->num_points());
+    const PointAttribute *const pos_att =
+        decoded_pc->GetNamedAttribute(GeometryAttribute::POSITION);
+    const PointAttribute *const dc_att =
+        decoded_pc->GetNamedAttribute(GeometryAttribute::SH_DC_IDX);
+    const PointAttribute *const rot_att =
+        decoded_pc->GetNamedAttribute(GeometryAttribute::ROTATION_IDX);
+    ASSERT_NE(pos_att, nullptr);
+    ASSERT_NE(dc_att, nullptr);
+    ASSERT_NE(rot_att, nullptr);
+    for (PointIndex pi(0); pi < decoded_pc->num_points(); ++pi) {
+      Vector3f pos;
+      pos_att->GetMappedValue(pi, &pos[0]);
+      const int x = static_cast<int>(std::lround(pos[0]));
+      const int y = static_cast<int>(std::lround(pos[1]));
+      uint16_t dc_index;
+      dc_att->GetMappedValue(pi, &dc_index);
+      ASSERT_EQ(dc_index, GetDcIndex(x, y)) << "speed " << speed;
+      VectorD<uint32_t, 2> rot_index;
+      rot_att->GetMappedValue(pi, &rot_index[0]);
+      ASSERT_EQ(rot_index, GetRotationIndex(y * kGridSize + x));
+    }
+  }
+}
+
+TEST_F(IndexAttributeEncodingTest, TestOnlyIndexAttributes) {
+  // Tests the kd-tree encoder with no attributes left for the kd-tree.
+  const std::unique_ptr<PointCloud> pc = CreatePointCloud(false);
+  ASSERT_NE(pc, nullptr);
+  EncoderBuffer buffer;
+  EncodePointCloud(*pc, 5, true, &buffer);
+  DecoderBuffer in_buffer;
+  in_buffer.Init(buffer.data(), buffer.size());
+  Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<PointCloud> decoded_pc,
+                         decoder.DecodePointCloudFromBuffer(&in_buffer));
+  ASSERT_EQ(decoded_pc->num_points(), pc->num_points());
+  for (int a = 0; a < pc->num_attributes(); ++a) {
+    const PointAttribute *const att = pc->attribute(a);
+    const PointAttribute *const decoded_att = decoded_pc->attribute(a);
+    ASSERT_EQ(decoded_att->byte_stride(), att->byte_stride());
+    for (PointIndex pi(0); pi < pc->num_points(); ++pi) {
+      ASSERT_EQ(memcmp(decoded_att->GetAddressOfMappedIndex(pi),
+                       att->GetAddressOfMappedIndex(pi), att->byte_stride()),
+                0);
+    }
+  }
+}
+
+TEST_F(IndexAttributeEncodingTest, TestBitstreamVersion) {
+  // Tests that VQ index coding raises the minor bit-stream version so that
+  // decoders without support for the feature reject the stream.
+  const std::unique_ptr<PointCloud> pc = CreatePointCloud(true);
+  ASSERT_NE(pc, nullptr);
+  for (const bool vq_index_coding : {false, true}) {
+    EncoderBuffer buffer;
+    EncodePointCloud(*pc, 5, vq_index_coding, &buffer);
+    DecoderBuffer in_buffer;
+    in_buffer.Init(buffer.data(), buffer.size());
+    DracoHeader header;
+    DRACO_ASSERT_OK(PointCloudDecoder::DecodeHeader(&in_buffer, &header));
+    ASSERT_EQ(header.version_minor,
+              vq_index_coding ? kDracoVqIndexCodingBitstreamVersionMinor
+                              : kDracoPointCloudBitstreamVersionMinor);
+  }
+
+  // A decoder that supports a lower minor version must fail.
+  EncoderBuffer buffer;
+  EncodePointCloud(*pc, 5, true, &buffer);
+  std::vector<char> data(buffer.data(), buffer.data() + buffer.size());
+  // The minor version follows the "DRACO" string and the major version.
+  data[6] = kDracoMaxSupportedBitstreamVersionMinor + 1;
+  DecoderBuffer in_buffer;
+  in_buffer.Init(data.data(), data.size());
+  Decoder decoder;
+  ASSERT_EQ(decoder.DecodePointCloudFromBuffer(&in_buffer).status().code(),
+            Status::UNKNOWN_VERSION);
+}
+
+TEST_F(IndexAttributeEncodingTest, TestCompressesBetter) {
+  // Tests that the VQ index coding is smaller than the default coding.
+  const std::unique_ptr<PointCloud> pc = CreatePointCloud(true);
+  ASSERT_NE(pc, nullptr);
+  for (const int speed : {10, 5}) {
+    EncoderBuffer default_buffer;
+    EncodePointCloud(*pc, speed, false, &default_buffer);
+    EncoderBuffer index_buffer;
+    EncodePointCloud(*pc, speed, true, &index_buffer);
+    ASSERT_LT(index_buffer.size(), default_buffer.size()) << "speed " << speed;
+  }
+}
+
+}  // namespace draco
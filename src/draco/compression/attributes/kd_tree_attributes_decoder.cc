@@ -14,11 +14,14 @@
 //
 #include "draco/compression/attributes/kd_tree_attributes_decoder.h"
 
+#include "draco/compression/attributes/index_attribute_coding_shared.h"
+#include "draco/compression/attributes/index_attribute_decoding.h"
 #include "draco/compression/attributes/kd_tree_attributes_shared.h"
 #include "draco/compression/point_cloud/algorithms/dynamic_integer_points_kd_tree_decoder.h"
 #include "draco/compression/point_cloud/algorithms/float_points_tree_decoder.h"
 #include "draco/compression/point_cloud/point_cloud_decoder.h"
 #include "draco/core/draco_types.h"
+#include "draco/core/trace.h"
 #include "draco/core/varint_decoding.h"
 
 namespace draco {
@@ -133,6 +136,7 @@ KdTreeAttributesDecoder::KdTreeAttributesDecoder() {}
 
 bool KdTreeAttributesDecoder::DecodePortableAttributes(
     DecoderBuffer *in_buffer) {
+  is_index_attribute_.assign(GetNumAttributes(), false);
   if (in_buffer->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 3)) {
     // Old bitstream does everything in the
     // DecodeDataNeededByPortableTransforms() method.
@@ -150,8 +154,11 @@ bool KdTreeAttributesDecoder::DecodePortableAttributes(
   // be dequantized after decoding).
 
   const int num_attributes = GetNumAttributes();
+  const bool vq_index_coding =
+      GetDecoder()->header_flags() & VQ_INDEX_CODING_FLAG_MASK;
   uint32_t total_dimensionality = 0;  // position is a required dimension
-  std::vector<AttributeTuple> atts(num_attributes);
+  std::vector<AttributeTuple> atts;
+  atts.reserve(num_attributes);
 
   for (int i = 0; i < GetNumAttributes(); ++i) {
     const int att_id = GetAttributeId(i);
@@ -161,6 +168,12 @@ bool KdTreeAttributesDecoder::DecodePortableAttributes(
     att->Reset(num_points);
     att->SetIdentityMapping();
 
+    if (vq_index_coding && IsIndexAttribute(*att)) {
+      // VQ indices are decoded after the kd-tree.
+      is_index_attribute_[i] = true;
+      continue;
+    }
+
     PointAttribute *target_att = nullptr;
     if (att->data_type() == DT_UINT32 || att->data_type() == DT_UINT16 ||
         att->data_type() == DT_UINT8) {
@@ -194,65 +207,82 @@ bool KdTreeAttributesDecoder::DecodePortableAttributes(
     const DataType data_type = target_att->data_type();
     const uint32_t data_size = (std::max)(0, DataTypeLength(data_type));
     const uint32_t num_components = target_att->num_components();
-    atts[i] = std::make_tuple(target_att, total_dimensionality, data_type,
-                              data_size, num_components);
+    atts.push_back(std::make_tuple(target_att, total_dimensionality, data_type,
+                                   data_size, num_components));
     total_dimensionality += num_components;
   }
-  typedef PointAttributeVectorOutputIterator<uint32_t> OutIt;
-  OutIt out_it(atts);
+  if (!atts.empty()) {
+    // The kd-tree is empty when all attributes are VQ index attributes.
+    typedef PointAttributeVectorOutputIterator<uint32_t> OutIt;
+    OutIt out_it(atts);
 
-  switch (compression_level) {
-    case 0: {
-      if (!DecodePoints<0, OutIt>(total_dimensionality, num_points, in_buffer,
-                                  &out_it)) {
-        return false;
+    DRACO_TRACE_SPAN_ARG("KdTreeDecodePoints", "num_points", num_points);
+    switch (compression_level) {
+      case 0: {
+        if (!DecodePoints<0, OutIt>(total_dimensionality, num_points,
+                                    in_buffer, &out_it)) {
+          return false;
+        }
+        break;
       }
-      break;
-    }
-    case 1: {
-      if (!DecodePoints<1, OutIt>(total_dimensionality, num_points, in_buffer,
-                                  &out_it)) {
-        return false;
+      case 1: {
+        if (!DecodePoints<1, OutIt>(total_dimensionality, num_points,
+                                    in_buffer, &out_it)) {
+          return false;
+        }
+        break;
       }
-      break;
-    }
-    case 2: {
-      if (!DecodePoints<2, OutIt>(total_dimensionality, num_points, in_buffer,
-                                  &out_it)) {
-        return false;
+      case 2: {
+        if (!DecodePoints<2, OutIt>(total_dimensionality, num_points,
+                                    in_buffer, &out_it)) {
+          return false;
+        }
+        break;
       }
-      break;
-    }
-    case 3: {
-      if (!DecodePoints<3, OutIt>(total_dimensionality, num_points, in_buffer,
-                                  &out_it)) {
-        return false;
+      case 3: {
+        if (!DecodePoints<3, OutIt>(total_dimensionality, num_points,
+                                    in_buffer, &out_it)) {
+          return false;
+        }
+        break;
       }
-      break;
-    }
-    case 4: {
-      if (!DecodePoints<4, OutIt>(total_dimensionality, num_points, in_buffer,
-                                  &out_it)) {
-        return false;
+      case 4: {
+        if (!DecodePoints<4, OutIt>(total_dimensionality, num_points,
+                                    in_buffer, &out_it)) {
+          return false;
+        }
+        break;
       }
-      break;
-    }
-    case 5: {
-      if (!DecodePoints<5, OutIt>(total_dimensionality, num_points, in_buffer,
-                                  &out_it)) {
-        return false;
+      case 5: {
+        if (!DecodePoints<5, OutIt>(total_dimensionality, num_points,
+                                    in_buffer, &out_it)) {
+          return false;
+        }
+        break;
       }
-      break;
-    }
-    case 6: {
-      if (!DecodePoints<6, OutIt>(total_dimensionality, num_points, in_buffer,
-                                  &out_it)) {
-        return false;
+      case 6: {
+        if (!DecodePoints<6, OutIt>(total_dimensionality, num_points,
+                                    in_buffer, &out_it)) {
+          return false;
+        }
+        break;
       }
-      break;
+      default:
+        return false;
+    }
+  }
+
+  // VQ index attributes follow the kd-tree and they are stored in the order
+  // of the decoded points.
+  for (int i = 0; i < num_attributes; ++i) {
+    if (!is_index_attribute_[i]) {
+      continue;
     }
-    default:
+    PointAttribute *const att =
+        GetDecoder()->point_cloud()->attribute(GetAttributeId(i));
+    if (!DecodeIndexAttribute(num_points, in_buffer, att)) {
       return false;
+    }
   }
   return true;
 }
@@ -281,23 +311,38 @@ bool KdTreeAttributesDecoder::DecodeDataNeededByPortableTransforms(
       const PointAttribute *const att =
           GetDecoder()->point_cloud()->attribute(att_id);
       if (att->data_type() == DT_FLOAT32) {
-        const int num_components = att->num_components();
-        min_value.resize(num_components);
-        if (!in_buffer->Decode(&min_value[0], sizeof(float) * num_components)) {
-          return false;
-        }
-        float max_value_dif;
-        if (!in_buffer->Decode(&max_value_dif)) {
-          return false;
-        }
-        uint8_t quantization_bits;
-        if (!in_buffer->Decode(&quantization_bits) || quantization_bits > 31) {
+        uint8_t is_shared = 0;
+        if ((GetDecoder()->header_flags() & SHARED_QUANTIZATION_FLAG_MASK) &&
+            !in_buffer->Decode(&is_shared)) {
           return false;
         }
         AttributeQuantizationTransform transform;
-        if (!transform.SetParameters(quantization_bits, min_value.data(),
-                                     num_components, max_value_dif)) {
-          return false;
+        if (is_shared) {
+          // Parameters are provided by the sequence header.
+          if (!GetDecoder()->GetSharedQuantizationTransform(*att,
+                                                            &transform)) {
+            return false;
+          }
+        } else {
+          const int num_components = att->num_components();
+          min_value.resize(num_components);
+          if (!in_buffer->Decode(&min_value[0],
+                                 sizeof(float) * num_components)) {
+            return false;
+          }
+          float max_value_dif;
+          if (!in_buffer->Decode(&max_value_dif)) {
+            return false;
+          }
+          uint8_t quantization_bits;
+          if (!in_buffer->Decode(&quantization_bits) ||
+              quantization_bits > 31) {
+            return false;
+          }
+          if (!transform.SetParameters(quantization_bits, min_value.data(),
+                                       num_components, max_value_dif)) {
+            return false;
+          }
         }
         const int num_transforms =
             static_cast<int>(attribute_quantization_transforms_.size());
@@ -499,7 +544,13 @@ bool KdTreeAttributesDecoder::TransformAttributesToOriginalFormat() {
   // Dequantize attributes that needed it.
   for (int i = 0; i < GetNumAttributes(); ++i) {
     const int att_id = GetAttributeId(i);
+    DRACO_TRACE_SPAN_ARG("TransformAttributeToOriginalFormat", "attribute_id",
+                         att_id);
     PointAttribute *const att = GetDecoder()->point_cloud()->attribute(att_id);
+    if (is_index_attribute_[i]) {
+      // VQ indices are decoded directly to their original format.
+      continue;
+    }
     if (att->data_type() == DT_INT32 || att->data_type() == DT_INT16 ||
         att->data_type() == DT_INT8) {
       std::vector<uint32_t> unsigned_val(att->num_components());
@@ -550,29 +601,17 @@ bool KdTreeAttributesDecoder::TransformAttributesToOriginalFormat() {
       // Convert all quantized values back to floats.
       const int32_t max_quantized_value =
           (1u << static_cast<uint32_t>(transform.quantization_bits())) - 1;
-      const int num_components = att->num_components();
-      const int entry_size = sizeof(float) * num_components;
-      const std::unique_ptr<float[]> att_val(new float[num_components]);
-      int quant_val_id = 0;
-      int out_byte_pos = 0;
       Dequantizer dequantizer;
       if (!dequantizer.Init(transform.range(), max_quantized_value)) {
         return false;
       }
-      const uint32_t *const portable_attribute_data =
-          reinterpret_cast<const uint32_t *>(
+      const int32_t *const portable_attribute_data =
+          reinterpret_cast<const int32_t *>(
               src_att->GetAddress(AttributeValueIndex(0)));
-      for (uint32_t i = 0; i < src_att->size(); ++i) {
-        for (int c = 0; c < num_components; ++c) {
-          float value = dequantizer.DequantizeFloat(
-              portable_attribute_data[quant_val_id++]);
-          value = value + transform.min_value(c);
-          att_val[c] = value;
-        }
-        // Store the floating point value into the attribute buffer.
-        att->buffer()->Write(out_byte_pos, att_val.get(), entry_size);
-        out_byte_pos += entry_size;
-      }
+      dequantizer.DequantizeFloats(
+          portable_attribute_data, src_att->size(), att->num_components(),
+          transform.min_values().data(),
+          reinterpret_cast<float *>(att->GetAddress(AttributeValueIndex(0))));
     }
   }
   return true;
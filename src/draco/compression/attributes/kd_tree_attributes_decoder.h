@@ -43,6 +43,9 @@ class KdTreeAttributesDecoder : public AttributesDecoder {
       attribute_quantization_transforms_;
   std::vector<int32_t> min_signed_values_;
   std::vector<std::unique_ptr<PointAttribute>> quantized_portable_attributes_;
+  // Whether each attribute is a VQ index attribute that is decoded separately
+  // from the kd-tree.
+  std::vector<bool> is_index_attribute_;
 };
 
 }  // namespace draco
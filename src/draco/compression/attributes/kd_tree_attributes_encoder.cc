@@ -14,8 +14,13 @@
 //
 #include "draco/compression/attributes/kd_tree_attributes_encoder.h"
 
+#include <algorithm>
+
+#include "draco/compression/attributes/index_attribute_coding_shared.h"
+#include "draco/compression/attributes/index_attribute_encoding.h"
 #include "draco/compression/attributes/kd_tree_attributes_shared.h"
 #include "draco/compression/attributes/point_d_vector.h"
+#include "draco/compression/entropy/symbol_encoding.h"
 #include "draco/compression/point_cloud/algorithms/dynamic_integer_points_kd_tree_encoder.h"
 #include "draco/compression/point_cloud/algorithms/float_points_tree_encoder.h"
 #include "draco/compression/point_cloud/point_cloud_encoder.h"
@@ -32,11 +37,19 @@ bool KdTreeAttributesEncoder::TransformAttributesToPortableFormat() {
   // Convert any of the input attributes into a format that can be processed by
   // the kd tree encoder (quantization of floating attributes for now).
   const size_t num_points = encoder()->point_cloud()->num_points();
+  const bool vq_index_coding =
+      encoder()->options()->GetGlobalBool("vq_index_coding", false);
   int num_components = 0;
+  is_index_attribute_.assign(num_attributes(), false);
   for (uint32_t i = 0; i < num_attributes(); ++i) {
     const int att_id = GetAttributeId(i);
     const PointAttribute *const att =
         encoder()->point_cloud()->attribute(att_id);
+    if (vq_index_coding && IsIndexAttribute(*att)) {
+      // VQ indices are coded after the kd-tree.
+      is_index_attribute_[i] = true;
+      continue;
+    }
     num_components += att->num_components();
   }
   num_components_ = num_components;
@@ -46,6 +59,24 @@ bool KdTreeAttributesEncoder::TransformAttributesToPortableFormat() {
     const int att_id = GetAttributeId(i);
     const PointAttribute *const att =
         encoder()->point_cloud()->attribute(att_id);
+    AttributeEncodingStats *const att_stats = GetAttributeStats(i);
+    const EncodingStatsTimer timer(att_stats != nullptr);
+    if (is_index_attribute_[i]) {
+      if (att_stats) {
+        att_stats->encoder = "index";
+        att_stats->num_values =
+            static_cast<int64_t>(num_points) * att->num_components();
+      }
+      continue;
+    }
+    if (att_stats) {
+      att_stats->encoder = "kd_tree";
+      att_stats->num_values =
+          static_cast<int64_t>(num_points) * att->num_components();
+      if (i > 0) {
+        att_stats->joint_attribute_id = GetAttributeId(0);
+      }
+    }
     if (att->data_type() == DT_FLOAT32) {
       // Quantization path.
       AttributeQuantizationTransform attribute_quantization_transform;
@@ -86,6 +117,10 @@ bool KdTreeAttributesEncoder::TransformAttributesToPortableFormat() {
       attribute_quantization_transform.TransformAttribute(*att, {},
                                                           portable_att.get());
       quantized_portable_attributes_.push_back(std::move(portable_att));
+      if (att_stats) {
+        att_stats->quantization_bits = quantization_bits;
+        att_stats->transform_time = timer.Elapsed();
+      }
     } else if (att->data_type() == DT_INT32 || att->data_type() == DT_INT16 ||
                att->data_type() == DT_INT8) {
       // For signed types, find the minimum value for each component. These
@@ -114,14 +149,47 @@ bool KdTreeAttributesEncoder::TransformAttributesToPortableFormat() {
 bool KdTreeAttributesEncoder::EncodeDataNeededByPortableTransforms(
     EncoderBuffer *out_buffer) {
   // Store quantization settings for all attributes that need it.
-  for (int i = 0; i < attribute_quantization_transforms_.size(); ++i) {
-    attribute_quantization_transforms_[i].EncodeParameters(out_buffer);
+  const bool shared_grids =
+      encoder()->options()->GetGlobalBool("shared_quantization_grids", false);
+  int num_processed_quantized_attributes = 0;
+  for (uint32_t i = 0; i < num_attributes(); ++i) {
+    const int att_id = GetAttributeId(i);
+    const PointAttribute *const att =
+        encoder()->point_cloud()->attribute(att_id);
+    if (att->data_type() != DT_FLOAT32) {
+      continue;
+    }
+    const AttributeQuantizationTransform &transform =
+        attribute_quantization_transforms_
+            [num_processed_quantized_attributes++];
+    const int64_t start_size = out_buffer->size();
+    if (shared_grids) {
+      // The decoder gets the parameters of shared grids from the sequence
+      // header so we only need to signal whether the grid is shared.
+      const bool is_shared = encoder()->options()->GetAttributeBool(
+          att_id, "quantization_shared", false);
+      out_buffer->Encode(static_cast<uint8_t>(is_shared));
+      if (!is_shared) {
+        transform.EncodeParameters(out_buffer);
+      }
+    } else {
+      transform.EncodeParameters(out_buffer);
+    }
+    AttributeEncodingStats *const att_stats = GetAttributeStats(i);
+    if (att_stats) {
+      att_stats->encoded_size += out_buffer->size() - start_size;
+    }
   }
 
   // Encode data needed for transforming signed integers to unsigned ones.
+  const int64_t start_size = out_buffer->size();
   for (int i = 0; i < min_signed_values_.size(); ++i) {
     EncodeVarint<int32_t>(min_signed_values_[i], out_buffer);
   }
+  AttributeEncodingStats *const att_stats = GetAttributeStats(0);
+  if (att_stats) {
+    att_stats->encoded_size += out_buffer->size() - start_size;
+  }
   return true;
 }
 
@@ -143,18 +211,29 @@ bool KdTreeAttributesEncoder::EncodePortableAttributes(
     compression_level = 5;
   }
 
+  const EncodingStatsTimer timer(encoder()->encoding_stats() != nullptr);
+  const int64_t start_size = out_buffer->size();
   out_buffer->Encode(compression_level);
 
   // Init PointDVector. The number of dimensions is equal to the total number
-  // of dimensions across all attributes.
+  // of dimensions across all attributes coded by the kd-tree. When there are
+  // VQ index attributes, an extra dimension stores the id of each point, which
+  // is not encoded but it tracks the points when the kd-tree reorders them.
   const int num_points = encoder()->point_cloud()->num_points();
-  PointDVector<uint32_t> point_vector(num_points, num_components_);
+  const bool has_index_attributes =
+      std::find(is_index_attribute_.begin(), is_index_attribute_.end(),
+                true) != is_index_attribute_.end();
+  PointDVector<uint32_t> point_vector(
+      num_points, num_components_ + (has_index_attributes ? 1 : 0));
 
   int num_processed_components = 0;
   int num_processed_quantized_attributes = 0;
   int num_processed_signed_components = 0;
   // Copy data to the point vector.
   for (uint32_t i = 0; i < num_attributes(); ++i) {
+    if (is_index_attribute_[i]) {
+      continue;
+    }
     const int att_id = GetAttributeId(i);
     const PointAttribute *const att =
         encoder()->point_cloud()->attribute(att_id);
@@ -225,81 +304,147 @@ bool KdTreeAttributesEncoder::EncodePortableAttributes(
     }
     num_processed_components += source_att->num_components();
   }
+  if (has_index_attributes) {
+    for (int p = 0; p < num_points; ++p) {
+      point_vector[p][num_components_] = p;
+    }
+  }
 
   // Compute the maximum bit length needed for the kd tree encoding.
   int num_bits = 0;
-  const uint32_t *data = point_vector[0];
-  for (int i = 0; i < num_points * num_components_; ++i) {
-    if (data[i] > 0) {
-      const int msb = MostSignificantBit(data[i]) + 1;
-      if (msb > num_bits) {
-        num_bits = msb;
+  for (int p = 0; p < num_points; ++p) {
+    const uint32_t *const data = point_vector[p];
+    for (int c = 0; c < num_components_; ++c) {
+      if (data[c] > 0) {
+        const int msb = MostSignificantBit(data[c]) + 1;
+        if (msb > num_bits) {
+          num_bits = msb;
+        }
       }
     }
   }
 
-  switch (compression_level) {
-    case 6: {
-      DynamicIntegerPointsKdTreeEncoder<6> points_encoder(num_components_);
-      if (!points_encoder.EncodePoints(point_vector.begin(), point_vector.end(),
-                                       num_bits, out_buffer)) {
-        return false;
-      }
-      break;
-    }
-    case 5: {
-      DynamicIntegerPointsKdTreeEncoder<5> points_encoder(num_components_);
-      if (!points_encoder.EncodePoints(point_vector.begin(), point_vector.end(),
-                                       num_bits, out_buffer)) {
-        return false;
-      }
-      break;
-    }
-    case 4: {
-      DynamicIntegerPointsKdTreeEncoder<4> points_encoder(num_components_);
-      if (!points_encoder.EncodePoints(point_vector.begin(), point_vector.end(),
-                                       num_bits, out_buffer)) {
+  std::vector<uint32_t> decoding_order;
+  std::vector<uint32_t> *const decoding_order_ptr =
+      has_index_attributes ? &decoding_order : nullptr;
+  if (num_components_ > 0) {
+    switch (compression_level) {
+      case 6:
+        if (!EncodePoints<6>(&point_vector, num_bits, out_buffer,
+                             decoding_order_ptr)) {
+          return false;
+        }
+        break;
+      case 5:
+        if (!EncodePoints<5>(&point_vector, num_bits, out_buffer,
+                             decoding_order_ptr)) {
+          return false;
+        }
+        break;
+      case 4:
+        if (!EncodePoints<4>(&point_vector, num_bits, out_buffer,
+                             decoding_order_ptr)) {
+          return false;
+        }
+        break;
+      case 3:
+        if (!EncodePoints<3>(&point_vector, num_bits, out_buffer,
+                             decoding_order_ptr)) {
+          return false;
+        }
+        break;
+      case 2:
+        if (!EncodePoints<2>(&point_vector, num_bits, out_buffer,
+                             decoding_order_ptr)) {
+          return false;
+        }
+        break;
+      case 1:
+        if (!EncodePoints<1>(&point_vector, num_bits, out_buffer,
+                             decoding_order_ptr)) {
+          return false;
+        }
+        break;
+      case 0:
+        if (!EncodePoints<0>(&point_vector, num_bits, out_buffer,
+                             decoding_order_ptr)) {
+          return false;
+        }
+        break;
+      // Compression level and/or encoding speed seem wrong.
+      default:
         return false;
-      }
-      break;
     }
-    case 3: {
-      DynamicIntegerPointsKdTreeEncoder<3> points_encoder(num_components_);
-      if (!points_encoder.EncodePoints(point_vector.begin(), point_vector.end(),
-                                       num_bits, out_buffer)) {
-        return false;
-      }
-      break;
+  }
+  AttributeEncodingStats *const att_stats = GetAttributeStats(0);
+  if (att_stats) {
+    // The attributes are encoded jointly so the sizes of the whole kd-tree are
+    // reported on the first attribute.
+    const int64_t tree_size = out_buffer->size() - start_size;
+    att_stats->encoded_size += tree_size;
+    att_stats->entropy_coded_size = tree_size;
+    att_stats->entropy_input_size =
+        (static_cast<int64_t>(num_points) * num_components_ * num_bits + 7) /
+        8;
+    att_stats->entropy_coding_time = timer.Elapsed();
+  }
+
+  if (has_index_attributes) {
+    // Encode the VQ index attributes in the order in which the decoder
+    // reconstructs the points. Without any kd-tree components, the points are
+    // decoded in their original order.
+    std::vector<PointIndex> point_ids(num_points);
+    for (int p = 0; p < num_points; ++p) {
+      point_ids[p] = num_components_ > 0
+                         ? PointIndex(point_vector[decoding_order[p]]
+                                                  [num_components_])
+                         : PointIndex(p);
     }
-    case 2: {
-      DynamicIntegerPointsKdTreeEncoder<2> points_encoder(num_components_);
-      if (!points_encoder.EncodePoints(point_vector.begin(), point_vector.end(),
-                                       num_bits, out_buffer)) {
-        return false;
+    Options symbol_encoding_options;
+    SetSymbolEncodingCompressionLevel(&symbol_encoding_options,
+                                      10 - encoder()->options()->GetSpeed());
+    for (uint32_t i = 0; i < num_attributes(); ++i) {
+      if (!is_index_attribute_[i]) {
+        continue;
       }
-      break;
-    }
-    case 1: {
-      DynamicIntegerPointsKdTreeEncoder<1> points_encoder(num_components_);
-      if (!points_encoder.EncodePoints(point_vector.begin(), point_vector.end(),
-                                       num_bits, out_buffer)) {
+      const EncodingStatsTimer index_timer(
+          encoder()->encoding_stats() != nullptr);
+      const int64_t index_start_size = out_buffer->size();
+      const PointAttribute *const att =
+          encoder()->point_cloud()->attribute(GetAttributeId(i));
+      if (!EncodeIndexAttribute(*att, point_ids, &symbol_encoding_options,
+                                out_buffer)) {
         return false;
       }
-      break;
-    }
-    case 0: {
-      DynamicIntegerPointsKdTreeEncoder<0> points_encoder(num_components_);
-      if (!points_encoder.EncodePoints(point_vector.begin(), point_vector.end(),
-                                       num_bits, out_buffer)) {
-        return false;
+      AttributeEncodingStats *const index_stats = GetAttributeStats(i);
+      if (index_stats) {
+        index_stats->encoded_size += out_buffer->size() - index_start_size;
+        index_stats->entropy_coded_size =
+            out_buffer->size() - index_start_size;
+        index_stats->entropy_coding_time = index_timer.Elapsed();
       }
-      break;
     }
-    // Compression level and/or encoding speed seem wrong.
-    default:
-      return false;
   }
   return true;
 }
 
+template <int level_t>
+bool KdTreeAttributesEncoder::EncodePoints(
+    PointDVector<uint32_t> *point_vector, int num_bits,
+    EncoderBuffer *out_buffer, std::vector<uint32_t> *decoding_order) {
+  DynamicIntegerPointsKdTreeEncoder<level_t> points_encoder(num_components_);
+  points_encoder.set_decoding_order(decoding_order);
+  return points_encoder.EncodePoints(point_vector->begin(),
+                                     point_vector->end(), num_bits,
+                                     out_buffer);
+}
+
+AttributeEncodingStats *KdTreeAttributesEncoder::GetAttributeStats(int i) {
+  EncodingStats *const stats = encoder()->encoding_stats();
+  if (stats == nullptr || i >= num_attributes()) {
+    return nullptr;
+  }
+  return stats->GetAttribute(GetAttributeId(i));
+}
+
 }  // namespace draco
@@ -17,7 +17,9 @@
 
 #include "draco/attributes/attribute_quantization_transform.h"
 #include "draco/compression/attributes/attributes_encoder.h"
+#include "draco/compression/attributes/point_d_vector.h"
 #include "draco/compression/config/compression_shared.h"
+#include "draco/compression/encoding_stats.h"
 
 namespace draco {
 
@@ -37,13 +39,28 @@ class KdTreeAttributesEncoder : public AttributesEncoder {
   bool EncodeDataNeededByPortableTransforms(EncoderBuffer *out_buffer) override;
 
  private:
+  // Encodes the points with the kd-tree encoder of the given compression
+  // level. When |decoding_order| is not null, it receives the order of the
+  // points in the decoder (see DynamicIntegerPointsKdTreeEncoder).
+  template <int level_t>
+  bool EncodePoints(PointDVector<uint32_t> *point_vector, int num_bits,
+                    EncoderBuffer *out_buffer,
+                    std::vector<uint32_t> *decoding_order);
+
+  // Returns stats of the i-th attribute or nullptr when the encoder does not
+  // collect stats.
+  AttributeEncodingStats *GetAttributeStats(int i);
+
   std::vector<AttributeQuantizationTransform>
       attribute_quantization_transforms_;
   // Min signed values are used to transform signed integers into unsigned ones
   // (by subtracting the min signed value for each component).
   std::vector<int32_t> min_signed_values_;
   std::vector<std::unique_ptr<PointAttribute>> quantized_portable_attributes_;
+  // Number of components of all attributes coded by the kd-tree.
   int num_components_;
+  // Whether each attribute is a VQ index attribute that is coded separately.
+  std::vector<bool> is_index_attribute_;
 };
 
 }  // namespace draco
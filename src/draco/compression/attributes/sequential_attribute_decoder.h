@@ -43,6 +43,15 @@ class SequentialAttributeDecoder {
   virtual bool DecodeDataNeededByPortableTransform(
       const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer);
 
+  // Finishes decoding of the portable attribute when the decoder postponed it
+  // in DecodePortableAttribute() (see
+  // PointCloudDecoder::defer_attribute_reconstruction()). Portable attributes
+  // of all parent attributes must be already reconstructed.
+  virtual bool ReconstructPortableAttribute(
+      const std::vector<PointIndex> &point_ids) {
+    return true;
+  }
+
   // Reverts transformation performed by encoder in
   // SequentialAttributeEncoder::TransformAttributeToPortableFormat() method.
   virtual bool TransformAttributeToOriginalFormat(
@@ -55,6 +64,11 @@ class SequentialAttributeDecoder {
   int attribute_id() const { return attribute_id_; }
   PointCloudDecoder *decoder() const { return decoder_; }
 
+  // Returns ids of attributes used by the prediction scheme of this decoder.
+  const std::vector<int32_t> &parent_attribute_ids() const {
+    return parent_attribute_ids_;
+  }
+
  protected:
   // Should be used to initialize newly created prediction scheme.
   // Returns false when the initialization failed (in which case the scheme
@@ -76,6 +90,7 @@ class SequentialAttributeDecoder {
   PointCloudDecoder *decoder_;
   PointAttribute *attribute_;
   int attribute_id_;
+  std::vector<int32_t> parent_attribute_ids_;
 
   // Storage for decoded portable attribute (after lossless decoding).
   std::unique_ptr<PointAttribute> portable_attribute_;
@@ -13,11 +13,18 @@
 // limitations under the License.
 //
 #include "draco/compression/attributes/sequential_attribute_decoders_controller.h"
+
+#include <algorithm>
+
+#include "draco/compression/attributes/sequential_float_attribute_decoder.h"
+#include "draco/compression/attributes/sequential_index_attribute_decoder.h"
 #ifdef DRACO_NORMAL_ENCODING_SUPPORTED
 #include "draco/compression/attributes/sequential_normal_attribute_decoder.h"
 #endif
 #include "draco/compression/attributes/sequential_quantization_attribute_decoder.h"
 #include "draco/compression/config/compression_shared.h"
+#include "draco/core/thread_pool.h"
+#include "draco/core/trace.h"
 
 namespace draco {
 
@@ -52,6 +59,29 @@ bool SequentialAttributeDecodersController::DecodeAttributesDecoderData(
 
 bool SequentialAttributeDecodersController::DecodeAttributes(
     DecoderBuffer *buffer) {
+  if (!GenerateSequence()) {
+    return false;
+  }
+  return AttributesDecoder::DecodeAttributes(buffer);
+}
+
+bool SequentialAttributeDecodersController::DecodeChunk(
+    int chunk_id, DecoderBuffer *in_buffer) {
+  if (chunk_id == 0 && !GenerateSequence()) {
+    return false;
+  }
+  DRACO_TRACE_SPAN_ARG("DecodeAttributeChunk", "attribute_id",
+                       GetAttributeId(chunk_id));
+  SequentialAttributeDecoder *const att_dec =
+      sequential_decoders_[chunk_id].get();
+  if (!att_dec->DecodePortableAttribute(point_ids_, in_buffer) ||
+      !att_dec->DecodeDataNeededByPortableTransform(point_ids_, in_buffer)) {
+    return false;
+  }
+  return TransformAttributeToOriginalFormat(chunk_id);
+}
+
+bool SequentialAttributeDecodersController::GenerateSequence() {
   if (!sequencer_ || !sequencer_->GenerateSequence(&point_ids_)) {
     return false;
   }
@@ -64,13 +94,15 @@ bool SequentialAttributeDecodersController::DecodeAttributes(
       return false;
     }
   }
-  return AttributesDecoder::DecodeAttributes(buffer);
+  return true;
 }
 
 bool SequentialAttributeDecodersController::DecodePortableAttributes(
     DecoderBuffer *in_buffer) {
   const int32_t num_attributes = GetNumAttributes();
   for (int i = 0; i < num_attributes; ++i) {
+    DRACO_TRACE_SPAN_ARG("DecodePortableAttribute", "attribute_id",
+                         GetAttributeId(i));
     if (!sequential_decoders_[i]->DecodePortableAttribute(point_ids_,
                                                           in_buffer)) {
       return false;
@@ -83,6 +115,8 @@ bool SequentialAttributeDecodersController::
     DecodeDataNeededByPortableTransforms(DecoderBuffer *in_buffer) {
   const int32_t num_attributes = GetNumAttributes();
   for (int i = 0; i < num_attributes; ++i) {
+    DRACO_TRACE_SPAN_ARG("DecodeDataNeededByPortableTransform",
+                         "attribute_id", GetAttributeId(i));
     if (!sequential_decoders_[i]->DecodeDataNeededByPortableTransform(
             point_ids_, in_buffer)) {
       return false;
@@ -95,32 +129,97 @@ bool SequentialAttributeDecodersController::
     TransformAttributesToOriginalFormat() {
   const int32_t num_attributes = GetNumAttributes();
   for (int i = 0; i < num_attributes; ++i) {
-    // Check whether the attribute transform should be skipped.
-    if (GetDecoder()->options()) {
-      const PointAttribute *const attribute =
-          sequential_decoders_[i]->attribute();
-      const PointAttribute *const portable_attribute =
-          sequential_decoders_[i]->GetPortableAttribute();
-      if (portable_attribute &&
-          GetDecoder()->options()->GetAttributeBool(
-              attribute->attribute_type(), "skip_attribute_transform", false)) {
-        // Attribute transform should not be performed. In this case, we replace
-        // the output geometry attribute with the portable attribute.
-        // TODO(ostava): We can potentially avoid this copy by introducing a new
-        // mechanism that would allow to use the final attributes as portable
-        // attributes for predictors that may need them.
-        sequential_decoders_[i]->attribute()->CopyFrom(*portable_attribute);
-        continue;
+    if (!TransformAttributeToOriginalFormat(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SequentialAttributeDecodersController::TransformAttributeToOriginalFormat(
+    int i) {
+  DRACO_TRACE_SPAN_ARG("TransformAttributeToOriginalFormat", "attribute_id",
+                       GetAttributeId(i));
+  // Check whether the attribute transform should be skipped.
+  if (GetDecoder()->options()) {
+    const PointAttribute *const attribute =
+        sequential_decoders_[i]->attribute();
+    const PointAttribute *const portable_attribute =
+        sequential_decoders_[i]->GetPortableAttribute();
+    if (portable_attribute &&
+        GetDecoder()->options()->GetAttributeBool(
+            attribute->attribute_type(), "skip_attribute_transform", false)) {
+      // Attribute transform should not be performed. In this case, we replace
+      // the output geometry attribute with the portable attribute.
+      // TODO(ostava): We can potentially avoid this copy by introducing a new
+      // mechanism that would allow to use the final attributes as portable
+      // attributes for predictors that may need them.
+      sequential_decoders_[i]->attribute()->CopyFrom(*portable_attribute);
+      return true;
+    }
+  }
+  return sequential_decoders_[i]->TransformAttributeToOriginalFormat(
+      point_ids_);
+}
+
+bool SequentialAttributeDecodersController::ReconstructAttributes() {
+  // Attributes predicted from other attributes of this decoder must wait until
+  // the portable values of their parents are reconstructed. Assign each
+  // attribute a level larger than the levels of its parents.
+  const int32_t num_attributes = GetNumAttributes();
+  std::vector<int> levels(num_attributes, 0);
+  int num_levels = 0;
+  for (int i = 0; i < num_attributes; ++i) {
+    for (const int32_t parent_att_id :
+         sequential_decoders_[i]->parent_attribute_ids()) {
+      const int32_t parent_id = GetLocalIdForPointAttribute(parent_att_id);
+      if (parent_id >= i) {
+        return false;  // Parents are always decoded first.
+      }
+      if (parent_id >= 0) {
+        levels[i] = std::max(levels[i], levels[parent_id] + 1);
       }
     }
-    if (!sequential_decoders_[i]->TransformAttributeToOriginalFormat(
-            point_ids_)) {
-      return false;
+    num_levels = std::max(num_levels, levels[i] + 1);
+  }
+
+  const int num_threads = GetDecoder()->num_attributes_decoder_threads();
+  for (int level = 0; level < num_levels; ++level) {
+    std::vector<int> level_ids;
+    for (int i = 0; i < num_attributes; ++i) {
+      if (levels[i] == level) {
+        level_ids.push_back(i);
+      }
+    }
+    const int num_level_attributes = static_cast<int>(level_ids.size());
+    std::vector<uint8_t> reconstructed(num_level_attributes, 0);
+    ParallelFor(num_level_attributes, num_threads, [&](int j) {
+      const int i = level_ids[j];
+      DRACO_TRACE_SPAN_ARG("ReconstructPortableAttribute", "attribute_id",
+                           GetAttributeId(i));
+      reconstructed[j] =
+          sequential_decoders_[i]->ReconstructPortableAttribute(point_ids_) &&
+          TransformAttributeToOriginalFormat(i);
+    });
+    for (int j = 0; j < num_level_attributes; ++j) {
+      if (!reconstructed[j]) {
+        return false;
+      }
     }
   }
   return true;
 }
 
+std::vector<int32_t>
+SequentialAttributeDecodersController::GetParentAttributeIds() const {
+  std::vector<int32_t> parent_att_ids;
+  for (const auto &seq_decoder : sequential_decoders_) {
+    const std::vector<int32_t> &ids = seq_decoder->parent_attribute_ids();
+    parent_att_ids.insert(parent_att_ids.end(), ids.begin(), ids.end());
+  }
+  return parent_att_ids;
+}
+
 std::unique_ptr<SequentialAttributeDecoder>
 SequentialAttributeDecodersController::CreateSequentialDecoder(
     uint8_t decoder_type) {
@@ -139,6 +238,12 @@ SequentialAttributeDecodersController::CreateSequentialDecoder(
       return std::unique_ptr<SequentialNormalAttributeDecoder>(
           new SequentialNormalAttributeDecoder());
 #endif
+    case SEQUENTIAL_ATTRIBUTE_ENCODER_INDEX:
+      return std::unique_ptr<SequentialAttributeDecoder>(
+          new SequentialIndexAttributeDecoder());
+    case SEQUENTIAL_ATTRIBUTE_ENCODER_FLOAT:
+      return std::unique_ptr<SequentialAttributeDecoder>(
+          new SequentialFloatAttributeDecoder());
     default:
       break;
   }
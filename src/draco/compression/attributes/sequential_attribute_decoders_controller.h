@@ -34,6 +34,12 @@ class SequentialAttributeDecodersController : public AttributesDecoder {
 
   bool DecodeAttributesDecoderData(DecoderBuffer *buffer) override;
   bool DecodeAttributes(DecoderBuffer *buffer) override;
+
+  // Each attribute is decoded from its own chunk.
+  int GetNumChunks() const override {
+    return static_cast<int>(sequential_decoders_.size());
+  }
+  bool DecodeChunk(int chunk_id, DecoderBuffer *in_buffer) override;
   const PointAttribute *GetPortableAttribute(
       int32_t point_attribute_id) override {
     const int32_t loc_id = GetLocalIdForPointAttribute(point_attribute_id);
@@ -42,6 +48,8 @@ class SequentialAttributeDecodersController : public AttributesDecoder {
     }
     return sequential_decoders_[loc_id]->GetPortableAttribute();
   }
+  bool ReconstructAttributes() override;
+  std::vector<int32_t> GetParentAttributeIds() const override;
 
  protected:
   bool DecodePortableAttributes(DecoderBuffer *in_buffer) override;
@@ -51,6 +59,14 @@ class SequentialAttributeDecodersController : public AttributesDecoder {
       uint8_t decoder_type);
 
  private:
+  // Generates the sequence of decoded points and updates the point to
+  // attribute value mapping of all attributes.
+  bool GenerateSequence();
+
+  // Reverts the transform of the |i|-th attribute of this decoder unless it is
+  // disabled by the "skip_attribute_transform" option.
+  bool TransformAttributeToOriginalFormat(int i);
+
   std::vector<std::unique_ptr<SequentialAttributeDecoder>> sequential_decoders_;
   std::vector<PointIndex> point_ids_;
   std::unique_ptr<PointsSequencer> sequencer_;
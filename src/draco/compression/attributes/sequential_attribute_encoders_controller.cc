@@ -13,11 +13,15 @@
 // limitations under the License.
 //
 #include "draco/compression/attributes/sequential_attribute_encoders_controller.h"
+#include "draco/compression/attributes/index_attribute_coding_shared.h"
+#include "draco/compression/attributes/sequential_float_attribute_encoder.h"
+#include "draco/compression/attributes/sequential_index_attribute_encoder.h"
 #ifdef DRACO_NORMAL_ENCODING_SUPPORTED
 #include "draco/compression/attributes/sequential_normal_attribute_encoder.h"
 #endif
 #include "draco/compression/attributes/sequential_quantization_attribute_encoder.h"
 #include "draco/compression/point_cloud/point_cloud_encoder.h"
+#include "draco/core/thread_pool.h"
 
 namespace draco {
 
@@ -67,11 +71,48 @@ bool SequentialAttributeEncodersController::EncodeAttributes(
   return AttributesEncoder::EncodeAttributes(buffer);
 }
 
+bool SequentialAttributeEncodersController::EncodeChunk(
+    int chunk_id, EncoderBuffer *out_buffer) {
+  if (chunk_id == 0) {
+    if (!sequencer_ || !sequencer_->GenerateSequence(&point_ids_)) {
+      return false;
+    }
+    if (!TransformAttributesToPortableFormat()) {
+      return false;
+    }
+  }
+  // The chunk holds all data of the attribute so that it can be decoded
+  // without the chunks of the following attributes.
+  const int64_t start_size = out_buffer->size();
+  SequentialAttributeEncoder *const att_enc =
+      sequential_encoders_[chunk_id].get();
+  if (!att_enc->EncodePortableAttribute(point_ids_, out_buffer) ||
+      !att_enc->EncodeDataNeededByPortableTransform(out_buffer)) {
+    return false;
+  }
+  AttributeEncodingStats *const att_stats = GetAttributeStats(chunk_id);
+  if (att_stats) {
+    att_stats->encoded_size += out_buffer->size() - start_size;
+  }
+  return true;
+}
+
 bool SequentialAttributeEncodersController::
     TransformAttributesToPortableFormat() {
-  for (uint32_t i = 0; i < sequential_encoders_.size(); ++i) {
-    if (!sequential_encoders_[i]->TransformAttributeToPortableFormat(
-            point_ids_)) {
+  // The transforms of individual attributes are independent.
+  const int num_encoders = static_cast<int>(sequential_encoders_.size());
+  std::vector<uint8_t> transformed(num_encoders, 0);
+  ParallelFor(num_encoders, GetNumThreads(), [&](int i) {
+    AttributeEncodingStats *const att_stats = GetAttributeStats(i);
+    const EncodingStatsTimer timer(att_stats != nullptr);
+    transformed[i] =
+        sequential_encoders_[i]->TransformAttributeToPortableFormat(point_ids_);
+    if (att_stats) {
+      att_stats->transform_time = timer.Elapsed();
+    }
+  });
+  for (int i = 0; i < num_encoders; ++i) {
+    if (!transformed[i]) {
       return false;
     }
   }
@@ -80,11 +121,41 @@ bool SequentialAttributeEncodersController::
 
 bool SequentialAttributeEncodersController::EncodePortableAttributes(
     EncoderBuffer *out_buffer) {
-  for (uint32_t i = 0; i < sequential_encoders_.size(); ++i) {
-    if (!sequential_encoders_[i]->EncodePortableAttribute(point_ids_,
-                                                          out_buffer)) {
+  const int num_threads = GetNumThreads();
+  if (num_threads < 2 || sequential_encoders_.size() < 2) {
+    for (uint32_t i = 0; i < sequential_encoders_.size(); ++i) {
+      const int64_t start_size = out_buffer->size();
+      if (!sequential_encoders_[i]->EncodePortableAttribute(point_ids_,
+                                                            out_buffer)) {
+        return false;
+      }
+      AttributeEncodingStats *const att_stats = GetAttributeStats(i);
+      if (att_stats) {
+        att_stats->encoded_size += out_buffer->size() - start_size;
+      }
+    }
+    return true;
+  }
+
+  // All portable attributes are already computed so the attributes can be
+  // encoded concurrently, even when they are predicted from each other. The
+  // encoded data is appended to |out_buffer| in the original order.
+  const int num_encoders = static_cast<int>(sequential_encoders_.size());
+  std::vector<EncoderBuffer> buffers(num_encoders);
+  std::vector<uint8_t> encoded(num_encoders, 0);
+  ParallelFor(num_encoders, num_threads, [&](int i) {
+    encoded[i] = sequential_encoders_[i]->EncodePortableAttribute(point_ids_,
+                                                                  &buffers[i]);
+  });
+  for (int i = 0; i < num_encoders; ++i) {
+    if (!encoded[i] ||
+        !out_buffer->Encode(buffers[i].data(), buffers[i].size())) {
       return false;
     }
+    AttributeEncodingStats *const att_stats = GetAttributeStats(i);
+    if (att_stats) {
+      att_stats->encoded_size += buffers[i].size();
+    }
   }
   return true;
 }
@@ -92,14 +163,65 @@ bool SequentialAttributeEncodersController::EncodePortableAttributes(
 bool SequentialAttributeEncodersController::
     EncodeDataNeededByPortableTransforms(EncoderBuffer *out_buffer) {
   for (uint32_t i = 0; i < sequential_encoders_.size(); ++i) {
+    const int64_t start_size = out_buffer->size();
     if (!sequential_encoders_[i]->EncodeDataNeededByPortableTransform(
             out_buffer)) {
       return false;
     }
+    AttributeEncodingStats *const att_stats = GetAttributeStats(i);
+    if (att_stats) {
+      att_stats->encoded_size += out_buffer->size() - start_size;
+    }
   }
   return true;
 }
 
+int SequentialAttributeEncodersController::GetNumThreads() const {
+  if (encoder() == nullptr) {
+    return 1;
+  }
+  return encoder()->num_attributes_encoder_threads();
+}
+
+AttributeEncodingStats *SequentialAttributeEncodersController::
+    GetAttributeStats(int i) {
+  EncodingStats *const stats = encoder()->encoding_stats();
+  if (stats == nullptr) {
+    return nullptr;
+  }
+  AttributeEncodingStats *const att_stats =
+      stats->GetAttribute(GetAttributeId(i));
+  if (att_stats == nullptr || !att_stats->encoder.empty()) {
+    return att_stats;
+  }
+  // Fill the encoder specific properties on first access.
+  switch (sequential_encoders_[i]->GetUniqueId()) {
+    case SEQUENTIAL_ATTRIBUTE_ENCODER_INTEGER:
+      att_stats->encoder = "integer";
+      break;
+    case SEQUENTIAL_ATTRIBUTE_ENCODER_QUANTIZATION:
+      att_stats->encoder = "quantization";
+      break;
+    case SEQUENTIAL_ATTRIBUTE_ENCODER_NORMALS:
+      att_stats->encoder = "normals";
+      break;
+    case SEQUENTIAL_ATTRIBUTE_ENCODER_INDEX:
+      att_stats->encoder = "index";
+      break;
+    case SEQUENTIAL_ATTRIBUTE_ENCODER_FLOAT:
+      att_stats->encoder = "lossless_float";
+      break;
+    default:
+      att_stats->encoder = "generic";
+      break;
+  }
+  if (sequential_encoders_[i]->IsLossyEncoder()) {
+    att_stats->quantization_bits = encoder()->options()->GetAttributeInt(
+        GetAttributeId(i), "quantization_bits", -1);
+  }
+  return att_stats;
+}
+
 bool SequentialAttributeEncodersController::CreateSequentialEncoders() {
   sequential_encoders_.resize(num_attributes());
   for (uint32_t i = 0; i < num_attributes(); ++i) {
@@ -121,6 +243,11 @@ SequentialAttributeEncodersController::CreateSequentialEncoder(int i) {
   const int32_t att_id = GetAttributeId(i);
   const PointAttribute *const att = encoder()->point_cloud()->attribute(att_id);
 
+  if (IsIndexAttribute(*att) &&
+      encoder()->options()->GetGlobalBool("vq_index_coding", false)) {
+    return std::unique_ptr<SequentialAttributeEncoder>(
+        new SequentialIndexAttributeEncoder());
+  }
   switch (att->data_type()) {
     case DT_UINT8:
     case DT_INT8:
@@ -147,6 +274,11 @@ SequentialAttributeEncodersController::CreateSequentialEncoder(int i) {
         }
 #endif
       }
+      if (encoder()->options()->GetGlobalBool("lossless_float_coding",
+                                              false)) {
+        return std::unique_ptr<SequentialAttributeEncoder>(
+            new SequentialFloatAttributeEncoder());
+      }
       break;
     default:
       break;
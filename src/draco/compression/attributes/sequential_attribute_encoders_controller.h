@@ -18,6 +18,7 @@
 #include "draco/compression/attributes/attributes_encoder.h"
 #include "draco/compression/attributes/points_sequencer.h"
 #include "draco/compression/attributes/sequential_attribute_encoder.h"
+#include "draco/compression/encoding_stats.h"
 
 namespace draco {
 
@@ -38,6 +39,12 @@ class SequentialAttributeEncodersController : public AttributesEncoder {
   bool Init(PointCloudEncoder *encoder, const PointCloud *pc) override;
   bool EncodeAttributesEncoderData(EncoderBuffer *out_buffer) override;
   bool EncodeAttributes(EncoderBuffer *buffer) override;
+
+  // Each attribute is encoded in its own chunk.
+  int NumChunks() const override {
+    return static_cast<int>(sequential_encoders_.size());
+  }
+  bool EncodeChunk(int chunk_id, EncoderBuffer *out_buffer) override;
   uint8_t GetUniqueId() const override { return BASIC_ATTRIBUTE_ENCODER; }
 
   int NumParentAttributes(int32_t point_attribute_id) const override {
@@ -101,6 +108,14 @@ class SequentialAttributeEncodersController : public AttributesEncoder {
       int i);
 
  private:
+  // Returns the maximum number of threads used for processing the attributes
+  // of this controller (see PointCloudEncoder::EncodeAllAttributes()).
+  int GetNumThreads() const;
+
+  // Returns stats of the i-th attribute or nullptr when the encoder does not
+  // collect stats.
+  AttributeEncodingStats *GetAttributeStats(int i);
+
   std::vector<std::unique_ptr<SequentialAttributeEncoder>> sequential_encoders_;
 
   // Flag for each sequential attribute encoder indicating whether it was marked
@@ -0,0 +1,83 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/sequential_float_attribute_decoder.h"
+
+#include <cstring>
+
+#include "draco/compression/entropy/symbol_decoding.h"
+
+namespace draco {
+
+bool SequentialFloatAttributeDecoder::DecodeValues(
+    const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
+  PointAttribute *const att = attribute();
+  if (att->data_type() != DT_FLOAT32) {
+    return false;
+  }
+  const int num_components = att->num_components();
+  const int num_points = static_cast<int>(point_ids.size());
+  const int num_values = num_points * num_components;
+  if (num_values == 0) {
+    return true;
+  }
+  if (att->buffer() == nullptr ||
+      att->buffer()->data_size() <
+          static_cast<int64_t>(num_values) * sizeof(uint32_t)) {
+    return false;
+  }
+
+  // Assemble the residuals from their byte planes.
+  std::vector<uint32_t> residuals(num_values, 0);
+  std::vector<uint32_t> plane(num_points);
+  for (int c = 0; c < num_components; ++c) {
+    for (int b = 0; b < 4; ++b) {
+      const int shift = 8 * b;
+      uint8_t plane_mode;
+      if (!in_buffer->Decode(&plane_mode)) {
+        return false;
+      }
+      if (plane_mode == 0) {
+        if (in_buffer->remaining_size() < num_points) {
+          return false;
+        }
+        const uint8_t *const raw_plane =
+            reinterpret_cast<const uint8_t *>(in_buffer->data_head());
+        for (int p = 0; p < num_points; ++p) {
+          residuals[p * num_components + c] |=
+              static_cast<uint32_t>(raw_plane[p]) << shift;
+        }
+        in_buffer->Advance(num_points);
+      } else if (plane_mode == 1) {
+        if (!DecodeSymbols(num_points, 1, in_buffer, plane.data())) {
+          return false;
+        }
+        for (int p = 0; p < num_points; ++p) {
+          // Masking invalid symbols keeps the loop branch free.
+          residuals[p * num_components + c] |= (plane[p] & 0xff) << shift;
+        }
+      } else {
+        return false;
+      }
+    }
+  }
+  // Undo the XOR with the previous point.
+  for (int i = num_components; i < num_values; ++i) {
+    residuals[i] ^= residuals[i - num_components];
+  }
+  att->buffer()->Write(0, residuals.data(), num_values * sizeof(uint32_t));
+  return true;
+}
+
+}  // namespace draco
@@ -0,0 +1,86 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/sequential_float_attribute_encoder.h"
+
+#include <cstring>
+
+#include "draco/compression/entropy/symbol_encoding.h"
+
+namespace draco {
+
+bool SequentialFloatAttributeEncoder::EncodeValues(
+    const std::vector<PointIndex> &point_ids, EncoderBuffer *out_buffer) {
+  const PointAttribute *const att = attribute();
+  if (att->data_type() != DT_FLOAT32) {
+    return false;
+  }
+  const int num_components = att->num_components();
+  const int num_points = static_cast<int>(point_ids.size());
+  const int num_values = num_points * num_components;
+  if (num_values == 0) {
+    return true;
+  }
+
+  // Gather the bit patterns of the values in the encoding order.
+  std::vector<uint32_t> values(num_values);
+  for (int p = 0; p < num_points; ++p) {
+    memcpy(&values[p * num_components],
+           att->GetAddressOfMappedIndex(point_ids[p]),
+           num_components * sizeof(uint32_t));
+  }
+  // XOR every value with the same component of the previous point.
+  std::vector<uint32_t> residuals(num_values);
+  for (int i = 0; i < num_components; ++i) {
+    residuals[i] = values[i];
+  }
+  for (int i = num_components; i < num_values; ++i) {
+    residuals[i] = values[i] ^ values[i - num_components];
+  }
+
+  Options symbol_encoding_options;
+  if (encoder() != nullptr) {
+    SetSymbolEncodingCompressionLevel(&symbol_encoding_options,
+                                      10 - encoder()->options()->GetSpeed());
+  }
+  std::vector<uint32_t> plane(num_points);
+  std::vector<uint8_t> raw_plane(num_points);
+  for (int c = 0; c < num_components; ++c) {
+    for (int b = 0; b < 4; ++b) {
+      const int shift = 8 * b;
+      for (int p = 0; p < num_points; ++p) {
+        plane[p] = (residuals[p * num_components + c] >> shift) & 0xff;
+      }
+      // Planes of the low mantissa bits are usually close to random and they
+      // are stored raw, which is also faster to decode.
+      if (EstimateEncodedSymbolsBits(plane.data(), num_points, 1) <
+          8 * static_cast<int64_t>(num_points)) {
+        out_buffer->Encode(static_cast<uint8_t>(1));
+        if (!EncodeSymbols(plane.data(), num_points, 1,
+                           &symbol_encoding_options, out_buffer)) {
+          return false;
+        }
+      } else {
+        out_buffer->Encode(static_cast<uint8_t>(0));
+        for (int p = 0; p < num_points; ++p) {
+          raw_plane[p] = static_cast<uint8_t>(plane[p]);
+        }
+        out_buffer->Encode(raw_plane.data(), num_points);
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace draco
@@ -0,0 +1,128 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "draco/compression/attributes/sequential_float_attribute_decoder.h"
+#include "draco/compression/attributes/sequential_float_attribute_encoder.h"
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/vector_d.h"
+#include "draco/point_cloud/point_cloud_builder.h"
+
+namespace draco {
+
+class SequentialFloatAttributeEncodingTest : public ::testing::Test {
+ protected:
+};
+
+TEST_F(SequentialFloatAttributeEncodingTest, DoesEncodeBitExact) {
+  // This test verifies that special values and values without any correlation
+  // are decoded bit exactly.
+  const std::vector<float> values{
+      0.f,
+      -0.f,
+      1.f,
+      -1.5f,
+      std::numeric_limits<float>::infinity(),
+      -std::numeric_limits<float>::infinity(),
+      std::numeric_limits<float>::quiet_NaN(),
+      std::numeric_limits<float>::denorm_min(),
+      std::numeric_limits<float>::max(),
+      std::numeric_limits<float>::lowest(),
+      123456.789f,
+      1e-30f};
+  PointAttribute pa;
+  pa.Init(GeometryAttribute::GENERIC, 2, DT_FLOAT32, false, values.size() / 2);
+  for (uint32_t i = 0; i < values.size() / 2; ++i) {
+    pa.SetAttributeValue(AttributeValueIndex(i), &values[2 * i]);
+  }
+  std::vector<PointIndex> point_ids(values.size() / 2);
+  std::iota(point_ids.begin(), point_ids.end(), 0);
+
+  EncoderBuffer out_buf;
+  SequentialFloatAttributeEncoder fe;
+  ASSERT_TRUE(fe.InitializeStandalone(&pa));
+  ASSERT_TRUE(fe.TransformAttributeToPortableFormat(point_ids));
+  ASSERT_TRUE(fe.EncodePortableAttribute(point_ids, &out_buf));
+
+  PointAttribute decoded_pa;
+  decoded_pa.Init(GeometryAttribute::GENERIC, 2, DT_FLOAT32, false, 0);
+  DecoderBuffer in_buf;
+  in_buf.Init(out_buf.data(), out_buf.size());
+  in_buf.set_bitstream_version(kDracoPointCloudBitstreamVersion);
+  SequentialFloatAttributeDecoder fd;
+  ASSERT_TRUE(fd.InitializeStandalone(&decoded_pa));
+  ASSERT_TRUE(fd.DecodePortableAttribute(point_ids, &in_buf));
+  ASSERT_EQ(decoded_pa.size(), pa.size());
+  ASSERT_EQ(memcmp(decoded_pa.GetAddress(AttributeValueIndex(0)),
+                   pa.GetAddress(AttributeValueIndex(0)),
+                   values.size() * sizeof(float)),
+            0);
+}
+
+TEST_F(SequentialFloatAttributeEncodingTest, DoesCompressPointCloud) {
+  // This test verifies that unquantized float attributes of a point cloud are
+  // decoded bit exactly and that they are smaller than the raw values.
+  constexpr int kNumPoints = 10000;
+  PointCloudBuilder builder;
+  builder.Start(kNumPoints);
+  const int pos_att_id =
+      builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+  const int scale_att_id =
+      builder.AddAttribute(GeometryAttribute::SCALE, 3, DT_FLOAT32);
+  for (PointIndex i(0); i < kNumPoints; ++i) {
+    const float t = static_cast<float>(i.value());
+    const Vector3f pos(std::sin(t * 0.01f), std::cos(t * 0.01f), t * 1e-3f);
+    builder.SetAttributeValueForPoint(pos_att_id, i, pos.data());
+    const Vector3f scale(-4.f - 0.25f * (i.value() % 4), -5.f, -4.5f);
+    builder.SetAttributeValueForPoint(scale_att_id, i, scale.data());
+  }
+  const std::unique_ptr<PointCloud> pc = builder.Finalize(false);
+  ASSERT_NE(pc, nullptr);
+
+  Encoder encoder;
+  encoder.SetSpeedOptions(5, 5);
+  encoder.SetLosslessFloatCoding(true);
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodePointCloudToBuffer(*pc, &buffer));
+  ASSERT_LT(buffer.size(), kNumPoints * 6 * sizeof(float) / 2);
+
+  DecoderBuffer in_buffer;
+  in_buffer.Init(buffer.data(), buffer.size());
+  Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<PointCloud> decoded_pc,
+                         decoder.DecodePointCloudFromBuffer(&in_buffer));
+  ASSERT_EQ(decoded_pc->num_points(), pc->num_points());
+  for (int a = 0; a < pc->num_attributes(); ++a) {
+    const PointAttribute *const att = pc->attribute(a);
+    const PointAttribute *const decoded_att = decoded_pc->attribute(a);
+    for (PointIndex i(0); i < kNumPoints; ++i) {
+      ASSERT_EQ(memcmp(att->GetAddressOfMappedIndex(i),
+                       decoded_att->GetAddressOfMappedIndex(i),
+                       att->byte_stride()),
+                0);
+    }
+  }
+}
+
+}  // namespace draco
@@ -0,0 +1,27 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/sequential_index_attribute_decoder.h"
+
+#include "draco/compression/attributes/index_attribute_decoding.h"
+
+namespace draco {
+
+bool SequentialIndexAttributeDecoder::DecodeValues(
+    const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
+  return DecodeIndexAttribute(static_cast<uint32_t>(point_ids.size()),
+                              in_buffer, attribute());
+}
+
+}  // namespace draco
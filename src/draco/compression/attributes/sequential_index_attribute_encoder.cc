@@ -0,0 +1,33 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/sequential_index_attribute_encoder.h"
+
+#include "draco/compression/attributes/index_attribute_encoding.h"
+#include "draco/compression/entropy/symbol_encoding.h"
+
+namespace draco {
+
+bool SequentialIndexAttributeEncoder::EncodeValues(
+    const std::vector<PointIndex> &point_ids, EncoderBuffer *out_buffer) {
+  Options symbol_encoding_options;
+  if (encoder() != nullptr) {
+    SetSymbolEncodingCompressionLevel(&symbol_encoding_options,
+                                      10 - encoder()->options()->GetSpeed());
+  }
+  return EncodeIndexAttribute(*attribute(), point_ids,
+                              &symbol_encoding_options, out_buffer);
+}
+
+}  // namespace draco
@@ -20,7 +20,8 @@
 
 namespace draco {
 
-SequentialIntegerAttributeDecoder::SequentialIntegerAttributeDecoder() {}
+SequentialIntegerAttributeDecoder::SequentialIntegerAttributeDecoder()
+    : reconstruction_pending_(false), pending_num_components_(0) {}
 
 bool SequentialIntegerAttributeDecoder::Init(PointCloudDecoder *decoder,
                                              int attribute_id) {
@@ -30,6 +31,17 @@ bool SequentialIntegerAttributeDecoder::Init(PointCloudDecoder *decoder,
   return true;
 }
 
+bool SequentialIntegerAttributeDecoder::ReconstructPortableAttribute(
+    const std::vector<PointIndex> &point_ids) {
+  if (!reconstruction_pending_) {
+    return true;
+  }
+  reconstruction_pending_ = false;
+  const int num_values =
+      static_cast<int>(point_ids.size()) * pending_num_components_;
+  return ComputeOriginalValues(point_ids, num_values, pending_num_components_);
+}
+
 bool SequentialIntegerAttributeDecoder::TransformAttributeToOriginalFormat(
     const std::vector<PointIndex> &point_ids) {
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
@@ -160,27 +172,48 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
     }
   }
 
-  if (num_values > 0 && (prediction_scheme_ == nullptr ||
-                         !prediction_scheme_->AreCorrectionsPositive())) {
+  if (prediction_scheme_) {
+    if (!prediction_scheme_->DecodePredictionData(in_buffer)) {
+      return false;
+    }
+  }
+
+  // All data of the attribute has been read from |in_buffer|. The remaining
+  // work can be postponed and done concurrently with other attributes.
+  if (decoder() && decoder()->defer_attribute_reconstruction()) {
+    reconstruction_pending_ = true;
+    pending_num_components_ = num_components;
+    return true;
+  }
+  return ComputeOriginalValues(point_ids, static_cast<int>(num_values),
+                               num_components);
+}
+
+bool SequentialIntegerAttributeDecoder::ComputeOriginalValues(
+    const std::vector<PointIndex> &point_ids, int num_values,
+    int num_components) {
+  if (num_values == 0) {
+    return true;
+  }
+  int32_t *const portable_attribute_data = GetPortableAttributeData();
+  if (portable_attribute_data == nullptr) {
+    return false;
+  }
+  if (prediction_scheme_ == nullptr ||
+      !prediction_scheme_->AreCorrectionsPositive()) {
     // Convert the values back to the original signed format.
     ConvertSymbolsToSignedInts(
         reinterpret_cast<const uint32_t *>(portable_attribute_data),
-        static_cast<int>(num_values), portable_attribute_data);
+        num_values, portable_attribute_data);
   }
 
   // If the data was encoded with a prediction scheme, we must revert it.
   if (prediction_scheme_) {
-    if (!prediction_scheme_->DecodePredictionData(in_buffer)) {
+    if (!prediction_scheme_->ComputeOriginalValues(
+            portable_attribute_data, portable_attribute_data, num_values,
+            num_components, point_ids.data())) {
       return false;
     }
-
-    if (num_values > 0) {
-      if (!prediction_scheme_->ComputeOriginalValues(
-              portable_attribute_data, portable_attribute_data,
-              static_cast<int>(num_values), num_components, point_ids.data())) {
-        return false;
-      }
-    }
   }
   return true;
 }
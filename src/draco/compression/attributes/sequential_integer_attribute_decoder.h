@@ -27,6 +27,8 @@ class SequentialIntegerAttributeDecoder : public SequentialAttributeDecoder {
   SequentialIntegerAttributeDecoder();
   bool Init(PointCloudDecoder *decoder, int attribute_id) override;
 
+  bool ReconstructPortableAttribute(
+      const std::vector<PointIndex> &point_ids) override;
   bool TransformAttributeToOriginalFormat(
       const std::vector<PointIndex> &point_ids) override;
 
@@ -67,8 +69,17 @@ class SequentialIntegerAttributeDecoder : public SequentialAttributeDecoder {
   template <typename AttributeTypeT>
   void StoreTypedValues(uint32_t num_values);
 
+  // Converts the decoded symbols to signed values and reverts the prediction.
+  bool ComputeOriginalValues(const std::vector<PointIndex> &point_ids,
+                             int num_values, int num_components);
+
   std::unique_ptr<PredictionSchemeTypedDecoderInterface<int32_t>>
       prediction_scheme_;
+
+  // Set when ComputeOriginalValues() was postponed to
+  // ReconstructPortableAttribute().
+  bool reconstruction_pending_;
+  int pending_num_components_;
 };
 
 }  // namespace draco
@@ -135,6 +135,12 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
   // process all encoded data in a separate array.
   std::vector<int32_t> encoded_data(num_values);
 
+  AttributeEncodingStats *att_stats = nullptr;
+  if (encoder() != nullptr && encoder()->encoding_stats() != nullptr) {
+    att_stats = encoder()->encoding_stats()->GetAttribute(attribute_id());
+  }
+  const EncodingStatsTimer prediction_timer(att_stats != nullptr);
+
   // All integer values are initialized. Process them using the prediction
   // scheme if we have one.
   if (prediction_scheme_) {
@@ -152,6 +158,13 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
     ConvertSignedIntsToSymbols(input, num_values,
                                reinterpret_cast<uint32_t *>(&encoded_data[0]));
   }
+  if (att_stats) {
+    att_stats->prediction_time = prediction_timer.Elapsed();
+    RecordSymbolStats(reinterpret_cast<uint32_t *>(encoded_data.data()),
+                      num_values, num_components, att_stats);
+  }
+  const EncodingStatsTimer entropy_coding_timer(att_stats != nullptr);
+  const int64_t entropy_coding_start_size = out_buffer->size();
 
   if (encoder() == nullptr || encoder()->options()->GetGlobalBool(
                                   "use_built_in_attribute_compression", true)) {
@@ -160,12 +173,25 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
     if (encoder() != nullptr) {
       SetSymbolEncodingCompressionLevel(&symbol_encoding_options,
                                         10 - encoder()->options()->GetSpeed());
+      SetSymbolEncodingBucketedCoding(
+          &symbol_encoding_options,
+          encoder()->options()->GetGlobalBool("bucketed_symbol_coding",
+                                              false));
     }
+    if (att_stats) {
+      // The first byte written by EncodeSymbols() is the coding method.
+      att_stats->symbol_coding_method = SYMBOL_CODING_TAGGED;
+    }
+    const int64_t symbols_start_size = out_buffer->size();
     if (!EncodeSymbols(reinterpret_cast<uint32_t *>(encoded_data.data()),
                        static_cast<int>(point_ids.size()) * num_components,
                        num_components, &symbol_encoding_options, out_buffer)) {
       return false;
     }
+    if (att_stats && out_buffer->size() > symbols_start_size) {
+      att_stats->symbol_coding_method =
+          out_buffer->data()[symbols_start_size];
+    }
   } else {
     // No compression. Just store the raw integer values, using the number of
     // bytes as needed.
@@ -193,12 +219,36 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
       }
     }
   }
+  if (att_stats) {
+    att_stats->entropy_coded_size =
+        out_buffer->size() - entropy_coding_start_size;
+    att_stats->entropy_coding_time = entropy_coding_timer.Elapsed();
+  }
   if (prediction_scheme_) {
     prediction_scheme_->EncodePredictionData(out_buffer);
   }
   return true;
 }
 
+void SequentialIntegerAttributeEncoder::RecordSymbolStats(
+    const uint32_t *symbols, int num_values, int num_components,
+    AttributeEncodingStats *att_stats) const {
+  if (prediction_scheme_) {
+    att_stats->prediction_scheme = prediction_scheme_->GetPredictionMethod();
+    att_stats->prediction_transform = prediction_scheme_->GetTransformType();
+  }
+  uint32_t masked_value = 0;
+  for (int i = 0; i < num_values; ++i) {
+    masked_value |= symbols[i];
+  }
+  const int num_bytes =
+      masked_value == 0 ? 1 : 1 + MostSignificantBit(masked_value) / 8;
+  att_stats->num_values = num_values;
+  att_stats->entropy_input_size = static_cast<int64_t>(num_values) * num_bytes;
+  att_stats->entropy_estimate_bits =
+      EstimateEncodedSymbolsBits(symbols, num_values, num_components);
+}
+
 bool SequentialIntegerAttributeEncoder::PrepareValues(
     const std::vector<PointIndex> &point_ids, int num_points) {
   // Convert all values to int32_t format.
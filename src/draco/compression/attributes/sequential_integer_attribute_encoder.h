@@ -56,6 +56,12 @@ class SequentialIntegerAttributeEncoder : public SequentialAttributeEncoder {
   }
 
  private:
+  // Stores the prediction scheme and the properties of the symbols passed to
+  // the entropy coder in |att_stats|.
+  void RecordSymbolStats(const uint32_t *symbols, int num_values,
+                         int num_components,
+                         AttributeEncodingStats *att_stats) const;
+
   // Optional prediction scheme can be used to modify the integer values in
   // order to make them easier to compress.
   std::unique_ptr<PredictionSchemeTypedEncoderInterface<int32_t>>
@@ -75,6 +75,17 @@ bool SequentialQuantizationAttributeDecoder::DecodeQuantizedDataInfo() {
     // and target attributes.
     att = attribute();
   }
+  if (decoder()->header_flags() & SHARED_QUANTIZATION_FLAG_MASK) {
+    uint8_t is_shared;
+    if (!decoder()->buffer()->Decode(&is_shared)) {
+      return false;
+    }
+    if (is_shared) {
+      // Parameters are provided by the sequence header.
+      return decoder()->GetSharedQuantizationTransform(
+          *attribute(), &quantization_transform_);
+    }
+  }
   return quantization_transform_.DecodeParameters(*att, decoder()->buffer());
 }
 
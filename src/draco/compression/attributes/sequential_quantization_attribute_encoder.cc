@@ -67,6 +67,16 @@ bool SequentialQuantizationAttributeEncoder::Init(PointCloudEncoder *encoder,
 
 bool SequentialQuantizationAttributeEncoder::
     EncodeDataNeededByPortableTransform(EncoderBuffer *out_buffer) {
+  if (encoder()->options()->GetGlobalBool("shared_quantization_grids",
+                                          false)) {
+    // Parameters of shared grids are stored in the sequence header.
+    const bool is_shared = encoder()->options()->GetAttributeBool(
+        attribute_id(), "quantization_shared", false);
+    out_buffer->Encode(static_cast<uint8_t>(is_shared));
+    if (is_shared) {
+      return attribute_quantization_transform_.is_initialized();
+    }
+  }
   return attribute_quantization_transform_.EncodeParameters(out_buffer);
 }
 
@@ -36,6 +36,24 @@ static constexpr uint16_t kDracoPointCloudBitstreamVersion =
 static constexpr uint16_t kDracoMeshBitstreamVersion = DRACO_BITSTREAM_VERSION(
     kDracoMeshBitstreamVersionMajor, kDracoMeshBitstreamVersionMinor);
 
+// Minor bit-stream version of point clouds and meshes that use VQ index coding
+// (see VQ_INDEX_CODING_FLAG_MASK). Decoders that predate the feature reject
+// such streams as UNKNOWN_VERSION instead of ignoring the flag.
+static constexpr uint8_t kDracoVqIndexCodingBitstreamVersionMinor = 4;
+
+// Minor bit-stream version of point clouds and meshes with attribute chunks
+// (see ATTRIBUTE_CHUNKS_FLAG_MASK).
+static constexpr uint8_t kDracoAttributeChunksBitstreamVersionMinor = 5;
+
+// Minor bit-stream version of point clouds and meshes whose attributes may
+// reference shared quantization grids (see SHARED_QUANTIZATION_FLAG_MASK).
+static constexpr uint8_t kDracoSharedQuantizationBitstreamVersionMinor = 6;
+
+// Latest minor bit-stream version supported by the decoder for both point
+// clouds and meshes, i.e. the largest of the feature versions above.
+static constexpr uint8_t kDracoMaxSupportedBitstreamVersionMinor =
+    kDracoSharedQuantizationBitstreamVersionMinor;
+
 // Currently, we support point cloud and triangular mesh encoding.
 // TODO(draco-eng) Convert enum to enum class (safety, not performance).
 enum EncodedGeometryType {
@@ -74,6 +92,8 @@ enum SequentialAttributeEncoderType {
   SEQUENTIAL_ATTRIBUTE_ENCODER_INTEGER,
   SEQUENTIAL_ATTRIBUTE_ENCODER_QUANTIZATION,
   SEQUENTIAL_ATTRIBUTE_ENCODER_NORMALS,
+  SEQUENTIAL_ATTRIBUTE_ENCODER_INDEX,
+  SEQUENTIAL_ATTRIBUTE_ENCODER_FLOAT,
 };
 
 // List of all prediction methods currently supported by our framework.
@@ -144,12 +164,31 @@ enum NormalPredictionMode {
 enum SymbolCodingMethod {
   SYMBOL_CODING_TAGGED = 0,
   SYMBOL_CODING_RAW = 1,
+  // Buckets coded with the raw scheme followed by raw extra bits. Used for
+  // alphabets that are too large for the raw scheme.
+  SYMBOL_CODING_BUCKETED = 2,
   NUM_SYMBOL_CODING_METHODS,
 };
 
 // Mask for setting and getting the bit for metadata in |flags| of header.
 #define METADATA_FLAG_MASK 0x8000
 
+// Mask for the bit signaling that quantized attributes may reference
+// quantization grids shared across a sequence of frames instead of storing
+// their own quantization parameters (see compression/sequence/).
+#define SHARED_QUANTIZATION_FLAG_MASK 0x4000
+
+// Mask for the bit signaling that VQ index attributes of point clouds encoded
+// with the kd-tree method are coded separately from the kd-tree (see
+// compression/attributes/index_attribute_coding_shared.h).
+#define VQ_INDEX_CODING_FLAG_MASK 0x2000
+
+// Mask for the bit signaling that the attribute data is split into chunks
+// prefixed by their size. Each chunk holds either one attribute or all
+// attributes of an attributes decoder, so the attributes can be decoded as
+// soon as their chunk is received (see compression/incremental_decoder.h).
+#define ATTRIBUTE_CHUNKS_FLAG_MASK 0x1000
+
 }  // namespace draco
 
 #endif  // DRACO_COMPRESSION_CONFIG_COMPRESSION_SHARED_H_
@@ -63,6 +63,62 @@ StatusOr<EncodedGeometryType> Decoder::GetEncodedGeometryType(
   return static_cast<EncodedGeometryType>(header.encoder_type);
 }
 
+StatusOr<DecodePlan> Decoder::Probe(DecoderBuffer *in_buffer) {
+  DecoderBuffer temp_buffer(*in_buffer);
+  DracoHeader header;
+  DRACO_RETURN_IF_ERROR(PointCloudDecoder::DecodeHeader(&temp_buffer, &header))
+  // Decode from a fresh copy so that |in_buffer| is not modified.
+  temp_buffer = *in_buffer;
+  std::unique_ptr<PointCloud> geometry;
+  uint32_t num_faces = 0;
+  if (header.encoder_type == POINT_CLOUD) {
+#ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
+    DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloudDecoder> decoder,
+                           CreatePointCloudDecoder(header.encoder_method))
+    geometry.reset(new PointCloud());
+    DRACO_RETURN_IF_ERROR(decoder->DecodeAttributeDescriptors(
+        options_, &temp_buffer, geometry.get()))
+#endif
+  } else if (header.encoder_type == TRIANGULAR_MESH) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+    DRACO_ASSIGN_OR_RETURN(std::unique_ptr<MeshDecoder> decoder,
+                           CreateMeshDecoder(header.encoder_method))
+    std::unique_ptr<Mesh> mesh(new Mesh());
+    DRACO_RETURN_IF_ERROR(
+        decoder->DecodeAttributeDescriptors(options_, &temp_buffer, mesh.get()))
+    num_faces = mesh->num_faces();
+    geometry = std::move(mesh);
+#endif
+  }
+  if (geometry == nullptr) {
+    return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+  }
+
+  DecodePlan plan;
+  plan.geometry_type = static_cast<EncodedGeometryType>(header.encoder_type);
+  plan.encoding_method = header.encoder_method;
+  plan.bitstream_version =
+      DRACO_BITSTREAM_VERSION(header.version_major, header.version_minor);
+  plan.has_metadata = geometry->GetMetadata() != nullptr;
+  plan.num_points = geometry->num_points();
+  plan.num_faces = num_faces;
+  plan.attributes_byte_size = 0;
+  for (int i = 0; i < geometry->num_attributes(); ++i) {
+    const PointAttribute *const att = geometry->attribute(i);
+    DecodePlan::Attribute plan_att;
+    plan_att.attribute_type = att->attribute_type();
+    plan_att.data_type = att->data_type();
+    plan_att.num_components = att->num_components();
+    plan_att.normalized = att->normalized();
+    plan_att.unique_id = att->unique_id();
+    plan_att.byte_size =
+        static_cast<size_t>(plan.num_points) * att->byte_stride();
+    plan.attributes_byte_size += plan_att.byte_size;
+    plan.attributes.push_back(plan_att);
+  }
+  return plan;
+}
+
 StatusOr<std::unique_ptr<PointCloud>> Decoder::DecodePointCloudFromBuffer(
     DecoderBuffer *in_buffer) {
   DRACO_ASSIGN_OR_RETURN(EncodedGeometryType type,
@@ -132,4 +188,8 @@ void Decoder::SetSkipAttributeTransform(GeometryAttribute::Type att_type) {
   options_.SetAttributeBool(att_type, "skip_attribute_transform", true);
 }
 
+void Decoder::SetNumDecodingThreads(int num_threads) {
+  options_.SetGlobalInt("num_decoding_threads", num_threads);
+}
+
 }  // namespace draco
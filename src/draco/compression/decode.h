@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_DECODE_H_
 #define DRACO_COMPRESSION_DECODE_H_
 
+#include <vector>
+
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/decoder_options.h"
 #include "draco/core/decoder_buffer.h"
@@ -24,6 +26,44 @@
 
 namespace draco {
 
+class MeshDecoder;
+class PointCloudDecoder;
+
+// Create decoders for the given encoding method. Used by classes that control
+// the decoding process themselves, such as IncrementalDecoder.
+StatusOr<std::unique_ptr<PointCloudDecoder>> CreatePointCloudDecoder(
+    int8_t method);
+StatusOr<std::unique_ptr<MeshDecoder>> CreateMeshDecoder(uint8_t method);
+
+// Describes the geometry that is produced by decoding an encoded buffer. It
+// is returned by Decoder::Probe() and it can be used to allocate the output
+// buffers before the geometry is decoded.
+struct DecodePlan {
+  struct Attribute {
+    GeometryAttribute::Type attribute_type;
+    DataType data_type;
+    int num_components;
+    bool normalized;
+    uint32_t unique_id;
+    // Size of the attribute values of all points in bytes, i.e., the size of
+    // a buffer holding the value of each decoded point. Attributes of meshes
+    // can store fewer unique values internally.
+    size_t byte_size;
+  };
+
+  EncodedGeometryType geometry_type;
+  int encoding_method;
+  uint16_t bitstream_version;
+  bool has_metadata;
+  uint32_t num_points;
+  // Number of faces, zero for point clouds.
+  uint32_t num_faces;
+  // Attributes in the order of their ids in the decoded geometry.
+  std::vector<Attribute> attributes;
+  // Sum of the byte sizes of all attributes.
+  size_t attributes_byte_size;
+};
+
 // Class responsible for decoding of meshes and point clouds that were
 // compressed by a Draco encoder.
 class Decoder {
@@ -36,6 +76,15 @@ class Decoder {
   static StatusOr<EncodedGeometryType> GetEncodedGeometryType(
       DecoderBuffer *in_buffer);
 
+  // Returns the number of points, the attribute layout and the exact decoded
+  // sizes of the geometry encoded in |in_buffer| without decoding any
+  // attribute values. Only the header, metadata, geometry data and attribute
+  // descriptors are parsed. For meshes this includes the connectivity because
+  // the number of points depends on it. |in_buffer| is not advanced. The sizes
+  // assume that all attribute transforms are applied, i.e., they don't hold
+  // for attributes whose transform is skipped by SetSkipAttributeTransform().
+  StatusOr<DecodePlan> Probe(DecoderBuffer *in_buffer);
+
   // Decodes point cloud from the provided buffer. The buffer must be filled
   // with data that was encoded with either the EncodePointCloudToBuffer or
   // EncodeMeshToBuffer methods in encode.h. In case the input buffer contains
@@ -67,6 +116,11 @@ class Decoder {
   // transform manually.
   void SetSkipAttributeTransform(GeometryAttribute::Type att_type);
 
+  // Sets the maximum number of threads used for decoding independent
+  // attributes concurrently (default = 1). The decoded geometry does not
+  // depend on the number of threads.
+  void SetNumDecodingThreads(int num_threads);
+
   // Returns the options instance used by the decoder that can be used by users
   // to control the decoding process.
   DecoderOptions *options() { return &options_; }
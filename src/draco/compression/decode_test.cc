@@ -22,6 +22,8 @@
 #include "draco/core/draco_test_utils.h"
 #include "draco/io/file_utils.h"
 #include "draco/io/obj_encoder.h"
+#include "draco/mesh/triangle_soup_mesh_builder.h"
+#include "draco/point_cloud/point_cloud_builder.h"
 
 namespace {
 
@@ -242,4 +244,168 @@ TEST_F(DecodeTest, TestSkipAttributeTransformUniqueId) {
             << std::endl;
 }
 
+// Checks that |plan| describes the decoded |pc| exactly.
+void ExpectPlanMatchesGeometry(const draco::DecodePlan &plan,
+                               const draco::PointCloud &pc) {
+  ASSERT_EQ(plan.num_points, pc.num_points());
+  ASSERT_EQ(plan.attributes.size(), pc.num_attributes());
+  size_t attributes_byte_size = 0;
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    const draco::PointAttribute *const att = pc.attribute(i);
+    const draco::DecodePlan::Attribute &plan_att = plan.attributes[i];
+    ASSERT_EQ(plan_att.attribute_type, att->attribute_type());
+    ASSERT_EQ(plan_att.data_type, att->data_type());
+    ASSERT_EQ(plan_att.num_components, att->num_components());
+    ASSERT_EQ(plan_att.normalized, att->normalized());
+    ASSERT_EQ(plan_att.unique_id, att->unique_id());
+    ASSERT_EQ(plan_att.byte_size, pc.num_points() * att->byte_stride());
+    attributes_byte_size += plan_att.byte_size;
+  }
+  ASSERT_EQ(plan.attributes_byte_size, attributes_byte_size);
+}
+
+TEST_F(DecodeTest, TestProbePointCloud) {
+  // Tests that Decoder::Probe() returns the layout of a decoded point cloud
+  // without advancing the input buffer.
+  constexpr int kNumPoints = 200;
+  draco::PointCloudBuilder builder;
+  builder.Start(kNumPoints);
+  const int pos_att_id = builder.AddAttribute(
+      draco::GeometryAttribute::POSITION, 3, draco::DT_FLOAT32);
+  const int color_att_id = builder.AddAttribute(
+      draco::GeometryAttribute::COLOR, 4, draco::DT_UINT8);
+  const int gen_att_id = builder.AddAttribute(
+      draco::GeometryAttribute::GENERIC, 7, draco::DT_FLOAT32);
+  for (draco::PointIndex i(0); i < kNumPoints; ++i) {
+    const float value = static_cast<float>(i.value());
+    builder.SetAttributeValueForPoint(
+        pos_att_id, i, draco::Vector3f(value, 2.f * value, -value).data());
+    const uint8_t color[4] = {static_cast<uint8_t>(i.value()), 10, 20, 255};
+    builder.SetAttributeValueForPoint(color_att_id, i, color);
+    std::vector<float> gen(7, 0.5f * value);
+    builder.SetAttributeValueForPoint(gen_att_id, i, gen.data());
+  }
+  std::unique_ptr<draco::PointCloud> pc = builder.Finalize(false);
+  ASSERT_NE(pc, nullptr);
+
+  // Test both the kd-tree and the sequential encoding.
+  for (const int speed : {0, 10}) {
+    draco::Encoder encoder;
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 11);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::GENERIC, 12);
+    encoder.SetSpeedOptions(speed, speed);
+    draco::EncoderBuffer encoder_buffer;
+    DRACO_ASSERT_OK(encoder.EncodePointCloudToBuffer(*pc, &encoder_buffer));
+
+    draco::DecoderBuffer buffer;
+    buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+    draco::Decoder decoder;
+    DRACO_ASSIGN_OR_ASSERT(const draco::DecodePlan plan,
+                           decoder.Probe(&buffer));
+    ASSERT_EQ(buffer.decoded_size(), 0);
+    ASSERT_EQ(plan.geometry_type, draco::POINT_CLOUD);
+    ASSERT_EQ(plan.encoding_method, speed == 10
+                                        ? draco::POINT_CLOUD_SEQUENTIAL_ENCODING
+                                        : draco::POINT_CLOUD_KD_TREE_ENCODING);
+    ASSERT_EQ(plan.num_faces, 0);
+
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::PointCloud> decoded_pc,
+                           decoder.DecodePointCloudFromBuffer(&buffer));
+    ASSERT_EQ(plan.num_points, kNumPoints);
+    ExpectPlanMatchesGeometry(plan, *decoded_pc);
+  }
+}
+
+TEST_F(DecodeTest, TestProbeMesh) {
+  // Tests that Decoder::Probe() returns the number of points of a decoded mesh
+  // that has attribute seams.
+  constexpr int kGridSize = 8;
+  draco::TriangleSoupMeshBuilder builder;
+  builder.Start(2 * kGridSize * kGridSize);
+  const int pos_att_id =
+      builder.AddAttribute(draco::GeometryAttribute::POSITION, 3,
+                           draco::DT_FLOAT32);
+  const int tex_att_id = builder.AddAttribute(
+      draco::GeometryAttribute::TEX_COORD, 2, draco::DT_FLOAT32);
+  const auto pos = [](int x, int y) {
+    return draco::Vector3f(static_cast<float>(x), static_cast<float>(y), 0.f);
+  };
+  // Texture coordinates with a seam in the middle of the grid.
+  const auto tex = [](int x, int y, bool left) {
+    return draco::Vector2f(static_cast<float>(x) + (left ? 0.f : 100.f),
+                           static_cast<float>(y));
+  };
+  draco::FaceIndex face(0);
+  for (int y = 0; y < kGridSize; ++y) {
+    for (int x = 0; x < kGridSize; ++x) {
+      const bool left = x < kGridSize / 2;
+      builder.SetAttributeValuesForFace(pos_att_id, face, pos(x, y).data(),
+                                        pos(x + 1, y).data(),
+                                        pos(x, y + 1).data());
+      builder.SetAttributeValuesForFace(tex_att_id, face,
+                                        tex(x, y, left).data(),
+                                        tex(x + 1, y, left).data(),
+                                        tex(x, y + 1, left).data());
+      ++face;
+      builder.SetAttributeValuesForFace(pos_att_id, face,
+                                        pos(x + 1, y).data(),
+                                        pos(x + 1, y + 1).data(),
+                                        pos(x, y + 1).data());
+      builder.SetAttributeValuesForFace(tex_att_id, face,
+                                        tex(x + 1, y, left).data(),
+                                        tex(x + 1, y + 1, left).data(),
+                                        tex(x, y + 1, left).data());
+      ++face;
+    }
+  }
+  std::unique_ptr<draco::Mesh> mesh = builder.Finalize();
+  ASSERT_NE(mesh, nullptr);
+
+  for (const draco::MeshEncoderMethod method :
+       {draco::MESH_EDGEBREAKER_ENCODING, draco::MESH_SEQUENTIAL_ENCODING}) {
+    draco::Encoder encoder;
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 10);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 10);
+    encoder.SetEncodingMethod(method);
+    draco::EncoderBuffer encoder_buffer;
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &encoder_buffer));
+
+    draco::DecoderBuffer buffer;
+    buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+    draco::Decoder decoder;
+    DRACO_ASSIGN_OR_ASSERT(const draco::DecodePlan plan,
+                           decoder.Probe(&buffer));
+    ASSERT_EQ(plan.geometry_type, draco::TRIANGULAR_MESH);
+    ASSERT_EQ(plan.encoding_method, method);
+
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> decoded_mesh,
+                           decoder.DecodeMeshFromBuffer(&buffer));
+    ASSERT_EQ(plan.num_faces, decoded_mesh->num_faces());
+    ExpectPlanMatchesGeometry(plan, *decoded_mesh);
+  }
+}
+
+TEST_F(DecodeTest, TestProbeInvalidInput) {
+  // Tests that Decoder::Probe() fails on truncated data.
+  draco::PointCloudBuilder builder;
+  builder.Start(10);
+  const int pos_att_id = builder.AddAttribute(
+      draco::GeometryAttribute::POSITION, 3, draco::DT_FLOAT32);
+  for (draco::PointIndex i(0); i < 10; ++i) {
+    const float value = static_cast<float>(i.value());
+    builder.SetAttributeValueForPoint(
+        pos_att_id, i, draco::Vector3f(value, value, value).data());
+  }
+  std::unique_ptr<draco::PointCloud> pc = builder.Finalize(false);
+  draco::Encoder encoder;
+  draco::EncoderBuffer encoder_buffer;
+  DRACO_ASSERT_OK(encoder.EncodePointCloudToBuffer(*pc, &encoder_buffer));
+
+  // Truncate the data inside of the header.
+  draco::DecoderBuffer buffer;
+  buffer.Init(encoder_buffer.data(), 8);
+  draco::Decoder decoder;
+  ASSERT_FALSE(decoder.Probe(&buffer).ok());
+}
+
 }  // namespace
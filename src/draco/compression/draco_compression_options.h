@@ -79,6 +79,9 @@ struct DracoCompressionOptions {
   int quantization_bits_generic = 8;
   int quantization_bits_tangent = 8;
   int quantization_bits_weight = 8;
+  // Used for Gaussian splat attributes SH_DC, SH_REST, OPACITY, SCALE, and
+  // ROTATION.
+  int quantization_bits_gaussian = 10;
   bool find_non_degenerate_texture_quantization = false;
 
   bool operator==(const DracoCompressionOptions &other) const {
@@ -90,6 +93,7 @@ struct DracoCompressionOptions {
            quantization_bits_generic == other.quantization_bits_generic &&
            quantization_bits_tangent == other.quantization_bits_tangent &&
            quantization_bits_weight == other.quantization_bits_weight &&
+           quantization_bits_gaussian == other.quantization_bits_gaussian &&
            find_non_degenerate_texture_quantization ==
                other.find_non_degenerate_texture_quantization;
   }
@@ -122,6 +126,8 @@ struct DracoCompressionOptions {
         Validate("Tangent quantization", quantization_bits_tangent, 0, 30));
     DRACO_RETURN_IF_ERROR(
         Validate("Weights quantization", quantization_bits_weight, 0, 30));
+    DRACO_RETURN_IF_ERROR(
+        Validate("Gaussian quantization", quantization_bits_gaussian, 0, 30));
     return OkStatus();
   }
 
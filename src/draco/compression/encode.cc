@@ -24,12 +24,14 @@ Status Encoder::EncodePointCloudToBuffer(const PointCloud &pc,
                                          EncoderBuffer *out_buffer) {
   ExpertEncoder encoder(pc);
   encoder.Reset(CreateExpertEncoderOptions(pc));
+  encoder.SetEncodingStats(encoding_stats());
   return encoder.EncodeToBuffer(out_buffer);
 }
 
 Status Encoder::EncodeMeshToBuffer(const Mesh &m, EncoderBuffer *out_buffer) {
   ExpertEncoder encoder(m);
   encoder.Reset(CreateExpertEncoderOptions(m));
+  encoder.SetEncodingStats(encoding_stats());
   DRACO_RETURN_IF_ERROR(encoder.EncodeToBuffer(out_buffer));
   set_num_encoded_points(encoder.num_encoded_points());
   set_num_encoded_faces(encoder.num_encoded_faces());
@@ -17,6 +17,7 @@
 
 #include "draco/attributes/geometry_attribute.h"
 #include "draco/compression/config/compression_shared.h"
+#include "draco/compression/encoding_stats.h"
 #include "draco/core/status.h"
 
 namespace draco {
@@ -32,7 +33,8 @@ class EncoderBase {
   EncoderBase()
       : options_(EncoderOptionsT::CreateDefaultOptions()),
         num_encoded_points_(0),
-        num_encoded_faces_(0) {}
+        num_encoded_faces_(0),
+        encoding_stats_(nullptr) {}
   virtual ~EncoderBase() {}
 
   const EncoderOptionsT &options() const { return options_; }
@@ -48,6 +50,53 @@ class EncoderBase {
   size_t num_encoded_points() const { return num_encoded_points_; }
   size_t num_encoded_faces() const { return num_encoded_faces_; }
 
+  // Sets an optional object that is filled with per-attribute sizes and
+  // timings during the following encoding operations (see encoding_stats.h).
+  // The object must outlive the encoding calls. Pass nullptr to disable the
+  // collection (default).
+  void SetEncodingStats(EncodingStats *stats) { encoding_stats_ = stats; }
+  EncodingStats *encoding_stats() const { return encoding_stats_; }
+
+  // Sets the maximum number of threads used for encoding independent
+  // attributes concurrently and for computing the mesh connectivity
+  // (default = 1). The encoded data does not depend on the number of threads.
+  void SetNumEncodingThreads(int num_threads) {
+    options_.SetGlobalInt("num_encoding_threads", num_threads);
+  }
+
+  // If enabled, integer VQ index attributes (SH_DC_IDX, SH_REST_IDX, SCALE_IDX
+  // and ROTATION_IDX) are coded with a context model that exploits the skewed
+  // distribution of codebook indices (default = false). Streams encoded with
+  // this option can't be decoded by decoders that predate it.
+  void SetVqIndexCoding(bool enabled) {
+    options_.SetGlobalBool("vq_index_coding", enabled);
+  }
+
+  // If enabled, integer symbols that need more than 18 bits, e.g. values
+  // quantized with more than 17 bits, may be entropy coded as buckets with raw
+  // extra bits when it is more efficient (default = false). Streams encoded
+  // with this option can't be decoded by decoders that predate it.
+  void SetBucketedSymbolCoding(bool enabled) {
+    options_.SetGlobalBool("bucketed_symbol_coding", enabled);
+  }
+
+  // If enabled, float attributes that are not quantized are compressed
+  // losslessly instead of being stored raw (default = false). Streams encoded
+  // with this option can't be decoded by decoders that predate it.
+  void SetLosslessFloatCoding(bool enabled) {
+    options_.SetGlobalBool("lossless_float_coding", enabled);
+  }
+
+  // If enabled, the data of each attribute is stored in a separate chunk
+  // prefixed by its size (default = false). It allows decoding of attributes
+  // while the rest of the data is still being received, see
+  // IncrementalDecoder. Attributes of point clouds encoded with the kd-tree
+  // method share a single chunk. Streams encoded with this option can't be
+  // decoded by decoders that predate it.
+  void SetAttributeChunks(bool enabled) {
+    options_.SetGlobalBool("attribute_chunks", enabled);
+  }
+
  protected:
   void Reset(const EncoderOptionsT &options) { options_ = options; }
 
@@ -118,6 +167,8 @@ class EncoderBase {
 
   size_t num_encoded_points_;
   size_t num_encoded_faces_;
+
+  EncodingStats *encoding_stats_;
 };
 
 template <class EncoderOptionsT>
@@ -16,6 +16,7 @@
 #include "draco/compression/encode.h"
 
 #include <cinttypes>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 
@@ -65,6 +66,51 @@ class EncodeTest : public ::testing::Test {
     return mesh_builder.Finalize();
   }
 
+  // Creates a grid mesh with |size| x |size| quads. Positions and normals are
+  // per-vertex while the texture coordinates are unique for every face.
+  std::unique_ptr<draco::Mesh> CreateTestGridMesh(int size) const {
+    draco::TriangleSoupMeshBuilder mesh_builder;
+    mesh_builder.Start(2 * size * size);
+    const int32_t pos_att_id = mesh_builder.AddAttribute(
+        draco::GeometryAttribute::POSITION, 3, draco::DT_FLOAT32);
+    const int32_t norm_att_id = mesh_builder.AddAttribute(
+        draco::GeometryAttribute::NORMAL, 3, draco::DT_FLOAT32);
+    const int32_t tex_att_id = mesh_builder.AddAttribute(
+        draco::GeometryAttribute::TEX_COORD, 2, draco::DT_FLOAT32);
+    const auto position = [](int x, int y) {
+      return draco::Vector3f(x, y, 0.1f * ((x * 7 + y * 3) % 5));
+    };
+    const auto normal = [](int x, int y) {
+      draco::Vector3f n(0.1f * (x % 3), 0.1f * (y % 4), 1.f);
+      n.Normalize();
+      return n;
+    };
+    draco::FaceIndex face(0);
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        const int corners[2][3][2] = {{{x, y}, {x + 1, y}, {x + 1, y + 1}},
+                                      {{x, y}, {x + 1, y + 1}, {x, y + 1}}};
+        for (int t = 0; t < 2; ++t, ++face) {
+          draco::Vector3f pos[3], norm[3];
+          draco::Vector2f tex[3];
+          for (int c = 0; c < 3; ++c) {
+            pos[c] = position(corners[t][c][0], corners[t][c][1]);
+            norm[c] = normal(corners[t][c][0], corners[t][c][1]);
+            tex[c] = draco::Vector2f(0.01f * face.value(), 0.1f * c);
+          }
+          mesh_builder.SetAttributeValuesForFace(
+              pos_att_id, face, pos[0].data(), pos[1].data(), pos[2].data());
+          mesh_builder.SetAttributeValuesForFace(norm_att_id, face,
+                                                 norm[0].data(), norm[1].data(),
+                                                 norm[2].data());
+          mesh_builder.SetAttributeValuesForFace(
+              tex_att_id, face, tex[0].data(), tex[1].data(), tex[2].data());
+        }
+      }
+    }
+    return mesh_builder.Finalize();
+  }
+
   std::unique_ptr<draco::PointCloud> CreateTestPointCloud() const {
     draco::PointCloudBuilder pc_builder;
 
@@ -403,6 +449,109 @@ TEST_F(EncodeTest, TestNoPosQuantizationNormalCoding) {
   ASSERT_NE(decoded_mesh, nullptr);
 }
 
+TEST_F(EncodeTest, TestMultithreadedAttributeEncoding) {
+  // Tests that attributes encoded on multiple threads result in the same
+  // bitstream as attributes encoded on a single thread.
+  const std::unique_ptr<draco::Mesh> mesh = CreateTestGridMesh(10);
+  ASSERT_NE(mesh, nullptr);
+  const std::unique_ptr<draco::PointCloud> pc = CreateTestPointCloud();
+  ASSERT_NE(pc, nullptr);
+
+  // Speed 0 uses normal prediction that depends on the positions.
+  for (const int speed : {0, 5}) {
+    for (const int method :
+         {draco::MESH_EDGEBREAKER_ENCODING, draco::MESH_SEQUENTIAL_ENCODING}) {
+      draco::Encoder encoder;
+      encoder.SetSpeedOptions(speed, speed);
+      encoder.SetEncodingMethod(method);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 11);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 8);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 10);
+      draco::EncoderBuffer single_thread_buffer;
+      DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &single_thread_buffer));
+      encoder.SetNumEncodingThreads(4);
+      draco::EncoderBuffer multi_thread_buffer;
+      DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &multi_thread_buffer));
+      ASSERT_EQ(single_thread_buffer.size(), multi_thread_buffer.size());
+      ASSERT_EQ(memcmp(single_thread_buffer.data(), multi_thread_buffer.data(),
+                       single_thread_buffer.size()),
+                0);
+
+      draco::DecoderBuffer in_buffer;
+      in_buffer.Init(multi_thread_buffer.data(), multi_thread_buffer.size());
+      draco::Decoder decoder;
+      DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<draco::Mesh> decoded_mesh,
+                             decoder.DecodeMeshFromBuffer(&in_buffer));
+      ASSERT_EQ(decoded_mesh->num_faces(), mesh->num_faces());
+    }
+  }
+
+  draco::Encoder encoder;
+  encoder.SetEncodingMethod(draco::POINT_CLOUD_SEQUENTIAL_ENCODING);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 11);
+  draco::EncoderBuffer single_thread_buffer;
+  DRACO_ASSERT_OK(encoder.EncodePointCloudToBuffer(*pc, &single_thread_buffer));
+  encoder.SetNumEncodingThreads(4);
+  draco::EncoderBuffer multi_thread_buffer;
+  DRACO_ASSERT_OK(encoder.EncodePointCloudToBuffer(*pc, &multi_thread_buffer));
+  ASSERT_EQ(single_thread_buffer.size(), multi_thread_buffer.size());
+  ASSERT_EQ(memcmp(single_thread_buffer.data(), multi_thread_buffer.data(),
+                   single_thread_buffer.size()),
+            0);
+}
+
+TEST_F(EncodeTest, TestMultithreadedAttributeDecoding) {
+  // Tests that attributes decoded on multiple threads are the same as
+  // attributes decoded on a single thread.
+  const std::unique_ptr<draco::Mesh> mesh = CreateTestGridMesh(10);
+  ASSERT_NE(mesh, nullptr);
+
+  // Speed 0 uses normal and texture coordinate predictions that depend on the
+  // positions.
+  for (const int speed : {0, 5, 10}) {
+    for (const int method :
+         {draco::MESH_EDGEBREAKER_ENCODING, draco::MESH_SEQUENTIAL_ENCODING}) {
+      draco::Encoder encoder;
+      encoder.SetSpeedOptions(speed, speed);
+      encoder.SetEncodingMethod(method);
+      if (speed < 10) {
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION,
+                                         11);
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 8);
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD,
+                                         10);
+      }
+      draco::EncoderBuffer buffer;
+      DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &buffer));
+
+      std::unique_ptr<draco::Mesh> decoded_meshes[2];
+      for (int i = 0; i < 2; ++i) {
+        draco::DecoderBuffer in_buffer;
+        in_buffer.Init(buffer.data(), buffer.size());
+        draco::Decoder decoder;
+        decoder.SetNumDecodingThreads(i == 0 ? 1 : 4);
+        DRACO_ASSIGN_OR_ASSERT(decoded_meshes[i],
+                               decoder.DecodeMeshFromBuffer(&in_buffer));
+      }
+      ASSERT_EQ(decoded_meshes[0]->num_faces(), mesh->num_faces());
+      ASSERT_EQ(decoded_meshes[1]->num_faces(), mesh->num_faces());
+      ASSERT_EQ(decoded_meshes[0]->num_attributes(),
+                decoded_meshes[1]->num_attributes());
+      for (int a = 0; a < decoded_meshes[0]->num_attributes(); ++a) {
+        const draco::DataBuffer *const single_thread_data =
+            decoded_meshes[0]->attribute(a)->buffer();
+        const draco::DataBuffer *const multi_thread_data =
+            decoded_meshes[1]->attribute(a)->buffer();
+        ASSERT_EQ(single_thread_data->data_size(),
+                  multi_thread_data->data_size());
+        ASSERT_EQ(memcmp(single_thread_data->data(), multi_thread_data->data(),
+                         single_thread_data->data_size()),
+                  0);
+      }
+    }
+  }
+}
+
 #ifdef DRACO_TRANSCODER_SUPPORTED
 TEST_F(EncodeTest, TestDracoCompressionOptions) {
   // This test verifies that we can set the encoder's compression options via
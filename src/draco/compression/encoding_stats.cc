@@ -0,0 +1,208 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/encoding_stats.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+
+namespace draco {
+
+namespace {
+
+// Appends printf style formatted text to |out|.
+void AppendFormat(std::string *out, const char *format, ...)
+#if defined(__GNUC__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    ;
+
+void AppendFormat(std::string *out, const char *format, ...) {
+  char buffer[512];
+  va_list args;
+  va_start(args, format);
+  const int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (length > 0) {
+    out->append(buffer, std::min<size_t>(length, sizeof(buffer) - 1));
+  }
+}
+
+}  // namespace
+
+const char *EncodedGeometryTypeToString(EncodedGeometryType type) {
+  switch (type) {
+    case POINT_CLOUD:
+      return "point_cloud";
+    case TRIANGULAR_MESH:
+      return "mesh";
+    default:
+      return "invalid";
+  }
+}
+
+const char *PredictionSchemeToString(PredictionSchemeMethod method) {
+  switch (method) {
+    case PREDICTION_NONE:
+      return "none";
+    case PREDICTION_DIFFERENCE:
+      return "difference";
+    case MESH_PREDICTION_PARALLELOGRAM:
+      return "parallelogram";
+    case MESH_PREDICTION_MULTI_PARALLELOGRAM:
+      return "multi_parallelogram";
+    case MESH_PREDICTION_TEX_COORDS_DEPRECATED:
+      return "tex_coords_deprecated";
+    case MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM:
+      return "constrained_multi_parallelogram";
+    case MESH_PREDICTION_TEX_COORDS_PORTABLE:
+      return "tex_coords_portable";
+    case MESH_PREDICTION_GEOMETRIC_NORMAL:
+      return "geometric_normal";
+    default:
+      return "undefined";
+  }
+}
+
+const char *PredictionTransformToString(PredictionSchemeTransformType type) {
+  switch (type) {
+    case PREDICTION_TRANSFORM_DELTA:
+      return "delta";
+    case PREDICTION_TRANSFORM_WRAP:
+      return "wrap";
+    case PREDICTION_TRANSFORM_NORMAL_OCTAHEDRON:
+      return "normal_octahedron";
+    case PREDICTION_TRANSFORM_NORMAL_OCTAHEDRON_CANONICALIZED:
+      return "normal_octahedron_canonicalized";
+    default:
+      return "none";
+  }
+}
+
+const char *SymbolCodingMethodToString(int method) {
+  switch (method) {
+    case SYMBOL_CODING_TAGGED:
+      return "tagged";
+    case SYMBOL_CODING_RAW:
+      return "raw";
+    default:
+      return "none";
+  }
+}
+
+AttributeEncodingStats::AttributeEncodingStats()
+    : attribute_id(-1),
+      attribute_type(GeometryAttribute::INVALID),
+      data_type(DT_INVALID),
+      num_components(0),
+      quantization_bits(-1),
+      prediction_scheme(PREDICTION_NONE),
+      prediction_transform(PREDICTION_TRANSFORM_NONE),
+      symbol_coding_method(-1),
+      num_values(0),
+      raw_size(0),
+      entropy_input_size(0),
+      entropy_coded_size(0),
+      entropy_estimate_bits(0),
+      encoded_size(0),
+      joint_attribute_id(-1),
+      transform_time(0.0),
+      prediction_time(0.0),
+      entropy_coding_time(0.0) {}
+
+EncodingStats::EncodingStats() { Clear(); }
+
+void EncodingStats::Clear() {
+  geometry_type = INVALID_GEOMETRY_TYPE;
+  encoding_method = -1;
+  header_size = 0;
+  geometry_size = 0;
+  total_size = 0;
+  geometry_time = 0.0;
+  total_time = 0.0;
+  attributes.clear();
+}
+
+AttributeEncodingStats *EncodingStats::GetAttribute(int att_id) {
+  for (auto &att : attributes) {
+    if (att.attribute_id == att_id) {
+      return &att;
+    }
+  }
+  return nullptr;
+}
+
+const AttributeEncodingStats *EncodingStats::GetAttribute(int att_id) const {
+  for (const auto &att : attributes) {
+    if (att.attribute_id == att_id) {
+      return &att;
+    }
+  }
+  return nullptr;
+}
+
+std::string EncodingStatsToJson(const EncodingStats &stats) {
+  std::string json;
+  AppendFormat(&json,
+               "{\n  \"geometry_type\": \"%s\",\n"
+               "  \"encoding_method\": %d,\n"
+               "  \"header_size\": %" PRId64 ",\n"
+               "  \"geometry_size\": %" PRId64 ",\n"
+               "  \"total_size\": %" PRId64 ",\n"
+               "  \"geometry_time\": %.9g,\n"
+               "  \"total_time\": %.9g,\n"
+               "  \"attributes\": [",
+               EncodedGeometryTypeToString(stats.geometry_type),
+               stats.encoding_method, stats.header_size, stats.geometry_size,
+               stats.total_size, stats.geometry_time, stats.total_time);
+  for (int i = 0; i < stats.attributes.size(); ++i) {
+    const AttributeEncodingStats &att = stats.attributes[i];
+    AppendFormat(&json,
+                 "%s\n    {\"attribute_id\": %d, \"type\": \"%s\", "
+                 "\"num_components\": %d, \"encoder\": \"%s\", "
+                 "\"quantization_bits\": %d, ",
+                 i == 0 ? "" : ",", att.attribute_id,
+                 GeometryAttribute::TypeToString(att.attribute_type).c_str(),
+                 att.num_components, att.encoder.c_str(),
+                 att.quantization_bits);
+    AppendFormat(&json,
+                 "\"prediction_scheme\": \"%s\", "
+                 "\"prediction_transform\": \"%s\", "
+                 "\"symbol_coding_method\": \"%s\", ",
+                 PredictionSchemeToString(att.prediction_scheme),
+                 PredictionTransformToString(att.prediction_transform),
+                 SymbolCodingMethodToString(att.symbol_coding_method));
+    AppendFormat(&json,
+                 "\"num_values\": %" PRId64 ", \"raw_size\": %" PRId64
+                 ", \"entropy_input_size\": %" PRId64
+                 ", \"entropy_coded_size\": %" PRId64
+                 ", \"entropy_estimate_bits\": %" PRId64
+                 ", \"encoded_size\": %" PRId64
+                 ", \"joint_attribute_id\": %d, ",
+                 att.num_values, att.raw_size, att.entropy_input_size,
+                 att.entropy_coded_size, att.entropy_estimate_bits,
+                 att.encoded_size, att.joint_attribute_id);
+    AppendFormat(&json,
+                 "\"transform_time\": %.9g, \"prediction_time\": %.9g, "
+                 "\"entropy_coding_time\": %.9g}",
+                 att.transform_time, att.prediction_time,
+                 att.entropy_coding_time);
+  }
+  json += "\n  ]\n}\n";
+  return json;
+}
+
+}  // namespace draco
@@ -0,0 +1,156 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_ENCODING_STATS_H_
+#define DRACO_COMPRESSION_ENCODING_STATS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "draco/attributes/geometry_attribute.h"
+#include "draco/compression/config/compression_shared.h"
+#include "draco/core/draco_types.h"
+
+namespace draco {
+
+// Sizes and timings collected while encoding a single attribute. All sizes are
+// in bytes and all times are wall times in seconds.
+struct AttributeEncodingStats {
+  AttributeEncodingStats();
+
+  int attribute_id;
+  GeometryAttribute::Type attribute_type;
+  DataType data_type;
+  int num_components;
+
+  // Name of the attribute encoder, one of "generic", "integer",
+  // "quantization", "normals" or "kd_tree".
+  std::string encoder;
+
+  // Number of quantization bits or -1 when the attribute is not quantized.
+  int quantization_bits;
+
+  // Prediction scheme and its transform. PREDICTION_NONE when no prediction
+  // was applied to the attribute values.
+  PredictionSchemeMethod prediction_scheme;
+  PredictionSchemeTransformType prediction_transform;
+
+  // SYMBOL_CODING_TAGGED or SYMBOL_CODING_RAW when the values were entropy
+  // coded with EncodeSymbols(), -1 otherwise.
+  int symbol_coding_method;
+
+  // Number of integer values (points times components) that were encoded.
+  int64_t num_values;
+
+  // Size of the input attribute data.
+  int64_t raw_size;
+
+  // Size of the values passed to the entropy coder when stored with the
+  // smallest number of bytes per value that fits all of them.
+  int64_t entropy_input_size;
+
+  // Size of the entropy coded values.
+  int64_t entropy_coded_size;
+
+  // Size of the entropy coded values estimated from the Shannon entropy of
+  // the symbols (see EstimateEncodedSymbolsBits()), in bits.
+  int64_t entropy_estimate_bits;
+
+  // Total size of all data encoded for the attribute including prediction and
+  // transform parameters.
+  int64_t encoded_size;
+
+  // Attributes encoded jointly with other attributes (kd-tree) report the
+  // entropy coding sizes and times on the first attribute of the group. For
+  // the remaining attributes of the group this is the id of that attribute.
+  // -1 when the attribute is encoded independently.
+  int joint_attribute_id;
+
+  // Time spent in the portable transform (e.g. quantization).
+  double transform_time;
+  // Time spent computing prediction corrections.
+  double prediction_time;
+  // Time spent in the entropy coder or in the raw value storage.
+  double entropy_coding_time;
+};
+
+// Statistics collected during encoding of a point cloud or a mesh, see
+// ExpertEncoder::SetEncodingStats().
+struct EncodingStats {
+  EncodingStats();
+
+  void Clear();
+
+  // Returns stats of the attribute with |att_id| or nullptr when the
+  // attribute was not encoded.
+  AttributeEncodingStats *GetAttribute(int att_id);
+  const AttributeEncodingStats *GetAttribute(int att_id) const;
+
+  EncodedGeometryType geometry_type;
+  int encoding_method;
+
+  // Size of the header, metadata and encoder specific data.
+  int64_t header_size;
+  // Size of the geometry data such as connectivity of meshes.
+  int64_t geometry_size;
+  // Size of the whole encoded geometry.
+  int64_t total_size;
+
+  double geometry_time;
+  double total_time;
+
+  // Stats of individual attributes in the order in which they were encoded.
+  std::vector<AttributeEncodingStats> attributes;
+};
+
+// Returns a JSON representation of |stats|.
+std::string EncodingStatsToJson(const EncodingStats &stats);
+
+// Names of the stats values as used in the JSON representation.
+const char *EncodedGeometryTypeToString(EncodedGeometryType type);
+const char *PredictionSchemeToString(PredictionSchemeMethod method);
+const char *PredictionTransformToString(PredictionSchemeTransformType type);
+const char *SymbolCodingMethodToString(int method);
+
+// Helper for measuring wall time of encoding stages. The clock is read only
+// when the timer is |enabled|, i.e. when encoding stats are collected.
+class EncodingStatsTimer {
+ public:
+  explicit EncodingStatsTimer(bool enabled) : enabled_(enabled) {
+    if (enabled_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  // Returns the number of seconds since the construction of the timer or 0 if
+  // the timer is disabled.
+  double Elapsed() const {
+    if (!enabled_) {
+      return 0.0;
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start_)
+        .count();
+  }
+
+ private:
+  bool enabled_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ENCODING_STATS_H_
@@ -0,0 +1,150 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/encoding_stats.h"
+
+#include <cmath>
+#include <memory>
+
+#include "draco/compression/expert_encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/point_cloud/point_cloud_builder.h"
+
+namespace draco {
+
+class EncodingStatsTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<PointCloud> CreatePointCloud(int num_points) {
+    PointCloudBuilder builder;
+    builder.Start(num_points);
+    const int pos_att_id =
+        builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+    const int opacity_att_id =
+        builder.AddAttribute(GeometryAttribute::OPACITY, 1, DT_FLOAT32);
+    const int idx_att_id =
+        builder.AddAttribute(GeometryAttribute::SH_DC_IDX, 1, DT_UINT32);
+    for (PointIndex i(0); i < num_points; ++i) {
+      const float t = static_cast<float>(i.value()) / num_points;
+      const float pos[3] = {t, std::sin(10.f * t), std::cos(10.f * t)};
+      const float opacity = 0.5f + 0.5f * std::sin(100.f * t);
+      const uint32_t idx = (i.value() * 7919) % 1024;
+      builder.SetAttributeValueForPoint(pos_att_id, i, pos);
+      builder.SetAttributeValueForPoint(opacity_att_id, i, &opacity);
+      builder.SetAttributeValueForPoint(idx_att_id, i, &idx);
+    }
+    return builder.Finalize(false);
+  }
+};
+
+TEST_F(EncodingStatsTest, TestSequentialEncoding) {
+  std::unique_ptr<PointCloud> pc = CreatePointCloud(1000);
+  ExpertEncoder encoder(*pc);
+  encoder.SetEncodingMethod(POINT_CLOUD_SEQUENTIAL_ENCODING);
+  encoder.SetAttributeQuantization(0, 12);
+  encoder.SetAttributeQuantization(1, 8);
+  EncodingStats stats;
+  encoder.SetEncodingStats(&stats);
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(&buffer));
+
+  ASSERT_EQ(stats.encoding_method, POINT_CLOUD_SEQUENTIAL_ENCODING);
+  ASSERT_EQ(stats.total_size, buffer.size());
+  ASSERT_EQ(stats.attributes.size(), 3);
+  int64_t attributes_size = 0;
+  for (const AttributeEncodingStats &att : stats.attributes) {
+    ASSERT_EQ(att.num_values, 1000 * att.num_components);
+    ASSERT_EQ(att.prediction_scheme, PREDICTION_DIFFERENCE);
+    ASSERT_TRUE(att.symbol_coding_method == SYMBOL_CODING_TAGGED ||
+                att.symbol_coding_method == SYMBOL_CODING_RAW);
+    ASSERT_GT(att.entropy_coded_size, 0);
+    ASSERT_GT(att.entropy_input_size, 0);
+    ASSERT_GT(att.entropy_estimate_bits, 0);
+    ASSERT_LE(att.entropy_coded_size, att.encoded_size);
+    ASSERT_EQ(att.joint_attribute_id, -1);
+    attributes_size += att.encoded_size;
+  }
+  ASSERT_LT(attributes_size + stats.header_size, stats.total_size);
+
+  const AttributeEncodingStats *const pos_stats = stats.GetAttribute(0);
+  ASSERT_NE(pos_stats, nullptr);
+  ASSERT_EQ(pos_stats->encoder, "quantization");
+  ASSERT_EQ(pos_stats->quantization_bits, 12);
+  ASSERT_EQ(pos_stats->raw_size, 1000 * 3 * sizeof(float));
+  const AttributeEncodingStats *const idx_stats = stats.GetAttribute(2);
+  ASSERT_NE(idx_stats, nullptr);
+  ASSERT_EQ(idx_stats->encoder, "integer");
+  ASSERT_EQ(idx_stats->quantization_bits, -1);
+
+  // Stats are not collected once disabled.
+  encoder.SetEncodingStats(nullptr);
+  EncoderBuffer buffer2;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(&buffer2));
+  ASSERT_EQ(buffer.size(), buffer2.size());
+  ASSERT_EQ(stats.total_size, buffer.size());
+}
+
+TEST_F(EncodingStatsTest, TestKdTreeEncoding) {
+  std::unique_ptr<PointCloud> pc = CreatePointCloud(1000);
+  ExpertEncoder encoder(*pc);
+  encoder.SetEncodingMethod(POINT_CLOUD_KD_TREE_ENCODING);
+  encoder.SetAttributeQuantization(0, 12);
+  encoder.SetAttributeQuantization(1, 8);
+  EncodingStats stats;
+  encoder.SetEncodingStats(&stats);
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(&buffer));
+
+  ASSERT_EQ(stats.total_size, buffer.size());
+  ASSERT_EQ(stats.attributes.size(), 3);
+  // All attributes are encoded jointly and the tree is reported on the first
+  // attribute.
+  const int first_att_id = stats.attributes[0].attribute_id;
+  ASSERT_GT(stats.attributes[0].entropy_coded_size, 0);
+  ASSERT_EQ(stats.attributes[0].joint_attribute_id, -1);
+  for (int i = 1; i < stats.attributes.size(); ++i) {
+    ASSERT_EQ(stats.attributes[i].encoder, "kd_tree");
+    ASSERT_EQ(stats.attributes[i].joint_attribute_id, first_att_id);
+    ASSERT_EQ(stats.attributes[i].entropy_coded_size, 0);
+  }
+  ASSERT_EQ(stats.GetAttribute(1)->quantization_bits, 8);
+}
+
+TEST_F(EncodingStatsTest, TestJson) {
+  std::unique_ptr<PointCloud> pc = CreatePointCloud(100);
+  ExpertEncoder encoder(*pc);
+  encoder.SetEncodingMethod(POINT_CLOUD_SEQUENTIAL_ENCODING);
+  encoder.SetAttributeQuantization(0, 12);
+  encoder.SetAttributeQuantization(1, 8);
+  EncodingStats stats;
+  encoder.SetEncodingStats(&stats);
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(&buffer));
+  const std::string json = EncodingStatsToJson(stats);
+  ASSERT_NE(json.find("\"total_size\": " + std::to_string(buffer.size())),
+            std::string::npos);
+  ASSERT_NE(json.find("\"type\": \"OPACITY\""), std::string::npos);
+  ASSERT_NE(json.find("\"geometry_type\": \"point_cloud\""),
+            std::string::npos);
+  ASSERT_NE(json.find("\"prediction_scheme\": \"difference\""),
+            std::string::npos);
+  ASSERT_EQ(json.front(), '{');
+}
+
+TEST_F(EncodingStatsTest, TestDisabledTimer) {
+  const EncodingStatsTimer timer(false);
+  ASSERT_EQ(timer.Elapsed(), 0.0);
+}
+
+}  // namespace draco
@@ -0,0 +1,77 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// File providing the mapping between symbols and buckets shared by the
+// bucketed symbol encoding and decoding (see SYMBOL_CODING_BUCKETED).
+#ifndef DRACO_COMPRESSION_ENTROPY_SYMBOL_BUCKET_CODING_H_
+#define DRACO_COMPRESSION_ENTROPY_SYMBOL_BUCKET_CODING_H_
+
+#include <stdint.h>
+
+#include "draco/core/bit_utils.h"
+
+namespace draco {
+
+// The bucketed scheme splits each symbol into a bucket that is entropy coded
+// and extra bits that are stored raw. Symbols smaller than 2^m, where m is the
+// number of mantissa bits, have their own buckets. Larger symbols are bucketed
+// by the position of their most significant bit and by the m bits that follow
+// it, while the remaining low bits are the extra bits. The number of buckets is
+// at most (33 - m) * 2^m, which keeps the rANS frequency tables small for any
+// alphabet size.
+constexpr int kMaxSymbolBucketMantissaBits = 8;
+
+// Returns the bucket of |symbol| and the number of its extra bits.
+inline uint32_t ComputeSymbolBucket(uint32_t symbol, int num_mantissa_bits,
+                                    int *out_num_extra_bits) {
+  if (symbol < (1u << num_mantissa_bits)) {
+    *out_num_extra_bits = 0;
+    return symbol;
+  }
+  const int num_extra_bits = MostSignificantBit(symbol) - num_mantissa_bits;
+  *out_num_extra_bits = num_extra_bits;
+  return ((num_extra_bits + 1) << num_mantissa_bits) |
+         ((symbol >> num_extra_bits) & ((1u << num_mantissa_bits) - 1));
+}
+
+// Returns the number of buckets for the given number of mantissa bits.
+inline uint32_t GetNumSymbolBuckets(int num_mantissa_bits) {
+  return (33 - num_mantissa_bits) << num_mantissa_bits;
+}
+
+// Returns the number of extra bits of symbols in |bucket|. |bucket| must be
+// smaller than GetNumSymbolBuckets().
+inline int GetSymbolBucketNumExtraBits(uint32_t bucket,
+                                       int num_mantissa_bits) {
+  if (bucket < (1u << num_mantissa_bits)) {
+    return 0;
+  }
+  return static_cast<int>(bucket >> num_mantissa_bits) - 1;
+}
+
+// Returns the symbol in |bucket| with the given |extra_bits|. |num_extra_bits|
+// must be the value returned by GetSymbolBucketNumExtraBits().
+inline uint32_t GetSymbolFromBucket(uint32_t bucket, int num_mantissa_bits,
+                                    int num_extra_bits, uint32_t extra_bits) {
+  if (bucket < (1u << num_mantissa_bits)) {
+    return bucket;
+  }
+  const uint32_t mantissa = (1u << num_mantissa_bits) |
+                            (bucket & ((1u << num_mantissa_bits) - 1));
+  return (mantissa << num_extra_bits) | extra_bits;
+}
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ENTROPY_SYMBOL_BUCKET_CODING_H_
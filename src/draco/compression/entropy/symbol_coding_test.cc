@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include <vector>
+
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/entropy/symbol_decoding.h"
 #include "draco/compression/entropy/symbol_encoding.h"
@@ -158,6 +160,63 @@ TEST_F(SymbolCodingTest, TestLargeNumberCondition) {
   }
 }
 
+TEST_F(SymbolCodingTest, TestBucketedScheme) {
+  // This test verifies that symbols over 18 bits from a skewed distribution,
+  // e.g. high precision quantized values, are encoded with the bucketed scheme
+  // when it is enabled and that the bucketed scheme beats the tagged scheme on
+  // them.
+  std::vector<uint32_t> in;
+  uint32_t seed = 1;
+  for (int i = 0; i < 100000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    // Sum of uniform random values clustered around 2^19.
+    const uint32_t offset = ((seed >> 8) & 0xfff) + ((seed >> 20) & 0xfff);
+    in.push_back((1 << 19) + offset - 0x1000);
+  }
+  Options options;
+  SetSymbolEncodingBucketedCoding(&options, true);
+  EncoderBuffer eb;
+  ASSERT_TRUE(EncodeSymbols(in.data(), in.size(), 1, &options, &eb));
+  ASSERT_EQ(eb.data()[0], SYMBOL_CODING_BUCKETED);
+
+  std::vector<uint32_t> out(in.size());
+  DecoderBuffer db;
+  db.Init(eb.data(), eb.size());
+  db.set_bitstream_version(bitstream_version_);
+  ASSERT_TRUE(DecodeSymbols(in.size(), 1, &db, &out[0]));
+  ASSERT_EQ(in, out);
+
+  // Without the option, the symbols are encoded with the tagged scheme that
+  // is supported by all decoders.
+  EncoderBuffer tagged_eb;
+  ASSERT_TRUE(EncodeSymbols(in.data(), in.size(), 1, nullptr, &tagged_eb));
+  ASSERT_EQ(tagged_eb.data()[0], SYMBOL_CODING_TAGGED);
+  ASSERT_LT(eb.size(), tagged_eb.size());
+}
+
+TEST_F(SymbolCodingTest, TestBucketedSchemeFullRange) {
+  // This test verifies that the bucketed scheme encodes symbols of all bit
+  // lengths including the full 32-bit range.
+  std::vector<uint32_t> in;
+  for (int i = 0; i < 32; ++i) {
+    in.push_back(1u << i);
+    in.push_back((1u << i) - 1);
+    in.push_back((1u << i) | 0x5a5a5a5a);
+  }
+  in.push_back(0xffffffff);
+  Options options;
+  SetSymbolEncodingMethod(&options, SYMBOL_CODING_BUCKETED);
+  EncoderBuffer eb;
+  ASSERT_TRUE(EncodeSymbols(in.data(), in.size(), 1, &options, &eb));
+
+  std::vector<uint32_t> out(in.size());
+  DecoderBuffer db;
+  db.Init(eb.data(), eb.size());
+  db.set_bitstream_version(bitstream_version_);
+  ASSERT_TRUE(DecodeSymbols(in.size(), 1, &db, &out[0]));
+  ASSERT_EQ(in, out);
+}
+
 TEST_F(SymbolCodingTest, TestConversionFullRange) {
   TestConvertToSymbolAndBack(static_cast<int8_t>(-128));
   TestConvertToSymbolAndBack(static_cast<int8_t>(-127));
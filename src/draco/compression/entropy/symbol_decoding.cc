@@ -18,6 +18,7 @@
 #include <cmath>
 
 #include "draco/compression/entropy/rans_symbol_decoder.h"
+#include "draco/compression/entropy/symbol_bucket_coding.h"
 
 namespace draco {
 
@@ -29,6 +30,10 @@ template <template <int> class SymbolDecoderT>
 bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
                       uint32_t *out_values);
 
+template <template <int> class SymbolDecoderT>
+bool DecodeBucketedSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
+                           uint32_t *out_values);
+
 bool DecodeSymbols(uint32_t num_values, int num_components,
                    DecoderBuffer *src_buffer, uint32_t *out_values) {
   if (num_values == 0) {
@@ -45,6 +50,9 @@ bool DecodeSymbols(uint32_t num_values, int num_components,
   } else if (scheme == SYMBOL_CODING_RAW) {
     return DecodeRawSymbols<RAnsSymbolDecoder>(num_values, src_buffer,
                                                out_values);
+  } else if (scheme == SYMBOL_CODING_BUCKETED) {
+    return DecodeBucketedSymbols<RAnsSymbolDecoder>(num_values, src_buffer,
+                                                    out_values);
   }
   return false;
 }
@@ -178,4 +186,50 @@ bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
   }
 }
 
+template <template <int> class SymbolDecoderT>
+bool DecodeBucketedSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
+                           uint32_t *out_values) {
+  uint8_t num_mantissa_bits;
+  if (!src_buffer->Decode(&num_mantissa_bits) ||
+      num_mantissa_bits > kMaxSymbolBucketMantissaBits) {
+    return false;
+  }
+  // Decode the buckets directly to the output and replace them with the
+  // symbols in place.
+  if (!DecodeRawSymbols<SymbolDecoderT>(num_values, src_buffer, out_values)) {
+    return false;
+  }
+  const uint32_t num_buckets = GetNumSymbolBuckets(num_mantissa_bits);
+  const uint32_t first_extra_bits_bucket = 1u << num_mantissa_bits;
+  bool bit_decoding_started = false;
+  for (uint32_t i = 0; i < num_values; ++i) {
+    const uint32_t bucket = out_values[i];
+    if (bucket < first_extra_bits_bucket) {
+      // Small symbols are their own buckets.
+      continue;
+    }
+    if (bucket >= num_buckets) {
+      return false;
+    }
+    if (!bit_decoding_started) {
+      // The extra bits follow the buckets.
+      src_buffer->StartBitDecoding(false, nullptr);
+      bit_decoding_started = true;
+    }
+    const int num_extra_bits =
+        GetSymbolBucketNumExtraBits(bucket, num_mantissa_bits);
+    uint32_t extra_bits;
+    if (!src_buffer->DecodeLeastSignificantBits32(num_extra_bits,
+                                                   &extra_bits)) {
+      return false;
+    }
+    out_values[i] = GetSymbolFromBucket(bucket, num_mantissa_bits,
+                                        num_extra_bits, extra_bits);
+  }
+  if (bit_decoding_started) {
+    src_buffer->EndBitDecoding();
+  }
+  return true;
+}
+
 }  // namespace draco
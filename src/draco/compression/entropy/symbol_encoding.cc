@@ -16,9 +16,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "draco/compression/entropy/rans_symbol_encoder.h"
 #include "draco/compression/entropy/shannon_entropy.h"
+#include "draco/compression/entropy/symbol_bucket_coding.h"
 #include "draco/core/bit_utils.h"
 #include "draco/core/macros.h"
 
@@ -34,6 +36,10 @@ void SetSymbolEncodingMethod(Options *options, SymbolCodingMethod method) {
   options->SetInt("symbol_encoding_method", method);
 }
 
+void SetSymbolEncodingBucketedCoding(Options *options, bool enabled) {
+  options->SetBool("symbol_encoding_bucketed_coding", enabled);
+}
+
 bool SetSymbolEncodingCompressionLevel(Options *options,
                                        int compression_level) {
   if (compression_level < 0 || compression_level > 10) {
@@ -102,6 +108,52 @@ static int64_t ApproximateRawSchemeBits(const uint32_t *symbols,
   return table_bits + data_bits;
 }
 
+// Computes buckets of the input symbols for the bucketed scheme. Returns the
+// total number of extra bits.
+static uint64_t ComputeSymbolBuckets(const uint32_t *symbols, int num_values,
+                                     int num_mantissa_bits,
+                                     std::vector<uint32_t> *out_buckets,
+                                     uint32_t *out_max_bucket) {
+  out_buckets->resize(num_values);
+  *out_max_bucket = 0;
+  uint64_t num_extra_bits = 0;
+  for (int i = 0; i < num_values; ++i) {
+    int symbol_extra_bits;
+    const uint32_t bucket =
+        ComputeSymbolBucket(symbols[i], num_mantissa_bits, &symbol_extra_bits);
+    (*out_buckets)[i] = bucket;
+    *out_max_bucket = std::max(*out_max_bucket, bucket);
+    num_extra_bits += symbol_extra_bits;
+  }
+  return num_extra_bits;
+}
+
+// Approximates the number of bits of the bucketed scheme for the best number
+// of mantissa bits, which is returned in |out_num_mantissa_bits|.
+static int64_t ApproximateBucketedSchemeBits(const uint32_t *symbols,
+                                             int num_values,
+                                             int *out_num_mantissa_bits) {
+  int64_t best_bits = std::numeric_limits<int64_t>::max();
+  std::vector<uint32_t> buckets;
+  for (int num_mantissa_bits = 0;
+       num_mantissa_bits <= kMaxSymbolBucketMantissaBits;
+       num_mantissa_bits += 2) {
+    uint32_t max_bucket;
+    const uint64_t extra_bits = ComputeSymbolBuckets(
+        symbols, num_values, num_mantissa_bits, &buckets, &max_bucket);
+    int num_unique_buckets;
+    const int64_t bits =
+        ApproximateRawSchemeBits(buckets.data(), num_values, max_bucket,
+                                 &num_unique_buckets) +
+        extra_bits;
+    if (bits < best_bits) {
+      best_bits = bits;
+      *out_num_mantissa_bits = num_mantissa_bits;
+    }
+  }
+  return best_bits;
+}
+
 template <template <int> class SymbolEncoderT>
 bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
                          int num_components,
@@ -113,6 +165,36 @@ bool EncodeRawSymbols(const uint32_t *symbols, int num_values,
                       uint32_t max_entry_value, int32_t num_unique_symbols,
                       const Options *options, EncoderBuffer *target_buffer);
 
+template <template <int> class SymbolEncoderT>
+bool EncodeBucketedSymbols(const uint32_t *symbols, int num_values,
+                           int num_mantissa_bits, const Options *options,
+                           EncoderBuffer *target_buffer);
+
+int64_t EstimateEncodedSymbolsBits(const uint32_t *symbols, int num_values,
+                                   int num_components) {
+  if (num_values <= 0) {
+    return 0;
+  }
+  if (num_components <= 0) {
+    num_components = 1;
+  }
+  std::vector<uint32_t> bit_lengths;
+  uint32_t max_value;
+  ComputeBitLengths(symbols, num_values, num_components, &bit_lengths,
+                    &max_value);
+  const int64_t tagged_scheme_total_bits =
+      ApproximateTaggedSchemeBits(bit_lengths, num_components);
+  const int max_value_bit_length =
+      MostSignificantBit(std::max(1u, max_value)) + 1;
+  if (max_value_bit_length > kMaxRawEncodingBitLength) {
+    return tagged_scheme_total_bits;
+  }
+  int num_unique_symbols = 0;
+  const int64_t raw_scheme_total_bits = ApproximateRawSchemeBits(
+      symbols, num_values, max_value, &num_unique_symbols);
+  return std::min(tagged_scheme_total_bits, raw_scheme_total_bits);
+}
+
 bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
                    const Options *options, EncoderBuffer *target_buffer) {
   if (num_values < 0) {
@@ -134,27 +216,44 @@ bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
   const int64_t tagged_scheme_total_bits =
       ApproximateTaggedSchemeBits(bit_lengths, num_components);
 
-  // Approximate number of bits needed for storing the symbols using the raw
-  // scheme.
-  int num_unique_symbols = 0;
-  const int64_t raw_scheme_total_bits = ApproximateRawSchemeBits(
-      symbols, num_values, max_value, &num_unique_symbols);
-
   // The maximum bit length of a single entry value that we can encode using
   // the raw scheme.
   const int max_value_bit_length =
       MostSignificantBit(std::max(1u, max_value)) + 1;
 
+  // Approximate number of bits needed for storing the symbols using the raw
+  // scheme. Larger alphabets are approximated with the bucketed scheme when it
+  // is allowed.
+  const bool bucketed_coding =
+      options != nullptr &&
+      options->GetBool("symbol_encoding_bucketed_coding", false);
+  int num_unique_symbols = 0;
+  int num_mantissa_bits = kMaxSymbolBucketMantissaBits;
+  int64_t raw_scheme_total_bits = 0;
+  int64_t bucketed_scheme_total_bits = 0;
+  if (max_value_bit_length <= kMaxRawEncodingBitLength) {
+    raw_scheme_total_bits = ApproximateRawSchemeBits(
+        symbols, num_values, max_value, &num_unique_symbols);
+  } else if (bucketed_coding) {
+    bucketed_scheme_total_bits =
+        ApproximateBucketedSchemeBits(symbols, num_values, &num_mantissa_bits);
+  }
+
   int method = -1;
   if (options != nullptr && options->IsOptionSet("symbol_encoding_method")) {
     method = options->GetInt("symbol_encoding_method");
-  } else {
-    if (tagged_scheme_total_bits < raw_scheme_total_bits ||
-        max_value_bit_length > kMaxRawEncodingBitLength) {
-      method = SYMBOL_CODING_TAGGED;
-    } else {
-      method = SYMBOL_CODING_RAW;
+  } else if (max_value_bit_length > kMaxRawEncodingBitLength) {
+    // Older decoders don't support the bucketed scheme so it is used only
+    // when it was allowed explicitly.
+    method = SYMBOL_CODING_TAGGED;
+    if (bucketed_coding &&
+        bucketed_scheme_total_bits <= tagged_scheme_total_bits) {
+      method = SYMBOL_CODING_BUCKETED;
     }
+  } else if (tagged_scheme_total_bits < raw_scheme_total_bits) {
+    method = SYMBOL_CODING_TAGGED;
+  } else {
+    method = SYMBOL_CODING_RAW;
   }
   // Use the tagged scheme.
   target_buffer->Encode(static_cast<uint8_t>(method));
@@ -163,10 +262,23 @@ bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
         symbols, num_values, num_components, bit_lengths, target_buffer);
   }
   if (method == SYMBOL_CODING_RAW) {
+    if (max_value_bit_length > kMaxRawEncodingBitLength) {
+      // The raw scheme was requested explicitly for a large alphabet.
+      ApproximateRawSchemeBits(symbols, num_values, max_value,
+                               &num_unique_symbols);
+    }
     return EncodeRawSymbols<RAnsSymbolEncoder>(symbols, num_values, max_value,
                                                num_unique_symbols, options,
                                                target_buffer);
   }
+  if (method == SYMBOL_CODING_BUCKETED) {
+    if (!bucketed_coding || max_value_bit_length <= kMaxRawEncodingBitLength) {
+      // The bucketed scheme was requested explicitly.
+      ApproximateBucketedSchemeBits(symbols, num_values, &num_mantissa_bits);
+    }
+    return EncodeBucketedSymbols<RAnsSymbolEncoder>(
+        symbols, num_values, num_mantissa_bits, options, target_buffer);
+  }
   // Unknown method selected.
   return false;
 }
@@ -373,4 +485,40 @@ bool EncodeRawSymbols(const uint32_t *symbols, int num_values,
   }
 }
 
+template <template <int> class SymbolEncoderT>
+bool EncodeBucketedSymbols(const uint32_t *symbols, int num_values,
+                           int num_mantissa_bits, const Options *options,
+                           EncoderBuffer *target_buffer) {
+  std::vector<uint32_t> buckets;
+  uint32_t max_bucket;
+  const uint64_t num_extra_bits = ComputeSymbolBuckets(
+      symbols, num_values, num_mantissa_bits, &buckets, &max_bucket);
+  int num_unique_buckets;
+  ComputeShannonEntropy(buckets.data(), num_values, max_bucket,
+                        &num_unique_buckets);
+  target_buffer->Encode(static_cast<uint8_t>(num_mantissa_bits));
+  // Encode the buckets with the raw scheme.
+  if (!EncodeRawSymbols<SymbolEncoderT>(buckets.data(), num_values, max_bucket,
+                                        num_unique_buckets, options,
+                                        target_buffer)) {
+    return false;
+  }
+  if (num_extra_bits == 0) {
+    return true;
+  }
+  // Append the extra bits of all symbols.
+  EncoderBuffer value_buffer;
+  value_buffer.StartBitEncoding(num_extra_bits, false);
+  for (int i = 0; i < num_values; ++i) {
+    const int bucket_extra_bits =
+        GetSymbolBucketNumExtraBits(buckets[i], num_mantissa_bits);
+    if (bucket_extra_bits > 0) {
+      value_buffer.EncodeLeastSignificantBits32(bucket_extra_bits, symbols[i]);
+    }
+  }
+  value_buffer.EndBitEncoding();
+  target_buffer->Encode(value_buffer.data(), value_buffer.size());
+  return true;
+}
+
 }  // namespace draco
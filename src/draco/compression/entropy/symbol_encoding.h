@@ -24,18 +24,34 @@ namespace draco {
 // Encodes an array of symbols using an entropy coding. This function
 // automatically decides whether to encode the symbol values using bit
 // length tags (see EncodeTaggedSymbols), or whether to encode them directly
-// (see EncodeRawSymbols). The symbols can be grouped into separate components
-// that can be used for better compression. |options| is an optional parameter
-// that allows more direct control over various stages of the symbol encoding
-// (see below for functions that are used to set valid options).
+// (see EncodeRawSymbols). Symbols that need more than 18 bits are encoded
+// with the bit length tags, or as buckets with raw extra bits when enabled by
+// SetSymbolEncodingBucketedCoding() (see EncodeBucketedSymbols). The symbols
+// can be grouped into separate components that can be used for better
+// compression. |options| is an optional parameter that allows more direct
+// control over various stages of the symbol encoding (see below for functions
+// that are used to set valid options).
 // Returns false on error.
 bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
                    const Options *options, EncoderBuffer *target_buffer);
 
+// Returns the approximate number of bits that would be needed to encode
+// |symbols| with EncodeSymbols() using the default encoding method selection.
+// The estimate is based on the Shannon entropy of the symbols and it is much
+// faster than the actual encoding.
+int64_t EstimateEncodedSymbolsBits(const uint32_t *symbols, int num_values,
+                                   int num_components);
+
 // Sets an option that forces symbol encoder to use the specified encoding
 // method.
 void SetSymbolEncodingMethod(Options *options, SymbolCodingMethod method);
 
+// Sets an option that allows the symbol encoder to use the bucketed scheme for
+// symbols that need more than 18 bits when it is smaller than the tagged
+// scheme (default = false). Symbols encoded with the bucketed scheme can't be
+// decoded by decoders that predate it.
+void SetSymbolEncodingBucketedCoding(Options *options, bool enabled);
+
 // Sets the desired compression level for symbol encoding in range <0, 10> where
 // 0 is the worst but fastest compression and 10 is the best but slowest
 // compression. If the option is not set, default value of 7 is used.
@@ -14,6 +14,7 @@
 //
 #include "draco/compression/expert_encode.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <ostream>
@@ -48,6 +49,87 @@ Status ExpertEncoder::EncodeToBuffer(EncoderBuffer *out_buffer) {
   return EncodeMeshToBuffer(*mesh_, out_buffer);
 }
 
+Status ExpertEncoder::EncodeToBufferWithRateControl(
+    const RateControlOptions &rate_control_options,
+    EncoderBuffer *out_buffer) {
+  if (point_cloud_ == nullptr) {
+    return Status(Status::DRACO_ERROR, "Invalid input geometry.");
+  }
+  RateController controller(*point_cloud_, rate_control_options);
+  DRACO_RETURN_IF_ERROR(controller.Init(options()));
+  const EncoderOptions base_options = options();
+  const int64_t target_size = rate_control_options.target_size;
+  if (target_size <= 0) {
+    controller.SelectQuantization(0, &options());
+    return EncodeToBuffer(out_buffer);
+  }
+
+  // The estimates don't account for headers, connectivity and attributes that
+  // are not controlled, so the size budget of the controlled attributes is
+  // corrected after each full encode by the ratio of the target and actual
+  // sizes. The largest encoding that fits the target is kept, or the smallest
+  // one if none of them fits.
+  EncoderOptions best_options = base_options;
+  EncoderBuffer best_buffer;
+  EncodingStats best_stats;
+  bool has_best = false;
+  int64_t size_budget = target_size;
+  int64_t last_estimated_size = -1;
+  int max_num_refinements = rate_control_options.max_num_refinements;
+  if (mesh_ == nullptr) {
+    // The kd-tree coder is not modeled by the size estimates, so allow more
+    // full encodes for correcting them. The selected method does not depend on
+    // the number of quantization bits as long as all of them are positive.
+    EncoderOptions candidate_options = base_options;
+    controller.SelectQuantization(target_size, &candidate_options);
+    Reset(candidate_options);
+    if (GetPointCloudEncodingMethod(*point_cloud_) ==
+        POINT_CLOUD_KD_TREE_ENCODING) {
+      max_num_refinements =
+          std::max(max_num_refinements,
+                   rate_control_options.max_num_kd_tree_refinements);
+    }
+  }
+  for (int i = 0; i <= max_num_refinements; ++i) {
+    EncoderOptions candidate_options = base_options;
+    const int64_t estimated_size =
+        controller.SelectQuantization(size_budget, &candidate_options);
+    if (estimated_size == last_estimated_size) {
+      break;  // Same quantization as in the previous iteration.
+    }
+    last_estimated_size = estimated_size;
+    Reset(candidate_options);
+    EncoderBuffer buffer;
+    DRACO_RETURN_IF_ERROR(EncodeToBuffer(&buffer));
+    const int64_t size = buffer.size();
+    const int64_t best_size = best_buffer.size();
+    const bool fits = size <= target_size;
+    const bool best_fits = has_best && best_size <= target_size;
+    if (!has_best || (fits && (!best_fits || size > best_size)) ||
+        (!fits && !best_fits && size < best_size)) {
+      best_options = candidate_options;
+      best_buffer.Clear();
+      best_buffer.Encode(buffer.data(), buffer.size());
+      if (encoding_stats()) {
+        best_stats = *encoding_stats();
+      }
+      has_best = true;
+    }
+    if (fits && size * 20 >= target_size * 19) {
+      break;  // Within 5% of the target size.
+    }
+    size_budget = std::max<int64_t>(
+        1, static_cast<int64_t>(static_cast<double>(size_budget) *
+                                target_size / size));
+  }
+  Reset(best_options);
+  if (encoding_stats()) {
+    *encoding_stats() = best_stats;
+  }
+  out_buffer->Encode(best_buffer.data(), best_buffer.size());
+  return OkStatus();
+}
+
 Status ExpertEncoder::EncodePointCloudToBuffer(const PointCloud &pc,
                                                EncoderBuffer *out_buffer) {
 #ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
@@ -57,52 +139,18 @@ Status ExpertEncoder::EncodePointCloudToBuffer(const PointCloud &pc,
 #endif  // DRACO_TRANSCODER_SUPPORTED
 
   std::unique_ptr<PointCloudEncoder> encoder;
-  const int encoding_method = options().GetGlobalInt("encoding_method", -1);
-
-  if (encoding_method == POINT_CLOUD_SEQUENTIAL_ENCODING) {
-    // Use sequential encoding if requested.
-    encoder.reset(new PointCloudSequentialEncoder());
-  } else if (encoding_method == -1 && options().GetSpeed() == 10) {
-    // Use sequential encoding if speed is at max.
+  const int encoding_method = GetPointCloudEncodingMethod(pc);
+  if (encoding_method == POINT_CLOUD_KD_TREE_ENCODING) {
+    encoder.reset(new PointCloudKdTreeEncoder());
+  } else if (encoding_method == POINT_CLOUD_SEQUENTIAL_ENCODING) {
     encoder.reset(new PointCloudSequentialEncoder());
   } else {
-    // Speed < 10, use POINT_CLOUD_KD_TREE_ENCODING if possible.
-    bool kd_tree_possible = true;
-    // Kd-Tree encoder can be currently used only when the following conditions
-    // are satisfied for all attributes:
-    //     -data type is float32 and quantization is enabled, OR
-    //     -data type is uint32, uint16, uint8 or int32, int16, int8
-    for (int i = 0; i < pc.num_attributes(); ++i) {
-      const PointAttribute *const att = pc.attribute(i);
-      if (kd_tree_possible && att->data_type() != DT_FLOAT32 &&
-          att->data_type() != DT_UINT32 && att->data_type() != DT_UINT16 &&
-          att->data_type() != DT_UINT8 && att->data_type() != DT_INT32 &&
-          att->data_type() != DT_INT16 && att->data_type() != DT_INT8) {
-        kd_tree_possible = false;
-      }
-      if (kd_tree_possible && att->data_type() == DT_FLOAT32 &&
-          options().GetAttributeInt(i, "quantization_bits", -1) <= 0) {
-        kd_tree_possible = false;  // Quantization not enabled.
-      }
-      if (!kd_tree_possible) {
-        break;
-      }
-    }
-
-    if (kd_tree_possible) {
-      // Create kD-tree encoder (all checks passed).
-      encoder.reset(new PointCloudKdTreeEncoder());
-    } else if (encoding_method == POINT_CLOUD_KD_TREE_ENCODING) {
-      // Encoding method was explicitly specified but we cannot use it for
-      // the given input (some of the checks above failed).
-      return Status(Status::DRACO_ERROR, "Invalid encoding method.");
-    }
-  }
-  if (!encoder) {
-    // Default choice.
-    encoder.reset(new PointCloudSequentialEncoder());
+    // Encoding method was explicitly specified but we cannot use it for
+    // the given input.
+    return Status(Status::DRACO_ERROR, "Invalid encoding method.");
   }
   encoder->SetPointCloud(pc);
+  encoder->SetEncodingStats(encoding_stats());
   DRACO_RETURN_IF_ERROR(encoder->Encode(options(), out_buffer));
 
   set_num_encoded_points(encoder->num_encoded_points());
@@ -113,6 +161,45 @@ Status ExpertEncoder::EncodePointCloudToBuffer(const PointCloud &pc,
 #endif
 }
 
+int ExpertEncoder::GetPointCloudEncodingMethod(const PointCloud &pc) const {
+  const int encoding_method = options().GetGlobalInt("encoding_method", -1);
+  if (encoding_method == POINT_CLOUD_SEQUENTIAL_ENCODING) {
+    // Use sequential encoding if requested.
+    return POINT_CLOUD_SEQUENTIAL_ENCODING;
+  }
+  if (encoding_method == -1 && options().GetSpeed() == 10) {
+    // Use sequential encoding if speed is at max.
+    return POINT_CLOUD_SEQUENTIAL_ENCODING;
+  }
+  // Speed < 10, use POINT_CLOUD_KD_TREE_ENCODING if possible.
+  // Kd-Tree encoder can be currently used only when the following conditions
+  // are satisfied for all attributes:
+  //     -data type is float32 and quantization is enabled, OR
+  //     -data type is uint32, uint16, uint8 or int32, int16, int8
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    const PointAttribute *const att = pc.attribute(i);
+    bool kd_tree_possible = true;
+    if (att->data_type() != DT_FLOAT32 && att->data_type() != DT_UINT32 &&
+        att->data_type() != DT_UINT16 && att->data_type() != DT_UINT8 &&
+        att->data_type() != DT_INT32 && att->data_type() != DT_INT16 &&
+        att->data_type() != DT_INT8) {
+      kd_tree_possible = false;
+    }
+    if (att->data_type() == DT_FLOAT32 &&
+        options().GetAttributeInt(i, "quantization_bits", -1) <= 0) {
+      kd_tree_possible = false;  // Quantization not enabled.
+    }
+    if (!kd_tree_possible) {
+      if (encoding_method == POINT_CLOUD_KD_TREE_ENCODING) {
+        return -1;
+      }
+      // Default choice.
+      return POINT_CLOUD_SEQUENTIAL_ENCODING;
+    }
+  }
+  return POINT_CLOUD_KD_TREE_ENCODING;
+}
+
 Status ExpertEncoder::EncodeMeshToBuffer(const Mesh &m,
                                          EncoderBuffer *out_buffer) {
 #ifdef DRACO_TRANSCODER_SUPPORTED
@@ -137,6 +224,7 @@ Status ExpertEncoder::EncodeMeshToBuffer(const Mesh &m,
     encoder = std::unique_ptr<MeshEncoder>(new MeshSequentialEncoder());
   }
   encoder->SetMesh(m);
+  encoder->SetEncodingStats(encoding_stats());
 
   DRACO_RETURN_IF_ERROR(encoder->Encode(options(), out_buffer));
 
@@ -247,6 +335,13 @@ Status ExpertEncoder::ApplyCompressionOptions(const PointCloud &pc) {
       case GeometryAttribute::GENERIC:
         quantization_bits = compression_options.quantization_bits_generic;
         break;
+      case GeometryAttribute::SH_DC:
+      case GeometryAttribute::SH_REST:
+      case GeometryAttribute::OPACITY:
+      case GeometryAttribute::SCALE:
+      case GeometryAttribute::ROTATION:
+        quantization_bits = compression_options.quantization_bits_gaussian;
+        break;
       default:
         break;
     }
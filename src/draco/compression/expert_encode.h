@@ -18,6 +18,7 @@
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/encoder_options.h"
 #include "draco/compression/encode_base.h"
+#include "draco/compression/rate_control.h"
 #include "draco/core/encoder_buffer.h"
 #include "draco/core/status.h"
 #include "draco/mesh/mesh.h"
@@ -40,6 +41,23 @@ class ExpertEncoder : public EncoderBase<EncoderOptions> {
   // Encodes the geometry provided in the constructor to the target buffer.
   Status EncodeToBuffer(EncoderBuffer *out_buffer);
 
+  // Encodes the geometry with quantization bits of all floating point
+  // attributes selected automatically to fit |rate_control_options.target_size|
+  // and/or to respect the maximum quantization errors. Normals and attributes
+  // with negative quantization bits are not controlled. Other options set on
+  // the encoder are preserved. Candidate quantizations are evaluated using
+  // entropy based size estimates, followed by a few full encodes that correct
+  // the estimates when the target size is missed. The estimates model the
+  // sequential coders, so point clouds encoded with the kd-tree method use up
+  // to |rate_control_options.max_num_kd_tree_refinements| full encodes
+  // instead. On success, the selected options can be retrieved from options()
+  // and the encoding stats (if enabled) describe the returned encoding. Fails
+  // when a maximum error needs more than
+  // |rate_control_options.max_quantization_bits|.
+  Status EncodeToBufferWithRateControl(
+      const RateControlOptions &rate_control_options,
+      EncoderBuffer *out_buffer);
+
   // Set encoder options used during the geometry encoding. Note that this call
   // overwrites any modifications to the options done with the functions below.
   void Reset(const EncoderOptions &options);
@@ -145,6 +163,10 @@ class ExpertEncoder : public EncoderBase<EncoderOptions> {
 
   Status EncodeMeshToBuffer(const Mesh &m, EncoderBuffer *out_buffer);
 
+  // Returns the point cloud encoding method selected for |pc| by the current
+  // options or -1 when the requested method can't be used for |pc|.
+  int GetPointCloudEncodingMethod(const PointCloud &pc) const;
+
 #ifdef DRACO_TRANSCODER_SUPPORTED
   // Applies compression options stored in |pc|.
   Status ApplyCompressionOptions(const PointCloud &pc);
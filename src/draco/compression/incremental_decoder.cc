@@ -0,0 +1,183 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/incremental_decoder.h"
+
+#include <utility>
+
+#include "draco/compression/decode.h"
+#include "draco/core/varint_decoding.h"
+
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+#include "draco/compression/mesh/mesh_decoder.h"
+#endif
+
+namespace draco {
+
+IncrementalDecoder::IncrementalDecoder()
+    : num_decoded_attributes_(0),
+      next_descriptors_attempt_size_(0),
+      all_data_received_(false),
+      finished_(false) {}
+
+Status IncrementalDecoder::AddData(const char *data, size_t data_size) {
+  if (all_data_received_) {
+    return Status(Status::DRACO_ERROR, "Data added after Finish().");
+  }
+  // Decoders may re-initialize |buffer_| at an offset of the received data,
+  // so the decoded position is computed from its data head.
+  const int64_t decoded_size =
+      decoder_ == nullptr ? 0 : buffer_.data_head() - data_.data();
+  data_.insert(data_.end(), data, data + data_size);
+  // The received data may have been reallocated.
+  buffer_.Init(data_.data(), data_.size());
+  buffer_.Advance(decoded_size);
+  return DecodeAvailableData();
+}
+
+Status IncrementalDecoder::Finish() {
+  all_data_received_ = true;
+  DRACO_RETURN_IF_ERROR(DecodeAvailableData())
+  if (!finished_) {
+    return Status(Status::IO_ERROR, "Incomplete data.");
+  }
+  return OkStatus();
+}
+
+bool IncrementalDecoder::IsAttributeDecoded(int att_id) const {
+  if (att_id < 0 || att_id >= static_cast<int>(decoded_attributes_.size())) {
+    return false;
+  }
+  return decoded_attributes_[att_id];
+}
+
+std::unique_ptr<PointCloud> IncrementalDecoder::ReleaseGeometry() {
+  if (!finished_) {
+    return nullptr;
+  }
+  return std::move(geometry_);
+}
+
+Status IncrementalDecoder::DecodeAvailableData() {
+  if (finished_) {
+    return OkStatus();
+  }
+  if (decoder_ == nullptr) {
+    DRACO_RETURN_IF_ERROR(DecodeDescriptors())
+    if (decoder_ == nullptr) {
+      return OkStatus();
+    }
+  }
+  return DecodeAttributes();
+}
+
+Status IncrementalDecoder::DecodeDescriptors() {
+  if (!all_data_received_ && data_.size() < next_descriptors_attempt_size_) {
+    return OkStatus();
+  }
+  DecoderBuffer header_buffer;
+  header_buffer.Init(data_.data(), data_.size());
+  DracoHeader header;
+  const Status header_status =
+      PointCloudDecoder::DecodeHeader(&header_buffer, &header);
+  if (!header_status.ok()) {
+    // An IO error means that the header is not complete yet.
+    if (all_data_received_ || header_status.code() != Status::IO_ERROR) {
+      return header_status;
+    }
+    return OkStatus();
+  }
+
+  std::unique_ptr<PointCloudDecoder> decoder;
+  std::unique_ptr<PointCloud> geometry;
+  Status status;
+  buffer_.Init(data_.data(), data_.size());
+  if (header.encoder_type == POINT_CLOUD) {
+#ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
+    DRACO_ASSIGN_OR_RETURN(decoder,
+                           CreatePointCloudDecoder(header.encoder_method))
+    geometry.reset(new PointCloud());
+    status = decoder->DecodeAttributeDescriptors(options_, &buffer_,
+                                                 geometry.get());
+#endif
+  } else if (header.encoder_type == TRIANGULAR_MESH) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+    DRACO_ASSIGN_OR_RETURN(std::unique_ptr<MeshDecoder> mesh_decoder,
+                           CreateMeshDecoder(header.encoder_method))
+    std::unique_ptr<Mesh> mesh(new Mesh());
+    status = mesh_decoder->DecodeAttributeDescriptors(options_, &buffer_,
+                                                      mesh.get());
+    decoder = std::move(mesh_decoder);
+    geometry = std::move(mesh);
+#endif
+  }
+  if (decoder == nullptr) {
+    return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+  }
+  if (!status.ok()) {
+    if (all_data_received_) {
+      return status;
+    }
+    // The data is most likely not complete yet.
+    next_descriptors_attempt_size_ = 2 * data_.size();
+    return OkStatus();
+  }
+  decoder_ = std::move(decoder);
+  geometry_ = std::move(geometry);
+  decoded_attributes_.assign(geometry_->num_attributes(), false);
+  return OkStatus();
+}
+
+Status IncrementalDecoder::DecodeAttributes() {
+  if (decoder_->has_attribute_chunks()) {
+    std::vector<int32_t> att_ids;
+    while (!decoder_->AllAttributeChunksDecoded()) {
+      // Decode the next chunk only when all its data was received.
+      DecoderBuffer chunk_buffer(buffer_);
+      uint64_t chunk_size;
+      if (!DecodeVarint(&chunk_size, &chunk_buffer) ||
+          chunk_size > static_cast<uint64_t>(chunk_buffer.remaining_size())) {
+        if (all_data_received_) {
+          return Status(Status::IO_ERROR, "Incomplete attribute data.");
+        }
+        return OkStatus();
+      }
+      DRACO_RETURN_IF_ERROR(decoder_->DecodeNextAttributeChunk(&att_ids))
+      for (const int32_t att_id : att_ids) {
+        MarkAttributeDecoded(att_id);
+      }
+    }
+  } else if (!all_data_received_) {
+    // Without chunks, the end of the attribute data is known only once all
+    // data was received.
+    return OkStatus();
+  }
+  DRACO_RETURN_IF_ERROR(decoder_->DecodeAttributeValues())
+  for (int i = 0; i < geometry_->num_attributes(); ++i) {
+    MarkAttributeDecoded(i);
+  }
+  finished_ = true;
+  return OkStatus();
+}
+
+void IncrementalDecoder::MarkAttributeDecoded(int att_id) {
+  if (att_id < 0 || att_id >= static_cast<int>(decoded_attributes_.size()) ||
+      decoded_attributes_[att_id]) {
+    return;
+  }
+  decoded_attributes_[att_id] = true;
+  ++num_decoded_attributes_;
+}
+
+}  // namespace draco
@@ -0,0 +1,112 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_INCREMENTAL_DECODER_H_
+#define DRACO_COMPRESSION_INCREMENTAL_DECODER_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/config/decoder_options.h"
+#include "draco/compression/point_cloud/point_cloud_decoder.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Decodes a point cloud or a mesh from data that is received in pieces, e.g.
+// over a network, so that the decoding overlaps with the transfer. The header,
+// metadata and attribute descriptors are decoded as soon as their data is
+// received. When the data was encoded with attribute chunks (see
+// EncoderBase::SetAttributeChunks()), each attribute is decoded as soon as its
+// chunk is received. Otherwise, all attributes are decoded in Finish().
+//
+// Usage:
+//
+//   IncrementalDecoder decoder;
+//   while (/* more data */) {
+//     DRACO_RETURN_IF_ERROR(decoder.AddData(data, size));
+//     // decoder.geometry() holds the attributes decoded so far.
+//   }
+//   DRACO_RETURN_IF_ERROR(decoder.Finish());
+//   std::unique_ptr<PointCloud> pc = decoder.ReleaseGeometry();
+class IncrementalDecoder {
+ public:
+  IncrementalDecoder();
+
+  // Appends |data_size| bytes of the encoded data and decodes all parts of the
+  // geometry whose data is complete. The data is copied.
+  Status AddData(const char *data, size_t data_size);
+
+  // Signals that all data was received and decodes the rest of the geometry.
+  // Returns an error when the data is incomplete or invalid.
+  Status Finish();
+
+  // Returns true when the attribute descriptors were decoded. From then on,
+  // geometry() contains all attributes and the number of points.
+  bool descriptors_decoded() const { return decoder_ != nullptr; }
+
+  // Returns true when all values of attribute |att_id| were decoded.
+  bool IsAttributeDecoded(int att_id) const;
+
+  int num_decoded_attributes() const { return num_decoded_attributes_; }
+
+  // Returns true when the whole geometry was decoded.
+  bool is_finished() const { return finished_; }
+
+  // Returns the geometry that is being decoded or nullptr when the attribute
+  // descriptors are not decoded yet. For meshes, the returned geometry can be
+  // down-casted to Mesh.
+  const PointCloud *geometry() const { return geometry_.get(); }
+
+  // Returns the decoded geometry once is_finished() is true. Otherwise returns
+  // nullptr.
+  std::unique_ptr<PointCloud> ReleaseGeometry();
+
+  // Returns the options used by the decoder. The options must be set before
+  // any data is added.
+  DecoderOptions *options() { return &options_; }
+
+ private:
+  // Decodes everything that can be decoded from the data received so far.
+  Status DecodeAvailableData();
+
+  // Decodes the header, metadata and attribute descriptors. Does nothing when
+  // their data is not complete yet.
+  Status DecodeDescriptors();
+
+  // Decodes the values of all attributes whose data is complete.
+  Status DecodeAttributes();
+
+  void MarkAttributeDecoded(int att_id);
+
+  // All data received so far.
+  std::vector<char> data_;
+  DecoderBuffer buffer_;
+  std::unique_ptr<PointCloudDecoder> decoder_;
+  std::unique_ptr<PointCloud> geometry_;
+  std::vector<bool> decoded_attributes_;
+  int num_decoded_attributes_;
+  // The descriptors are decoded from scratch on each attempt, so the next
+  // attempt is postponed until the amount of received data doubles.
+  size_t next_descriptors_attempt_size_;
+  bool all_data_received_;
+  bool finished_;
+  DecoderOptions options_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_INCREMENTAL_DECODER_H_
@@ -0,0 +1,270 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/incremental_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/compression/point_cloud/point_cloud_decoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/vector_d.h"
+#include "draco/mesh/triangle_soup_mesh_builder.h"
+#include "draco/point_cloud/point_cloud_builder.h"
+
+namespace draco {
+
+namespace {
+
+std::unique_ptr<PointCloud> CreateTestPointCloud() {
+  constexpr int kNumPoints = 500;
+  PointCloudBuilder builder;
+  builder.Start(kNumPoints);
+  const int pos_att_id =
+      builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+  const int dc_att_id =
+      builder.AddAttribute(GeometryAttribute::SH_DC, 3, DT_FLOAT32);
+  const int opacity_att_id =
+      builder.AddAttribute(GeometryAttribute::OPACITY, 1, DT_FLOAT32);
+  const int idx_att_id =
+      builder.AddAttribute(GeometryAttribute::SCALE_IDX, 1, DT_UINT16);
+  for (PointIndex i(0); i < kNumPoints; ++i) {
+    const float value = static_cast<float>(i.value());
+    builder.SetAttributeValueForPoint(
+        pos_att_id, i,
+        Vector3f(value, 0.5f * value, static_cast<float>(i.value() % 7))
+            .data());
+    builder.SetAttributeValueForPoint(
+        dc_att_id, i, Vector3f(0.1f * value, 1.f, -0.2f * value).data());
+    const float opacity = static_cast<float>(i.value() % 10) / 10.f;
+    builder.SetAttributeValueForPoint(opacity_att_id, i, &opacity);
+    const uint16_t idx = static_cast<uint16_t>((i.value() * 37) % 101);
+    builder.SetAttributeValueForPoint(idx_att_id, i, &idx);
+  }
+  return builder.Finalize(false);
+}
+
+std::unique_ptr<Mesh> CreateTestMesh() {
+  constexpr int kGridSize = 10;
+  TriangleSoupMeshBuilder builder;
+  builder.Start(2 * kGridSize * kGridSize);
+  const int pos_att_id =
+      builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+  const int tex_att_id =
+      builder.AddAttribute(GeometryAttribute::TEX_COORD, 2, DT_FLOAT32);
+  const auto pos = [](int x, int y) {
+    return Vector3f(static_cast<float>(x), static_cast<float>(y),
+                    static_cast<float>((x * y) % 3));
+  };
+  const auto tex = [](int x, int y) {
+    return Vector2f(static_cast<float>(x) / kGridSize,
+                    static_cast<float>(y) / kGridSize);
+  };
+  FaceIndex face(0);
+  for (int y = 0; y < kGridSize; ++y) {
+    for (int x = 0; x < kGridSize; ++x) {
+      builder.SetAttributeValuesForFace(pos_att_id, face, pos(x, y).data(),
+                                        pos(x + 1, y).data(),
+                                        pos(x, y + 1).data());
+      builder.SetAttributeValuesForFace(tex_att_id, face, tex(x, y).data(),
+                                        tex(x + 1, y).data(),
+                                        tex(x, y + 1).data());
+      ++face;
+      builder.SetAttributeValuesForFace(pos_att_id, face,
+                                        pos(x + 1, y).data(),
+                                        pos(x + 1, y + 1).data(),
+                                        pos(x, y + 1).data());
+      builder.SetAttributeValuesForFace(tex_att_id, face,
+                                        tex(x + 1, y).data(),
+                                        tex(x + 1, y + 1).data(),
+                                        tex(x, y + 1).data());
+      ++face;
+    }
+  }
+  return builder.Finalize();
+}
+
+// Checks that the attribute values of all points of |pc| and |expected_pc|
+// are equal.
+void ExpectEqualAttributes(const PointCloud &pc,
+                           const PointCloud &expected_pc) {
+  ASSERT_EQ(pc.num_points(), expected_pc.num_points());
+  ASSERT_EQ(pc.num_attributes(), expected_pc.num_attributes());
+  for (int a = 0; a < pc.num_attributes(); ++a) {
+    const PointAttribute *const att = pc.attribute(a);
+    const PointAttribute *const expected_att = expected_pc.attribute(a);
+    ASSERT_EQ(att->attribute_type(), expected_att->attribute_type());
+    ASSERT_EQ(att->byte_stride(), expected_att->byte_stride());
+    for (PointIndex i(0); i < pc.num_points(); ++i) {
+      ASSERT_EQ(memcmp(att->GetAddressOfMappedIndex(i),
+                       expected_att->GetAddressOfMappedIndex(i),
+                       att->byte_stride()),
+                0);
+    }
+  }
+}
+
+// Decodes |data| with the IncrementalDecoder by adding it in pieces of
+// |piece_size| bytes. Returns the number of attributes that were decoded
+// before all data was added in |num_early_attributes|.
+std::unique_ptr<PointCloud> DecodeInPieces(const EncoderBuffer &data,
+                                           size_t piece_size,
+                                           int *num_early_attributes) {
+  IncrementalDecoder decoder;
+  for (size_t offset = 0; offset < data.size(); offset += piece_size) {
+    const size_t size = std::min(piece_size, data.size() - offset);
+    if (!decoder.AddData(data.data() + offset, size).ok()) {
+      return nullptr;
+    }
+    if (offset + size < data.size()) {
+      *num_early_attributes = decoder.num_decoded_attributes();
+    }
+  }
+  if (!decoder.Finish().ok()) {
+    return nullptr;
+  }
+  return decoder.ReleaseGeometry();
+}
+
+std::unique_ptr<PointCloud> DecodeAtOnce(const EncoderBuffer &data) {
+  DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  Decoder decoder;
+  auto statusor = decoder.DecodePointCloudFromBuffer(&buffer);
+  if (!statusor.ok()) {
+    return nullptr;
+  }
+  return std::move(statusor).value();
+}
+
+}  // namespace
+
+class IncrementalDecoderTest : public ::testing::Test {};
+
+TEST_F(IncrementalDecoderTest, TestAttributeChunks) {
+  // Tests that attributes of point clouds encoded with attribute chunks are
+  // decoded before all data is received and that the decoded point cloud is
+  // the same as when it is decoded at once.
+  const std::unique_ptr<PointCloud> pc = CreateTestPointCloud();
+  ASSERT_NE(pc, nullptr);
+  for (const int speed : {10, 5, 0}) {
+    Encoder encoder;
+    encoder.SetAttributeQuantization(GeometryAttribute::POSITION, 12);
+    encoder.SetAttributeQuantization(GeometryAttribute::SH_DC, 10);
+    encoder.SetSpeedOptions(speed, speed);
+    encoder.SetAttributeChunks(true);
+    EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder.EncodePointCloudToBuffer(*pc, &buffer));
+
+    // Decoders without support for attribute chunks must reject the data.
+    DecoderBuffer header_buffer;
+    header_buffer.Init(buffer.data(), buffer.size());
+    DracoHeader header;
+    DRACO_ASSERT_OK(PointCloudDecoder::DecodeHeader(&header_buffer, &header));
+    ASSERT_EQ(header.version_minor,
+              kDracoAttributeChunksBitstreamVersionMinor);
+
+    const std::unique_ptr<PointCloud> expected_pc = DecodeAtOnce(buffer);
+    ASSERT_NE(expected_pc, nullptr);
+    for (const size_t piece_size : {1, 13, 256}) {
+      int num_early_attributes = 0;
+      const std::unique_ptr<PointCloud> decoded_pc =
+          DecodeInPieces(buffer, piece_size, &num_early_attributes);
+      ASSERT_NE(decoded_pc, nullptr);
+      ExpectEqualAttributes(*decoded_pc, *expected_pc);
+      if (speed == 10) {
+        // Each attribute has its own chunk so all but the last one are
+        // decoded before the last piece of data is added.
+        ASSERT_EQ(num_early_attributes, pc->num_attributes() - 1);
+      }
+    }
+  }
+}
+
+TEST_F(IncrementalDecoderTest, TestWithoutAttributeChunks) {
+  // Tests that data encoded without attribute chunks is decoded once all
+  // data is received.
+  const std::unique_ptr<PointCloud> pc = CreateTestPointCloud();
+  ASSERT_NE(pc, nullptr);
+  Encoder encoder;
+  encoder.SetAttributeQuantization(GeometryAttribute::POSITION, 12);
+  encoder.SetSpeedOptions(10, 10);
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodePointCloudToBuffer(*pc, &buffer));
+
+  const std::unique_ptr<PointCloud> expected_pc = DecodeAtOnce(buffer);
+  ASSERT_NE(expected_pc, nullptr);
+  int num_early_attributes = 0;
+  const std::unique_ptr<PointCloud> decoded_pc =
+      DecodeInPieces(buffer, 64, &num_early_attributes);
+  ASSERT_NE(decoded_pc, nullptr);
+  ASSERT_EQ(num_early_attributes, 0);
+  ExpectEqualAttributes(*decoded_pc, *expected_pc);
+}
+
+TEST_F(IncrementalDecoderTest, TestMesh) {
+  // Tests incremental decoding of meshes encoded with attribute chunks.
+  const std::unique_ptr<Mesh> mesh = CreateTestMesh();
+  ASSERT_NE(mesh, nullptr);
+  for (const int method :
+       {MESH_EDGEBREAKER_ENCODING, MESH_SEQUENTIAL_ENCODING}) {
+    Encoder encoder;
+    encoder.SetAttributeQuantization(GeometryAttribute::POSITION, 10);
+    encoder.SetAttributeQuantization(GeometryAttribute::TEX_COORD, 10);
+    encoder.SetEncodingMethod(method);
+    encoder.SetAttributeChunks(true);
+    EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &buffer));
+
+    const std::unique_ptr<PointCloud> expected_mesh = DecodeAtOnce(buffer);
+    ASSERT_NE(expected_mesh, nullptr);
+    int num_early_attributes = 0;
+    const std::unique_ptr<PointCloud> decoded_mesh =
+        DecodeInPieces(buffer, 32, &num_early_attributes);
+    ASSERT_NE(decoded_mesh, nullptr);
+    ExpectEqualAttributes(*decoded_mesh, *expected_mesh);
+    const Mesh &m = static_cast<const Mesh &>(*decoded_mesh);
+    const Mesh &expected_m = static_cast<const Mesh &>(*expected_mesh);
+    ASSERT_EQ(m.num_faces(), expected_m.num_faces());
+    for (FaceIndex f(0); f < m.num_faces(); ++f) {
+      ASSERT_EQ(m.face(f), expected_m.face(f));
+    }
+  }
+}
+
+TEST_F(IncrementalDecoderTest, TestIncompleteData) {
+  // Tests that Finish() fails when some data is missing.
+  const std::unique_ptr<PointCloud> pc = CreateTestPointCloud();
+  ASSERT_NE(pc, nullptr);
+  Encoder encoder;
+  encoder.SetSpeedOptions(10, 10);
+  encoder.SetAttributeChunks(true);
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodePointCloudToBuffer(*pc, &buffer));
+
+  IncrementalDecoder decoder;
+  DRACO_ASSERT_OK(decoder.AddData(buffer.data(), buffer.size() - 1));
+  ASSERT_TRUE(decoder.descriptors_decoded());
+  ASSERT_FALSE(decoder.is_finished());
+  ASSERT_EQ(decoder.ReleaseGeometry(), nullptr);
+  ASSERT_FALSE(decoder.Finish().ok());
+}
+
+}  // namespace draco
@@ -14,6 +14,8 @@
 //
 #include "draco/compression/mesh/mesh_decoder.h"
 
+#include "draco/core/trace.h"
+
 namespace draco {
 
 MeshDecoder::MeshDecoder() : mesh_(nullptr) {}
@@ -24,12 +26,23 @@ Status MeshDecoder::Decode(const DecoderOptions &options,
   return PointCloudDecoder::Decode(options, in_buffer, out_mesh);
 }
 
+Status MeshDecoder::DecodeAttributeDescriptors(const DecoderOptions &options,
+                                               DecoderBuffer *in_buffer,
+                                               Mesh *out_mesh) {
+  mesh_ = out_mesh;
+  return PointCloudDecoder::DecodeAttributeDescriptors(options, in_buffer,
+                                                       out_mesh);
+}
+
 bool MeshDecoder::DecodeGeometryData() {
   if (mesh_ == nullptr) {
     return false;
   }
-  if (!DecodeConnectivity()) {
-    return false;
+  {
+    DRACO_TRACE_SPAN("DecodeConnectivityData");
+    if (!DecodeConnectivity()) {
+      return false;
+    }
   }
   return PointCloudDecoder::DecodeGeometryData();
 }
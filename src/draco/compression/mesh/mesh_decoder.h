@@ -36,6 +36,11 @@ class MeshDecoder : public PointCloudDecoder {
   Status Decode(const DecoderOptions &options, DecoderBuffer *in_buffer,
                 Mesh *out_mesh);
 
+  // Decodes the mesh connectivity and the attribute descriptors, see
+  // PointCloudDecoder::DecodeAttributeDescriptors().
+  Status DecodeAttributeDescriptors(const DecoderOptions &options,
+                                    DecoderBuffer *in_buffer, Mesh *out_mesh);
+
   // Returns the base connectivity of the decoded mesh (or nullptr if it is not
   // initialized).
   virtual const CornerTable *GetCornerTable() const { return nullptr; }
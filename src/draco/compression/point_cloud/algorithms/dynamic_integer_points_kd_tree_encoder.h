@@ -106,7 +106,8 @@ class DynamicIntegerPointsKdTreeEncoder {
         num_remaining_bits_(dimension, 0),
         axes_(dimension, 0),
         base_stack_(32 * dimension + 1, VectorUint32(dimension, 0)),
-        levels_stack_(32 * dimension + 1, VectorUint32(dimension, 0)) {}
+        levels_stack_(32 * dimension + 1, VectorUint32(dimension, 0)),
+        decoding_order_(nullptr) {}
 
   // Encodes an integer point cloud given by [begin,end) into buffer.
   // |bit_length| gives the highest bit used for all coordinates.
@@ -123,6 +124,14 @@ class DynamicIntegerPointsKdTreeEncoder {
 
   const uint32_t dimension() const { return dimension_; }
 
+  // Sets an optional vector that is filled by EncodePoints() with the order in
+  // which the decoder outputs the points. The entries are positions within the
+  // range [begin,end) after the encoding, which reorders the range. Can be
+  // used to encode other data of the points in the decoded order.
+  void set_decoding_order(std::vector<uint32_t> *decoding_order) {
+    decoding_order_ = decoding_order;
+  }
+
  private:
   template <class RandomAccessIteratorT>
   uint32_t GetAndEncodeAxis(RandomAccessIteratorT begin,
@@ -149,6 +158,17 @@ class DynamicIntegerPointsKdTreeEncoder {
     numbers_encoder_.EncodeLeastSignificantBits32(nbits, value);
   }
 
+  // Appends |num_points| consecutive positions starting at |position| to the
+  // decoding order when it is requested.
+  void AppendToDecodingOrder(size_t position, uint32_t num_points) {
+    if (decoding_order_ == nullptr) {
+      return;
+    }
+    for (uint32_t i = 0; i < num_points; ++i) {
+      decoding_order_->push_back(static_cast<uint32_t>(position + i));
+    }
+  }
+
   template <class RandomAccessIteratorT>
   struct EncodingStatus {
     EncodingStatus(RandomAccessIteratorT begin_, RandomAccessIteratorT end_,
@@ -179,6 +199,7 @@ class DynamicIntegerPointsKdTreeEncoder {
   VectorUint32 axes_;
   std::vector<VectorUint32> base_stack_;
   std::vector<VectorUint32> levels_stack_;
+  std::vector<uint32_t> *decoding_order_;
 };
 
 template <int compression_level_t>
@@ -191,6 +212,10 @@ bool DynamicIntegerPointsKdTreeEncoder<compression_level_t>::EncodePoints(
 
   buffer->Encode(bit_length_);
   buffer->Encode(num_points_);
+  if (decoding_order_) {
+    decoding_order_->clear();
+    decoding_order_->reserve(num_points_);
+  }
   if (num_points_ == 0) {
     return true;
   }
@@ -273,6 +298,7 @@ template <class RandomAccessIteratorT>
 void DynamicIntegerPointsKdTreeEncoder<compression_level_t>::EncodeInternal(
     RandomAccessIteratorT begin, RandomAccessIteratorT end) {
   typedef EncodingStatus<RandomAccessIteratorT> Status;
+  const RandomAccessIteratorT first = begin;
 
   base_stack_[0] = VectorUint32(dimension_, 0);
   levels_stack_[0] = VectorUint32(dimension_, 0);
@@ -299,6 +325,8 @@ void DynamicIntegerPointsKdTreeEncoder<compression_level_t>::EncodeInternal(
 
     // If this happens all axis are subdivided to the end.
     if ((bit_length_ - level) == 0) {
+      // The decoder outputs all points of the leaf at this point.
+      AppendToDecodingOrder(begin - first, num_remaining_points);
       continue;
     }
 
@@ -321,6 +349,7 @@ void DynamicIntegerPointsKdTreeEncoder<compression_level_t>::EncodeInternal(
           }
         }
       }
+      AppendToDecodingOrder(begin - first, num_remaining_points);
       continue;
     }
 
@@ -14,6 +14,11 @@
 //
 #include "draco/compression/point_cloud/point_cloud_decoder.h"
 
+#include <algorithm>
+
+#include "draco/core/thread_pool.h"
+#include "draco/core/trace.h"
+#include "draco/core/varint_decoding.h"
 #include "draco/metadata/metadata_decoder.h"
 
 namespace draco {
@@ -23,7 +28,12 @@ PointCloudDecoder::PointCloudDecoder()
       buffer_(nullptr),
       version_major_(0),
       version_minor_(0),
-      options_(nullptr) {}
+      header_flags_(0),
+      options_(nullptr),
+      num_decoding_threads_(1),
+      num_attributes_decoder_threads_(1),
+      chunk_att_decoder_id_(0),
+      chunk_id_(0) {}
 
 Status PointCloudDecoder::DecodeHeader(DecoderBuffer *buffer,
                                        DracoHeader *out_header) {
@@ -66,11 +76,66 @@ Status PointCloudDecoder::DecodeMetadata() {
 Status PointCloudDecoder::Decode(const DecoderOptions &options,
                                  DecoderBuffer *in_buffer,
                                  PointCloud *out_point_cloud) {
+  DRACO_RETURN_IF_ERROR(
+      DecodeAttributeDescriptors(options, in_buffer, out_point_cloud))
+  return DecodeAttributeValues();
+}
+
+Status PointCloudDecoder::DecodeAttributeValues() {
+  if (!DecodePointAttributes()) {
+    return Status(Status::DRACO_ERROR, "Failed to decode point attributes.");
+  }
+  return OkStatus();
+}
+
+Status PointCloudDecoder::DecodeNextAttributeChunk(
+    std::vector<int32_t> *out_att_ids) {
+  if (!has_attribute_chunks() || AllAttributeChunksDecoded()) {
+    return Status(Status::DRACO_ERROR, "No attribute chunk to decode.");
+  }
+  uint64_t chunk_size;
+  if (!DecodeVarint(&chunk_size, buffer_) ||
+      chunk_size > static_cast<uint64_t>(buffer_->remaining_size())) {
+    return Status(Status::IO_ERROR, "Failed to decode attribute chunk size.");
+  }
+  const int64_t chunk_start = buffer_->decoded_size();
+  AttributesDecoderInterface *const att_dec =
+      attributes_decoders_[chunk_att_decoder_id_].get();
+  if (!att_dec->DecodeChunk(chunk_id_, buffer_) ||
+      buffer_->decoded_size() - chunk_start !=
+          static_cast<int64_t>(chunk_size)) {
+    return Status(Status::DRACO_ERROR, "Failed to decode attribute chunk.");
+  }
+  const int num_chunks = att_dec->GetNumChunks();
+  if (out_att_ids != nullptr) {
+    out_att_ids->clear();
+    if (num_chunks == 1) {
+      for (int i = 0; i < att_dec->GetNumAttributes(); ++i) {
+        out_att_ids->push_back(att_dec->GetAttributeId(i));
+      }
+    } else {
+      out_att_ids->push_back(att_dec->GetAttributeId(chunk_id_));
+    }
+  }
+  if (++chunk_id_ == num_chunks) {
+    chunk_id_ = 0;
+    ++chunk_att_decoder_id_;
+  }
+  return OkStatus();
+}
+
+Status PointCloudDecoder::DecodeAttributeDescriptors(
+    const DecoderOptions &options, DecoderBuffer *in_buffer,
+    PointCloud *out_point_cloud) {
   options_ = &options;
   buffer_ = in_buffer;
   point_cloud_ = out_point_cloud;
+  DRACO_TRACE_SPAN("PointCloudDecoder::Decode");
   DracoHeader header;
-  DRACO_RETURN_IF_ERROR(DecodeHeader(buffer_, &header))
+  {
+    DRACO_TRACE_SPAN("DecodeHeader");
+    DRACO_RETURN_IF_ERROR(DecodeHeader(buffer_, &header))
+  }
   // Sanity check that we are really using the right decoder (mostly for cases
   // where the Decode method was called manually outside of our main API.
   if (header.encoder_type != GetGeometryType()) {
@@ -81,13 +146,17 @@ Status PointCloudDecoder::Decode(const DecoderOptions &options,
   // don't expose the decoding method id.
   version_major_ = header.version_major;
   version_minor_ = header.version_minor;
+  header_flags_ = header.flags;
 
   const uint8_t max_supported_major_version =
       header.encoder_type == POINT_CLOUD ? kDracoPointCloudBitstreamVersionMajor
                                          : kDracoMeshBitstreamVersionMajor;
-  const uint8_t max_supported_minor_version =
+  const uint8_t min_supported_minor_version =
       header.encoder_type == POINT_CLOUD ? kDracoPointCloudBitstreamVersionMinor
                                          : kDracoMeshBitstreamVersionMinor;
+  // Streams that use newer features are written with a higher minor version.
+  const uint8_t max_supported_minor_version =
+      kDracoMaxSupportedBitstreamVersionMinor;
 
   // Check for version compatibility.
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
@@ -102,7 +171,8 @@ Status PointCloudDecoder::Decode(const DecoderOptions &options,
   if (version_major_ != max_supported_major_version) {
     return Status(Status::UNKNOWN_VERSION, "Unsupported major version.");
   }
-  if (version_minor_ != max_supported_minor_version) {
+  if (version_minor_ < min_supported_minor_version ||
+      version_minor_ > max_supported_minor_version) {
     return Status(Status::UNKNOWN_VERSION, "Unsupported minor version.");
   }
 #endif
@@ -111,21 +181,27 @@ Status PointCloudDecoder::Decode(const DecoderOptions &options,
 
   if (bitstream_version() >= DRACO_BITSTREAM_VERSION(1, 3) &&
       (header.flags & METADATA_FLAG_MASK)) {
+    DRACO_TRACE_SPAN("DecodeMetadata");
     DRACO_RETURN_IF_ERROR(DecodeMetadata())
   }
   if (!InitializeDecoder()) {
     return Status(Status::DRACO_ERROR, "Failed to initialize the decoder.");
   }
-  if (!DecodeGeometryData()) {
-    return Status(Status::DRACO_ERROR, "Failed to decode geometry data.");
+  {
+    DRACO_TRACE_SPAN("DecodeGeometryData");
+    if (!DecodeGeometryData()) {
+      return Status(Status::DRACO_ERROR, "Failed to decode geometry data.");
+    }
   }
-  if (!DecodePointAttributes()) {
-    return Status(Status::DRACO_ERROR, "Failed to decode point attributes.");
+  if (!DecodeAttributesDecodersData()) {
+    return Status(Status::DRACO_ERROR,
+                  "Failed to decode attribute descriptors.");
   }
   return OkStatus();
 }
 
-bool PointCloudDecoder::DecodePointAttributes() {
+bool PointCloudDecoder::DecodeAttributesDecodersData() {
+  DRACO_TRACE_SPAN("DecodeAttributesDecodersData");
   uint8_t num_attributes_decoders;
   if (!buffer_->Decode(&num_attributes_decoders)) {
     return false;
@@ -164,7 +240,11 @@ bool PointCloudDecoder::DecodePointAttributes() {
       attribute_to_decoder_map_[att_id] = i;
     }
   }
+  return true;
+}
 
+bool PointCloudDecoder::DecodePointAttributes() {
+  DRACO_TRACE_SPAN("DecodePointAttributes");
   // Decode the actual attributes using the created attribute decoders.
   if (!DecodeAllAttributes()) {
     return false;
@@ -177,14 +257,109 @@ bool PointCloudDecoder::DecodePointAttributes() {
 }
 
 bool PointCloudDecoder::DecodeAllAttributes() {
+  if (has_attribute_chunks()) {
+    // The chunks are decoded one after another without deferred
+    // reconstruction. Chunks decoded by DecodeNextAttributeChunk() before are
+    // skipped.
+    while (!AllAttributeChunksDecoded()) {
+      if (!DecodeNextAttributeChunk(nullptr).ok()) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Older bitstreams predict attributes from the final values of their parent
+  // attributes, so the reconstruction can't be postponed.
+  num_decoding_threads_ = 1;
+  if (options_ != nullptr &&
+      bitstream_version() >= DRACO_BITSTREAM_VERSION(2, 0)) {
+    num_decoding_threads_ =
+        std::max(options_->GetGlobalInt("num_decoding_threads", 1), 1);
+  }
+  num_attributes_decoder_threads_ = num_decoding_threads_;
   for (auto &att_dec : attributes_decoders_) {
     if (!att_dec->DecodeAttributes(buffer_)) {
       return false;
     }
   }
+  if (!defer_attribute_reconstruction()) {
+    return true;
+  }
+
+  // The parent attributes are always decoded before their children. Assign
+  // each decoder a level that is larger than the levels of all decoders of its
+  // parent attributes. Decoders of the same level are independent.
+  const int num_decoders = static_cast<int>(attributes_decoders_.size());
+  std::vector<int> decoder_levels(num_decoders, 0);
+  int num_levels = 0;
+  for (int i = 0; i < num_decoders; ++i) {
+    for (const int32_t parent_att_id :
+         attributes_decoders_[i]->GetParentAttributeIds()) {
+      if (parent_att_id < 0 ||
+          parent_att_id >= static_cast<int>(attribute_to_decoder_map_.size())) {
+        return false;
+      }
+      const int parent_decoder_id = attribute_to_decoder_map_[parent_att_id];
+      if (parent_decoder_id > i) {
+        return false;
+      }
+      if (parent_decoder_id != i) {
+        decoder_levels[i] =
+            std::max(decoder_levels[i], decoder_levels[parent_decoder_id] + 1);
+      }
+    }
+    num_levels = std::max(num_levels, decoder_levels[i] + 1);
+  }
+
+  for (int level = 0; level < num_levels; ++level) {
+    std::vector<int> level_decoder_ids;
+    for (int i = 0; i < num_decoders; ++i) {
+      if (decoder_levels[i] == level) {
+        level_decoder_ids.push_back(i);
+      }
+    }
+    // Threads are given to the attributes decoder when it is the only one on
+    // this level.
+    const int num_level_decoders = static_cast<int>(level_decoder_ids.size());
+    num_attributes_decoder_threads_ =
+        num_level_decoders == 1 ? num_decoding_threads_ : 1;
+    std::vector<uint8_t> reconstructed(num_level_decoders, 0);
+    ParallelFor(num_level_decoders, num_decoding_threads_, [&](int i) {
+      reconstructed[i] =
+          attributes_decoders_[level_decoder_ids[i]]->ReconstructAttributes();
+    });
+    for (int i = 0; i < num_level_decoders; ++i) {
+      if (!reconstructed[i]) {
+        return false;
+      }
+    }
+  }
+  num_attributes_decoder_threads_ = num_decoding_threads_;
   return true;
 }
 
+bool PointCloudDecoder::GetSharedQuantizationTransform(
+    const PointAttribute &attribute,
+    AttributeQuantizationTransform *transform) const {
+  const GeometryAttribute::Type att_type = attribute.attribute_type();
+  if (!options_->IsAttributeOptionSet(att_type, "quantization_origin") ||
+      !options_->IsAttributeOptionSet(att_type, "quantization_range")) {
+    return false;  // The shared grid was not provided.
+  }
+  const int num_components = attribute.num_components();
+  std::vector<float> origin(num_components);
+  if (!options_->GetAttributeVector(att_type, "quantization_origin",
+                                    num_components, &origin[0])) {
+    return false;
+  }
+  const int quantization_bits =
+      options_->GetAttributeInt(att_type, "quantization_bits", -1);
+  const float range =
+      options_->GetAttributeFloat(att_type, "quantization_range", 1.f);
+  return transform->SetParameters(quantization_bits, origin.data(),
+                                  num_components, range);
+}
+
 const PointAttribute *PointCloudDecoder::GetPortableAttribute(
     int32_t parent_att_id) {
   if (parent_att_id < 0 || parent_att_id >= point_cloud_->num_attributes()) {
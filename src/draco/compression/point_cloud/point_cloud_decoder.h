@@ -15,6 +15,7 @@
 #ifndef DRACO_COMPRESSION_POINT_CLOUD_POINT_CLOUD_DECODER_H_
 #define DRACO_COMPRESSION_POINT_CLOUD_POINT_CLOUD_DECODER_H_
 
+#include "draco/attributes/attribute_quantization_transform.h"
 #include "draco/compression/attributes/attributes_decoder_interface.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/decoder_options.h"
@@ -40,6 +41,38 @@ class PointCloudDecoder {
   Status Decode(const DecoderOptions &options, DecoderBuffer *in_buffer,
                 PointCloud *out_point_cloud);
 
+  // Decodes the header, metadata and geometry data followed by the
+  // descriptors of all attributes, and stops before any attribute values are
+  // decoded. The attributes are added to |out_point_cloud| without values and
+  // the number of points is set. Used to inspect encoded data without the cost
+  // of decoding it, see Decoder::Probe().
+  Status DecodeAttributeDescriptors(const DecoderOptions &options,
+                                    DecoderBuffer *in_buffer,
+                                    PointCloud *out_point_cloud);
+
+  // Decodes the values of all attributes that were not decoded yet. Must be
+  // called after DecodeAttributeDescriptors().
+  Status DecodeAttributeValues();
+
+  // Returns true when the attribute data is split into chunks prefixed by
+  // their size, see ATTRIBUTE_CHUNKS_FLAG_MASK.
+  bool has_attribute_chunks() const {
+    return (header_flags_ & ATTRIBUTE_CHUNKS_FLAG_MASK) != 0;
+  }
+
+  // Decodes the next chunk of the attribute data. It allows decoding of the
+  // attributes one chunk at a time after DecodeAttributeDescriptors(), see
+  // IncrementalDecoder. The ids of the decoded attributes are stored in
+  // |out_att_ids| unless it is nullptr. Can be used only when
+  // has_attribute_chunks() is true.
+  Status DecodeNextAttributeChunk(std::vector<int32_t> *out_att_ids);
+
+  // Returns true when all chunks of the attribute data were decoded.
+  bool AllAttributeChunksDecoded() const {
+    return chunk_att_decoder_id_ >=
+           static_cast<int>(attributes_decoders_.size());
+  }
+
   bool SetAttributesDecoder(
       int att_decoder_id, std::unique_ptr<AttributesDecoderInterface> decoder) {
     if (att_decoder_id < 0) {
@@ -64,6 +97,17 @@ class PointCloudDecoder {
     return DRACO_BITSTREAM_VERSION(version_major_, version_minor_);
   }
 
+  // Returns the |flags| field of the decoded Draco header.
+  uint16_t header_flags() const { return header_flags_; }
+
+  // Initializes |transform| with the quantization grid of |attribute| that is
+  // shared across a sequence of frames. The grid parameters are not part of
+  // the bitstream and they must be provided through the decoder options, see
+  // SequenceHeader::ApplyToDecoderOptions().
+  bool GetSharedQuantizationTransform(
+      const PointAttribute &attribute,
+      AttributeQuantizationTransform *transform) const;
+
   const AttributesDecoderInterface *attributes_decoder(int dec_id) {
     return attributes_decoders_[dec_id].get();
   }
@@ -79,6 +123,21 @@ class PointCloudDecoder {
   DecoderBuffer *buffer() { return buffer_; }
   const DecoderOptions *options() const { return options_; }
 
+  // Returns true when the attribute decoders should only read their data from
+  // the input buffer in DecodeAttributes() and postpone the remaining work
+  // (prediction and attribute transforms) to ReconstructAttributes(). This is
+  // enabled by the "num_decoding_threads" option.
+  bool defer_attribute_reconstruction() const {
+    return num_decoding_threads_ > 1;
+  }
+
+  // Returns the maximum number of threads that can be used by an attributes
+  // decoder in ReconstructAttributes(). It is set to one when multiple
+  // attribute decoders are reconstructed concurrently.
+  int num_attributes_decoder_threads() const {
+    return num_attributes_decoder_threads_;
+  }
+
  protected:
   // Can be implemented by derived classes to perform any custom initialization
   // of the decoder. Called in the Decode() method.
@@ -87,14 +146,24 @@ class PointCloudDecoder {
   // Creates an attribute decoder.
   virtual bool CreateAttributesDecoder(int32_t att_decoder_id) = 0;
   virtual bool DecodeGeometryData() { return true; }
+  // Decodes values of all attributes whose decoders were created by
+  // DecodeAttributeDescriptors().
   virtual bool DecodePointAttributes();
 
+  // Decodes data of all attributes. When the "num_decoding_threads" option is
+  // larger than one, the data of all attribute decoders is read first and the
+  // attributes are then reconstructed concurrently in the order given by
+  // their dependencies.
   virtual bool DecodeAllAttributes();
   virtual bool OnAttributesDecoded() { return true; }
 
   Status DecodeMetadata();
 
  private:
+  // Creates and initializes all attribute decoders and decodes their data,
+  // i.e. the attribute descriptors.
+  bool DecodeAttributesDecodersData();
+
   // Point cloud that is being filled in by the decoder.
   PointCloud *point_cloud_;
 
@@ -110,7 +179,17 @@ class PointCloudDecoder {
   uint8_t version_major_;
   uint8_t version_minor_;
 
+  // Flags stored in the Draco header.
+  uint16_t header_flags_;
+
   const DecoderOptions *options_;
+
+  int num_decoding_threads_;
+  int num_attributes_decoder_threads_;
+
+  // Attributes decoder and chunk of the next attribute chunk to be decoded.
+  int chunk_att_decoder_id_;
+  int chunk_id_;
 };
 
 }  // namespace draco
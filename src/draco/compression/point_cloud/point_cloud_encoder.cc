@@ -14,12 +14,20 @@
 //
 #include "draco/compression/point_cloud/point_cloud_encoder.h"
 
+#include <algorithm>
+
+#include "draco/core/thread_pool.h"
+#include "draco/core/varint_encoding.h"
 #include "draco/metadata/metadata_encoder.h"
 
 namespace draco {
 
 PointCloudEncoder::PointCloudEncoder()
-    : point_cloud_(nullptr), buffer_(nullptr), num_encoded_points_(0) {}
+    : point_cloud_(nullptr),
+      buffer_(nullptr),
+      num_encoded_points_(0),
+      encoding_stats_(nullptr),
+      num_attributes_encoder_threads_(1) {}
 
 void PointCloudEncoder::SetPointCloud(const PointCloud &pc) {
   point_cloud_ = &pc;
@@ -38,6 +46,13 @@ Status PointCloudEncoder::Encode(const EncoderOptions &options,
   if (!point_cloud_) {
     return Status(Status::DRACO_ERROR, "Invalid input geometry.");
   }
+  const EncodingStatsTimer timer(encoding_stats_ != nullptr);
+  const int64_t start_size = buffer_->size();
+  if (encoding_stats_) {
+    encoding_stats_->Clear();
+    encoding_stats_->geometry_type = GetGeometryType();
+    encoding_stats_->encoding_method = GetEncodingMethod();
+  }
   DRACO_RETURN_IF_ERROR(EncodeHeader())
   DRACO_RETURN_IF_ERROR(EncodeMetadata())
   if (!InitializeEncoder()) {
@@ -46,10 +61,21 @@ Status PointCloudEncoder::Encode(const EncoderOptions &options,
   if (!EncodeEncoderData()) {
     return Status(Status::DRACO_ERROR, "Failed to encode internal data.");
   }
+  const int64_t geometry_start_size = buffer_->size();
+  const EncodingStatsTimer geometry_timer(encoding_stats_ != nullptr);
   DRACO_RETURN_IF_ERROR(EncodeGeometryData());
+  if (encoding_stats_) {
+    encoding_stats_->header_size = geometry_start_size - start_size;
+    encoding_stats_->geometry_size = buffer_->size() - geometry_start_size;
+    encoding_stats_->geometry_time = geometry_timer.Elapsed();
+  }
   if (!EncodePointAttributes()) {
     return Status(Status::DRACO_ERROR, "Failed to encode point attributes.");
   }
+  if (encoding_stats_) {
+    encoding_stats_->total_size = buffer_->size() - start_size;
+    encoding_stats_->total_time = timer.Elapsed();
+  }
   if (options.GetGlobalBool("store_number_of_encoded_points", false)) {
     ComputeNumberOfEncodedPoints();
   }
@@ -69,6 +95,28 @@ Status PointCloudEncoder::EncodeHeader() {
   version_minor = encoder_type == POINT_CLOUD
                       ? kDracoPointCloudBitstreamVersionMinor
                       : kDracoMeshBitstreamVersionMinor;
+  // Reserved for flags.
+  uint16_t flags = 0;
+  // First bit of |flags| is reserved for metadata.
+  if (point_cloud_->GetMetadata()) {
+    flags |= METADATA_FLAG_MASK;
+  }
+  if (options_->GetGlobalBool("shared_quantization_grids", false)) {
+    flags |= SHARED_QUANTIZATION_FLAG_MASK;
+    version_minor =
+        std::max(version_minor, kDracoSharedQuantizationBitstreamVersionMinor);
+  }
+  if (options_->GetGlobalBool("vq_index_coding", false)) {
+    flags |= VQ_INDEX_CODING_FLAG_MASK;
+    // Make decoders that ignore the flag fail with an unknown version.
+    version_minor =
+        std::max(version_minor, kDracoVqIndexCodingBitstreamVersionMinor);
+  }
+  if (options_->GetGlobalBool("attribute_chunks", false)) {
+    flags |= ATTRIBUTE_CHUNKS_FLAG_MASK;
+    version_minor =
+        std::max(version_minor, kDracoAttributeChunksBitstreamVersionMinor);
+  }
 
   buffer_->Encode(version_major);
   buffer_->Encode(version_minor);
@@ -76,12 +124,6 @@ Status PointCloudEncoder::EncodeHeader() {
   buffer_->Encode(encoder_type);
   // Unique identifier for the selected encoding method (edgebreaker, etc...).
   buffer_->Encode(GetEncodingMethod());
-  // Reserved for flags.
-  uint16_t flags = 0;
-  // First bit of |flags| is reserved for metadata.
-  if (point_cloud_->GetMetadata()) {
-    flags |= METADATA_FLAG_MASK;
-  }
   buffer_->Encode(flags);
   return OkStatus();
 }
@@ -119,6 +161,27 @@ bool PointCloudEncoder::EncodePointAttributes() {
     return false;
   }
 
+  if (encoding_stats_) {
+    // Create stats of all attributes in the order in which they are encoded.
+    // The entries are filled by the attribute encoders.
+    for (int att_encoder_id : attributes_encoder_ids_order_) {
+      const AttributesEncoder *const att_enc =
+          attributes_encoders_[att_encoder_id].get();
+      for (uint32_t i = 0; i < att_enc->num_attributes(); ++i) {
+        const int att_id = att_enc->GetAttributeId(i);
+        const PointAttribute *const att = point_cloud_->attribute(att_id);
+        AttributeEncodingStats att_stats;
+        att_stats.attribute_id = att_id;
+        att_stats.attribute_type = att->attribute_type();
+        att_stats.data_type = att->data_type();
+        att_stats.num_components = att->num_components();
+        att_stats.raw_size =
+            static_cast<int64_t>(att->size()) * att->byte_stride();
+        encoding_stats_->attributes.push_back(att_stats);
+      }
+    }
+  }
+
   // Encode any data that is necessary to create the corresponding attribute
   // decoder.
   for (int att_encoder_id : attributes_encoder_ids_order_) {
@@ -159,14 +222,105 @@ bool PointCloudEncoder::GenerateAttributesEncoders() {
 }
 
 bool PointCloudEncoder::EncodeAllAttributes() {
+  const int num_threads = options_->GetGlobalInt("num_encoding_threads", 1);
+  num_attributes_encoder_threads_ = num_threads;
+  if (options_->GetGlobalBool("attribute_chunks", false)) {
+    return EncodeAttributeChunks();
+  }
+  if (num_threads < 2 || attributes_encoders_.size() < 2) {
+    for (int att_encoder_id : attributes_encoder_ids_order_) {
+      if (!attributes_encoders_[att_encoder_id]->EncodeAttributes(buffer_)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Attribute encoders depend on each other only through the portable
+  // attributes of their parent attributes. Assign each encoder a level that is
+  // larger than the levels of all its parent encoders. Encoders of the same
+  // level are independent. |attributes_encoder_ids_order_| already respects
+  // the dependencies so the levels can be computed in a single pass.
+  std::vector<int> encoder_levels(attributes_encoders_.size(), 0);
+  int num_levels = 0;
+  for (int att_encoder_id : attributes_encoder_ids_order_) {
+    const AttributesEncoder *const att_enc =
+        attributes_encoders_[att_encoder_id].get();
+    int level = 0;
+    for (uint32_t i = 0; i < att_enc->num_attributes(); ++i) {
+      const int32_t att_id = att_enc->GetAttributeId(i);
+      for (int p = 0; p < att_enc->NumParentAttributes(att_id); ++p) {
+        const int32_t parent_encoder_id =
+            attribute_to_encoder_map_[att_enc->GetParentAttributeId(att_id, p)];
+        if (parent_encoder_id != att_encoder_id) {
+          level = std::max(level, encoder_levels[parent_encoder_id] + 1);
+        }
+      }
+    }
+    encoder_levels[att_encoder_id] = level;
+    num_levels = std::max(num_levels, level + 1);
+  }
+
+  std::vector<std::unique_ptr<EncoderBuffer>> encoder_buffers(
+      attributes_encoders_.size());
+  for (int level = 0; level < num_levels; ++level) {
+    std::vector<int> level_encoder_ids;
+    for (int att_encoder_id : attributes_encoder_ids_order_) {
+      if (encoder_levels[att_encoder_id] == level) {
+        level_encoder_ids.push_back(att_encoder_id);
+      }
+    }
+    // Threads are given to the attributes encoder when it is the only one on
+    // this level.
+    const int num_level_encoders = static_cast<int>(level_encoder_ids.size());
+    num_attributes_encoder_threads_ = num_level_encoders == 1 ? num_threads : 1;
+    std::vector<uint8_t> encoded(num_level_encoders, 0);
+    ParallelFor(num_level_encoders, num_threads, [&](int i) {
+      const int att_encoder_id = level_encoder_ids[i];
+      encoder_buffers[att_encoder_id].reset(new EncoderBuffer());
+      encoded[i] = attributes_encoders_[att_encoder_id]->EncodeAttributes(
+          encoder_buffers[att_encoder_id].get());
+    });
+    for (int i = 0; i < num_level_encoders; ++i) {
+      if (!encoded[i]) {
+        return false;
+      }
+    }
+  }
+  num_attributes_encoder_threads_ = num_threads;
+
+  // Append the data in the original order so that the bitstream does not
+  // depend on the number of threads.
   for (int att_encoder_id : attributes_encoder_ids_order_) {
-    if (!attributes_encoders_[att_encoder_id]->EncodeAttributes(buffer_)) {
+    const EncoderBuffer &att_buffer = *encoder_buffers[att_encoder_id];
+    if (!buffer_->Encode(att_buffer.data(), att_buffer.size())) {
       return false;
     }
   }
   return true;
 }
 
+bool PointCloudEncoder::EncodeAttributeChunks() {
+  // The chunks are encoded one after another. Threads are used only within
+  // the attributes encoders.
+  EncoderBuffer chunk_buffer;
+  for (int att_encoder_id : attributes_encoder_ids_order_) {
+    AttributesEncoder *const att_enc =
+        attributes_encoders_[att_encoder_id].get();
+    for (int c = 0; c < att_enc->NumChunks(); ++c) {
+      chunk_buffer.Clear();
+      if (!att_enc->EncodeChunk(c, &chunk_buffer)) {
+        return false;
+      }
+      EncodeVarint<uint64_t>(chunk_buffer.size(), buffer_);
+      if (!buffer_->Encode(chunk_buffer.data(), chunk_buffer.size())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 bool PointCloudEncoder::MarkParentAttribute(int32_t parent_att_id) {
   if (parent_att_id < 0 || parent_att_id >= point_cloud_->num_attributes()) {
     return false;
@@ -18,6 +18,7 @@
 #include "draco/compression/attributes/attributes_encoder.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/encoder_options.h"
+#include "draco/compression/encoding_stats.h"
 #include "draco/core/encoder_buffer.h"
 #include "draco/core/status.h"
 #include "draco/point_cloud/point_cloud.h"
@@ -49,6 +50,15 @@ class PointCloudEncoder {
   // in the provided EncoderOptions.
   size_t num_encoded_points() const { return num_encoded_points_; }
 
+  // Sets an optional object that is filled with sizes and timings of the
+  // individual encoding stages during the following Encode() calls. Pass
+  // nullptr to disable the collection.
+  void SetEncodingStats(EncodingStats *stats) { encoding_stats_ = stats; }
+
+  // Returns the stats object used by the encoder or nullptr when the stats are
+  // not collected.
+  EncodingStats *encoding_stats() const { return encoding_stats_; }
+
   int num_attributes_encoders() const {
     return static_cast<int>(attributes_encoders_.size());
   }
@@ -76,6 +86,13 @@ class PointCloudEncoder {
   const EncoderOptions *options() const { return options_; }
   const PointCloud *point_cloud() const { return point_cloud_; }
 
+  // Returns the maximum number of threads that can be used by an attributes
+  // encoder to encode its own attributes. It is set to one when multiple
+  // attribute encoders are encoded concurrently.
+  int num_attributes_encoder_threads() const {
+    return num_attributes_encoder_threads_;
+  }
+
  protected:
   // Can be implemented by derived classes to perform any custom initialization
   // of the encoder. Called in the Encode() method.
@@ -112,9 +129,16 @@ class PointCloudEncoder {
     return true;
   }
 
-  // Encodes all the attribute data using the created attribute encoders.
+  // Encodes all the attribute data using the created attribute encoders. When
+  // the "num_encoding_threads" option is larger than one, attribute encoders
+  // whose parent attributes are already encoded are encoded concurrently into
+  // separate buffers that are appended to |buffer_| in the encoding order.
   virtual bool EncodeAllAttributes();
 
+  // Encodes the data of all attributes encoders in chunks prefixed by their
+  // size, see ATTRIBUTE_CHUNKS_FLAG_MASK.
+  bool EncodeAttributeChunks();
+
   // Computes and sets the num_encoded_points_ for the encoder.
   virtual void ComputeNumberOfEncodedPoints() = 0;
 
@@ -151,6 +175,10 @@ class PointCloudEncoder {
   const EncoderOptions *options_;
 
   size_t num_encoded_points_;
+
+  EncodingStats *encoding_stats_;
+
+  int num_attributes_encoder_threads_;
 };
 
 }  // namespace draco
@@ -0,0 +1,275 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/rate_control.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "draco/compression/entropy/symbol_encoding.h"
+#include "draco/core/bit_utils.h"
+#include "draco/core/quantization_utils.h"
+#include "draco/core/thread_pool.h"
+
+namespace draco {
+
+namespace {
+// Number of consecutive points sampled together when estimating attribute
+// sizes. Consecutive points are needed to capture the correlation of values
+// exploited by the delta coding.
+constexpr int kSampleBlockSize = 256;
+}  // namespace
+
+RateControlOptions::RateControlOptions()
+    : target_size(0),
+      max_error(0.f),
+      min_quantization_bits(4),
+      max_quantization_bits(16),
+      num_threads(ThreadPool::GetDefaultNumThreads()),
+      max_num_sample_points(100000),
+      max_num_refinements(3),
+      max_num_kd_tree_refinements(8) {}
+
+RateController::RateController(const PointCloud &pc,
+                               const RateControlOptions &options)
+    : point_cloud_(&pc), options_(options) {}
+
+Status RateController::Init(const EncoderOptions &encoder_options) {
+  if (options_.min_quantization_bits < 1 ||
+      options_.max_quantization_bits > 30 ||
+      options_.min_quantization_bits > options_.max_quantization_bits) {
+    return ErrorStatus("Invalid range of quantization bits.");
+  }
+  groups_.clear();
+  for (int att_id = 0; att_id < point_cloud_->num_attributes(); ++att_id) {
+    const PointAttribute *const att = point_cloud_->attribute(att_id);
+    if (att->data_type() != DT_FLOAT32 || att->size() == 0) {
+      continue;
+    }
+    if (encoder_options.GetAttributeBool(att_id, "quantization_shared",
+                                         false)) {
+      // Quantization of attributes sharing a grid across frames is fixed.
+      continue;
+    }
+    if (encoder_options.GetAttributeInt(att_id, "quantization_bits", 0) < 0) {
+      // Quantization was explicitly disabled for the attribute.
+      continue;
+    }
+    if (att->attribute_type() == GeometryAttribute::NORMAL) {
+      // Normals are octahedron coded, so neither the error bound nor the size
+      // estimate of the linear quantization applies to them.
+      continue;
+    }
+    AttributeGroup *group = nullptr;
+    for (auto &g : groups_) {
+      if (g.type == att->attribute_type()) {
+        group = &g;
+        break;
+      }
+    }
+    if (group == nullptr) {
+      groups_.emplace_back();
+      group = &groups_.back();
+      group->type = att->attribute_type();
+      group->max_range = 0.f;
+      group->num_components = 0;
+    }
+    group->attribute_ids.push_back(att_id);
+    group->num_components += att->num_components();
+  }
+
+  // Compute quantization ranges and error limited number of bits.
+  for (auto &group : groups_) {
+    for (const int att_id : group.attribute_ids) {
+      const PointAttribute *const att = point_cloud_->attribute(att_id);
+      const int num_components = att->num_components();
+      std::vector<float> min_values(num_components,
+                                    std::numeric_limits<float>::max());
+      std::vector<float> max_values(num_components,
+                                    std::numeric_limits<float>::lowest());
+      const std::unique_ptr<float[]> att_val(new float[num_components]);
+      for (AttributeValueIndex avi(0); avi < static_cast<uint32_t>(att->size());
+           ++avi) {
+        att->GetValue(avi, att_val.get());
+        for (int c = 0; c < num_components; ++c) {
+          min_values[c] = std::min(min_values[c], att_val[c]);
+          max_values[c] = std::max(max_values[c], att_val[c]);
+        }
+      }
+      float range = 0.f;
+      for (int c = 0; c < num_components; ++c) {
+        range = std::max(range, max_values[c] - min_values[c]);
+      }
+      if (range == 0.f) {
+        range = 1.f;
+      }
+      if (!std::isfinite(range)) {
+        return ErrorStatus("Attribute contains non-finite values.");
+      }
+      group.min_values.push_back(std::move(min_values));
+      group.ranges.push_back(range);
+      group.max_range = std::max(group.max_range, range);
+    }
+    group.min_bits = options_.min_quantization_bits;
+    const float max_error = GetMaxError(group.type);
+    if (max_error > 0.f) {
+      // The maximum error of a quantized value is half of the quantization
+      // step: range / (2^bits - 1) / 2.
+      const double num_steps = group.max_range / (2.0 * max_error);
+      const int bits = static_cast<int>(std::ceil(std::log2(num_steps + 1.0)));
+      if (bits > options_.max_quantization_bits) {
+        return ErrorStatus(
+            std::string("Maximum error of ") +
+            GeometryAttribute::TypeToString(group.type) +
+            " attributes needs more than the maximum quantization bits.");
+      }
+      group.min_bits = std::max(group.min_bits, bits);
+    }
+    group.estimated_sizes.assign(
+        options_.max_quantization_bits - group.min_bits + 1, 0);
+  }
+
+  // Evaluate all candidates in parallel.
+  std::vector<std::pair<int, int>> candidates;
+  for (int g = 0; g < groups_.size(); ++g) {
+    for (int i = 0; i < groups_[g].estimated_sizes.size(); ++i) {
+      candidates.push_back({g, i});
+    }
+  }
+  ParallelFor(static_cast<int>(candidates.size()), options_.num_threads,
+              [&](int i) {
+                AttributeGroup &group = groups_[candidates[i].first];
+                const int bits_offset = candidates[i].second;
+                int64_t size = 0;
+                for (int a = 0; a < group.attribute_ids.size(); ++a) {
+                  size += EstimateAttributeSize(
+                      *point_cloud_->attribute(group.attribute_ids[a]),
+                      group.min_values[a], group.ranges[a],
+                      group.min_bits + bits_offset);
+                }
+                group.estimated_sizes[bits_offset] = size;
+              });
+  return OkStatus();
+}
+
+int64_t RateController::SelectQuantization(
+    int64_t size_budget, EncoderOptions *encoder_options) const {
+  std::vector<int> bits(groups_.size());
+  int64_t total_size = 0;
+  for (int g = 0; g < groups_.size(); ++g) {
+    const AttributeGroup &group = groups_[g];
+    if (size_budget > 0) {
+      bits[g] = options_.max_quantization_bits;
+    } else {
+      bits[g] = group.min_bits;
+    }
+    total_size += group.estimated_sizes[bits[g] - group.min_bits];
+  }
+  while (size_budget > 0 && total_size > size_budget) {
+    // Find the group where removing one bit saves the most bytes relative to
+    // the increase of the quantization error. The error is measured relative
+    // to the range of the attribute so that attributes with different units
+    // can be compared. Quantization noise energy for |b| bits is proportional
+    // to 4^-b, so removing a bit increases it by 3 * 4^-b per component.
+    int best_group = -1;
+    double best_ratio = 0.0;
+    for (int g = 0; g < groups_.size(); ++g) {
+      const AttributeGroup &group = groups_[g];
+      if (bits[g] <= group.min_bits) {
+        continue;
+      }
+      const int64_t saved_size =
+          group.estimated_sizes[bits[g] - group.min_bits] -
+          group.estimated_sizes[bits[g] - 1 - group.min_bits];
+      const double error_increase =
+          3.0 * group.num_components * std::ldexp(1.0, -2 * bits[g]);
+      const double ratio = saved_size / error_increase;
+      if (best_group == -1 || ratio > best_ratio) {
+        best_group = g;
+        best_ratio = ratio;
+      }
+    }
+    if (best_group == -1) {
+      break;  // All groups are at the error limit.
+    }
+    const AttributeGroup &group = groups_[best_group];
+    total_size -= group.estimated_sizes[bits[best_group] - group.min_bits];
+    --bits[best_group];
+    total_size += group.estimated_sizes[bits[best_group] - group.min_bits];
+  }
+  for (int g = 0; g < groups_.size(); ++g) {
+    for (const int att_id : groups_[g].attribute_ids) {
+      encoder_options->SetAttributeInt(att_id, "quantization_bits", bits[g]);
+    }
+  }
+  return total_size;
+}
+
+int64_t RateController::EstimateAttributeSize(
+    const PointAttribute &att, const std::vector<float> &min_values,
+    float range, int quantization_bits) const {
+  const int num_components = att.num_components();
+  const int num_points = point_cloud_->num_points();
+  if (num_points == 0) {
+    return 0;
+  }
+  Quantizer quantizer;
+  quantizer.Init(range, (1 << quantization_bits) - 1);
+
+  // Sample blocks of consecutive points spread evenly over the point cloud.
+  const int num_samples =
+      std::min(num_points, std::max(options_.max_num_sample_points, 1));
+  const int num_blocks =
+      (num_samples + kSampleBlockSize - 1) / kSampleBlockSize;
+  std::vector<int32_t> deltas;
+  deltas.reserve(static_cast<size_t>(num_samples) * num_components);
+  std::vector<int32_t> prev_value(num_components, 0);
+  const std::unique_ptr<float[]> att_val(new float[num_components]);
+  for (int b = 0; b < num_blocks; ++b) {
+    const int block_start =
+        static_cast<int>(static_cast<int64_t>(num_points) * b / num_blocks);
+    const int block_end = std::min(num_points, block_start + kSampleBlockSize);
+    for (int p = block_start; p < block_end; ++p) {
+      att.GetValue(att.mapped_index(PointIndex(p)), att_val.get());
+      for (int c = 0; c < num_components; ++c) {
+        const int32_t q = quantizer.QuantizeFloat(att_val[c] - min_values[c]);
+        deltas.push_back(q - prev_value[c]);
+        prev_value[c] = q;
+      }
+    }
+  }
+  std::vector<uint32_t> symbols(deltas.size());
+  ConvertSignedIntsToSymbols(deltas.data(), static_cast<int>(deltas.size()),
+                             symbols.data());
+  const int64_t sample_bits = EstimateEncodedSymbolsBits(
+      symbols.data(), static_cast<int>(symbols.size()), num_components);
+  const int num_sampled_points =
+      static_cast<int>(deltas.size() / num_components);
+  return static_cast<int64_t>(
+      std::ceil(sample_bits / 8.0 * num_points / num_sampled_points));
+}
+
+float RateController::GetMaxError(GeometryAttribute::Type type) const {
+  const auto it = options_.max_errors.find(type);
+  if (it != options_.max_errors.end()) {
+    return it->second;
+  }
+  return options_.max_error;
+}
+
+}  // namespace draco
@@ -0,0 +1,123 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_RATE_CONTROL_H_
+#define DRACO_COMPRESSION_RATE_CONTROL_H_
+
+#include <map>
+#include <vector>
+
+#include "draco/attributes/geometry_attribute.h"
+#include "draco/compression/config/encoder_options.h"
+#include "draco/core/status.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Options controlling the automatic selection of quantization bits, see
+// ExpertEncoder::EncodeToBufferWithRateControl().
+struct RateControlOptions {
+  RateControlOptions();
+
+  // Desired maximum size of the encoded geometry in bytes. Ignored when <= 0.
+  int64_t target_size;
+
+  // Maximum absolute quantization error allowed for any attribute component.
+  // Ignored when <= 0. Type specific limits can be set in |max_errors|.
+  float max_error;
+  std::map<GeometryAttribute::Type, float> max_errors;
+
+  // Range of quantization bits considered by the search.
+  int min_quantization_bits;
+  int max_quantization_bits;
+
+  // Number of threads used for evaluating quantization candidates.
+  int num_threads;
+
+  // Maximum number of points used for estimating the encoded size of an
+  // attribute. Larger values give more accurate estimates.
+  int max_num_sample_points;
+
+  // Maximum number of additional full encodes used for correcting the size
+  // estimates when the encoded geometry does not fit |target_size|.
+  int max_num_refinements;
+
+  // Same as |max_num_refinements| but used for point clouds encoded with the
+  // kd-tree method. The kd-tree coder is not modeled by the size estimates,
+  // which are therefore less accurate and need more corrections.
+  int max_num_kd_tree_refinements;
+};
+
+// Selects quantization bits for all floating point attributes of a point cloud
+// except normals and attributes with negative "quantization_bits", which keep
+// their options. Attributes of the same type form a group that shares the same
+// quantization bits. The number of encoded bytes for each group and each
+// candidate number of bits is estimated from the entropy of quantized and delta
+// coded attribute values, without running the actual encoder. The estimates
+// model the sequential attribute coders and don't account for the kd-tree
+// coder, whose sizes are corrected only by full encodes.
+//
+// The selected bits are the smallest ones satisfying the error limits when no
+// target size is given. Otherwise the controller starts from the maximum bits
+// and greedily removes bits from the groups with the smallest increase of the
+// quantization error per saved byte until the estimated size fits the budget.
+// The error limits are never violated, even if the target size can't be met.
+class RateController {
+ public:
+  RateController(const PointCloud &pc, const RateControlOptions &options);
+
+  // Estimates encoded sizes of all candidates. Must be called before
+  // SelectQuantization(). Returns an error when an error limit can't be met
+  // with |max_quantization_bits|.
+  Status Init(const EncoderOptions &encoder_options);
+
+  // Selects quantization bits of all groups so that the estimated size fits
+  // |size_budget| bytes and stores them in |encoder_options|. Returns the
+  // estimated size of the controlled attributes in bytes.
+  int64_t SelectQuantization(int64_t size_budget,
+                             EncoderOptions *encoder_options) const;
+
+  int num_groups() const { return static_cast<int>(groups_.size()); }
+
+ private:
+  struct AttributeGroup {
+    GeometryAttribute::Type type;
+    std::vector<int> attribute_ids;
+    // Quantization origins and ranges of the attributes in |attribute_ids|.
+    std::vector<std::vector<float>> min_values;
+    std::vector<float> ranges;
+    // Maximum quantization range over all attributes in the group.
+    float max_range;
+    // Total number of components over all attributes in the group.
+    int num_components;
+    // Smallest number of bits satisfying the error limit.
+    int min_bits;
+    // Estimated encoded size in bytes for each number of bits starting at
+    // |min_bits|.
+    std::vector<int64_t> estimated_sizes;
+  };
+
+  int64_t EstimateAttributeSize(const PointAttribute &att,
+                                const std::vector<float> &min_values,
+                                float range, int quantization_bits) const;
+  float GetMaxError(GeometryAttribute::Type type) const;
+
+  const PointCloud *point_cloud_;
+  RateControlOptions options_;
+  std::vector<AttributeGroup> groups_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_RATE_CONTROL_H_
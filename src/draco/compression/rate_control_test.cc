@@ -0,0 +1,194 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/rate_control.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/expert_encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/point_cloud/point_cloud_builder.h"
+
+namespace draco {
+
+class RateControlTest : public ::testing::Test {
+ protected:
+  // Creates a point cloud resembling a Gaussian splat scene with position,
+  // opacity and scale attributes.
+  std::unique_ptr<PointCloud> CreatePointCloud(int num_points) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    PointCloudBuilder builder;
+    builder.Start(num_points);
+    const int pos_att_id =
+        builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+    const int opacity_att_id =
+        builder.AddAttribute(GeometryAttribute::OPACITY, 1, DT_FLOAT32);
+    const int scale_att_id =
+        builder.AddAttribute(GeometryAttribute::SCALE, 3, DT_FLOAT32);
+    for (PointIndex i(0); i < num_points; ++i) {
+      const float t = static_cast<float>(i.value()) / num_points;
+      const float pos[3] = {10.f * t,
+                            std::sin(20.f * t) + 0.01f * dist(generator),
+                            dist(generator)};
+      const float opacity = dist(generator);
+      const float scale[3] = {-5.f + dist(generator), -5.f + dist(generator),
+                              -4.f + dist(generator)};
+      builder.SetAttributeValueForPoint(pos_att_id, i, pos);
+      builder.SetAttributeValueForPoint(opacity_att_id, i, &opacity);
+      builder.SetAttributeValueForPoint(scale_att_id, i, scale);
+    }
+    return builder.Finalize(false);
+  }
+
+  // Returns the maximum absolute difference between attribute values of |pc0|
+  // and |pc1| for attributes of the given |type|.
+  float ComputeMaxError(const PointCloud &pc0, const PointCloud &pc1,
+                        GeometryAttribute::Type type) {
+    const PointAttribute *const att0 = pc0.GetNamedAttribute(type);
+    const PointAttribute *const att1 = pc1.GetNamedAttribute(type);
+    float max_error = 0.f;
+    for (PointIndex pi(0); pi < pc0.num_points(); ++pi) {
+      float val0[3], val1[3];
+      att0->GetMappedValue(pi, val0);
+      att1->GetMappedValue(pi, val1);
+      for (int c = 0; c < att0->num_components(); ++c) {
+        max_error = std::max(max_error, std::abs(val0[c] - val1[c]));
+      }
+    }
+    return max_error;
+  }
+
+  std::unique_ptr<PointCloud> Decode(const EncoderBuffer &buffer) {
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    Decoder decoder;
+    auto statusor = decoder.DecodePointCloudFromBuffer(&dec_buffer);
+    if (!statusor.ok()) {
+      return nullptr;
+    }
+    return std::move(statusor).value();
+  }
+};
+
+TEST_F(RateControlTest, TestMaxError) {
+  // Tests that the selected quantization respects the maximum error.
+  std::unique_ptr<PointCloud> pc = CreatePointCloud(2000);
+  RateControlOptions rc_options;
+  rc_options.max_error = 0.01f;
+  rc_options.max_errors[GeometryAttribute::OPACITY] = 0.002f;
+  ExpertEncoder encoder(*pc);
+  encoder.SetEncodingMethod(POINT_CLOUD_SEQUENTIAL_ENCODING);
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBufferWithRateControl(rc_options, &buffer));
+  // Position range is 10, so at least 9 bits are needed (10 / 511 / 2).
+  ASSERT_EQ(encoder.options().GetAttributeInt(0, "quantization_bits", -1), 9);
+  ASSERT_EQ(encoder.options().GetAttributeInt(1, "quantization_bits", -1), 8);
+  ASSERT_EQ(encoder.options().GetAttributeInt(2, "quantization_bits", -1), 6);
+  std::unique_ptr<PointCloud> decoded_pc = Decode(buffer);
+  ASSERT_NE(decoded_pc, nullptr);
+  ASSERT_LE(ComputeMaxError(*pc, *decoded_pc, GeometryAttribute::POSITION),
+            0.01f + 1e-5f);
+  ASSERT_LE(ComputeMaxError(*pc, *decoded_pc, GeometryAttribute::OPACITY),
+            0.002f + 1e-5f);
+  ASSERT_LE(ComputeMaxError(*pc, *decoded_pc, GeometryAttribute::SCALE),
+            0.01f + 1e-5f);
+}
+
+TEST_F(RateControlTest, TestSkippedAttribute) {
+  // Tests that attributes with explicitly disabled quantization are not
+  // controlled.
+  std::unique_ptr<PointCloud> pc = CreatePointCloud(2000);
+  RateControlOptions rc_options;
+  rc_options.max_error = 0.01f;
+  ExpertEncoder encoder(*pc);
+  encoder.SetEncodingMethod(POINT_CLOUD_SEQUENTIAL_ENCODING);
+  encoder.SetAttributeQuantization(2, -1);
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBufferWithRateControl(rc_options, &buffer));
+  ASSERT_EQ(encoder.options().GetAttributeInt(0, "quantization_bits", -1), 9);
+  ASSERT_EQ(encoder.options().GetAttributeInt(2, "quantization_bits", 0), -1);
+  std::unique_ptr<PointCloud> decoded_pc = Decode(buffer);
+  ASSERT_NE(decoded_pc, nullptr);
+  ASSERT_EQ(ComputeMaxError(*pc, *decoded_pc, GeometryAttribute::SCALE), 0.f);
+}
+
+TEST_F(RateControlTest, TestTargetSize) {
+  // Tests that the encoded point cloud fits the target size and that the
+  // result does not depend on the number of threads.
+  std::unique_ptr<PointCloud> pc = CreatePointCloud(5000);
+  ExpertEncoder reference_encoder(*pc);
+  for (int i = 0; i < pc->num_attributes(); ++i) {
+    reference_encoder.SetAttributeQuantization(i, 16);
+  }
+  EncoderBuffer reference_buffer;
+  DRACO_ASSERT_OK(reference_encoder.EncodeToBuffer(&reference_buffer));
+
+  RateControlOptions rc_options;
+  rc_options.target_size = reference_buffer.size() / 2;
+  EncoderBuffer buffers[2];
+  for (int t = 0; t < 2; ++t) {
+    rc_options.num_threads = t == 0 ? 1 : 4;
+    ExpertEncoder encoder(*pc);
+    DRACO_ASSERT_OK(
+        encoder.EncodeToBufferWithRateControl(rc_options, &buffers[t]));
+    ASSERT_LE(buffers[t].size(), rc_options.target_size);
+    ASSERT_GT(buffers[t].size(), 0);
+  }
+  ASSERT_EQ(buffers[0].size(), buffers[1].size());
+  ASSERT_NE(Decode(buffers[0]), nullptr);
+}
+
+TEST_F(RateControlTest, TestErrorLimitOverridesTargetSize) {
+  // Tests that the error limit is respected even when the target size can't
+  // be met.
+  std::unique_ptr<PointCloud> pc = CreatePointCloud(1000);
+  RateControlOptions rc_options;
+  rc_options.target_size = 10;
+  rc_options.max_error = 0.001f;
+  ExpertEncoder encoder(*pc);
+  // Sequential encoding preserves the order of points.
+  encoder.SetEncodingMethod(POINT_CLOUD_SEQUENTIAL_ENCODING);
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBufferWithRateControl(rc_options, &buffer));
+  ASSERT_GT(buffer.size(), rc_options.target_size);
+  std::unique_ptr<PointCloud> decoded_pc = Decode(buffer);
+  ASSERT_NE(decoded_pc, nullptr);
+  ASSERT_LE(ComputeMaxError(*pc, *decoded_pc, GeometryAttribute::POSITION),
+            0.001f + 1e-5f);
+}
+
+TEST_F(RateControlTest, TestMaxErrorExceedsMaxBits) {
+  // Tests that rate control fails when the maximum error needs more than the
+  // maximum quantization bits instead of silently exceeding the error.
+  std::unique_ptr<PointCloud> pc = CreatePointCloud(1000);
+  RateControlOptions rc_options;
+  // Position range is 10, so 14 bits are needed (10 / 16383 / 2).
+  rc_options.max_error = 0.0005f;
+  rc_options.max_quantization_bits = 13;
+  ExpertEncoder encoder(*pc);
+  EncoderBuffer buffer;
+  ASSERT_FALSE(encoder.EncodeToBufferWithRateControl(rc_options, &buffer).ok());
+
+  rc_options.max_quantization_bits = 14;
+  DRACO_ASSERT_OK(encoder.EncodeToBufferWithRateControl(rc_options, &buffer));
+  ASSERT_EQ(encoder.options().GetAttributeInt(0, "quantization_bits", -1), 14);
+}
+
+}  // namespace draco
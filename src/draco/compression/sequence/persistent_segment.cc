@@ -0,0 +1,166 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/sequence/persistent_segment.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#include "draco/compression/sequence/persistent_segment_builder.h"
+#include "draco/metadata/geometry_metadata.h"
+
+namespace draco {
+
+PersistentSegment::PersistentSegment() : first_frame_(0), num_frames_(0) {}
+
+Status PersistentSegment::Init(std::unique_ptr<PointCloud> segment) {
+  const GeometryMetadata *const metadata = segment->GetMetadata();
+  if (metadata == nullptr ||
+      !metadata->GetEntryInt(kSegmentFirstFrameMetadataName, &first_frame_) ||
+      !metadata->GetEntryInt(kSegmentNumFramesMetadataName, &num_frames_) ||
+      num_frames_ < 1) {
+    return ErrorStatus("Point cloud is not a persistent segment.");
+  }
+  const PointAttribute *const ins_att =
+      segment->GetNamedAttribute(GeometryAttribute::INS);
+  const PointAttribute *const outs_att =
+      segment->GetNamedAttribute(GeometryAttribute::OUTS);
+  if (ins_att == nullptr || outs_att == nullptr) {
+    return ErrorStatus("Segment doesn't have INS and OUTS attributes.");
+  }
+  const uint32_t num_points = segment->num_points();
+  std::vector<int32_t> buckets(num_points);
+  std::vector<int32_t> outs(num_points);
+  bucket_starts_.assign(num_frames_ + 1, 0);
+  for (PointIndex pi(0); pi < num_points; ++pi) {
+    int32_t ins;
+    if (!ins_att->ConvertValue<int32_t>(ins_att->mapped_index(pi), 1, &ins) ||
+        !outs_att->ConvertValue<int32_t>(outs_att->mapped_index(pi), 1,
+                                         &outs[pi.value()])) {
+      return ErrorStatus("Invalid INS or OUTS value.");
+    }
+    // Gaussians that became visible before the segment are assigned to its
+    // first frame. Gaussians that start after the segment end up in the last
+    // bucket that is never selected.
+    const int32_t bucket =
+        std::min(std::max(ins - first_frame_, 0), num_frames_);
+    buckets[pi.value()] = bucket;
+    ++bucket_starts_[bucket];
+  }
+  // Counting sort by the bucket followed by sorting of each bucket by OUTS.
+  std::vector<uint32_t> bucket_offsets(num_frames_ + 1, 0);
+  uint32_t offset = 0;
+  for (int b = 0; b <= num_frames_; ++b) {
+    const uint32_t bucket_size = bucket_starts_[b];
+    bucket_starts_[b] = offset;
+    bucket_offsets[b] = offset;
+    offset += bucket_size;
+  }
+  std::vector<uint32_t> order(num_points);
+  for (uint32_t p = 0; p < num_points; ++p) {
+    order[bucket_offsets[buckets[p]]++] = p;
+  }
+  for (int b = 0; b < num_frames_; ++b) {
+    std::stable_sort(order.begin() + bucket_starts_[b],
+                     order.begin() + bucket_starts_[b + 1],
+                     [&outs](uint32_t p0, uint32_t p1) {
+                       return outs[p0] > outs[p1];
+                     });
+  }
+  // Points that start after the segment are not needed.
+  const uint32_t num_sorted_points = bucket_starts_[num_frames_];
+
+  // Store the points in the sorted order.
+  segment_ = std::unique_ptr<PointCloud>(new PointCloud());
+  segment_->set_num_points(num_sorted_points);
+  for (int i = 0; i < segment->num_attributes(); ++i) {
+    const PointAttribute *const att = segment->attribute(i);
+    std::unique_ptr<PointAttribute> sorted_att(new PointAttribute());
+    sorted_att->Init(att->attribute_type(), att->num_components(),
+                     att->data_type(), att->normalized(), num_sorted_points);
+    sorted_att->set_unique_id(att->unique_id());
+    for (uint32_t p = 0; p < num_sorted_points; ++p) {
+      sorted_att->SetAttributeValue(
+          AttributeValueIndex(p),
+          att->GetAddressOfMappedIndex(PointIndex(order[p])));
+    }
+    segment_->AddAttribute(std::move(sorted_att));
+  }
+  outs_.resize(num_sorted_points);
+  for (uint32_t p = 0; p < num_sorted_points; ++p) {
+    outs_[p] = outs[order[p]];
+  }
+  return OkStatus();
+}
+
+Status PersistentSegment::GetVisibleRanges(
+    int frame,
+    std::vector<std::pair<PointIndex, PointIndex>> *out_ranges) const {
+  out_ranges->clear();
+  if (segment_ == nullptr) {
+    return ErrorStatus("Segment is not initialized.");
+  }
+  if (frame < first_frame_ || frame >= first_frame_ + num_frames_) {
+    return ErrorStatus("Frame is outside of the segment.");
+  }
+  // Only Gaussians that became visible at or before |frame| can be visible.
+  for (int b = 0; b <= frame - first_frame_; ++b) {
+    const auto begin = outs_.begin() + bucket_starts_[b];
+    const auto end = outs_.begin() + bucket_starts_[b + 1];
+    // OUTS values are sorted in descending order within each bucket.
+    const auto visible_end = std::partition_point(
+        begin, end, [frame](int32_t outs) { return outs > frame; });
+    if (visible_end != begin) {
+      out_ranges->push_back(
+          std::make_pair(PointIndex(bucket_starts_[b]),
+                         PointIndex(visible_end - outs_.begin())));
+    }
+  }
+  return OkStatus();
+}
+
+StatusOr<std::unique_ptr<PointCloud>> PersistentSegment::ExtractFrame(
+    int frame) const {
+  std::vector<std::pair<PointIndex, PointIndex>> ranges;
+  DRACO_RETURN_IF_ERROR(GetVisibleRanges(frame, &ranges));
+  uint32_t num_points = 0;
+  for (const auto &range : ranges) {
+    num_points += range.second.value() - range.first.value();
+  }
+  std::unique_ptr<PointCloud> pc(new PointCloud());
+  pc->set_num_points(num_points);
+  for (int i = 0; i < segment_->num_attributes(); ++i) {
+    const PointAttribute *const att = segment_->attribute(i);
+    std::unique_ptr<PointAttribute> frame_att(new PointAttribute());
+    frame_att->Init(att->attribute_type(), att->num_components(),
+                    att->data_type(), att->normalized(), num_points);
+    frame_att->set_unique_id(att->unique_id());
+    // Attribute values of the sorted segment are stored in the point order,
+    // so each range is copied at once.
+    const size_t stride = att->byte_stride();
+    uint8_t *dst = frame_att->GetAddress(AttributeValueIndex(0));
+    for (const auto &range : ranges) {
+      const size_t size =
+          stride * (range.second.value() - range.first.value());
+      memcpy(dst, att->GetAddress(AttributeValueIndex(range.first.value())),
+             size);
+      dst += size;
+    }
+    pc->AddAttribute(std::move(frame_att));
+  }
+  return std::move(pc);
+}
+
+}  // namespace draco
@@ -0,0 +1,73 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_SEQUENCE_PERSISTENT_SEGMENT_H_
+#define DRACO_COMPRESSION_SEQUENCE_PERSISTENT_SEGMENT_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "draco/core/status.h"
+#include "draco/core/status_or.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Decoded segment of frames created by PersistentSegmentBuilder. Each Gaussian
+// of the segment is stored once together with the range of frames [ins, outs)
+// in which it is visible. The segment materializes individual frames by
+// selecting the Gaussians visible in them.
+//
+// Gaussians are reordered by their first visible frame within the segment and,
+// for the same first frame, by their last visible frame in descending order.
+// The Gaussians visible in a frame then form one contiguous range per first
+// frame, so a frame is materialized without scanning all Gaussians of the
+// segment.
+class PersistentSegment {
+ public:
+  PersistentSegment();
+
+  // Initializes the segment from a decoded segment point cloud.
+  Status Init(std::unique_ptr<PointCloud> segment);
+
+  int first_frame() const { return first_frame_; }
+  int num_frames() const { return num_frames_; }
+
+  // Returns all Gaussians of the segment in the sorted order.
+  const PointCloud &point_cloud() const { return *segment_; }
+
+  // Returns the ranges of points [first, second) of point_cloud() that are
+  // visible in |frame|.
+  Status GetVisibleRanges(
+      int frame,
+      std::vector<std::pair<PointIndex, PointIndex>> *out_ranges) const;
+
+  // Returns a point cloud with all Gaussians visible in |frame|.
+  StatusOr<std::unique_ptr<PointCloud>> ExtractFrame(int frame) const;
+
+ private:
+  std::unique_ptr<PointCloud> segment_;
+  int first_frame_;
+  int num_frames_;
+  // Index of the first point whose first visible frame within the segment is
+  // |first_frame_| + i. Has |num_frames_| + 1 entries.
+  std::vector<uint32_t> bucket_starts_;
+  // OUTS values of all points in the sorted order.
+  std::vector<int32_t> outs_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_SEQUENCE_PERSISTENT_SEGMENT_H_
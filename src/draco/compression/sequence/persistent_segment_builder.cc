@@ -0,0 +1,191 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/sequence/persistent_segment_builder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "draco/core/hash_utils.h"
+#include "draco/metadata/geometry_metadata.h"
+
+namespace draco {
+
+PersistentSegmentBuilder::PersistentSegmentBuilder()
+    : num_points_(0),
+      capacity_(0),
+      first_frame_(0),
+      num_frames_(0),
+      ins_att_id_(-1),
+      outs_att_id_(-1) {}
+
+void PersistentSegmentBuilder::Start(int first_frame) {
+  segment_.reset();
+  point_table_ = FlatHashIndexTable();
+  point_first_frame_.clear();
+  point_last_frame_.clear();
+  point_num_frames_.clear();
+  num_points_ = 0;
+  capacity_ = 0;
+  first_frame_ = first_frame;
+  num_frames_ = 0;
+  ins_att_id_ = -1;
+  outs_att_id_ = -1;
+}
+
+Status PersistentSegmentBuilder::InitSegment(const PointCloud &frame) {
+  ins_att_id_ = frame.GetNamedAttributeId(GeometryAttribute::INS);
+  outs_att_id_ = frame.GetNamedAttributeId(GeometryAttribute::OUTS);
+  if (ins_att_id_ < 0 || outs_att_id_ < 0) {
+    return ErrorStatus("Segment frames must have INS and OUTS attributes.");
+  }
+  // Persistent Gaussians are usually the majority of each frame.
+  capacity_ = std::max<uint32_t>(frame.num_points(), 16);
+  segment_ = std::unique_ptr<PointCloud>(new PointCloud());
+  for (int i = 0; i < frame.num_attributes(); ++i) {
+    const PointAttribute *const att = frame.attribute(i);
+    std::unique_ptr<PointAttribute> segment_att(new PointAttribute());
+    segment_att->Init(att->attribute_type(), att->num_components(),
+                      att->data_type(), att->normalized(), capacity_);
+    segment_att->set_unique_id(att->unique_id());
+    segment_->AddAttribute(std::move(segment_att));
+  }
+  point_table_.Init(capacity_);
+  return OkStatus();
+}
+
+Status PersistentSegmentBuilder::AddFrame(const PointCloud &frame) {
+  if (segment_ == nullptr) {
+    DRACO_RETURN_IF_ERROR(InitSegment(frame));
+  } else {
+    if (frame.num_attributes() != segment_->num_attributes()) {
+      return ErrorStatus("Segment frames must have the same attributes.");
+    }
+    for (int i = 0; i < frame.num_attributes(); ++i) {
+      const PointAttribute *const att = frame.attribute(i);
+      const PointAttribute *const segment_att = segment_->attribute(i);
+      if (att->attribute_type() != segment_att->attribute_type() ||
+          att->data_type() != segment_att->data_type() ||
+          att->num_components() != segment_att->num_components()) {
+        return ErrorStatus("Segment frames must have the same attributes.");
+      }
+    }
+  }
+  const int frame_id = first_frame_ + num_frames_;
+  const PointAttribute *const ins_att = frame.attribute(ins_att_id_);
+  const PointAttribute *const outs_att = frame.attribute(outs_att_id_);
+  for (PointIndex pi(0); pi < frame.num_points(); ++pi) {
+    int32_t ins, outs;
+    if (!ins_att->ConvertValue<int32_t>(ins_att->mapped_index(pi), 1, &ins) ||
+        !outs_att->ConvertValue<int32_t>(outs_att->mapped_index(pi), 1,
+                                         &outs)) {
+      return ErrorStatus("Invalid INS or OUTS value.");
+    }
+    if (frame_id < ins || frame_id >= outs) {
+      return ErrorStatus("Gaussian is not visible in its frame.");
+    }
+    AddPoint(frame, pi);
+  }
+  ++num_frames_;
+  return OkStatus();
+}
+
+void PersistentSegmentBuilder::AddPoint(const PointCloud &frame,
+                                        PointIndex pi) {
+  const int num_attributes = frame.num_attributes();
+  const int frame_id = first_frame_ + num_frames_;
+  uint64_t hash = num_attributes;
+  for (int i = 0; i < num_attributes; ++i) {
+    const PointAttribute *const att = frame.attribute(i);
+    hash = (hash ^ HashBytes(att->GetAddressOfMappedIndex(pi),
+                             att->byte_stride())) *
+           0x9e3779b97f4a7c15ull;
+  }
+  const uint32_t point = point_table_.FindOrInsert(
+      MixHash(hash), num_points_, [&](uint32_t p) {
+        // Each segment point can represent only one Gaussian of a frame.
+        if (point_last_frame_[p] == frame_id) {
+          return false;
+        }
+        for (int i = 0; i < num_attributes; ++i) {
+          const PointAttribute *const att = frame.attribute(i);
+          if (memcmp(att->GetAddressOfMappedIndex(pi),
+                     segment_->attribute(i)->GetAddress(AttributeValueIndex(p)),
+                     att->byte_stride()) != 0) {
+            return false;
+          }
+        }
+        return true;
+      });
+  if (point == num_points_) {
+    if (num_points_ == capacity_) {
+      capacity_ *= 2;
+      for (int i = 0; i < num_attributes; ++i) {
+        segment_->attribute(i)->Resize(capacity_);
+      }
+    }
+    for (int i = 0; i < num_attributes; ++i) {
+      const PointAttribute *const att = frame.attribute(i);
+      segment_->attribute(i)->SetAttributeValue(
+          AttributeValueIndex(point), att->GetAddressOfMappedIndex(pi));
+    }
+    point_first_frame_.push_back(frame_id);
+    point_last_frame_.push_back(frame_id);
+    point_num_frames_.push_back(1);
+    ++num_points_;
+  } else {
+    point_last_frame_[point] = frame_id;
+    ++point_num_frames_[point];
+  }
+}
+
+StatusOr<std::unique_ptr<PointCloud>> PersistentSegmentBuilder::Finalize() {
+  if (segment_ == nullptr) {
+    return ErrorStatus("Segment doesn't contain any frame.");
+  }
+  // Each Gaussian must appear in all frames of the segment that are within
+  // its range [ins, outs), otherwise it would be added to frames that don't
+  // contain it when the segment is split into frames.
+  const int end_frame = first_frame_ + num_frames_;
+  const PointAttribute *const ins_att = segment_->attribute(ins_att_id_);
+  const PointAttribute *const outs_att = segment_->attribute(outs_att_id_);
+  for (uint32_t p = 0; p < num_points_; ++p) {
+    int32_t ins, outs;
+    ins_att->ConvertValue<int32_t>(AttributeValueIndex(p), 1, &ins);
+    outs_att->ConvertValue<int32_t>(AttributeValueIndex(p), 1, &outs);
+    const int expected_num_frames =
+        std::min<int>(outs, end_frame) - std::max<int>(ins, first_frame_);
+    if (point_num_frames_[p] != expected_num_frames) {
+      return ErrorStatus("Gaussian found in frames " +
+                         std::to_string(point_first_frame_[p]) + " to " +
+                         std::to_string(point_last_frame_[p]) +
+                         " is missing from a frame of its INS and OUTS "
+                         "range.");
+    }
+  }
+  segment_->set_num_points(num_points_);
+  for (int i = 0; i < segment_->num_attributes(); ++i) {
+    segment_->attribute(i)->Resize(num_points_);
+  }
+  std::unique_ptr<GeometryMetadata> metadata(new GeometryMetadata());
+  metadata->AddEntryInt(kSegmentFirstFrameMetadataName, first_frame_);
+  metadata->AddEntryInt(kSegmentNumFramesMetadataName, num_frames_);
+  segment_->AddMetadata(std::move(metadata));
+  std::unique_ptr<PointCloud> segment = std::move(segment_);
+  Start(first_frame_ + num_frames_);
+  return std::move(segment);
+}
+
+}  // namespace draco
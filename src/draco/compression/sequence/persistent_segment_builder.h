@@ -0,0 +1,96 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_SEQUENCE_PERSISTENT_SEGMENT_BUILDER_H_
+#define DRACO_COMPRESSION_SEQUENCE_PERSISTENT_SEGMENT_BUILDER_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/core/flat_hash_index_table.h"
+#include "draco/core/status.h"
+#include "draco/core/status_or.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Names of the metadata entries that store the frame range of a segment.
+constexpr char kSegmentFirstFrameMetadataName[] = "segment_first_frame";
+constexpr char kSegmentNumFramesMetadataName[] = "segment_num_frames";
+
+// Builds a single point cloud from a segment of consecutive frames in which
+// each Gaussian is stored only once. Gaussians must have INS and OUTS
+// attributes with the range of frames [ins, outs) in which they are visible.
+// A Gaussian that persists over several frames appears in each of them with
+// the same attribute values and it is added to the segment only once.
+//
+// The resulting point cloud can be encoded with any Draco encoder. The frame
+// range of the segment is stored in its metadata and PersistentSegment can
+// extract the individual frames after decoding.
+//
+// Usage:
+//   PersistentSegmentBuilder builder;
+//   builder.Start(first_frame);
+//   for (const auto &frame : frames) {
+//     DRACO_RETURN_IF_ERROR(builder.AddFrame(*frame));
+//   }
+//   DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloud> segment,
+//                          builder.Finalize());
+class PersistentSegmentBuilder {
+ public:
+  PersistentSegmentBuilder();
+
+  // Starts a new segment whose first frame has index |first_frame|.
+  void Start(int first_frame);
+
+  // Adds the next frame of the segment. All frames must have the same
+  // attribute layout and all Gaussians of the frame must be visible in it
+  // according to their INS and OUTS values.
+  Status AddFrame(const PointCloud &frame);
+
+  // Returns the segment point cloud. Fails when a Gaussian is missing from
+  // any frame of the segment in which it is visible according to its INS and
+  // OUTS values. The builder must be started again before it can be reused.
+  StatusOr<std::unique_ptr<PointCloud>> Finalize();
+
+  int num_frames() const { return num_frames_; }
+
+ private:
+  // Creates the segment point cloud with the attribute layout of |frame|.
+  Status InitSegment(const PointCloud &frame);
+
+  // Adds point |pi| of |frame| to the segment unless it was already added by
+  // a previous frame.
+  void AddPoint(const PointCloud &frame, PointIndex pi);
+
+  std::unique_ptr<PointCloud> segment_;
+  FlatHashIndexTable point_table_;
+  // Index of the first and the last frame in which each segment point was
+  // found. The last frame is used to keep duplicate Gaussians within a single
+  // frame.
+  std::vector<int> point_first_frame_;
+  std::vector<int> point_last_frame_;
+  // Number of frames in which each segment point was found.
+  std::vector<int> point_num_frames_;
+  uint32_t num_points_;
+  uint32_t capacity_;
+  int first_frame_;
+  int num_frames_;
+  int ins_att_id_;
+  int outs_att_id_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_SEQUENCE_PERSISTENT_SEGMENT_BUILDER_H_
@@ -0,0 +1,144 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/sequence/persistent_segment.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/expert_encode.h"
+#include "draco/compression/sequence/persistent_segment_builder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/point_cloud/point_cloud_builder.h"
+
+namespace draco {
+
+namespace {
+
+struct Gaussian {
+  float pos[3];
+  int32_t ins;
+  int32_t outs;
+};
+
+// Gaussians of the test sequence. The third and fourth Gaussians are
+// identical and the last one became visible before the segment start.
+const Gaussian kGaussians[] = {{{0.f, 0.f, 0.f}, 0, 4},
+                               {{1.f, 0.f, 0.f}, 1, 3},
+                               {{2.f, 0.f, 0.f}, 2, 6},
+                               {{2.f, 0.f, 0.f}, 2, 6},
+                               {{3.f, 0.f, 0.f}, 3, 4},
+                               {{4.f, 0.f, 0.f}, -5, 2}};
+
+// Returns a frame with all Gaussians visible in |frame|.
+std::unique_ptr<PointCloud> CreateFrame(int frame) {
+  std::vector<Gaussian> gaussians;
+  for (const Gaussian &g : kGaussians) {
+    if (g.ins <= frame && frame < g.outs) {
+      gaussians.push_back(g);
+    }
+  }
+  PointCloudBuilder builder;
+  builder.Start(gaussians.size());
+  const int pos_att_id =
+      builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+  const int ins_att_id =
+      builder.AddAttribute(GeometryAttribute::INS, 1, DT_INT32);
+  const int outs_att_id =
+      builder.AddAttribute(GeometryAttribute::OUTS, 1, DT_INT32);
+  for (PointIndex i(0); i < gaussians.size(); ++i) {
+    const Gaussian &g = gaussians[i.value()];
+    builder.SetAttributeValueForPoint(pos_att_id, i, g.pos);
+    builder.SetAttributeValueForPoint(ins_att_id, i, &g.ins);
+    builder.SetAttributeValueForPoint(outs_att_id, i, &g.outs);
+  }
+  return builder.Finalize(false);
+}
+
+// Returns sorted x coordinates of all points of |pc|.
+std::vector<float> GetSortedX(const PointCloud &pc) {
+  const PointAttribute *const att =
+      pc.GetNamedAttribute(GeometryAttribute::POSITION);
+  std::vector<float> values;
+  for (PointIndex i(0); i < pc.num_points(); ++i) {
+    std::array<float, 3> pos;
+    att->GetMappedValue(i, pos.data());
+    values.push_back(pos[0]);
+  }
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+}  // namespace
+
+TEST(PersistentSegmentTest, TestEncodeAndExtractFrames) {
+  // Tests that frames extracted from an encoded segment contain the same
+  // Gaussians as the input frames.
+  const int kNumFrames = 4;
+  PersistentSegmentBuilder builder;
+  builder.Start(0);
+  for (int f = 0; f < kNumFrames; ++f) {
+    DRACO_ASSERT_OK(builder.AddFrame(*CreateFrame(f)));
+  }
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<PointCloud> segment,
+                         builder.Finalize());
+  // Each Gaussian is stored once.
+  ASSERT_EQ(segment->num_points(), 6);
+
+  ExpertEncoder encoder(*segment);
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(&buffer));
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<PointCloud> decoded,
+                         decoder.DecodePointCloudFromBuffer(&dec_buffer));
+
+  PersistentSegment persistent_segment;
+  DRACO_ASSERT_OK(persistent_segment.Init(std::move(decoded)));
+  ASSERT_EQ(persistent_segment.first_frame(), 0);
+  ASSERT_EQ(persistent_segment.num_frames(), kNumFrames);
+  for (int f = 0; f < kNumFrames; ++f) {
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<PointCloud> frame,
+                           persistent_segment.ExtractFrame(f));
+    ASSERT_EQ(GetSortedX(*frame), GetSortedX(*CreateFrame(f)));
+  }
+  ASSERT_FALSE(persistent_segment.ExtractFrame(kNumFrames).ok());
+}
+
+TEST(PersistentSegmentTest, TestInvisibleGaussian) {
+  // Tests that the builder rejects frames with Gaussians outside of their
+  // visibility range.
+  PersistentSegmentBuilder builder;
+  builder.Start(4);
+  ASSERT_FALSE(builder.AddFrame(*CreateFrame(0)).ok());
+}
+
+TEST(PersistentSegmentTest, TestMissingGaussian) {
+  // Tests that the builder rejects segments in which a Gaussian is missing
+  // from a frame within its visibility range. The second Gaussian is visible
+  // in frames 1 and 2 but the frame 1 doesn't contain it.
+  PersistentSegmentBuilder builder;
+  builder.Start(0);
+  DRACO_ASSERT_OK(builder.AddFrame(*CreateFrame(0)));
+  DRACO_ASSERT_OK(builder.AddFrame(*CreateFrame(0)));
+  DRACO_ASSERT_OK(builder.AddFrame(*CreateFrame(2)));
+  ASSERT_FALSE(builder.Finalize().ok());
+}
+
+}  // namespace draco
@@ -0,0 +1,79 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_SEQUENCE_SEQUENCE_CONTAINER_H_
+#define DRACO_COMPRESSION_SEQUENCE_SEQUENCE_CONTAINER_H_
+
+#include <stdint.h>
+
+namespace draco {
+
+// Layout of a Draco sequence container that stores encoded frames of a
+// sequence in a single file:
+//
+//   "DRACOSEQ"                  8 bytes
+//   version major, minor        2 x uint8_t
+//   reserved                    uint16_t
+//   header size                 uint32_t
+//   SequenceHeader              |header size| bytes
+//   frame 0, frame 1, ...       Draco bitstreams
+//   frame table                 |num frames| x SequenceFrameEntry
+//   static layer entry          SequenceFrameEntry (version 1.1+)
+//   footer                      SequenceFooter
+//
+// The frame table and the footer are stored at the end so that frames can be
+// written as they are encoded. All entries have a fixed size, which allows
+// readers to locate any frame in constant time and to decode the frames
+// directly from a memory mapped file.
+//
+// Scenes with a static background can store the Gaussians that don't move in
+// an optional static layer that is encoded only once and stored among the
+// frames. Each frame then contains only the dynamic Gaussians and the full
+// frame is the union of both layers. The static layer entry has zero size
+// when the container has no static layer.
+constexpr char kSequenceContainerString[] = "DRACOSEQ";
+constexpr uint8_t kSequenceContainerVersionMajor = 1;
+constexpr uint8_t kSequenceContainerVersionMinor = 1;
+constexpr int kSequenceContainerHeaderSize = 16;
+
+// Entry of the frame table.
+struct SequenceFrameEntry {
+  // Offset of the frame bitstream from the start of the container.
+  uint64_t offset;
+  // Size of the frame bitstream in bytes.
+  uint32_t size;
+  // Index of the closest keyframe at or before this frame. Equal to the index
+  // of the frame itself for keyframes. Unused for the static layer.
+  uint32_t keyframe;
+};
+
+struct SequenceFooter {
+  // Offset of the frame table from the start of the container.
+  uint64_t frame_table_offset;
+  uint32_t num_frames;
+  // Must be equal to kSequenceFooterMagic.
+  uint32_t magic;
+};
+
+// "DRSQ" in little endian byte order.
+constexpr uint32_t kSequenceFooterMagic = 0x51535244;
+
+static_assert(sizeof(SequenceFrameEntry) == 16,
+              "Unexpected size of SequenceFrameEntry.");
+static_assert(sizeof(SequenceFooter) == 16,
+              "Unexpected size of SequenceFooter.");
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_SEQUENCE_SEQUENCE_CONTAINER_H_
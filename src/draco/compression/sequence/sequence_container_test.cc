@@ -0,0 +1,192 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "draco/compression/expert_encode.h"
+#include "draco/compression/sequence/sequence_quantization_analyzer.h"
+#include "draco/compression/sequence/sequence_reader.h"
+#include "draco/compression/sequence/sequence_writer.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/point_cloud/point_cloud_builder.h"
+
+namespace draco {
+
+class SequenceContainerTest : public ::testing::Test {
+ protected:
+  // Creates a frame with |num_points| points moved by |offset|.
+  std::unique_ptr<PointCloud> CreateFrame(int num_points, float offset) {
+    PointCloudBuilder builder;
+    builder.Start(num_points);
+    const int pos_att_id =
+        builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+    const int opacity_att_id =
+        builder.AddAttribute(GeometryAttribute::OPACITY, 1, DT_FLOAT32);
+    for (PointIndex i(0); i < num_points; ++i) {
+      const float pos[3] = {i.value() + offset, 2.f * i.value(), -offset};
+      const float opacity = 0.1f * (i.value() % 10);
+      builder.SetAttributeValueForPoint(pos_att_id, i, pos);
+      builder.SetAttributeValueForPoint(opacity_att_id, i, &opacity);
+    }
+    return builder.Finalize(false);
+  }
+};
+
+TEST_F(SequenceContainerTest, TestWriteAndRead) {
+  // Tests that frames written into a container can be decoded in any order.
+  const int kNumFrames = 5;
+  std::vector<std::unique_ptr<PointCloud>> frames;
+  SequenceQuantizationAnalyzer analyzer;
+  analyzer.SetAttributeQuantizationBits(GeometryAttribute::POSITION, 12);
+  analyzer.SetAttributeQuantizationBits(GeometryAttribute::OPACITY, 8);
+  for (int f = 0; f < kNumFrames; ++f) {
+    frames.push_back(CreateFrame(10 + f, 0.5f * f));
+    DRACO_ASSERT_OK(analyzer.AddFrame(*frames.back()));
+  }
+  SequenceHeader header;
+  DRACO_ASSERT_OK(analyzer.ComputeSequenceHeader(&header));
+  header.SetAttributeLayout(*frames[0]);
+
+  EncoderBuffer buffer;
+  SequenceWriter writer;
+  DRACO_ASSERT_OK(writer.Start(header, &buffer));
+  const EncoderOptions options = EncoderOptions::CreateDefaultOptions();
+  for (int f = 0; f < kNumFrames; ++f) {
+    DRACO_ASSERT_OK(writer.EncodeFrame(*frames[f], options, f == 3));
+  }
+  // Frames with a different attribute layout are rejected.
+  std::unique_ptr<PointCloud> bad_frame(new PointCloud());
+  bad_frame->set_num_points(1);
+  ASSERT_FALSE(writer.EncodeFrame(*bad_frame, options, false).ok());
+  ASSERT_EQ(writer.num_frames(), kNumFrames);
+  DRACO_ASSERT_OK(writer.Finish());
+
+  SequenceReader reader;
+  DRACO_ASSERT_OK(reader.Init(buffer.data(), buffer.size()));
+  ASSERT_EQ(reader.num_frames(), kNumFrames);
+  ASSERT_EQ(reader.header().num_quantization_grids(), 2);
+  ASSERT_EQ(reader.header().num_attributes(), 2);
+  ASSERT_EQ(reader.header().attribute_layout(0).attribute_type,
+            GeometryAttribute::POSITION);
+  ASSERT_EQ(reader.header().attribute_layout(1).num_components, 1);
+  const int expected_keyframes[kNumFrames] = {0, 0, 0, 3, 3};
+  for (int f = 0; f < kNumFrames; ++f) {
+    ASSERT_EQ(reader.GetKeyframe(f), expected_keyframes[f]);
+    ASSERT_EQ(reader.IsKeyframe(f), expected_keyframes[f] == f);
+  }
+  // Frames point directly into the container data.
+  ASSERT_GE(reader.GetFrameData(0), buffer.data());
+  ASSERT_LE(reader.GetFrameData(kNumFrames - 1) +
+                reader.GetFrameSize(kNumFrames - 1),
+            buffer.data() + buffer.size());
+
+  Decoder decoder;
+  for (int f = kNumFrames - 1; f >= 0; --f) {
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<PointCloud> pc,
+                           reader.DecodeFrame(f, &decoder));
+    ASSERT_EQ(pc->num_points(), frames[f]->num_points());
+    ASSERT_EQ(pc->num_attributes(), 2);
+  }
+}
+
+TEST_F(SequenceContainerTest, TestStaticLayer) {
+  // Tests that frames are merged with the static layer that is stored only
+  // once in the container.
+  SequenceQuantizationAnalyzer analyzer;
+  analyzer.SetAttributeQuantizationBits(GeometryAttribute::POSITION, 12);
+  analyzer.SetAttributeQuantizationBits(GeometryAttribute::OPACITY, 8);
+  std::unique_ptr<PointCloud> static_layer = CreateFrame(20, 0.f);
+  std::unique_ptr<PointCloud> frames[2] = {CreateFrame(5, 1.f),
+                                           CreateFrame(7, 2.f)};
+  DRACO_ASSERT_OK(analyzer.AddFrame(*static_layer));
+  for (const auto &frame : frames) {
+    DRACO_ASSERT_OK(analyzer.AddFrame(*frame));
+  }
+  SequenceHeader header;
+  DRACO_ASSERT_OK(analyzer.ComputeSequenceHeader(&header));
+  header.SetAttributeLayout(*static_layer);
+
+  EncoderBuffer buffer;
+  SequenceWriter writer;
+  DRACO_ASSERT_OK(writer.Start(header, &buffer));
+  const EncoderOptions options = EncoderOptions::CreateDefaultOptions();
+  DRACO_ASSERT_OK(writer.EncodeFrame(*frames[0], options, true));
+  DRACO_ASSERT_OK(writer.EncodeStaticLayer(*static_layer, options));
+  ASSERT_FALSE(writer.EncodeStaticLayer(*static_layer, options).ok());
+  DRACO_ASSERT_OK(writer.EncodeFrame(*frames[1], options, false));
+  DRACO_ASSERT_OK(writer.Finish());
+
+  SequenceReader reader;
+  DRACO_ASSERT_OK(reader.Init(buffer.data(), buffer.size()));
+  ASSERT_EQ(reader.num_frames(), 2);
+  ASSERT_TRUE(reader.has_static_layer());
+  Decoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<PointCloud> decoded_static_layer,
+                         reader.DecodeStaticLayer(&decoder));
+  ASSERT_EQ(decoded_static_layer->num_points(), 20);
+  for (int f = 0; f < 2; ++f) {
+    DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<PointCloud> dynamic_layer,
+                           reader.DecodeFrame(f, &decoder));
+    DRACO_ASSIGN_OR_ASSERT(
+        std::unique_ptr<PointCloud> pc,
+        reader.DecodeFrame(f, *decoded_static_layer, &decoder));
+    ASSERT_EQ(pc->num_points(), 20 + frames[f]->num_points());
+    ASSERT_EQ(pc->num_attributes(), 2);
+    // Static points are followed by the points of the frame.
+    for (int i = 0; i < pc->num_attributes(); ++i) {
+      const PointAttribute *const att = pc->attribute(i);
+      for (PointIndex pi(0); pi < pc->num_points(); ++pi) {
+        const PointAttribute *const expected_att =
+            pi < 20 ? decoded_static_layer->attribute(i)
+                    : dynamic_layer->attribute(i);
+        const PointIndex expected_pi = pi < 20 ? pi : pi - 20;
+        ASSERT_EQ(memcmp(att->GetAddressOfMappedIndex(pi),
+                         expected_att->GetAddressOfMappedIndex(expected_pi),
+                         att->byte_stride()),
+                  0);
+      }
+    }
+  }
+}
+
+TEST_F(SequenceContainerTest, TestInvalidContainer) {
+  // Tests that truncated containers are rejected.
+  std::unique_ptr<PointCloud> frame = CreateFrame(10, 0.f);
+  SequenceHeader header;
+  EncoderBuffer frame_buffer;
+  ExpertEncoder encoder(*frame);
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(&frame_buffer));
+
+  EncoderBuffer buffer;
+  SequenceWriter writer;
+  DRACO_ASSERT_OK(writer.Start(header, &buffer));
+  DRACO_ASSERT_OK(writer.AddEncodedFrame(frame_buffer.data(),
+                                         frame_buffer.size(), false));
+  DRACO_ASSERT_OK(writer.Finish());
+
+  SequenceReader reader;
+  DRACO_ASSERT_OK(reader.Init(buffer.data(), buffer.size()));
+  ASSERT_EQ(reader.num_frames(), 1);
+  ASSERT_FALSE(reader.has_static_layer());
+  ASSERT_TRUE(reader.IsKeyframe(0));
+  ASSERT_EQ(reader.GetFrameSize(0), frame_buffer.size());
+  for (const size_t size : {size_t(0), size_t(20), buffer.size() - 1}) {
+    ASSERT_FALSE(reader.Init(buffer.data(), size).ok());
+  }
+}
+
+}  // namespace draco
@@ -0,0 +1,230 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/sequence/sequence_header.h"
+
+#include <cstring>
+
+#include "draco/core/varint_decoding.h"
+#include "draco/core/varint_encoding.h"
+
+namespace draco {
+
+namespace {
+constexpr char kSequenceHeaderString[] = "DRSEQ";
+constexpr uint8_t kSequenceHeaderVersionMajor = 1;
+constexpr uint8_t kSequenceHeaderVersionMinor = 1;
+}  // namespace
+
+void SequenceHeader::SetQuantizationGrid(const SequenceQuantizationGrid &grid) {
+  for (auto &existing_grid : quantization_grids_) {
+    if (existing_grid.attribute_type == grid.attribute_type) {
+      existing_grid = grid;
+      return;
+    }
+  }
+  quantization_grids_.push_back(grid);
+}
+
+const SequenceQuantizationGrid *SequenceHeader::GetQuantizationGrid(
+    GeometryAttribute::Type type) const {
+  for (const auto &grid : quantization_grids_) {
+    if (grid.attribute_type == type) {
+      return &grid;
+    }
+  }
+  return nullptr;
+}
+
+void SequenceHeader::SetAttributeLayout(const PointCloud &pc) {
+  attribute_layouts_.resize(pc.num_attributes());
+  for (int att_id = 0; att_id < pc.num_attributes(); ++att_id) {
+    const PointAttribute *const att = pc.attribute(att_id);
+    SequenceAttributeLayout &layout = attribute_layouts_[att_id];
+    layout.attribute_type = att->attribute_type();
+    layout.data_type = att->data_type();
+    layout.num_components = att->num_components();
+    layout.normalized = att->normalized();
+    layout.unique_id = att->unique_id();
+  }
+}
+
+Status SequenceHeader::CheckAttributeLayout(const PointCloud &pc) const {
+  if (attribute_layouts_.empty()) {
+    return OkStatus();
+  }
+  if (pc.num_attributes() != num_attributes()) {
+    return ErrorStatus("Frame doesn't match the sequence attribute layout.");
+  }
+  for (int att_id = 0; att_id < pc.num_attributes(); ++att_id) {
+    const PointAttribute *const att = pc.attribute(att_id);
+    const SequenceAttributeLayout &layout = attribute_layouts_[att_id];
+    if (att->attribute_type() != layout.attribute_type ||
+        att->data_type() != layout.data_type ||
+        att->num_components() != layout.num_components ||
+        att->normalized() != layout.normalized) {
+      return ErrorStatus("Frame doesn't match the sequence attribute layout.");
+    }
+  }
+  return OkStatus();
+}
+
+Status SequenceHeader::ApplyToEncoderOptions(const PointCloud &pc,
+                                             EncoderOptions *options) const {
+  bool any_grid_used = false;
+  for (int att_id = 0; att_id < pc.num_attributes(); ++att_id) {
+    const PointAttribute *const att = pc.attribute(att_id);
+    const SequenceQuantizationGrid *const grid =
+        GetQuantizationGrid(att->attribute_type());
+    if (grid == nullptr || att->data_type() != DT_FLOAT32) {
+      continue;
+    }
+    if (pc.NumNamedAttributes(att->attribute_type()) != 1) {
+      return ErrorStatus(
+          "Shared quantization grids require unique attribute types.");
+    }
+    if (grid->origin.size() != att->num_components()) {
+      return ErrorStatus(
+          "Shared quantization grid doesn't match the attribute layout.");
+    }
+    options->SetAttributeInt(att_id, "quantization_bits",
+                             grid->quantization_bits);
+    options->SetAttributeVector(att_id, "quantization_origin",
+                                att->num_components(), grid->origin.data());
+    options->SetAttributeFloat(att_id, "quantization_range", grid->range);
+    options->SetAttributeBool(att_id, "quantization_shared", true);
+    any_grid_used = true;
+  }
+  if (any_grid_used) {
+    options->SetGlobalBool("shared_quantization_grids", true);
+  }
+  return OkStatus();
+}
+
+void SequenceHeader::ApplyToDecoderOptions(DecoderOptions *options) const {
+  for (const auto &grid : quantization_grids_) {
+    options->SetAttributeInt(grid.attribute_type, "quantization_bits",
+                             grid.quantization_bits);
+    options->SetAttributeVector(grid.attribute_type, "quantization_origin",
+                                static_cast<int>(grid.origin.size()),
+                                grid.origin.data());
+    options->SetAttributeFloat(grid.attribute_type, "quantization_range",
+                               grid.range);
+  }
+}
+
+Status SequenceHeader::Encode(EncoderBuffer *out_buffer) const {
+  out_buffer->Encode(kSequenceHeaderString, 5);
+  out_buffer->Encode(kSequenceHeaderVersionMajor);
+  out_buffer->Encode(kSequenceHeaderVersionMinor);
+  EncodeVarint(static_cast<uint32_t>(quantization_grids_.size()), out_buffer);
+  for (const auto &grid : quantization_grids_) {
+    out_buffer->Encode(static_cast<uint8_t>(grid.attribute_type));
+    out_buffer->Encode(static_cast<uint8_t>(grid.quantization_bits));
+    out_buffer->Encode(static_cast<uint8_t>(grid.origin.size()));
+    out_buffer->Encode(grid.origin.data(), sizeof(float) * grid.origin.size());
+    out_buffer->Encode(grid.range);
+  }
+  EncodeVarint(static_cast<uint32_t>(attribute_layouts_.size()), out_buffer);
+  for (const auto &layout : attribute_layouts_) {
+    out_buffer->Encode(static_cast<uint8_t>(layout.attribute_type));
+    out_buffer->Encode(static_cast<uint8_t>(layout.data_type));
+    out_buffer->Encode(static_cast<uint8_t>(layout.num_components));
+    out_buffer->Encode(static_cast<uint8_t>(layout.normalized));
+    EncodeVarint(layout.unique_id, out_buffer);
+  }
+  return OkStatus();
+}
+
+Status SequenceHeader::Decode(DecoderBuffer *in_buffer) {
+  constexpr char kIoErrorMsg[] = "Failed to parse sequence header.";
+  char header_string[5];
+  if (!in_buffer->Decode(header_string, 5)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  if (memcmp(header_string, kSequenceHeaderString, 5) != 0) {
+    return ErrorStatus("Not a Draco sequence header.");
+  }
+  uint8_t version_major, version_minor;
+  if (!in_buffer->Decode(&version_major) ||
+      !in_buffer->Decode(&version_minor)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  if (version_major != kSequenceHeaderVersionMajor) {
+    return Status(Status::UNKNOWN_VERSION,
+                  "Unsupported sequence header version.");
+  }
+  uint32_t num_grids;
+  if (!DecodeVarint(&num_grids, in_buffer)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  quantization_grids_.clear();
+  for (uint32_t i = 0; i < num_grids; ++i) {
+    uint8_t att_type, quantization_bits, num_components;
+    if (!in_buffer->Decode(&att_type) ||
+        !in_buffer->Decode(&quantization_bits) ||
+        !in_buffer->Decode(&num_components)) {
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    }
+    if (att_type >= GeometryAttribute::NAMED_ATTRIBUTES_COUNT ||
+        quantization_bits < 1 || quantization_bits > 30 ||
+        num_components == 0) {
+      return ErrorStatus("Invalid sequence quantization grid.");
+    }
+    SequenceQuantizationGrid grid;
+    grid.attribute_type = static_cast<GeometryAttribute::Type>(att_type);
+    grid.quantization_bits = quantization_bits;
+    grid.origin.resize(num_components);
+    if (!in_buffer->Decode(grid.origin.data(),
+                           sizeof(float) * num_components) ||
+        !in_buffer->Decode(&grid.range)) {
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    }
+    SetQuantizationGrid(grid);
+  }
+  attribute_layouts_.clear();
+  if (version_minor < 1) {
+    // Attribute layouts are not stored in version 1.0 headers.
+    return OkStatus();
+  }
+  uint32_t num_layouts;
+  if (!DecodeVarint(&num_layouts, in_buffer)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  if (num_layouts > in_buffer->remaining_size()) {
+    return ErrorStatus("Invalid sequence attribute layout.");
+  }
+  attribute_layouts_.resize(num_layouts);
+  for (auto &layout : attribute_layouts_) {
+    uint8_t att_type, data_type, num_components, normalized;
+    if (!in_buffer->Decode(&att_type) || !in_buffer->Decode(&data_type) ||
+        !in_buffer->Decode(&num_components) ||
+        !in_buffer->Decode(&normalized) ||
+        !DecodeVarint(&layout.unique_id, in_buffer)) {
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    }
+    if (att_type >= GeometryAttribute::NAMED_ATTRIBUTES_COUNT ||
+        data_type == DT_INVALID || data_type >= DT_TYPES_COUNT ||
+        num_components == 0) {
+      return ErrorStatus("Invalid sequence attribute layout.");
+    }
+    layout.attribute_type = static_cast<GeometryAttribute::Type>(att_type);
+    layout.data_type = static_cast<DataType>(data_type);
+    layout.num_components = num_components;
+    layout.normalized = normalized != 0;
+  }
+  return OkStatus();
+}
+
+}  // namespace draco
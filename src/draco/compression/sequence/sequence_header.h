@@ -0,0 +1,122 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_SEQUENCE_SEQUENCE_HEADER_H_
+#define DRACO_COMPRESSION_SEQUENCE_SEQUENCE_HEADER_H_
+
+#include <vector>
+
+#include "draco/attributes/geometry_attribute.h"
+#include "draco/compression/config/decoder_options.h"
+#include "draco/compression/config/encoder_options.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Quantization grid of one attribute that is shared by all frames of a
+// sequence. Values of the attribute are quantized in the box
+// <origin, origin + range> using |quantization_bits| bits per component.
+struct SequenceQuantizationGrid {
+  SequenceQuantizationGrid()
+      : attribute_type(GeometryAttribute::INVALID), quantization_bits(0),
+        range(0.f) {}
+
+  GeometryAttribute::Type attribute_type;
+  int quantization_bits;
+  std::vector<float> origin;
+  float range;
+};
+
+// Layout of one attribute that is the same in all frames of a sequence.
+struct SequenceAttributeLayout {
+  SequenceAttributeLayout()
+      : attribute_type(GeometryAttribute::INVALID),
+        data_type(DT_INVALID),
+        num_components(0),
+        normalized(false),
+        unique_id(0) {}
+
+  GeometryAttribute::Type attribute_type;
+  DataType data_type;
+  int num_components;
+  bool normalized;
+  uint32_t unique_id;
+};
+
+// Data shared by all frames of a sequence of point clouds (such as Gaussian
+// frames of a 4D video). The header is stored once for the whole sequence and
+// individual frame bitstreams reference it instead of repeating the data. Using
+// the same quantization grid for all frames ensures that static values are
+// mapped to the same quantized integers in every frame.
+//
+// Grids are identified by the attribute type, therefore only attribute types
+// that appear at most once in a frame can use them.
+class SequenceHeader {
+ public:
+  SequenceHeader() {}
+
+  // Adds a new quantization grid or replaces an existing grid of the same
+  // attribute type.
+  void SetQuantizationGrid(const SequenceQuantizationGrid &grid);
+
+  // Returns the quantization grid for |type| or nullptr if it doesn't exist.
+  const SequenceQuantizationGrid *GetQuantizationGrid(
+      GeometryAttribute::Type type) const;
+
+  int num_quantization_grids() const {
+    return static_cast<int>(quantization_grids_.size());
+  }
+  const SequenceQuantizationGrid &quantization_grid(int i) const {
+    return quantization_grids_[i];
+  }
+
+  // Stores the attribute layout of |pc| as the layout of all frames.
+  void SetAttributeLayout(const PointCloud &pc);
+
+  // Returns an error when the attributes of |pc| don't match the stored
+  // attribute layout. Any point cloud matches when no layout is stored.
+  Status CheckAttributeLayout(const PointCloud &pc) const;
+
+  int num_attributes() const {
+    return static_cast<int>(attribute_layouts_.size());
+  }
+  const SequenceAttributeLayout &attribute_layout(int i) const {
+    return attribute_layouts_[i];
+  }
+
+  // Sets up |options| so that all attributes of |pc| that have a shared grid
+  // are quantized with it and so that the encoded frame references the grid
+  // instead of storing the quantization parameters.
+  Status ApplyToEncoderOptions(const PointCloud &pc,
+                               EncoderOptions *options) const;
+
+  // Provides the shared grids to the decoder. Must be called before decoding
+  // any frame that was encoded with ApplyToEncoderOptions().
+  void ApplyToDecoderOptions(DecoderOptions *options) const;
+
+  // Encodes / decodes the header into / from a buffer.
+  Status Encode(EncoderBuffer *out_buffer) const;
+  Status Decode(DecoderBuffer *in_buffer);
+
+ private:
+  std::vector<SequenceQuantizationGrid> quantization_grids_;
+  std::vector<SequenceAttributeLayout> attribute_layouts_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_SEQUENCE_SEQUENCE_HEADER_H_
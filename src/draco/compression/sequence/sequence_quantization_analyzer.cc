@@ -0,0 +1,113 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/sequence/sequence_quantization_analyzer.h"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace draco {
+
+SequenceQuantizationAnalyzer::SequenceQuantizationAnalyzer()
+    : bounds_(GeometryAttribute::NAMED_ATTRIBUTES_COUNT), num_frames_(0) {}
+
+void SequenceQuantizationAnalyzer::SetAttributeQuantizationBits(
+    GeometryAttribute::Type type, int quantization_bits) {
+  if (type < 0 || type >= GeometryAttribute::NAMED_ATTRIBUTES_COUNT) {
+    return;
+  }
+  bounds_[type].quantization_bits = quantization_bits;
+}
+
+Status SequenceQuantizationAnalyzer::AddFrame(const PointCloud &pc) {
+  for (int att_id = 0; att_id < pc.num_attributes(); ++att_id) {
+    const PointAttribute *const att = pc.attribute(att_id);
+    const GeometryAttribute::Type type = att->attribute_type();
+    if (type < 0 || type >= GeometryAttribute::NAMED_ATTRIBUTES_COUNT) {
+      continue;
+    }
+    AttributeBounds &bounds = bounds_[type];
+    if (bounds.quantization_bits < 1 || att->data_type() != DT_FLOAT32 ||
+        att->size() == 0) {
+      continue;
+    }
+    if (pc.NumNamedAttributes(type) != 1) {
+      bounds.is_unique = false;
+      continue;
+    }
+    const int num_components = att->num_components();
+    if (bounds.min_values.empty()) {
+      bounds.min_values.assign(num_components,
+                               std::numeric_limits<float>::max());
+      bounds.max_values.assign(num_components,
+                               std::numeric_limits<float>::lowest());
+    } else if (bounds.min_values.size() != num_components) {
+      return ErrorStatus(
+          "Number of attribute components changed within the sequence.");
+    }
+    const std::unique_ptr<float[]> att_val(new float[num_components]);
+    for (AttributeValueIndex avi(0); avi < static_cast<uint32_t>(att->size());
+         ++avi) {
+      att->GetValue(avi, att_val.get());
+      for (int c = 0; c < num_components; ++c) {
+        if (std::isnan(att_val[c]) || std::isinf(att_val[c])) {
+          return ErrorStatus("Attribute contains non-finite values.");
+        }
+        if (bounds.min_values[c] > att_val[c]) {
+          bounds.min_values[c] = att_val[c];
+        }
+        if (bounds.max_values[c] < att_val[c]) {
+          bounds.max_values[c] = att_val[c];
+        }
+      }
+    }
+  }
+  ++num_frames_;
+  return OkStatus();
+}
+
+Status SequenceQuantizationAnalyzer::ComputeSequenceHeader(
+    SequenceHeader *out_header) const {
+  if (num_frames_ == 0) {
+    return ErrorStatus("No frames were analyzed.");
+  }
+  for (int type = 0; type < GeometryAttribute::NAMED_ATTRIBUTES_COUNT;
+       ++type) {
+    const AttributeBounds &bounds = bounds_[type];
+    if (!bounds.is_unique || bounds.min_values.empty()) {
+      continue;
+    }
+    SequenceQuantizationGrid grid;
+    grid.attribute_type = static_cast<GeometryAttribute::Type>(type);
+    grid.quantization_bits = bounds.quantization_bits;
+    grid.origin = bounds.min_values;
+    // Same as in AttributeQuantizationTransform::ComputeParameters(), the range
+    // is the maximum extent over all components.
+    grid.range = 0.f;
+    for (int c = 0; c < bounds.min_values.size(); ++c) {
+      const float dif = bounds.max_values[c] - bounds.min_values[c];
+      if (dif > grid.range) {
+        grid.range = dif;
+      }
+    }
+    if (grid.range == 0.f) {
+      grid.range = 1.f;
+    }
+    out_header->SetQuantizationGrid(grid);
+  }
+  return OkStatus();
+}
+
+}  // namespace draco
@@ -0,0 +1,76 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_SEQUENCE_SEQUENCE_QUANTIZATION_ANALYZER_H_
+#define DRACO_COMPRESSION_SEQUENCE_SEQUENCE_QUANTIZATION_ANALYZER_H_
+
+#include <vector>
+
+#include "draco/attributes/geometry_attribute.h"
+#include "draco/compression/sequence/sequence_header.h"
+#include "draco/core/status.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// First pass of a two-pass sequence encoder. The analyzer collects value bounds
+// of all quantized attributes over all frames of a sequence and computes
+// quantization grids that are stable across the whole sequence.
+//
+// Usage:
+//   SequenceQuantizationAnalyzer analyzer;
+//   analyzer.SetAttributeQuantizationBits(GeometryAttribute::POSITION, 16);
+//   for (const auto &frame : frames) {
+//     DRACO_RETURN_IF_ERROR(analyzer.AddFrame(*frame));
+//   }
+//   SequenceHeader header;
+//   DRACO_RETURN_IF_ERROR(analyzer.ComputeSequenceHeader(&header));
+//   // Second pass: encode every frame with options prepared by
+//   // SequenceHeader::ApplyToEncoderOptions().
+class SequenceQuantizationAnalyzer {
+ public:
+  SequenceQuantizationAnalyzer();
+
+  // Sets the number of quantization bits for attributes of a given |type|.
+  // Only attribute types with valid quantization bits are analyzed.
+  void SetAttributeQuantizationBits(GeometryAttribute::Type type,
+                                    int quantization_bits);
+
+  // Updates the collected bounds with attribute values of |pc|.
+  Status AddFrame(const PointCloud &pc);
+
+  // Computes quantization grids covering all frames added so far and stores
+  // them in |out_header|.
+  Status ComputeSequenceHeader(SequenceHeader *out_header) const;
+
+  int num_frames() const { return num_frames_; }
+
+ private:
+  struct AttributeBounds {
+    AttributeBounds() : quantization_bits(0), is_unique(true) {}
+    int quantization_bits;
+    // Set to false when any frame contains more than one attribute of the
+    // given type. Such attributes can't be matched to a shared grid.
+    bool is_unique;
+    std::vector<float> min_values;
+    std::vector<float> max_values;
+  };
+
+  std::vector<AttributeBounds> bounds_;
+  int num_frames_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_SEQUENCE_SEQUENCE_QUANTIZATION_ANALYZER_H_
@@ -0,0 +1,166 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/sequence/sequence_quantization_analyzer.h"
+
+#include <memory>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/decode.h"
+#include "draco/compression/expert_encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/point_cloud/point_cloud_builder.h"
+
+namespace draco {
+
+class SequenceQuantizationAnalyzerTest : public ::testing::Test {
+ protected:
+  // Creates a frame where the first point is static and the second point
+  // moves by |offset|. The opacity of the first point is static as well.
+  std::unique_ptr<PointCloud> CreateFrame(float offset) {
+    PointCloudBuilder builder;
+    builder.Start(2);
+    const int pos_att_id =
+        builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+    const int opacity_att_id =
+        builder.AddAttribute(GeometryAttribute::OPACITY, 1, DT_FLOAT32);
+    const float pos[2][3] = {{0.25f, 0.5f, 0.75f},
+                             {1.f + offset, 2.f, 3.f - offset}};
+    const float opacity[2] = {0.3f, 0.9f - offset * 0.1f};
+    for (PointIndex i(0); i < 2; ++i) {
+      builder.SetAttributeValueForPoint(pos_att_id, i, pos[i.value()]);
+      builder.SetAttributeValueForPoint(opacity_att_id, i,
+                                        &opacity[i.value()]);
+    }
+    return builder.Finalize(false);
+  }
+
+  // Encodes |pc| using shared grids from |header| and returns the decoded
+  // point cloud with quantized (portable) attribute values.
+  std::unique_ptr<PointCloud> EncodeAndDecode(const PointCloud &pc,
+                                              const SequenceHeader &header,
+                                              int encoding_method,
+                                              EncoderBuffer *buffer) {
+    ExpertEncoder encoder(pc);
+    EncoderOptions options = EncoderOptions::CreateDefaultOptions();
+    if (!header.ApplyToEncoderOptions(pc, &options).ok()) {
+      return nullptr;
+    }
+    options.SetGlobalInt("encoding_method", encoding_method);
+    encoder.Reset(options);
+    if (!encoder.EncodeToBuffer(buffer).ok()) {
+      return nullptr;
+    }
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer->data(), buffer->size());
+    Decoder decoder;
+    header.ApplyToDecoderOptions(decoder.options());
+    decoder.SetSkipAttributeTransform(GeometryAttribute::POSITION);
+    decoder.SetSkipAttributeTransform(GeometryAttribute::OPACITY);
+    auto statusor = decoder.DecodePointCloudFromBuffer(&dec_buffer);
+    if (!statusor.ok()) {
+      return nullptr;
+    }
+    return std::move(statusor).value();
+  }
+
+  void TestStaticValuesAreStable(int encoding_method) {
+    std::unique_ptr<PointCloud> frames[2] = {CreateFrame(0.f),
+                                             CreateFrame(4.f)};
+    SequenceQuantizationAnalyzer analyzer;
+    analyzer.SetAttributeQuantizationBits(GeometryAttribute::POSITION, 11);
+    analyzer.SetAttributeQuantizationBits(GeometryAttribute::OPACITY, 8);
+    for (const auto &frame : frames) {
+      DRACO_ASSERT_OK(analyzer.AddFrame(*frame));
+    }
+    ASSERT_EQ(analyzer.num_frames(), 2);
+    SequenceHeader header;
+    DRACO_ASSERT_OK(analyzer.ComputeSequenceHeader(&header));
+    ASSERT_EQ(header.num_quantization_grids(), 2);
+
+    // Encode and decode the header to ensure it is stored correctly.
+    EncoderBuffer header_buffer;
+    DRACO_ASSERT_OK(header.Encode(&header_buffer));
+    DecoderBuffer header_dec_buffer;
+    header_dec_buffer.Init(header_buffer.data(), header_buffer.size());
+    SequenceHeader decoded_header;
+    DRACO_ASSERT_OK(decoded_header.Decode(&header_dec_buffer));
+    ASSERT_EQ(decoded_header.num_quantization_grids(), 2);
+
+    std::vector<uint32_t> first_point_values[2];
+    for (int f = 0; f < 2; ++f) {
+      EncoderBuffer buffer;
+      std::unique_ptr<PointCloud> decoded_pc =
+          EncodeAndDecode(*frames[f], decoded_header, encoding_method, &buffer);
+      ASSERT_NE(decoded_pc, nullptr);
+      // Decoders without support for shared grids must reject the frame. The
+      // minor version follows the "DRACO" string and the major version.
+      ASSERT_EQ(buffer.data()[6],
+                kDracoSharedQuantizationBitstreamVersionMinor);
+      ASSERT_EQ(decoded_pc->num_points(), 2);
+      // Find the decoded quantized values of the static point.
+      for (const auto type :
+           {GeometryAttribute::POSITION, GeometryAttribute::OPACITY}) {
+        const PointAttribute *const att =
+            decoded_pc->GetNamedAttribute(type);
+        ASSERT_NE(att, nullptr);
+        for (PointIndex pi(0); pi < 2; ++pi) {
+          uint32_t val[3];
+          att->ConvertValue<uint32_t>(att->mapped_index(pi), val);
+          // The static point is the one with the smallest quantized value.
+          if (val[0] == 0) {
+            first_point_values[f].insert(first_point_values[f].end(), val,
+                                         val + att->num_components());
+          }
+        }
+      }
+    }
+    ASSERT_FALSE(first_point_values[0].empty());
+    ASSERT_EQ(first_point_values[0], first_point_values[1]);
+  }
+};
+
+TEST_F(SequenceQuantizationAnalyzerTest, KdTreeStaticValuesAreStable) {
+  TestStaticValuesAreStable(POINT_CLOUD_KD_TREE_ENCODING);
+}
+
+TEST_F(SequenceQuantizationAnalyzerTest, SequentialStaticValuesAreStable) {
+  TestStaticValuesAreStable(POINT_CLOUD_SEQUENTIAL_ENCODING);
+}
+
+TEST_F(SequenceQuantizationAnalyzerTest, MissingGridFailsDecoding) {
+  std::unique_ptr<PointCloud> frame = CreateFrame(0.f);
+  SequenceQuantizationAnalyzer analyzer;
+  analyzer.SetAttributeQuantizationBits(GeometryAttribute::POSITION, 11);
+  analyzer.SetAttributeQuantizationBits(GeometryAttribute::OPACITY, 8);
+  DRACO_ASSERT_OK(analyzer.AddFrame(*frame));
+  SequenceHeader header;
+  DRACO_ASSERT_OK(analyzer.ComputeSequenceHeader(&header));
+
+  ExpertEncoder encoder(*frame);
+  EncoderOptions options = EncoderOptions::CreateDefaultOptions();
+  DRACO_ASSERT_OK(header.ApplyToEncoderOptions(*frame, &options));
+  encoder.Reset(options);
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(&buffer));
+
+  // Decoding without the sequence header must fail.
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  Decoder decoder;
+  ASSERT_FALSE(decoder.DecodePointCloudFromBuffer(&dec_buffer).ok());
+}
+
+}  // namespace draco
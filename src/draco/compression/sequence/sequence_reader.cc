@@ -0,0 +1,190 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/sequence/sequence_reader.h"
+
+#include <cstring>
+
+namespace draco {
+
+namespace {
+
+// Returns a point cloud with the points of |static_layer| followed by the
+// points of |dynamic_layer|. Both layers must have the same attributes.
+StatusOr<std::unique_ptr<PointCloud>> MergeLayers(
+    const PointCloud &static_layer, const PointCloud &dynamic_layer) {
+  if (static_layer.num_attributes() != dynamic_layer.num_attributes()) {
+    return ErrorStatus("Sequence layers have different attributes.");
+  }
+  const PointCloud *const layer_pcs[2] = {&static_layer, &dynamic_layer};
+  const uint32_t num_points =
+      static_layer.num_points() + dynamic_layer.num_points();
+  std::unique_ptr<PointCloud> pc(new PointCloud());
+  pc->set_num_points(num_points);
+  for (int i = 0; i < static_layer.num_attributes(); ++i) {
+    const PointAttribute *const layers[2] = {static_layer.attribute(i),
+                                             dynamic_layer.attribute(i)};
+    if (layers[0]->attribute_type() != layers[1]->attribute_type() ||
+        layers[0]->data_type() != layers[1]->data_type() ||
+        layers[0]->num_components() != layers[1]->num_components()) {
+      return ErrorStatus("Sequence layers have different attributes.");
+    }
+    std::unique_ptr<PointAttribute> att(new PointAttribute());
+    att->Init(layers[0]->attribute_type(), layers[0]->num_components(),
+              layers[0]->data_type(), layers[0]->normalized(), num_points);
+    att->set_unique_id(layers[0]->unique_id());
+    const size_t stride = att->byte_stride();
+    uint8_t *dst = att->GetAddress(AttributeValueIndex(0));
+    for (int l = 0; l < 2; ++l) {
+      const PointAttribute *const src = layers[l];
+      const uint32_t num_src_points = layer_pcs[l]->num_points();
+      if (src->is_mapping_identity() && src->byte_stride() == stride) {
+        // Decoded attributes usually store one value per point so the values
+        // can be copied at once.
+        memcpy(dst, src->GetAddress(AttributeValueIndex(0)),
+               stride * num_src_points);
+        dst += stride * num_src_points;
+      } else {
+        for (PointIndex pi(0); pi < num_src_points; ++pi) {
+          src->GetMappedValue(pi, dst);
+          dst += stride;
+        }
+      }
+    }
+    pc->AddAttribute(std::move(att));
+  }
+  return std::move(pc);
+}
+
+}  // namespace
+
+SequenceReader::SequenceReader() : data_(nullptr) {
+  static_layer_ = {0, 0, 0};
+}
+
+Status SequenceReader::Init(const char *data, size_t data_size) {
+  constexpr char kIoErrorMsg[] = "Failed to parse sequence container.";
+  data_ = data;
+  frames_.clear();
+  static_layer_ = {0, 0, 0};
+  if (data_size < kSequenceContainerHeaderSize + sizeof(SequenceFooter)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  DecoderBuffer buffer;
+  buffer.Init(data, data_size);
+  char container_string[8];
+  uint8_t version_major, version_minor;
+  uint16_t reserved;
+  uint32_t header_size;
+  if (!buffer.Decode(container_string, 8) || !buffer.Decode(&version_major) ||
+      !buffer.Decode(&version_minor) || !buffer.Decode(&reserved) ||
+      !buffer.Decode(&header_size)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  if (memcmp(container_string, kSequenceContainerString, 8) != 0) {
+    return ErrorStatus("Not a Draco sequence container.");
+  }
+  if (version_major != kSequenceContainerVersionMajor) {
+    return Status(Status::UNKNOWN_VERSION,
+                  "Unsupported sequence container version.");
+  }
+  const size_t frames_begin = kSequenceContainerHeaderSize + header_size;
+  if (frames_begin > data_size - sizeof(SequenceFooter)) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  DecoderBuffer header_buffer;
+  header_buffer.Init(data + kSequenceContainerHeaderSize, header_size);
+  DRACO_RETURN_IF_ERROR(header_.Decode(&header_buffer));
+
+  SequenceFooter footer;
+  memcpy(&footer, data + data_size - sizeof(SequenceFooter), sizeof(footer));
+  if (footer.magic != kSequenceFooterMagic) {
+    return ErrorStatus("Invalid sequence container footer.");
+  }
+  // Containers before version 1.1 don't have the static layer entry.
+  const uint64_t num_entries =
+      static_cast<uint64_t>(footer.num_frames) + (version_minor > 0 ? 1 : 0);
+  const size_t frame_table_end = data_size - sizeof(SequenceFooter);
+  if (footer.frame_table_offset < frames_begin ||
+      footer.frame_table_offset > frame_table_end ||
+      frame_table_end - footer.frame_table_offset !=
+          sizeof(SequenceFrameEntry) * num_entries) {
+    return Status(Status::IO_ERROR, kIoErrorMsg);
+  }
+  if (version_minor > 0) {
+    SequenceFrameEntry static_layer;
+    memcpy(&static_layer, data + frame_table_end - sizeof(static_layer),
+           sizeof(static_layer));
+    if (static_layer.size > 0 &&
+        (static_layer.offset < frames_begin ||
+         static_layer.offset > footer.frame_table_offset ||
+         static_layer.size > footer.frame_table_offset - static_layer.offset)) {
+      return ErrorStatus("Invalid sequence static layer.");
+    }
+    static_layer_ = static_layer;
+  }
+  frames_.resize(footer.num_frames);
+  if (footer.num_frames > 0) {
+    memcpy(frames_.data(), data + footer.frame_table_offset,
+           sizeof(SequenceFrameEntry) * footer.num_frames);
+  }
+  for (uint32_t i = 0; i < footer.num_frames; ++i) {
+    const SequenceFrameEntry &entry = frames_[i];
+    if (entry.offset < frames_begin ||
+        entry.offset > footer.frame_table_offset ||
+        entry.size > footer.frame_table_offset - entry.offset ||
+        entry.keyframe > i || frames_[entry.keyframe].keyframe !=
+                                  entry.keyframe) {
+      frames_.clear();
+      return ErrorStatus("Invalid sequence frame table.");
+    }
+  }
+  return OkStatus();
+}
+
+void SequenceReader::InitFrameBuffer(int frame_id,
+                                     DecoderBuffer *out_buffer) const {
+  out_buffer->Init(GetFrameData(frame_id), GetFrameSize(frame_id));
+}
+
+StatusOr<std::unique_ptr<PointCloud>> SequenceReader::DecodeFrame(
+    int frame_id, Decoder *decoder) const {
+  if (frame_id < 0 || frame_id >= num_frames()) {
+    return ErrorStatus("Invalid sequence frame id.");
+  }
+  header_.ApplyToDecoderOptions(decoder->options());
+  DecoderBuffer buffer;
+  InitFrameBuffer(frame_id, &buffer);
+  return decoder->DecodePointCloudFromBuffer(&buffer);
+}
+
+StatusOr<std::unique_ptr<PointCloud>> SequenceReader::DecodeFrame(
+    int frame_id, const PointCloud &static_layer, Decoder *decoder) const {
+  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloud> frame,
+                         DecodeFrame(frame_id, decoder));
+  return MergeLayers(static_layer, *frame);
+}
+
+StatusOr<std::unique_ptr<PointCloud>> SequenceReader::DecodeStaticLayer(
+    Decoder *decoder) const {
+  if (!has_static_layer()) {
+    return ErrorStatus("Sequence doesn't have a static layer.");
+  }
+  header_.ApplyToDecoderOptions(decoder->options());
+  DecoderBuffer buffer;
+  buffer.Init(GetStaticLayerData(), GetStaticLayerSize());
+  return decoder->DecodePointCloudFromBuffer(&buffer);
+}
+
+}  // namespace draco
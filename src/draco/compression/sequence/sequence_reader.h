@@ -0,0 +1,98 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_SEQUENCE_SEQUENCE_READER_H_
+#define DRACO_COMPRESSION_SEQUENCE_SEQUENCE_READER_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/sequence/sequence_container.h"
+#include "draco/compression/sequence/sequence_header.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/core/status_or.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Provides random access to frames of a sequence container written by
+// SequenceWriter. The reader doesn't copy the container data. Frames are
+// decoded directly from the memory passed to Init(), which can be for example
+// a memory mapped file.
+class SequenceReader {
+ public:
+  SequenceReader();
+
+  // Parses the sequence header and the frame table of a container stored in
+  // |data|. |data| must stay valid for the lifetime of the reader.
+  Status Init(const char *data, size_t data_size);
+
+  const SequenceHeader &header() const { return header_; }
+  int num_frames() const { return static_cast<int>(frames_.size()); }
+
+  bool IsKeyframe(int frame_id) const {
+    return frames_[frame_id].keyframe == static_cast<uint32_t>(frame_id);
+  }
+
+  // Returns the index of the closest keyframe at or before |frame_id|.
+  int GetKeyframe(int frame_id) const { return frames_[frame_id].keyframe; }
+
+  // Returns the byte range of |frame_id| within the container data.
+  const char *GetFrameData(int frame_id) const {
+    return data_ + frames_[frame_id].offset;
+  }
+  size_t GetFrameSize(int frame_id) const { return frames_[frame_id].size; }
+
+  // Initializes |out_buffer| with the bitstream of |frame_id| without copying
+  // any data.
+  void InitFrameBuffer(int frame_id, DecoderBuffer *out_buffer) const;
+
+  // Decodes |frame_id| with |decoder|. The shared quantization grids of the
+  // sequence header are applied to the decoder options before decoding.
+  StatusOr<std::unique_ptr<PointCloud>> DecodeFrame(int frame_id,
+                                                    Decoder *decoder) const;
+
+  // Decodes |frame_id| and merges it with |static_layer| that was decoded
+  // earlier with DecodeStaticLayer(). The returned point cloud contains all
+  // points of |static_layer| followed by the points of the frame. Decoding
+  // the static layer once and reusing it for all frames avoids decoding the
+  // static points again for every frame.
+  StatusOr<std::unique_ptr<PointCloud>> DecodeFrame(
+      int frame_id, const PointCloud &static_layer, Decoder *decoder) const;
+
+  // Returns true when the sequence has a static layer shared by all frames.
+  bool has_static_layer() const { return static_layer_.size > 0; }
+
+  // Returns the byte range of the static layer within the container data.
+  const char *GetStaticLayerData() const {
+    return data_ + static_layer_.offset;
+  }
+  size_t GetStaticLayerSize() const { return static_layer_.size; }
+
+  // Decodes the static layer with |decoder|.
+  StatusOr<std::unique_ptr<PointCloud>> DecodeStaticLayer(
+      Decoder *decoder) const;
+
+ private:
+  const char *data_;
+  SequenceHeader header_;
+  std::vector<SequenceFrameEntry> frames_;
+  SequenceFrameEntry static_layer_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_SEQUENCE_SEQUENCE_READER_H_
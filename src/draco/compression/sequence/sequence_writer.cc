@@ -0,0 +1,125 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/sequence/sequence_writer.h"
+
+#include <limits>
+
+#include "draco/compression/expert_encode.h"
+
+namespace draco {
+
+SequenceWriter::SequenceWriter() : out_buffer_(nullptr), start_offset_(0) {
+  static_layer_ = {0, 0, 0};
+}
+
+Status SequenceWriter::Start(const SequenceHeader &header,
+                             EncoderBuffer *out_buffer) {
+  header_ = header;
+  out_buffer_ = out_buffer;
+  start_offset_ = out_buffer->size();
+  frames_.clear();
+  static_layer_ = {0, 0, 0};
+  EncoderBuffer header_buffer;
+  DRACO_RETURN_IF_ERROR(header.Encode(&header_buffer));
+  out_buffer->Encode(kSequenceContainerString, 8);
+  out_buffer->Encode(kSequenceContainerVersionMajor);
+  out_buffer->Encode(kSequenceContainerVersionMinor);
+  out_buffer->Encode(static_cast<uint16_t>(0));
+  out_buffer->Encode(static_cast<uint32_t>(header_buffer.size()));
+  out_buffer->Encode(header_buffer.data(), header_buffer.size());
+  return OkStatus();
+}
+
+Status SequenceWriter::EncodeFrame(const PointCloud &pc,
+                                   const EncoderOptions &options,
+                                   bool is_keyframe) {
+  EncoderBuffer frame_buffer;
+  DRACO_RETURN_IF_ERROR(EncodeLayer(pc, options, &frame_buffer));
+  return AddEncodedFrame(frame_buffer.data(), frame_buffer.size(),
+                         is_keyframe);
+}
+
+Status SequenceWriter::EncodeStaticLayer(const PointCloud &pc,
+                                         const EncoderOptions &options) {
+  EncoderBuffer layer_buffer;
+  DRACO_RETURN_IF_ERROR(EncodeLayer(pc, options, &layer_buffer));
+  return AddEncodedStaticLayer(layer_buffer.data(), layer_buffer.size());
+}
+
+Status SequenceWriter::AddEncodedFrame(const char *data, size_t size,
+                                       bool is_keyframe) {
+  SequenceFrameEntry entry;
+  DRACO_RETURN_IF_ERROR(AppendBitstream(data, size, &entry));
+  const uint32_t frame_id = static_cast<uint32_t>(frames_.size());
+  // The first frame is always a keyframe.
+  entry.keyframe =
+      (is_keyframe || frames_.empty()) ? frame_id : frames_.back().keyframe;
+  frames_.push_back(entry);
+  return OkStatus();
+}
+
+Status SequenceWriter::AddEncodedStaticLayer(const char *data, size_t size) {
+  if (static_layer_.size > 0) {
+    return ErrorStatus("Sequence already has a static layer.");
+  }
+  if (size == 0) {
+    return ErrorStatus("Empty static layer.");
+  }
+  return AppendBitstream(data, size, &static_layer_);
+}
+
+Status SequenceWriter::Finish() {
+  if (out_buffer_ == nullptr) {
+    return ErrorStatus("Sequence writer was not started.");
+  }
+  SequenceFooter footer;
+  footer.frame_table_offset = out_buffer_->size() - start_offset_;
+  footer.num_frames = static_cast<uint32_t>(frames_.size());
+  footer.magic = kSequenceFooterMagic;
+  out_buffer_->Encode(frames_.data(),
+                      sizeof(SequenceFrameEntry) * frames_.size());
+  out_buffer_->Encode(static_layer_);
+  out_buffer_->Encode(footer);
+  out_buffer_ = nullptr;
+  return OkStatus();
+}
+
+Status SequenceWriter::EncodeLayer(const PointCloud &pc,
+                                   const EncoderOptions &options,
+                                   EncoderBuffer *out_buffer) const {
+  DRACO_RETURN_IF_ERROR(header_.CheckAttributeLayout(pc));
+  EncoderOptions layer_options = options;
+  DRACO_RETURN_IF_ERROR(header_.ApplyToEncoderOptions(pc, &layer_options));
+  ExpertEncoder encoder(pc);
+  encoder.Reset(layer_options);
+  return encoder.EncodeToBuffer(out_buffer);
+}
+
+Status SequenceWriter::AppendBitstream(const char *data, size_t size,
+                                       SequenceFrameEntry *out_entry) {
+  if (out_buffer_ == nullptr) {
+    return ErrorStatus("Sequence writer was not started.");
+  }
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    return ErrorStatus("Sequence frame is too large.");
+  }
+  out_entry->offset = out_buffer_->size() - start_offset_;
+  out_entry->size = static_cast<uint32_t>(size);
+  out_entry->keyframe = 0;
+  out_buffer_->Encode(data, size);
+  return OkStatus();
+}
+
+}  // namespace draco
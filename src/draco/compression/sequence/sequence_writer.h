@@ -0,0 +1,94 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_SEQUENCE_SEQUENCE_WRITER_H_
+#define DRACO_COMPRESSION_SEQUENCE_SEQUENCE_WRITER_H_
+
+#include <vector>
+
+#include "draco/compression/config/encoder_options.h"
+#include "draco/compression/sequence/sequence_container.h"
+#include "draco/compression/sequence/sequence_header.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Writes frames of a sequence into a single seekable container (see
+// sequence_container.h). The SequenceHeader with the attribute layout and the
+// shared quantization grids is stored only once for all frames.
+//
+// Usage:
+//   SequenceWriter writer;
+//   DRACO_RETURN_IF_ERROR(writer.Start(header, &out_buffer));
+//   for (int f = 0; f < num_frames; ++f) {
+//     DRACO_RETURN_IF_ERROR(
+//         writer.EncodeFrame(*frames[f], options, f % 30 == 0));
+//   }
+//   DRACO_RETURN_IF_ERROR(writer.Finish());
+class SequenceWriter {
+ public:
+  SequenceWriter();
+
+  // Starts a new container in |out_buffer|. The buffer must stay valid until
+  // Finish() is called.
+  Status Start(const SequenceHeader &header, EncoderBuffer *out_buffer);
+
+  // Encodes |pc| with |options| and appends it as a new frame. The shared
+  // quantization grids of the header are applied to |options| and |pc| must
+  // match the attribute layout of the header.
+  Status EncodeFrame(const PointCloud &pc, const EncoderOptions &options,
+                     bool is_keyframe);
+
+  // Appends a frame that was already encoded with the shared header.
+  Status AddEncodedFrame(const char *data, size_t size, bool is_keyframe);
+
+  // Encodes |pc| with |options| as the static layer of the sequence, which
+  // contains the points shared by all frames. Can be called at most once at
+  // any point before Finish(). The same requirements as for EncodeFrame()
+  // apply to |pc|.
+  Status EncodeStaticLayer(const PointCloud &pc,
+                           const EncoderOptions &options);
+
+  // Sets a static layer that was already encoded with the shared header.
+  Status AddEncodedStaticLayer(const char *data, size_t size);
+
+  // Writes the frame table and completes the container.
+  Status Finish();
+
+  int num_frames() const { return static_cast<int>(frames_.size()); }
+
+ private:
+  // Encodes |pc| using the shared quantization grids of the header.
+  Status EncodeLayer(const PointCloud &pc, const EncoderOptions &options,
+                     EncoderBuffer *out_buffer) const;
+
+  // Appends a bitstream to the container and stores its location in
+  // |out_entry|.
+  Status AppendBitstream(const char *data, size_t size,
+                         SequenceFrameEntry *out_entry);
+
+  SequenceHeader header_;
+  EncoderBuffer *out_buffer_;
+  // Position of the container start in |out_buffer_|.
+  size_t start_offset_;
+  std::vector<SequenceFrameEntry> frames_;
+  // Entry of the static layer. Its size is zero when there is no static layer.
+  SequenceFrameEntry static_layer_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_SEQUENCE_SEQUENCE_WRITER_H_
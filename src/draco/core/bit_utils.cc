@@ -14,6 +14,10 @@
 //
 #include "draco/core/bit_utils.h"
 
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
 namespace draco {
 
 void ConvertSignedIntsToSymbols(const int32_t *in, int in_values,
@@ -28,7 +32,17 @@ void ConvertSignedIntsToSymbols(const int32_t *in, int in_values,
 
 void ConvertSymbolsToSignedInts(const uint32_t *in, int in_values,
                                 int32_t *out) {
-  for (int i = 0; i < in_values; ++i) {
+  int i = 0;
+#ifdef __wasm_simd128__
+  // Same as ConvertSymbolToSignedInt(): (val >> 1) ^ -(val & 1).
+  const v128_t one = wasm_i32x4_splat(1);
+  for (; i + 4 <= in_values; i += 4) {
+    const v128_t val = wasm_v128_load(in + i);
+    const v128_t sign = wasm_i32x4_neg(wasm_v128_and(val, one));
+    wasm_v128_store(out + i, wasm_v128_xor(wasm_u32x4_shr(val, 1), sign));
+  }
+#endif
+  for (; i < in_values; ++i) {
     out[i] = ConvertSymbolToSignedInt(in[i]);
   }
 }
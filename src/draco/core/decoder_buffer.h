@@ -161,6 +161,19 @@ class DecoderBuffer {
       if (nbits > 32) {
         return false;
       }
+      const size_t byte_offset = bit_offset_ >> 3;
+      if (byte_offset + sizeof(uint64_t) <=
+          static_cast<size_t>(bit_buffer_end_ - bit_buffer_)) {
+        // Fast path that reads all bits at once. The bits are stored starting
+        // from the least significant bit of each byte so the bytes can be
+        // loaded as a little-endian word.
+        uint64_t word;
+        memcpy(&word, bit_buffer_ + byte_offset, sizeof(word));
+        word >>= bit_offset_ & 0x7;
+        *x = static_cast<uint32_t>(word & ((uint64_t{1} << nbits) - 1));
+        bit_offset_ += nbits;
+        return true;
+      }
       uint32_t value = 0;
       for (uint32_t bit = 0; bit < nbits; ++bit) {
         value |= GetBit() << bit;
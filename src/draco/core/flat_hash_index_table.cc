@@ -0,0 +1,74 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/flat_hash_index_table.h"
+
+namespace draco {
+
+namespace {
+
+// Maximum load factor of the table is 7/8.
+size_t GetMaxNumEntries(size_t num_slots) { return num_slots - num_slots / 8; }
+
+}  // namespace
+
+FlatHashIndexTable::FlatHashIndexTable()
+    : group_mask_(0), num_entries_(0), max_num_entries_(0) {}
+
+void FlatHashIndexTable::Init(size_t expected_num_entries) {
+  size_t num_groups = 1;
+  while (GetMaxNumEntries(num_groups * kGroupSize) < expected_num_entries) {
+    num_groups *= 2;
+  }
+  Group empty_group;
+  for (int i = 0; i < kGroupSize; ++i) {
+    empty_group.hashes[i] = 0;
+    empty_group.indices[i] = kInvalidIndex;
+  }
+  groups_.assign(num_groups, empty_group);
+  group_mask_ = num_groups - 1;
+  num_entries_ = 0;
+  max_num_entries_ = GetMaxNumEntries(num_groups * kGroupSize);
+}
+
+void FlatHashIndexTable::InsertUnique(uint32_t hash, uint32_t index) {
+  size_t group_id = hash & group_mask_;
+  for (size_t step = 1;; ++step) {
+    Group &group = groups_[group_id];
+    for (int i = 0; i < kGroupSize; ++i) {
+      if (group.indices[i] == kInvalidIndex) {
+        group.hashes[i] = hash;
+        group.indices[i] = index;
+        ++num_entries_;
+        return;
+      }
+    }
+    group_id = (group_id + step) & group_mask_;
+  }
+}
+
+void FlatHashIndexTable::Grow() {
+  std::vector<Group> old_groups;
+  old_groups.swap(groups_);
+  Init(old_groups.empty() ? 1 : 2 * max_num_entries_);
+  for (const Group &group : old_groups) {
+    for (int i = 0; i < kGroupSize; ++i) {
+      if (group.indices[i] != kInvalidIndex) {
+        InsertUnique(group.hashes[i], group.indices[i]);
+      }
+    }
+  }
+}
+
+}  // namespace draco
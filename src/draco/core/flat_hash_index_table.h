@@ -0,0 +1,107 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_FLAT_HASH_INDEX_TABLE_H_
+#define DRACO_CORE_FLAT_HASH_INDEX_TABLE_H_
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace draco {
+
+// Open-addressing hash table that stores uint32_t indices of entries kept by
+// the caller, e.g. attribute values or points. It is meant for deduplication
+// where each entry is looked up once and inserted when it is not found, and
+// it doesn't support removal of entries.
+//
+// Slots are arranged in groups of eight. Each group stores the full hashes and
+// the indices of its entries in a single 64-byte block, so a probe of a group
+// reads at most two cache lines and calls the caller comparison only for
+// entries with a matching hash. Groups are probed in triangular order and
+// filled from their first slot, which keeps the probe sequences short even at
+// high load factors.
+class FlatHashIndexTable {
+ public:
+  FlatHashIndexTable();
+
+  // Clears the table and prepares it for |expected_num_entries| entries. The
+  // table grows automatically when more entries are inserted.
+  void Init(size_t expected_num_entries);
+
+  // Returns the index of an entry with |hash| for which |is_equal(index)|
+  // returns true. If there is no such entry, |new_index| is inserted and
+  // returned. |hash| should have well mixed bits, see MixHash(). |new_index|
+  // must not be kInvalidIndex.
+  template <typename IsEqualT>
+  uint32_t FindOrInsert(uint32_t hash, uint32_t new_index,
+                        const IsEqualT &is_equal);
+
+  size_t num_entries() const { return num_entries_; }
+
+  static constexpr uint32_t kInvalidIndex = 0xffffffff;
+
+ private:
+  static constexpr int kGroupSize = 8;
+
+  struct Group {
+    uint32_t hashes[kGroupSize];
+    // Indices of the entries or kInvalidIndex for empty slots.
+    uint32_t indices[kGroupSize];
+  };
+
+  // Inserts an entry that is known not to be in the table.
+  void InsertUnique(uint32_t hash, uint32_t index);
+
+  // Doubles the number of slots and reinserts all entries.
+  void Grow();
+
+  std::vector<Group> groups_;
+  size_t group_mask_;
+  size_t num_entries_;
+  size_t max_num_entries_;
+};
+
+template <typename IsEqualT>
+uint32_t FlatHashIndexTable::FindOrInsert(uint32_t hash, uint32_t new_index,
+                                          const IsEqualT &is_equal) {
+  if (num_entries_ >= max_num_entries_) {
+    Grow();
+  }
+  size_t group_id = hash & group_mask_;
+  // Triangular probing visits every group when the number of groups is a
+  // power of two.
+  for (size_t step = 1;; ++step) {
+    Group &group = groups_[group_id];
+    for (int i = 0; i < kGroupSize; ++i) {
+      const uint32_t index = group.indices[i];
+      if (index == kInvalidIndex) {
+        // Entries are never removed so an empty slot ends the probe sequence.
+        group.hashes[i] = hash;
+        group.indices[i] = new_index;
+        ++num_entries_;
+        return new_index;
+      }
+      if (group.hashes[i] == hash && is_equal(index)) {
+        return index;
+      }
+    }
+    group_id = (group_id + step) & group_mask_;
+  }
+}
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_FLAT_HASH_INDEX_TABLE_H_
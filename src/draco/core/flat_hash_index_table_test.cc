@@ -0,0 +1,78 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/flat_hash_index_table.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/hash_utils.h"
+
+namespace {
+
+// Inserts |keys| into |table| and returns the index assigned to each key.
+// |hash_mask| limits the number of distinct hashes to test collisions.
+std::vector<uint32_t> InsertKeys(const std::vector<int> &keys,
+                                 uint32_t hash_mask,
+                                 draco::FlatHashIndexTable *table) {
+  std::vector<int> unique_keys;
+  std::vector<uint32_t> indices;
+  for (const int key : keys) {
+    const uint32_t hash =
+        draco::HashBytes(&key, sizeof(key)) & hash_mask;
+    const uint32_t index = table->FindOrInsert(
+        hash, static_cast<uint32_t>(unique_keys.size()),
+        [&](uint32_t i) { return unique_keys[i] == key; });
+    if (index == unique_keys.size()) {
+      unique_keys.push_back(key);
+    }
+    indices.push_back(index);
+  }
+  return indices;
+}
+
+TEST(FlatHashIndexTableTest, TestFindOrInsert) {
+  // Each key repeats three times and unique keys get consecutive indices in
+  // the order of their first occurrence.
+  constexpr int kNumKeys = 1000;
+  std::vector<int> keys;
+  for (int i = 0; i < 3 * kNumKeys; ++i) {
+    keys.push_back((i * 7919) % kNumKeys);
+  }
+  std::vector<uint32_t> expected_indices(keys.size());
+  std::vector<int> first_index(kNumKeys, -1);
+  int num_unique = 0;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (first_index[keys[i]] < 0) {
+      first_index[keys[i]] = num_unique++;
+    }
+    expected_indices[i] = first_index[keys[i]];
+  }
+
+  // Test a table that is sized upfront, a table that needs to grow from its
+  // default state and tables where many keys share the same hash.
+  for (const uint32_t hash_mask : {0xffffffffu, 0xfe000003u, 0u}) {
+    draco::FlatHashIndexTable sized_table;
+    sized_table.Init(kNumKeys);
+    ASSERT_EQ(InsertKeys(keys, hash_mask, &sized_table), expected_indices);
+    ASSERT_EQ(sized_table.num_entries(), kNumKeys);
+
+    draco::FlatHashIndexTable growing_table;
+    ASSERT_EQ(InsertKeys(keys, hash_mask, &growing_table), expected_indices);
+    ASSERT_EQ(growing_table.num_entries(), kNumKeys);
+  }
+}
+
+}  // namespace
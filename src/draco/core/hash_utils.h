@@ -18,6 +18,7 @@
 #include <stdint.h>
 
 #include <cstddef>
+#include <cstring>
 #include <functional>
 
 namespace draco {
@@ -39,6 +40,35 @@ inline uint64_t HashCombine(uint64_t a, uint64_t b) {
   return (a + 1013) ^ (b + 107) << 1;
 }
 
+// Mixes all bits of |hash| into the returned 32 bits (the finalizer of
+// MurmurHash3). Used when the low bits of the hash select a hash table slot.
+inline uint32_t MixHash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ull;
+  hash ^= hash >> 33;
+  return static_cast<uint32_t>(hash);
+}
+
+// Hashes |size| bytes of |data|. Meant for short keys like attribute values.
+inline uint32_t HashBytes(const void *data, size_t size) {
+  const uint8_t *const bytes = static_cast<const uint8_t *>(data);
+  uint64_t hash = size;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    memcpy(&word, bytes + i, 8);
+    hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+  }
+  if (i < size) {
+    uint64_t word = 0;
+    memcpy(&word, bytes + i, size - i);
+    hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+  }
+  return MixHash(hash);
+}
+
 // Will never return 1 or 0.
 uint64_t FingerprintString(const char *s, size_t len);
 
@@ -14,6 +14,12 @@
 //
 #include "draco/core/quantization_utils.h"
 
+#include <vector>
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
 namespace draco {
 
 Quantizer::Quantizer() : inverse_delta_(1.f) {}
@@ -39,4 +45,36 @@ bool Dequantizer::Init(float delta) {
   return true;
 }
 
+void Dequantizer::DequantizeFloats(const int32_t *in, int num_values,
+                                   int num_components, const float *offsets,
+                                   float *out) const {
+  const int64_t num_entries = static_cast<int64_t>(num_values) * num_components;
+  int64_t i = 0;
+#ifdef __wasm_simd128__
+  // Four entries span exactly |num_components| vectors, so the offsets of
+  // each vector repeat every four entries.
+  std::vector<float> vector_offsets(4 * num_components);
+  for (int j = 0; j < 4 * num_components; ++j) {
+    vector_offsets[j] = offsets[j % num_components];
+  }
+  const v128_t delta = wasm_f32x4_splat(delta_);
+  const int64_t block_size = 4 * num_components;
+  for (; block_size > 0 && i + block_size <= num_entries; i += block_size) {
+    for (int j = 0; j < block_size; j += 4) {
+      const v128_t values =
+          wasm_f32x4_convert_i32x4(wasm_v128_load(in + i + j));
+      wasm_v128_store(out + i + j,
+                      wasm_f32x4_add(wasm_f32x4_mul(values, delta),
+                                     wasm_v128_load(&vector_offsets[j])));
+    }
+  }
+#endif
+  for (int c = 0; i < num_entries; ++i) {
+    out[i] = DequantizeFloat(in[i]) + offsets[c];
+    if (++c == num_components) {
+      c = 0;
+    }
+  }
+}
+
 }  // namespace draco
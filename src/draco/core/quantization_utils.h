@@ -73,6 +73,12 @@ class Dequantizer {
   }
   inline float operator()(int32_t val) const { return DequantizeFloat(val); }
 
+  // Dequantizes |num_values| entries of |num_components| components each from
+  // |in| and adds |offsets|[c] to component c of every entry. The result is
+  // the same as calling DequantizeFloat() for each component.
+  void DequantizeFloats(const int32_t *in, int num_values, int num_components,
+                        const float *offsets, float *out) const;
+
  private:
   float delta_;
 };
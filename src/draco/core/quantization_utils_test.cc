@@ -14,6 +14,8 @@
 //
 #include "draco/core/quantization_utils.h"
 
+#include <vector>
+
 #include "draco/core/draco_test_base.h"
 
 namespace draco {
@@ -88,4 +90,28 @@ TEST_F(QuantizationUtilsTest, TestDeltaQuantization) {
             dequantizer_range.DequantizeFloat(0));
 }
 
+TEST_F(QuantizationUtilsTest, TestDequantizeFloats) {
+  // Test verifies that dequantization of multiple values gives the same
+  // results as dequantization of the individual values for all numbers of
+  // values and components.
+  Dequantizer dequantizer;
+  ASSERT_TRUE(dequantizer.Init(3.7f, 4095));
+  const float offsets[5] = {-1.5f, 2.25f, 0.1f, -7.f, 3.f};
+  for (int num_components = 1; num_components <= 5; ++num_components) {
+    for (int num_values = 0; num_values < 11; ++num_values) {
+      std::vector<int32_t> in(num_values * num_components);
+      for (size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<int32_t>((i * 7919) % 8191) - 4095;
+      }
+      std::vector<float> out(in.size());
+      dequantizer.DequantizeFloats(in.data(), num_values, num_components,
+                                   offsets, out.data());
+      for (size_t i = 0; i < in.size(); ++i) {
+        ASSERT_EQ(out[i], dequantizer.DequantizeFloat(in[i]) +
+                              offsets[i % num_components]);
+      }
+    }
+  }
+}
+
 }  // namespace draco
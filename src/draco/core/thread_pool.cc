@@ -0,0 +1,115 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace draco {
+
+ThreadPool::ThreadPool(int num_threads) : num_pending_tasks_(0), stop_(false) {
+  num_threads = std::min(num_threads, GetDefaultNumThreads());
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_available_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+  if (workers_.empty()) {
+    task();
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+    ++num_pending_tasks_;
+  }
+  task_available_.notify_one();
+}
+
+void ThreadPool::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  tasks_finished_.wait(lock, [this]() { return num_pending_tasks_ == 0; });
+}
+
+int ThreadPool::GetDefaultNumThreads() {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+  return 0;
+#else
+  return static_cast<int>(std::thread::hardware_concurrency());
+#endif
+}
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_available_.wait(lock,
+                           [this]() { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;  // |stop_| was set and there is no more work.
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+    bool all_finished;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      all_finished = --num_pending_tasks_ == 0;
+    }
+    if (all_finished) {
+      tasks_finished_.notify_all();
+    }
+  }
+}
+
+void ParallelFor(int num_items, int num_threads,
+                 const std::function<void(int)> &func) {
+  num_threads = std::min(num_threads, num_items);
+  if (num_threads <= 1) {
+    for (int i = 0; i < num_items; ++i) {
+      func(i);
+    }
+    return;
+  }
+  // Items are distributed dynamically because the processing time of the
+  // individual items can be very different.
+  std::atomic<int> next_item(0);
+  ThreadPool pool(num_threads);
+  for (int t = 0; t < std::max(pool.num_threads(), 1); ++t) {
+    pool.Schedule([&]() {
+      for (int i = next_item++; i < num_items; i = next_item++) {
+        func(i);
+      }
+    });
+  }
+  pool.Wait();
+}
+
+}  // namespace draco
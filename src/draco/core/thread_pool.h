@@ -0,0 +1,81 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_THREAD_POOL_H_
+#define DRACO_CORE_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace draco {
+
+// Simple fixed size pool of worker threads. Tasks are executed in the order in
+// which they were scheduled, but they may finish in any order. When the pool
+// is created with zero threads (or when threads are not supported on the
+// target platform), all tasks are executed directly in Schedule().
+//
+// Usage:
+//   ThreadPool pool(ThreadPool::GetDefaultNumThreads());
+//   for (int i = 0; i < num_tasks; ++i) {
+//     pool.Schedule([i, &results]() { results[i] = Compute(i); });
+//   }
+//   pool.Wait();
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Adds a new task to the queue.
+  void Schedule(std::function<void()> task);
+
+  // Blocks until all scheduled tasks are finished.
+  void Wait();
+
+  int num_threads() const { return static_cast<int>(workers_.size()); }
+
+  // Returns the number of hardware threads available on the system or 0 if
+  // threads are not supported.
+  static int GetDefaultNumThreads();
+
+ private:
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  // Signaled when a new task is added or when the pool is being destroyed.
+  std::condition_variable task_available_;
+  // Signaled when all tasks are finished.
+  std::condition_variable tasks_finished_;
+  // Number of tasks that are either queued or being executed.
+  int num_pending_tasks_;
+  bool stop_;
+};
+
+// Calls |func| for all indices in range <0, num_items) using up to
+// |num_threads| threads. Each index is processed exactly once. The function
+// returns after all indices are processed.
+void ParallelFor(int num_items, int num_threads,
+                 const std::function<void(int)> &func);
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_THREAD_POOL_H_
@@ -0,0 +1,94 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/trace.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+namespace draco {
+
+namespace {
+
+std::atomic<TraceSink *> trace_sink(nullptr);
+
+// Returns a small integer identifying the calling thread.
+uint32_t GetTraceThreadId() {
+  static std::atomic<uint32_t> next_thread_id(1);
+  thread_local const uint32_t thread_id = next_thread_id++;
+  return thread_id;
+}
+
+}  // namespace
+
+void SetTraceSink(TraceSink *sink) {
+  trace_sink.store(sink, std::memory_order_release);
+}
+
+TraceSink *GetTraceSink() { return trace_sink.load(std::memory_order_acquire); }
+
+int64_t GetTraceTimeUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void TraceSpan::Finish() {
+  event_.duration_us = GetTraceTimeUs() - event_.start_us;
+  event_.thread_id = GetTraceThreadId();
+  sink_->OnEvent(event_);
+}
+
+void ChromeTraceWriter::OnEvent(const TraceEvent &event) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  events_.push_back(event);
+}
+
+std::string ChromeTraceWriter::ToJson() const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  std::string json = "{\"traceEvents\": [";
+  char buffer[256];
+  for (size_t i = 0; i < events_.size(); ++i) {
+    const TraceEvent &event = events_[i];
+    // Span names are string literals that don't need escaping.
+    snprintf(buffer, sizeof(buffer),
+             "%s\n  {\"name\": \"%s\", \"cat\": \"draco\", \"ph\": \"X\", "
+             "\"ts\": %" PRId64 ", \"dur\": %" PRId64
+             ", \"pid\": 1, \"tid\": %u",
+             i == 0 ? "" : ",", event.name, event.start_us, event.duration_us,
+             event.thread_id);
+    json += buffer;
+    if (event.arg_name != nullptr) {
+      snprintf(buffer, sizeof(buffer), ", \"args\": {\"%s\": %" PRId64 "}",
+               event.arg_name, event.arg_value);
+      json += buffer;
+    }
+    json += "}";
+  }
+  json += "\n]}\n";
+  return json;
+}
+
+void ChromeTraceWriter::Clear() {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  events_.clear();
+}
+
+size_t ChromeTraceWriter::num_events() const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return events_.size();
+}
+
+}  // namespace draco
@@ -0,0 +1,126 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_TRACE_H_
+#define DRACO_CORE_TRACE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "draco/draco_features.h"
+
+namespace draco {
+
+// A single completed span. Times are in microseconds since an arbitrary
+// steady clock origin.
+struct TraceEvent {
+  // Name of the span. Must point to a string with static storage duration.
+  const char *name;
+  // Optional integer argument of the span (such as an attribute id). Ignored
+  // when |arg_name| is nullptr.
+  const char *arg_name;
+  int64_t arg_value;
+  int64_t start_us;
+  int64_t duration_us;
+  // Identifier of the thread that recorded the span.
+  uint32_t thread_id;
+};
+
+// Interface of objects receiving completed spans. OnEvent() can be called
+// concurrently from multiple threads.
+class TraceSink {
+ public:
+  virtual ~TraceSink() = default;
+  virtual void OnEvent(const TraceEvent &event) = 0;
+};
+
+// Sets the sink receiving all spans recorded by the library. Pass nullptr to
+// stop the recording. The sink must outlive all spans recorded while it is
+// set.
+void SetTraceSink(TraceSink *sink);
+TraceSink *GetTraceSink();
+
+// Returns the current time of the trace clock in microseconds.
+int64_t GetTraceTimeUs();
+
+// Records the lifetime of the object as a span when a trace sink is set. Use
+// the DRACO_TRACE_SPAN macros below instead of using this class directly so
+// that the spans are compiled out when tracing is disabled.
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char *name) : TraceSpan(name, nullptr, 0) {}
+  TraceSpan(const char *name, const char *arg_name, int64_t arg_value)
+      : sink_(GetTraceSink()) {
+    if (sink_) {
+      event_.name = name;
+      event_.arg_name = arg_name;
+      event_.arg_value = arg_value;
+      event_.start_us = GetTraceTimeUs();
+    }
+  }
+  ~TraceSpan() {
+    if (sink_) {
+      Finish();
+    }
+  }
+
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+ private:
+  void Finish();
+
+  TraceSink *const sink_;
+  TraceEvent event_;
+};
+
+// Sink collecting the spans in memory and writing them in the Chrome trace
+// event format that can be loaded in chrome://tracing or Perfetto.
+class ChromeTraceWriter : public TraceSink {
+ public:
+  void OnEvent(const TraceEvent &event) override;
+
+  // Returns all collected events as a JSON document.
+  std::string ToJson() const;
+
+  void Clear();
+  size_t num_events() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<TraceEvent> events_;
+};
+
+}  // namespace draco
+
+// Macros for recording spans that last until the end of the current scope.
+// |name| must be a string literal. When DRACO_TRACING_SUPPORTED is not
+// defined, the macros expand to nothing.
+#define DRACO_TRACE_CONCAT_INNER(a, b) a##b
+#define DRACO_TRACE_CONCAT(a, b) DRACO_TRACE_CONCAT_INNER(a, b)
+#ifdef DRACO_TRACING_SUPPORTED
+#define DRACO_TRACE_SPAN(name) \
+  const ::draco::TraceSpan DRACO_TRACE_CONCAT(draco_trace_span_, __LINE__)(name)
+#define DRACO_TRACE_SPAN_ARG(name, arg_name, arg_value)                     \
+  const ::draco::TraceSpan DRACO_TRACE_CONCAT(draco_trace_span_, __LINE__)( \
+      name, arg_name, arg_value)
+#else
+#define DRACO_TRACE_SPAN(name)
+#define DRACO_TRACE_SPAN_ARG(name, arg_name, arg_value)
+#endif
+
+#endif  // DRACO_CORE_TRACE_H_
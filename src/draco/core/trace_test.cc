@@ -0,0 +1,72 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/trace.h"
+
+#include <string>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+TEST(TraceTest, TestSpansAreRecordedBySink) {
+  draco::ChromeTraceWriter writer;
+  {
+    // No sink is set so nothing is recorded.
+    const draco::TraceSpan span("Ignored");
+  }
+  draco::SetTraceSink(&writer);
+  {
+    const draco::TraceSpan outer("Outer");
+    const draco::TraceSpan inner("Inner", "attribute_id", 3);
+  }
+  draco::SetTraceSink(nullptr);
+  {
+    const draco::TraceSpan span("Ignored");
+  }
+  ASSERT_EQ(writer.num_events(), 2);
+
+  const std::string json = writer.ToJson();
+  // Inner span finishes first.
+  const size_t inner_pos = json.find("\"name\": \"Inner\"");
+  const size_t outer_pos = json.find("\"name\": \"Outer\"");
+  ASSERT_NE(inner_pos, std::string::npos);
+  ASSERT_NE(outer_pos, std::string::npos);
+  ASSERT_LT(inner_pos, outer_pos);
+  ASSERT_EQ(json.find("Ignored"), std::string::npos);
+  ASSERT_NE(json.find("\"args\": {\"attribute_id\": 3}"), std::string::npos);
+  ASSERT_NE(json.find("\"ph\": \"X\""), std::string::npos);
+  ASSERT_EQ(json.find("{\"traceEvents\": ["), 0);
+
+  writer.Clear();
+  ASSERT_EQ(writer.num_events(), 0);
+}
+
+TEST(TraceTest, TestMacros) {
+  draco::ChromeTraceWriter writer;
+  draco::SetTraceSink(&writer);
+  {
+    DRACO_TRACE_SPAN("Span");
+    DRACO_TRACE_SPAN_ARG("SpanWithArg", "value", 7);
+  }
+  draco::SetTraceSink(nullptr);
+#ifdef DRACO_TRACING_SUPPORTED
+  ASSERT_EQ(writer.num_events(), 2);
+#else
+  // Spans are compiled out.
+  ASSERT_EQ(writer.num_events(), 0);
+#endif
+}
+
+}  // namespace
@@ -0,0 +1,221 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/gaussian_attribute_utils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+namespace draco {
+
+namespace {
+
+struct GaussianAttributeName {
+  GeometryAttribute::Type type;
+  const char *name;
+};
+
+// Application-specific glTF attribute names must start with an underscore.
+const GaussianAttributeName kGaussianAttributeNames[] = {
+    {GeometryAttribute::SH_DC, "_SH_DC"},
+    {GeometryAttribute::SH_REST, "_SH_REST"},
+    {GeometryAttribute::OPACITY, "_OPACITY"},
+    {GeometryAttribute::SCALE, "_SCALE"},
+    {GeometryAttribute::ROTATION, "_ROTATION"},
+    {GeometryAttribute::AUX, "_AUX"},
+    {GeometryAttribute::SH_DC_IDX, "_SH_DC_IDX"},
+    {GeometryAttribute::SH_REST_IDX, "_SH_REST_IDX"},
+    {GeometryAttribute::SCALE_IDX, "_SCALE_IDX"},
+    {GeometryAttribute::ROTATION_IDX, "_ROTATION_IDX"},
+    {GeometryAttribute::INS, "_INS"},
+    {GeometryAttribute::OUTS, "_OUTS"}};
+
+GeometryAttribute::Type GetTypeFromGltfAttributeName(const std::string &name) {
+  for (const GaussianAttributeName &entry : kGaussianAttributeNames) {
+    if (name == entry.name) {
+      return entry.type;
+    }
+  }
+  return GeometryAttribute::INVALID;
+}
+
+}  // namespace
+
+bool GaussianAttributeUtils::IsGaussianAttribute(
+    GeometryAttribute::Type type) {
+  return !GetGltfAttributeName(type).empty();
+}
+
+std::string GaussianAttributeUtils::GetGltfAttributeName(
+    GeometryAttribute::Type type) {
+  for (const GaussianAttributeName &entry : kGaussianAttributeNames) {
+    if (entry.type == type) {
+      return entry.name;
+    }
+  }
+  return "";
+}
+
+std::string GaussianAttributeUtils::GetGltfAttributeName(
+    GeometryAttribute::Type type, int chunk) {
+  const std::string name = GetGltfAttributeName(type);
+  if (name.empty()) {
+    return name;
+  }
+  return name + "_" + std::to_string(chunk);
+}
+
+bool GaussianAttributeUtils::ParseGltfAttributeName(
+    const std::string &name, GeometryAttribute::Type *type, int *chunk) {
+  *type = GetTypeFromGltfAttributeName(name);
+  if (*type != GeometryAttribute::INVALID) {
+    *chunk = -1;
+    return true;
+  }
+  // Check for chunk suffix like "_SH_REST_3".
+  const size_t pos = name.rfind('_');
+  if (pos == std::string::npos || pos + 1 == name.size() ||
+      name.size() - pos > 4) {
+    return false;
+  }
+  int value = 0;
+  for (size_t i = pos + 1; i < name.size(); ++i) {
+    if (name[i] < '0' || name[i] > '9') {
+      return false;
+    }
+    value = value * 10 + (name[i] - '0');
+  }
+  *type = GetTypeFromGltfAttributeName(name.substr(0, pos));
+  if (*type == GeometryAttribute::INVALID) {
+    return false;
+  }
+  *chunk = value;
+  return true;
+}
+
+bool GaussianAttributeUtils::HasAttributesToSplit(const PointCloud &pc) {
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    const PointAttribute *const att = pc.attribute(i);
+    if (IsGaussianAttribute(att->attribute_type()) &&
+        att->num_components() > kMaxChunkComponents) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Status GaussianAttributeUtils::SplitAttributes(PointCloud *pc) {
+  uint32_t max_unique_id = 0;
+  std::vector<int> split_att_ids;
+  for (int i = 0; i < pc->num_attributes(); ++i) {
+    const PointAttribute *const att = pc->attribute(i);
+    max_unique_id = std::max(max_unique_id, att->unique_id());
+    if (IsGaussianAttribute(att->attribute_type()) &&
+        att->num_components() > kMaxChunkComponents) {
+      split_att_ids.push_back(i);
+    }
+  }
+
+  for (const int att_id : split_att_ids) {
+    const PointAttribute &att = *pc->attribute(att_id);
+    const int num_components = att.num_components();
+    const int component_size = DataTypeLength(att.data_type());
+    const size_t num_values = att.size();
+    for (int first = 0; first < num_components;
+         first += kMaxChunkComponents) {
+      const int chunk_components =
+          std::min(kMaxChunkComponents, num_components - first);
+      std::unique_ptr<PointAttribute> chunk(new PointAttribute());
+      chunk->Init(att.attribute_type(), chunk_components, att.data_type(),
+                  att.normalized(), num_values);
+      for (AttributeValueIndex avi(0); avi < num_values; ++avi) {
+        chunk->SetAttributeValue(
+            avi, att.GetAddress(avi) + first * component_size);
+      }
+      if (!att.is_mapping_identity()) {
+        chunk->SetExplicitMapping(pc->num_points());
+        for (PointIndex pi(0); pi < pc->num_points(); ++pi) {
+          chunk->SetPointMapEntry(pi, att.mapped_index(pi));
+        }
+      }
+      // New attributes would get unique ids based on their position that may
+      // collide with ids of existing attributes.
+      const int chunk_id = pc->AddAttribute(std::move(chunk));
+      pc->attribute(chunk_id)->set_unique_id(++max_unique_id);
+    }
+  }
+
+  // Delete the original attributes from the last one so that the ids of the
+  // remaining ones stay valid.
+  for (auto it = split_att_ids.rbegin(); it != split_att_ids.rend(); ++it) {
+    pc->DeleteAttribute(*it);
+  }
+  return OkStatus();
+}
+
+StatusOr<int> GaussianAttributeUtils::MergeAttributes(
+    const std::vector<int> &att_ids, PointCloud *pc) {
+  if (att_ids.empty()) {
+    return Status(Status::DRACO_ERROR, "No attributes to merge.");
+  }
+  const PointAttribute *const first_att = pc->attribute(att_ids[0]);
+  int num_components = 0;
+  uint32_t max_unique_id = 0;
+  for (const int att_id : att_ids) {
+    const PointAttribute *const att = pc->attribute(att_id);
+    if (att == nullptr ||
+        att->attribute_type() != first_att->attribute_type() ||
+        att->data_type() != first_att->data_type()) {
+      return Status(Status::DRACO_ERROR, "Incompatible attributes to merge.");
+    }
+    num_components += att->num_components();
+  }
+  if (num_components > 127) {
+    return Status(Status::DRACO_ERROR, "Too many components to merge.");
+  }
+  for (int i = 0; i < pc->num_attributes(); ++i) {
+    max_unique_id = std::max(max_unique_id, pc->attribute(i)->unique_id());
+  }
+
+  // The chunks can have different value mappings so the merged attribute
+  // stores one value per point.
+  const int component_size = DataTypeLength(first_att->data_type());
+  std::unique_ptr<PointAttribute> merged(new PointAttribute());
+  merged->Init(first_att->attribute_type(), num_components,
+               first_att->data_type(), first_att->normalized(),
+               pc->num_points());
+  std::vector<uint8_t> value(num_components * component_size);
+  for (PointIndex pi(0); pi < pc->num_points(); ++pi) {
+    uint8_t *dst = value.data();
+    for (const int att_id : att_ids) {
+      const PointAttribute *const att = pc->attribute(att_id);
+      const size_t size = att->num_components() * component_size;
+      memcpy(dst, att->GetAddressOfMappedIndex(pi), size);
+      dst += size;
+    }
+    merged->SetAttributeValue(AttributeValueIndex(pi.value()), value.data());
+  }
+
+  std::vector<int> sorted_att_ids = att_ids;
+  std::sort(sorted_att_ids.rbegin(), sorted_att_ids.rend());
+  for (const int att_id : sorted_att_ids) {
+    pc->DeleteAttribute(att_id);
+  }
+  const int merged_id = pc->AddAttribute(std::move(merged));
+  pc->attribute(merged_id)->set_unique_id(max_unique_id + 1);
+  return merged_id;
+}
+
+}  // namespace draco
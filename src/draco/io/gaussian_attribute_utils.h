@@ -0,0 +1,77 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_IO_GAUSSIAN_ATTRIBUTE_UTILS_H_
+#define DRACO_IO_GAUSSIAN_ATTRIBUTE_UTILS_H_
+
+#include <string>
+#include <vector>
+
+#include "draco/attributes/geometry_attribute.h"
+#include "draco/core/status_or.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Helper class for storing Gaussian splat attributes (SH_DC, SH_REST, OPACITY,
+// SCALE, ROTATION, ...) in containers such as glTF that only support
+// attributes with up to four components. Each Gaussian attribute type is
+// mapped to an application-specific glTF attribute name like "_SH_DC".
+// Attributes with more components (e.g. the 45 components of SH_REST) are
+// split into chunks of at most four components that are named with a chunk
+// suffix like "_SH_REST_3".
+class GaussianAttributeUtils {
+ public:
+  // Maximum number of components of an attribute stored in glTF.
+  static constexpr int kMaxChunkComponents = 4;
+
+  // Returns true when |type| is one of the Gaussian splat attribute types.
+  static bool IsGaussianAttribute(GeometryAttribute::Type type);
+
+  // Returns the glTF attribute name of Gaussian attribute |type| or an empty
+  // string when |type| is not a Gaussian attribute.
+  static std::string GetGltfAttributeName(GeometryAttribute::Type type);
+
+  // Returns the glTF attribute name of the |chunk|-th chunk of a split
+  // Gaussian attribute |type|.
+  static std::string GetGltfAttributeName(GeometryAttribute::Type type,
+                                          int chunk);
+
+  // Parses glTF attribute |name| of a Gaussian attribute. Returns false when
+  // |name| does not belong to a Gaussian attribute. Otherwise sets |type| and
+  // |chunk| that is -1 for attributes that were not split.
+  static bool ParseGltfAttributeName(const std::string &name,
+                                     GeometryAttribute::Type *type,
+                                     int *chunk);
+
+  // Returns true when |pc| contains Gaussian attributes with more than
+  // kMaxChunkComponents components.
+  static bool HasAttributesToSplit(const PointCloud &pc);
+
+  // Replaces each Gaussian attribute of |pc| that has more than
+  // kMaxChunkComponents components by consecutive attributes of the same type
+  // holding at most kMaxChunkComponents components each. The chunks are
+  // appended to |pc| in component order and get new unique ids.
+  static Status SplitAttributes(PointCloud *pc);
+
+  // Concatenates components of attributes |att_ids| of |pc| in the given order
+  // into a single attribute that replaces them. All attributes must have the
+  // same type and data type. Returns the id of the merged attribute.
+  static StatusOr<int> MergeAttributes(const std::vector<int> &att_ids,
+                                       PointCloud *pc);
+};
+
+}  // namespace draco
+
+#endif  // DRACO_IO_GAUSSIAN_ATTRIBUTE_UTILS_H_
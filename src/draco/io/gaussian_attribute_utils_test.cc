@@ -0,0 +1,137 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/gaussian_attribute_utils.h"
+
+#include <array>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/point_cloud/point_cloud_builder.h"
+
+namespace {
+
+constexpr int kNumShRestComponents = 45;
+
+std::unique_ptr<draco::PointCloud> CreateGaussians(int num_points) {
+  draco::PointCloudBuilder builder;
+  builder.Start(num_points);
+  const int pos_att_id = builder.AddAttribute(
+      draco::GeometryAttribute::POSITION, 3, draco::DT_FLOAT32);
+  const int sh_rest_att_id = builder.AddAttribute(
+      draco::GeometryAttribute::SH_REST, kNumShRestComponents,
+      draco::DT_FLOAT32);
+  const int opacity_att_id = builder.AddAttribute(
+      draco::GeometryAttribute::OPACITY, 1, draco::DT_FLOAT32);
+  for (draco::PointIndex i(0); i < num_points; ++i) {
+    const float pos[3] = {static_cast<float>(i.value()), 0.f, 1.f};
+    std::array<float, kNumShRestComponents> sh_rest;
+    for (int c = 0; c < kNumShRestComponents; ++c) {
+      sh_rest[c] = i.value() * 100.f + c;
+    }
+    const float opacity = 0.25f * i.value();
+    builder.SetAttributeValueForPoint(pos_att_id, i, pos);
+    builder.SetAttributeValueForPoint(sh_rest_att_id, i, sh_rest.data());
+    builder.SetAttributeValueForPoint(opacity_att_id, i, &opacity);
+  }
+  return builder.Finalize(false);
+}
+
+TEST(GaussianAttributeUtilsTest, TestGltfAttributeNames) {
+  using draco::GaussianAttributeUtils;
+  using draco::GeometryAttribute;
+  ASSERT_EQ(
+      GaussianAttributeUtils::GetGltfAttributeName(GeometryAttribute::SH_DC),
+      "_SH_DC");
+  ASSERT_EQ(GaussianAttributeUtils::GetGltfAttributeName(
+                GeometryAttribute::SH_REST, 11),
+            "_SH_REST_11");
+  ASSERT_TRUE(GaussianAttributeUtils::GetGltfAttributeName(
+                  GeometryAttribute::POSITION)
+                  .empty());
+
+  GeometryAttribute::Type type;
+  int chunk;
+  ASSERT_TRUE(GaussianAttributeUtils::ParseGltfAttributeName("_OPACITY", &type,
+                                                             &chunk));
+  ASSERT_EQ(type, GeometryAttribute::OPACITY);
+  ASSERT_EQ(chunk, -1);
+  ASSERT_TRUE(GaussianAttributeUtils::ParseGltfAttributeName("_SH_REST_IDX",
+                                                             &type, &chunk));
+  ASSERT_EQ(type, GeometryAttribute::SH_REST_IDX);
+  ASSERT_EQ(chunk, -1);
+  ASSERT_TRUE(GaussianAttributeUtils::ParseGltfAttributeName("_SH_REST_10",
+                                                             &type, &chunk));
+  ASSERT_EQ(type, GeometryAttribute::SH_REST);
+  ASSERT_EQ(chunk, 10);
+  ASSERT_FALSE(GaussianAttributeUtils::ParseGltfAttributeName("_FEATURE_ID_0",
+                                                              &type, &chunk));
+  ASSERT_FALSE(GaussianAttributeUtils::ParseGltfAttributeName("_SH_REST_",
+                                                              &type, &chunk));
+  ASSERT_FALSE(
+      GaussianAttributeUtils::ParseGltfAttributeName("COLOR_0", &type, &chunk));
+}
+
+TEST(GaussianAttributeUtilsTest, TestSplitAndMerge) {
+  using draco::GaussianAttributeUtils;
+  using draco::GeometryAttribute;
+  constexpr int kNumPoints = 10;
+  std::unique_ptr<draco::PointCloud> pc = CreateGaussians(kNumPoints);
+  ASSERT_NE(pc, nullptr);
+  ASSERT_TRUE(GaussianAttributeUtils::HasAttributesToSplit(*pc));
+  DRACO_ASSERT_OK(GaussianAttributeUtils::SplitAttributes(pc.get()));
+  ASSERT_FALSE(GaussianAttributeUtils::HasAttributesToSplit(*pc));
+
+  // 45 components are split into 11 chunks of 4 components and one chunk with
+  // a single component.
+  const int num_chunks = pc->NumNamedAttributes(GeometryAttribute::SH_REST);
+  ASSERT_EQ(num_chunks, 12);
+  std::vector<int> chunk_ids;
+  for (int i = 0; i < num_chunks; ++i) {
+    const draco::PointAttribute *const chunk =
+        pc->GetNamedAttribute(GeometryAttribute::SH_REST, i);
+    ASSERT_EQ(chunk->num_components(), i < 11 ? 4 : 1);
+    float value[4];
+    chunk->GetMappedValue(draco::PointIndex(3), value);
+    ASSERT_EQ(value[0], 300.f + 4 * i);
+    chunk_ids.push_back(pc->GetNamedAttributeId(GeometryAttribute::SH_REST, i));
+  }
+  ASSERT_NE(pc->GetNamedAttribute(GeometryAttribute::OPACITY), nullptr);
+
+  // All unique ids must stay unique.
+  std::set<uint32_t> unique_ids;
+  for (int i = 0; i < pc->num_attributes(); ++i) {
+    ASSERT_TRUE(unique_ids.insert(pc->attribute(i)->unique_id()).second);
+  }
+
+  DRACO_ASSIGN_OR_ASSERT(
+      const int merged_id,
+      GaussianAttributeUtils::MergeAttributes(chunk_ids, pc.get()));
+  ASSERT_EQ(pc->NumNamedAttributes(GeometryAttribute::SH_REST), 1);
+  const draco::PointAttribute *const merged = pc->attribute(merged_id);
+  ASSERT_EQ(merged->attribute_type(), GeometryAttribute::SH_REST);
+  ASSERT_EQ(merged->num_components(), kNumShRestComponents);
+  for (draco::PointIndex i(0); i < kNumPoints; ++i) {
+    std::array<float, kNumShRestComponents> value;
+    merged->GetMappedValue(i, value.data());
+    for (int c = 0; c < kNumShRestComponents; ++c) {
+      ASSERT_EQ(value[c], i.value() * 100.f + c);
+    }
+  }
+}
+
+}  // namespace
@@ -26,11 +26,13 @@
 #include <utility>
 #include <vector>
 
+#include "draco/compression/decode.h"
 #include "draco/core/draco_types.h"
 #include "draco/core/hash_utils.h"
 #include "draco/core/status.h"
 #include "draco/core/status_or.h"
 #include "draco/io/file_utils.h"
+#include "draco/io/gaussian_attribute_utils.h"
 #include "draco/io/texture_io.h"
 #include "draco/io/tiny_gltf_utils.h"
 #include "draco/material/material_library.h"
@@ -87,6 +89,13 @@ GeometryAttribute::Type GltfAttributeToDracoAttribute(
   } else if (attribute_name.rfind("_FEATURE_ID_") == 0) {
     // Feature ID attribute like _FEATURE_ID_5 from EXT_mesh_features extension.
     return GeometryAttribute::GENERIC;
+  }
+  GeometryAttribute::Type gaussian_type;
+  int gaussian_chunk;
+  if (GaussianAttributeUtils::ParseGltfAttributeName(
+          attribute_name, &gaussian_type, &gaussian_chunk)) {
+    // Gaussian splat attribute like _SH_DC or a chunk like _SH_REST_3.
+    return gaussian_type;
   } else if (attribute_name.rfind('_', 0) == 0) {
     // Feature ID attribute like _DIRECTION from EXT_structural_metadata
     // extension whose name begins with an underscore.
@@ -95,6 +104,24 @@ GeometryAttribute::Type GltfAttributeToDracoAttribute(
   return GeometryAttribute::INVALID;
 }
 
+// Converts values of |att| for all points of |pc| to type T and stores them
+// in |data|.
+template <typename T>
+bool ConvertAttributeValuesForAllPoints(const PointCloud &pc,
+                                        const PointAttribute &att,
+                                        std::vector<unsigned char> *data) {
+  const int num_components = att.num_components();
+  data->resize(pc.num_points() * num_components * sizeof(T));
+  T *const values = reinterpret_cast<T *>(data->data());
+  for (PointIndex pi(0); pi < pc.num_points(); ++pi) {
+    if (!att.ConvertValue<T>(att.mapped_index(pi), num_components,
+                             values + pi.value() * num_components)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 StatusOr<TextureMap::AxisWrappingMode> TinyGltfToDracoAxisWrappingMode(
     int wrap_mode) {
   switch (wrap_mode) {
@@ -515,6 +542,7 @@ Status GltfDecoder::LoadFile(const std::string &file_name,
     return Status(Status::DRACO_ERROR, "Unknown input file extension.");
   }
   DRACO_RETURN_IF_ERROR(CheckUnsupportedFeatures());
+  DRACO_RETURN_IF_ERROR(DecodeDracoPointClouds());
   input_file_name_ = file_name;
   return OkStatus();
 }
@@ -532,6 +560,7 @@ Status GltfDecoder::LoadBuffer(const DecoderBuffer &buffer) {
                   "TinyGLTF failed to load glb buffer: " + err);
   }
   DRACO_RETURN_IF_ERROR(CheckUnsupportedFeatures());
+  DRACO_RETURN_IF_ERROR(DecodeDracoPointClouds());
   input_file_name_.clear();
   return OkStatus();
 }
@@ -572,6 +601,7 @@ StatusOr<std::unique_ptr<Mesh>> GltfDecoder::BuildMesh() {
   DRACO_RETURN_IF_ERROR(AddStructuralMetadataToGeometry(mesh.get()));
   MoveNonMaterialTextures(mesh.get());
   DRACO_RETURN_IF_ERROR(AddAssetMetadata(mesh.get()));
+  DRACO_RETURN_IF_ERROR(MergeGaussianAttributeChunks(mesh.get()));
   return mesh;
 }
 
@@ -646,6 +676,168 @@ Status GltfDecoder::CheckUnsupportedFeatures() {
   return OkStatus();
 }
 
+Status GltfDecoder::DecodeDracoPointClouds() {
+  for (const tinygltf::Mesh &mesh : gltf_model_.meshes) {
+    for (const tinygltf::Primitive &primitive : mesh.primitives) {
+      const auto it = primitive.extensions.find("KHR_draco_mesh_compression");
+      if (primitive.mode == TINYGLTF_MODE_POINTS &&
+          it != primitive.extensions.end()) {
+        DRACO_RETURN_IF_ERROR(DecodeDracoPointCloud(it->second, primitive));
+      }
+    }
+  }
+  return OkStatus();
+}
+
+Status GltfDecoder::DecodeDracoPointCloud(
+    const tinygltf::Value &extension, const tinygltf::Primitive &primitive) {
+  // TinyGLTF decodes only Draco compressed meshes. Accessors of primitives
+  // compressed as Draco point clouds are left without data.
+  bool has_data = true;
+  for (const auto &attribute : primitive.attributes) {
+    if (attribute.second < 0 ||
+        attribute.second >= gltf_model_.accessors.size()) {
+      return ErrorStatus("Invalid accessor.");
+    }
+    if (gltf_model_.accessors[attribute.second].bufferView < 0) {
+      has_data = false;
+    }
+  }
+  if (has_data) {
+    return OkStatus();
+  }
+
+  const tinygltf::Value &buffer_view_value = extension.Get("bufferView");
+  const tinygltf::Value &attributes = extension.Get("attributes");
+  if (!buffer_view_value.IsInt() || !attributes.IsObject()) {
+    return ErrorStatus("Invalid KHR_draco_mesh_compression extension.");
+  }
+  const int buffer_view_index = buffer_view_value.Get<int>();
+  if (buffer_view_index < 0 ||
+      buffer_view_index >= gltf_model_.bufferViews.size()) {
+    return ErrorStatus("Invalid Draco buffer view.");
+  }
+  const tinygltf::BufferView &buffer_view =
+      gltf_model_.bufferViews[buffer_view_index];
+  if (buffer_view.buffer < 0 ||
+      buffer_view.buffer >= gltf_model_.buffers.size()) {
+    return ErrorStatus("Invalid Draco buffer.");
+  }
+  const tinygltf::Buffer &buffer = gltf_model_.buffers[buffer_view.buffer];
+  if (buffer_view.byteOffset + buffer_view.byteLength > buffer.data.size()) {
+    return ErrorStatus("Draco buffer view is out of range.");
+  }
+  DecoderBuffer decoder_buffer;
+  decoder_buffer.Init(
+      reinterpret_cast<const char *>(buffer.data.data()) +
+          buffer_view.byteOffset,
+      buffer_view.byteLength);
+  Decoder decoder;
+  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloud> pc,
+                         decoder.DecodePointCloudFromBuffer(&decoder_buffer));
+
+  for (const auto &attribute : primitive.attributes) {
+    if (!attributes.Has(attribute.first)) {
+      continue;
+    }
+    const tinygltf::Value &unique_id = attributes.Get(attribute.first);
+    if (!unique_id.IsInt()) {
+      return ErrorStatus("Invalid Draco attribute id.");
+    }
+    const PointAttribute *const att =
+        pc->GetAttributeByUniqueId(unique_id.Get<int>());
+    if (att == nullptr) {
+      return ErrorStatus("Draco attribute is missing: " + attribute.first);
+    }
+    tinygltf::Accessor &accessor = gltf_model_.accessors[attribute.second];
+    if (TinyGltfUtils::GetNumComponentsForType(accessor.type) !=
+        att->num_components()) {
+      return ErrorStatus("Draco attribute does not match accessor type.");
+    }
+    std::vector<unsigned char> data;
+    bool converted = false;
+    switch (accessor.componentType) {
+      case TINYGLTF_COMPONENT_TYPE_BYTE:
+        converted =
+            ConvertAttributeValuesForAllPoints<int8_t>(*pc, *att, &data);
+        break;
+      case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+        converted =
+            ConvertAttributeValuesForAllPoints<uint8_t>(*pc, *att, &data);
+        break;
+      case TINYGLTF_COMPONENT_TYPE_SHORT:
+        converted =
+            ConvertAttributeValuesForAllPoints<int16_t>(*pc, *att, &data);
+        break;
+      case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+        converted =
+            ConvertAttributeValuesForAllPoints<uint16_t>(*pc, *att, &data);
+        break;
+      case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+        converted =
+            ConvertAttributeValuesForAllPoints<uint32_t>(*pc, *att, &data);
+        break;
+      case TINYGLTF_COMPONENT_TYPE_FLOAT:
+        converted =
+            ConvertAttributeValuesForAllPoints<float>(*pc, *att, &data);
+        break;
+      default:
+        break;
+    }
+    if (!converted) {
+      return ErrorStatus("Could not convert Draco attribute: " +
+                         attribute.first);
+    }
+
+    // Store the decoded values in a new buffer referred to by the accessor.
+    tinygltf::BufferView decoded_buffer_view;
+    decoded_buffer_view.buffer = gltf_model_.buffers.size();
+    decoded_buffer_view.byteOffset = 0;
+    decoded_buffer_view.byteLength = data.size();
+    tinygltf::Buffer decoded_buffer;
+    decoded_buffer.data = std::move(data);
+    gltf_model_.buffers.push_back(std::move(decoded_buffer));
+    gltf_model_.bufferViews.push_back(decoded_buffer_view);
+    accessor.bufferView = gltf_model_.bufferViews.size() - 1;
+    accessor.byteOffset = 0;
+    accessor.count = pc->num_points();
+  }
+  return OkStatus();
+}
+
+Status GltfDecoder::MergeGaussianAttributeChunks(Mesh *mesh) {
+  // Each merge changes attribute ids so the chunks are collected again for
+  // every attribute type.
+  while (true) {
+    GeometryAttribute::Type chunk_type = GeometryAttribute::INVALID;
+    std::map<int, int> chunk_to_att_id;
+    for (int i = 0; i < mesh->num_attributes(); ++i) {
+      GeometryAttribute::Type type;
+      int chunk;
+      if (!GaussianAttributeUtils::ParseGltfAttributeName(
+              mesh->attribute(i)->name(), &type, &chunk) ||
+          chunk < 0) {
+        continue;
+      }
+      if (chunk_type == GeometryAttribute::INVALID) {
+        chunk_type = type;
+      }
+      if (type == chunk_type) {
+        chunk_to_att_id[chunk] = i;
+      }
+    }
+    if (chunk_to_att_id.empty()) {
+      return OkStatus();
+    }
+    std::vector<int> att_ids;
+    for (const auto &it : chunk_to_att_id) {
+      att_ids.push_back(it.second);
+    }
+    DRACO_RETURN_IF_ERROR(
+        GaussianAttributeUtils::MergeAttributes(att_ids, mesh).status());
+  }
+}
+
 Status GltfDecoder::DecodeNode(int node_index,
                                const Eigen::Matrix4d &parent_matrix) {
   const tinygltf::Node &node = gltf_model_.nodes[node_index];
@@ -925,6 +1117,8 @@ Status GltfDecoder::AddAttributeValuesToBuilder(
     int number_of_elements, const Eigen::Matrix4d &transform_matrix,
     BuilderT *builder) {
   const bool reverse_winding = Determinant(transform_matrix) < 0;
+  GeometryAttribute::Type gaussian_type;
+  int gaussian_chunk;
   if (attribute_name == "TEXCOORD_0" || attribute_name == "TEXCOORD_1") {
     DRACO_RETURN_IF_ERROR(AddTexCoordToBuilder(accessor, indices_data, att_id,
                                                number_of_elements,
@@ -942,6 +1136,17 @@ Status GltfDecoder::AddAttributeValuesToBuilder(
     DRACO_RETURN_IF_ERROR(AddTransformedDataToBuilder(
         accessor, indices_data, att_id, number_of_elements, matrix, normalize,
         reverse_winding, builder));
+  } else if (GaussianAttributeUtils::ParseGltfAttributeName(
+                 attribute_name, &gaussian_type, &gaussian_chunk)) {
+    // Gaussian splat attribute like _OPACITY.
+    DRACO_RETURN_IF_ERROR(AddAttributeDataByTypes(accessor, indices_data,
+                                                  att_id, number_of_elements,
+                                                  reverse_winding, builder));
+    if (gaussian_chunk >= 0) {
+      // Chunks of split attributes like _SH_REST_3 are merged by their names
+      // once the mesh is built.
+      builder->SetAttributeName(att_id, attribute_name);
+    }
   } else if (attribute_name.rfind("_FEATURE_ID_") == 0) {
     DRACO_RETURN_IF_ERROR(AddFeatureIdToBuilder(
         accessor, indices_data, att_id, number_of_elements, reverse_winding,
@@ -2059,6 +2264,7 @@ Status GltfDecoder::DecodePrimitiveForScene(
   DRACO_RETURN_IF_ERROR(AddPrimitiveExtensionsToDracoMesh(
       primitive, &scene_->GetMaterialLibrary().MutableTextureLibrary(),
       mesh.get()));
+  DRACO_RETURN_IF_ERROR(MergeGaussianAttributeChunks(mesh.get()));
 
   const MeshIndex mesh_index = scene_->AddMesh(std::move(mesh));
   if (mesh_index == kInvalidMeshIndex) {
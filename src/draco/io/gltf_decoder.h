@@ -100,6 +100,20 @@ class GltfDecoder {
   // UNSUPPORTED_FEATURE.
   Status CheckUnsupportedFeatures();
 
+  // Decodes primitives of |gltf_model_| compressed as Draco point clouds that
+  // are not decoded by TinyGLTF. The decoded attribute values are stored in
+  // new buffers referred to by the primitive accessors.
+  Status DecodeDracoPointClouds();
+
+  // Decodes a single point cloud |primitive| compressed with Draco as
+  // described by its KHR_draco_mesh_compression |extension|.
+  Status DecodeDracoPointCloud(const tinygltf::Value &extension,
+                               const tinygltf::Primitive &primitive);
+
+  // Merges Gaussian splat attributes that were split into chunks like
+  // _SH_REST_3 when stored in glTF back into single attributes of |mesh|.
+  static Status MergeGaussianAttributeChunks(Mesh *mesh);
+
   // Decodes a glTF Node as well as any child Nodes. If |node| contains a mesh
   // it will process all of the mesh's primitives.
   Status DecodeNode(int node_index, const Eigen::Matrix4d &parent_matrix);
@@ -37,9 +37,11 @@
 #include "draco/compression/draco_compression_options.h"
 #include "draco/compression/expert_encode.h"
 #include "draco/core/draco_types.h"
+#include "draco/core/thread_pool.h"
 #include "draco/core/vector_d.h"
 #include "draco/io/file_utils.h"
 #include "draco/io/file_writer_utils.h"
+#include "draco/io/gaussian_attribute_utils.h"
 #include "draco/io/gltf_utils.h"
 #include "draco/io/texture_io.h"
 #include "draco/mesh/mesh_features.h"
@@ -309,8 +311,24 @@ class GltfAsset {
   void set_output_type(GltfEncoder::OutputType type) { output_type_ = type; }
   GltfEncoder::OutputType output_type() const { return output_type_; }
   void set_json_output_mode(JsonWriter::Mode mode) { gltf_json_.SetMode(mode); }
+  void set_num_threads(int num_threads) { num_threads_ = num_threads; }
+  int num_threads() const { return num_threads_; }
 
  private:
+  // Draco compressed data of a single mesh.
+  struct DracoCompressedMesh {
+    DracoCompressedMesh() : num_encoded_points(0), num_encoded_faces(0) {}
+    EncoderBuffer buffer;
+    int64_t num_encoded_points;
+    int64_t num_encoded_faces;
+  };
+
+  // Mesh that is compressed by PrecompressMeshes().
+  struct MeshCompressionJob {
+    const Mesh *mesh;
+    Eigen::Matrix4d transform;
+  };
+
   // Pad |buffer_| to 4 byte boundary.
   bool PadBuffer();
 
@@ -323,13 +341,35 @@ class GltfAsset {
       const std::string &name, GltfDracoCompressedMesh *compressed_mesh_info);
 
   // Compresses |mesh| using Draco. On success returns the buffer_view in
-  // |primitive| and number of encoded points and faces.
+  // |primitive| and number of encoded points and faces. Uses the result of
+  // PrecompressMeshes() when available.
   Status CompressMeshWithDraco(const Mesh &mesh,
                                const Eigen::Matrix4d &transform,
                                GltfPrimitive *primitive,
                                int64_t *num_encoded_points,
                                int64_t *num_encoded_faces);
 
+  // Encodes |mesh| using Draco into |compressed_mesh|. The function does not
+  // modify the asset so it can be called concurrently for different meshes.
+  static Status EncodeMeshWithDraco(const Mesh &mesh,
+                                    const Eigen::Matrix4d &transform,
+                                    DracoCompressedMesh *compressed_mesh);
+
+  // Compresses meshes of |jobs| that have compression enabled on up to
+  // |num_threads_| threads. The results are stored in |precompressed_meshes_|
+  // and they are added to |buffer_| by CompressMeshWithDraco() in the order in
+  // which the primitives are added so the output does not depend on the number
+  // of threads.
+  Status PrecompressMeshes(const std::vector<MeshCompressionJob> &jobs);
+
+  // Compresses all meshes that will be added by AddSceneNode().
+  Status PrecompressSceneMeshes(const Scene &scene);
+
+  // Returns |mesh| or its copy with Gaussian attributes split into glTF
+  // compatible chunks. The copy is created once per |mesh| and it is owned by
+  // the asset.
+  StatusOr<const Mesh *> GetMeshWithSplitGaussianAttributes(const Mesh &mesh);
+
   // Adds a Draco mesh associated with a material id and material variants.
   bool AddDracoMesh(const Mesh &mesh, int material_id,
                     const std::vector<MeshGroup::MaterialsVariantsMapping>
@@ -386,6 +426,13 @@ class GltfAsset {
       const Mesh &mesh, int num_encoded_points,
       std::unordered_map<int, int> *feature_id_name_indices);
 
+  // Adds the Gaussian splat attributes of |mesh| like SH_DC or OPACITY to the
+  // glTF data as application-specific attributes named like "_SH_DC". The
+  // attributes must have at most four components. Returns a vector of
+  // attribute-name, accessor pairs for each added attribute.
+  std::vector<std::pair<std::string, int>> AddDracoGaussians(
+      const Mesh &mesh, int num_encoded_points);
+
   // Iterate through the materials that are associated with |mesh| and add them
   // to the asset.
   void AddMaterials(const Mesh &mesh);
@@ -661,6 +708,19 @@ class GltfAsset {
   std::vector<EncoderInstanceArray> instance_arrays_;
   const StructuralMetadata *structural_metadata_;
 
+  // Copies of meshes whose Gaussian attributes were split into glTF compatible
+  // chunks, keyed by the original meshes. Primitives may refer to data owned
+  // by these meshes.
+  std::map<const Mesh *, std::unique_ptr<Mesh>> split_gaussian_meshes_;
+
+  // Meshes compressed by PrecompressMeshes() that have not been added to
+  // |buffer_| yet.
+  std::unordered_map<const Mesh *, std::unique_ptr<DracoCompressedMesh>>
+      precompressed_meshes_;
+
+  // Maximum number of threads used for compressing meshes.
+  int num_threads_;
+
   // Indicates whether Draco compression is used for any of the asset meshes.
   bool draco_compression_used_;
 
@@ -720,6 +780,7 @@ GltfAsset::GltfAsset()
       scene_index_(-1),
       buffer_name_("buffer0.bin"),
       structural_metadata_(nullptr),
+      num_threads_(1),
       draco_compression_used_(false),
       mesh_features_used_(false),
       structural_metadata_used_(false),
@@ -758,12 +819,15 @@ bool GltfAsset::AddDracoMesh(const Mesh &mesh) {
       return false;
     }
     auto split_meshes = std::move(split_maybe).value();
+    std::vector<uint32_t> mat_indices;
+    std::vector<MeshCompressionJob> jobs;
     for (int i = 0; i < split_meshes.size(); ++i) {
       if (split_meshes[i] == nullptr) {
         continue;  // Empty mesh. Ignore.
       }
       uint32_t mat_index = 0;
       mat_att->GetValue(AttributeValueIndex(i), &mat_index);
+      mat_indices.push_back(mat_index);
 
       // Copy over mesh features for a given material index.
       Mesh::CopyMeshFeaturesForMaterial(mesh, split_meshes[i].get(), mat_index);
@@ -777,10 +841,17 @@ bool GltfAsset::AddDracoMesh(const Mesh &mesh) {
       // do this because the split mesh may contain mesh features data that are
       // used later in the encoding process.
       local_meshes_.push_back(std::move(split_meshes[i]));
+      jobs.push_back({local_meshes_.back().get(), Eigen::Matrix4d::Identity()});
+    }
 
+    // The split meshes are independent so they can be compressed in parallel.
+    if (!PrecompressMeshes(jobs).ok()) {
+      return false;
+    }
+    for (int i = 0; i < jobs.size(); ++i) {
       // The material index in the glTF file corresponds to the index of the
       // split mesh.
-      if (!AddDracoMesh(*(local_meshes_.back().get()), mat_index, {},
+      if (!AddDracoMesh(*jobs[i].mesh, mat_indices[i], {},
                         Eigen::Matrix4d::Identity())) {
         return false;
       }
@@ -882,37 +953,88 @@ Status GltfAsset::CompressMeshWithDraco(const Mesh &mesh,
                                         GltfPrimitive *primitive,
                                         int64_t *num_encoded_points,
                                         int64_t *num_encoded_faces) {
+  std::unique_ptr<DracoCompressedMesh> compressed_mesh;
+  const auto it = precompressed_meshes_.find(&mesh);
+  if (it != precompressed_meshes_.end()) {
+    compressed_mesh = std::move(it->second);
+    precompressed_meshes_.erase(it);
+  }
+  if (compressed_mesh == nullptr) {
+    compressed_mesh.reset(new DracoCompressedMesh());
+    DRACO_RETURN_IF_ERROR(
+        EncodeMeshWithDraco(mesh, transform, compressed_mesh.get()));
+  }
+  *num_encoded_points = compressed_mesh->num_encoded_points;
+  *num_encoded_faces = compressed_mesh->num_encoded_faces;
+
+  const EncoderBuffer &buffer = compressed_mesh->buffer;
+  const size_t buffer_start_offset = buffer_.size();
+  if (!buffer_.Encode(buffer.data(), buffer.size())) {
+    return Status(Status::DRACO_ERROR, "Could not copy Draco compressed data.");
+  }
+  if (!PadBuffer()) {
+    return Status(Status::DRACO_ERROR, "Could not pad glTF buffer.");
+  }
+
+  GltfBufferView buffer_view;
+  buffer_view.buffer_byte_offset = buffer_start_offset;
+  buffer_view.byte_length = buffer_.size() - buffer_start_offset;
+  buffer_views_.push_back(buffer_view);
+  primitive->compressed_mesh_info.buffer_view_index =
+      static_cast<int>(buffer_views_.size() - 1);
+  return OkStatus();
+}
+
+Status GltfAsset::EncodeMeshWithDraco(const Mesh &mesh,
+                                      const Eigen::Matrix4d &transform,
+                                      DracoCompressedMesh *compressed_mesh) {
   // Check that geometry comression options are valid.
-  DracoCompressionOptions compression_options = mesh.GetCompressionOptions();
+  const DracoCompressionOptions &compression_options =
+      mesh.GetCompressionOptions();
   DRACO_RETURN_IF_ERROR(compression_options.Check());
 
-  // Make a copy of the mesh. It will be modified and compressed.
-  std::unique_ptr<Mesh> mesh_copy(new Mesh());
-  mesh_copy->Copy(mesh);
+  // The mesh needs to be copied only when some of its attributes must be
+  // modified before the compression.
+  const bool has_auto_generated_tangents =
+      MeshUtils::HasAutoGeneratedTangents(mesh);
+  bool needs_copy = has_auto_generated_tangents;
+  for (int i = 0; i < mesh.num_attributes(); ++i) {
+    switch (mesh.attribute(i)->attribute_type()) {
+      case GeometryAttribute::TEX_COORD:
+      case GeometryAttribute::TANGENT:
+      case GeometryAttribute::JOINTS:
+      case GeometryAttribute::WEIGHTS:
+        needs_copy = true;
+        break;
+      default:
+        break;
+    }
+  }
+  std::unique_ptr<Mesh> mesh_copy;
+  if (needs_copy) {
+    mesh_copy.reset(new Mesh());
+    mesh_copy->Copy(mesh);
+  }
+  const Mesh &encoded_mesh = needs_copy ? *mesh_copy : mesh;
 
   // Delete auto-generated tangents.
-  if (MeshUtils::HasAutoGeneratedTangents(*mesh_copy)) {
-    for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
-      PointAttribute *const att = mesh_copy->attribute(i);
-      if (att->attribute_type() == GeometryAttribute::TANGENT) {
-        while (mesh_copy->GetNamedAttribute(GeometryAttribute::TANGENT)) {
-          mesh_copy->DeleteAttribute(
-              mesh_copy->GetNamedAttributeId(GeometryAttribute::TANGENT));
-        }
-        break;
-      }
+  if (has_auto_generated_tangents) {
+    while (mesh_copy->GetNamedAttribute(GeometryAttribute::TANGENT)) {
+      mesh_copy->DeleteAttribute(
+          mesh_copy->GetNamedAttributeId(GeometryAttribute::TANGENT));
     }
   }
 
   // Create Draco encoder.
-  EncoderBuffer buffer;
   std::unique_ptr<ExpertEncoder> encoder;
-  if (mesh_copy->num_faces() > 0) {
+  if (encoded_mesh.num_faces() > 0) {
     // Encode mesh.
-    encoder.reset(new ExpertEncoder(*mesh_copy));
+    encoder.reset(new ExpertEncoder(encoded_mesh));
   } else {
-    return Status(Status::DRACO_ERROR,
-                  "Draco compression is not supported for glTF point clouds.");
+    // Encode point cloud. The kd-tree or the sequential point cloud encoding
+    // is selected based on the encoding speed.
+    const PointCloud &pc = encoded_mesh;
+    encoder.reset(new ExpertEncoder(pc));
   }
   encoder->SetTrackEncodedProperties(true);
 
@@ -921,8 +1043,8 @@ Status GltfAsset::CompressMeshWithDraco(const Mesh &mesh,
   encoder->SetSpeedOptions(speed, speed);
 
   // Configure attribute quantization.
-  for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
-    const PointAttribute *const att = mesh_copy->attribute(i);
+  for (int i = 0; i < encoded_mesh.num_attributes(); ++i) {
+    const PointAttribute *const att = encoded_mesh.attribute(i);
     if (att->attribute_type() == GeometryAttribute::POSITION &&
         !compression_options.quantization_position
              .AreQuantizationBitsDefined()) {
@@ -947,8 +1069,10 @@ Status GltfAsset::CompressMeshWithDraco(const Mesh &mesh,
       // spacing must be.
       const float local_spacing = global_spacing / max_scale;
 
-      // Update the compression options of the processed mesh.
-      compression_options.quantization_position.SetGrid(local_spacing);
+      // The grid is set directly on the encoder so that the compression
+      // options of the (possibly shared) mesh don't need to be modified.
+      DRACO_RETURN_IF_ERROR(encoder->SetAttributeGridQuantization(
+          encoded_mesh, i, local_spacing));
     } else {
       int num_quantization_bits = -1;
       switch (att->attribute_type()) {
@@ -969,8 +1093,16 @@ Status GltfAsset::CompressMeshWithDraco(const Mesh &mesh,
         case GeometryAttribute::WEIGHTS:
           num_quantization_bits = compression_options.quantization_bits_weight;
           break;
+        case GeometryAttribute::SH_DC:
+        case GeometryAttribute::SH_REST:
+        case GeometryAttribute::OPACITY:
+        case GeometryAttribute::SCALE:
+        case GeometryAttribute::ROTATION:
+          num_quantization_bits =
+              compression_options.quantization_bits_gaussian;
+          break;
         case GeometryAttribute::GENERIC:
-          if (!IsFeatureIdAttribute(i, *mesh_copy)) {
+          if (!IsFeatureIdAttribute(i, encoded_mesh)) {
             num_quantization_bits =
                 compression_options.quantization_bits_generic;
           } else {
@@ -987,56 +1119,123 @@ Status GltfAsset::CompressMeshWithDraco(const Mesh &mesh,
     }
   }
 
-  // Flip UV values as required by glTF Draco and non-Draco files.
-  for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
-    PointAttribute *const att = mesh_copy->attribute(i);
-    if (att->attribute_type() == GeometryAttribute::TEX_COORD) {
-      if (!MeshUtils::FlipTextureUvValues(false, true, att)) {
-        return Status(Status::DRACO_ERROR, "Could not flip texture UV values.");
+  if (needs_copy) {
+    // Flip UV values as required by glTF Draco and non-Draco files.
+    for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
+      PointAttribute *const att = mesh_copy->attribute(i);
+      if (att->attribute_type() == GeometryAttribute::TEX_COORD) {
+        if (!MeshUtils::FlipTextureUvValues(false, true, att)) {
+          return Status(Status::DRACO_ERROR,
+                        "Could not flip texture UV values.");
+        }
       }
     }
-  }
 
-  // Change tangents, joints, and weights attribute types to generic. The
-  // original mesh's attribute type is unchanged and the mapping of the glTF
-  // attribute type to Draco compressed attribute id is written to the output
-  // glTF file.
-  for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
-    PointAttribute *const att = mesh_copy->attribute(i);
-    if (att->attribute_type() == GeometryAttribute::TANGENT ||
-        att->attribute_type() == GeometryAttribute::JOINTS ||
-        att->attribute_type() == GeometryAttribute::WEIGHTS) {
-      att->set_attribute_type(GeometryAttribute::GENERIC);
+    // Change tangents, joints, and weights attribute types to generic. The
+    // original mesh's attribute type is unchanged and the mapping of the glTF
+    // attribute type to Draco compressed attribute id is written to the output
+    // glTF file.
+    for (int i = 0; i < mesh_copy->num_attributes(); ++i) {
+      PointAttribute *const att = mesh_copy->attribute(i);
+      if (att->attribute_type() == GeometryAttribute::TANGENT ||
+          att->attribute_type() == GeometryAttribute::JOINTS ||
+          att->attribute_type() == GeometryAttribute::WEIGHTS) {
+        att->set_attribute_type(GeometryAttribute::GENERIC);
+      }
     }
   }
 
-  // |compression_options| may have been modified and we need to update them
-  // before we start the encoding.
-  mesh_copy->SetCompressionOptions(compression_options);
-  DRACO_RETURN_IF_ERROR(encoder->EncodeToBuffer(&buffer));
-  *num_encoded_points = encoder->num_encoded_points();
-  if (mesh_copy->num_faces() > 0) {
-    *num_encoded_faces = encoder->num_encoded_faces();
+  DRACO_RETURN_IF_ERROR(encoder->EncodeToBuffer(&compressed_mesh->buffer));
+  compressed_mesh->num_encoded_points = encoder->num_encoded_points();
+  if (encoded_mesh.num_faces() > 0) {
+    compressed_mesh->num_encoded_faces = encoder->num_encoded_faces();
   } else {
-    *num_encoded_faces = 0;
+    compressed_mesh->num_encoded_faces = 0;
   }
-  const size_t buffer_start_offset = buffer_.size();
-  if (!buffer_.Encode(buffer.data(), buffer.size())) {
-    return Status(Status::DRACO_ERROR, "Could not copy Draco compressed data.");
+  return OkStatus();
+}
+
+Status GltfAsset::PrecompressMeshes(
+    const std::vector<MeshCompressionJob> &jobs) {
+  // Gaussian attributes are split before the compression in the same way as in
+  // AddDracoMesh() so that the results can be found by the split meshes.
+  std::vector<MeshCompressionJob> compressed_jobs;
+  for (const MeshCompressionJob &job : jobs) {
+    if (!job.mesh->IsCompressionEnabled()) {
+      continue;
+    }
+    const Mesh *mesh = job.mesh;
+    if (GaussianAttributeUtils::HasAttributesToSplit(*mesh)) {
+      DRACO_ASSIGN_OR_RETURN(mesh, GetMeshWithSplitGaussianAttributes(*mesh));
+    }
+    if (precompressed_meshes_.count(mesh) == 0) {
+      compressed_jobs.push_back({mesh, job.transform});
+      precompressed_meshes_[mesh] = nullptr;
+    }
   }
-  if (!PadBuffer()) {
-    return Status(Status::DRACO_ERROR, "Could not pad glTF buffer.");
+  if (compressed_jobs.size() < 2 || num_threads_ < 2) {
+    // Nothing to gain. The meshes are compressed by CompressMeshWithDraco().
+    for (const MeshCompressionJob &job : compressed_jobs) {
+      precompressed_meshes_.erase(job.mesh);
+    }
+    return OkStatus();
   }
 
-  GltfBufferView buffer_view;
-  buffer_view.buffer_byte_offset = buffer_start_offset;
-  buffer_view.byte_length = buffer_.size() - buffer_start_offset;
-  buffer_views_.push_back(buffer_view);
-  primitive->compressed_mesh_info.buffer_view_index =
-      static_cast<int>(buffer_views_.size() - 1);
+  std::vector<std::unique_ptr<DracoCompressedMesh>> results(
+      compressed_jobs.size());
+  std::vector<Status> statuses(compressed_jobs.size());
+  ParallelFor(static_cast<int>(compressed_jobs.size()), num_threads_,
+              [&](int i) {
+                results[i].reset(new DracoCompressedMesh());
+                statuses[i] = EncodeMeshWithDraco(*compressed_jobs[i].mesh,
+                                                  compressed_jobs[i].transform,
+                                                  results[i].get());
+              });
+  for (int i = 0; i < compressed_jobs.size(); ++i) {
+    DRACO_RETURN_IF_ERROR(statuses[i]);
+    precompressed_meshes_[compressed_jobs[i].mesh] = std::move(results[i]);
+  }
   return OkStatus();
 }
 
+Status GltfAsset::PrecompressSceneMeshes(const Scene &scene) {
+  // Collect base meshes in the order in which they are added by
+  // AddSceneNode().
+  std::vector<MeshCompressionJob> jobs;
+  std::set<MeshIndex> added_meshes;
+  std::set<MeshGroupIndex> added_mesh_groups;
+  for (SceneNodeIndex i(0); i < scene.NumNodes(); ++i) {
+    const MeshGroupIndex mesh_group_index =
+        scene.GetNode(i)->GetMeshGroupIndex();
+    if (mesh_group_index == kInvalidMeshGroupIndex ||
+        !added_mesh_groups.insert(mesh_group_index).second) {
+      continue;
+    }
+    const MeshGroup *const mesh_group = scene.GetMeshGroup(mesh_group_index);
+    for (int j = 0; j < mesh_group->NumMeshInstances(); ++j) {
+      const MeshIndex mesh_index = mesh_group->GetMeshInstance(j).mesh_index;
+      if (added_meshes.insert(mesh_index).second) {
+        jobs.push_back(
+            {&scene.GetMesh(mesh_index), base_mesh_transforms_[mesh_index]});
+      }
+    }
+  }
+  return PrecompressMeshes(jobs);
+}
+
+StatusOr<const Mesh *> GltfAsset::GetMeshWithSplitGaussianAttributes(
+    const Mesh &mesh) {
+  std::unique_ptr<Mesh> &split_mesh = split_gaussian_meshes_[&mesh];
+  if (split_mesh == nullptr) {
+    std::unique_ptr<Mesh> mesh_copy(new Mesh());
+    mesh_copy->Copy(mesh);
+    DRACO_RETURN_IF_ERROR(
+        GaussianAttributeUtils::SplitAttributes(mesh_copy.get()));
+    split_mesh = std::move(mesh_copy);
+  }
+  return split_mesh.get();
+}
+
 bool CheckAndGetTexCoordAttributeOrder(const Mesh &mesh,
                                        std::vector<int> *tex_coord_order) {
   // We will only consider at most two texture coordinate attributes.
@@ -1089,10 +1288,21 @@ bool GltfAsset::AddDracoMesh(
     const std::vector<MeshGroup::MaterialsVariantsMapping>
         &material_variants_mappings,
     const Eigen::Matrix4d &transform) {
+  if (GaussianAttributeUtils::HasAttributesToSplit(mesh)) {
+    // glTF attributes have at most four components so Gaussian attributes
+    // like SH_REST are stored as multiple attributes.
+    StatusOr<const Mesh *> split_mesh_or =
+        GetMeshWithSplitGaussianAttributes(mesh);
+    if (!split_mesh_or.ok()) {
+      return false;
+    }
+    return AddDracoMesh(*split_mesh_or.value(), material_id,
+                        material_variants_mappings, transform);
+  }
   GltfPrimitive primitive;
   int64_t num_encoded_points = mesh.num_points();
   int64_t num_encoded_faces = mesh.num_faces();
-  if (num_encoded_faces > 0 && mesh.IsCompressionEnabled()) {
+  if (mesh.IsCompressionEnabled()) {
     const Status status = CompressMeshWithDraco(
         mesh, transform, &primitive, &num_encoded_points, &num_encoded_faces);
     if (!status.ok()) {
@@ -1128,6 +1338,8 @@ bool GltfAsset::AddDracoMesh(
   const std::vector<std::pair<std::string, int>> generics_accessors =
       AddDracoGenerics(mesh, num_encoded_points,
                        &primitive.feature_id_name_indices);
+  const std::vector<std::pair<std::string, int>> gaussian_accessors =
+      AddDracoGaussians(mesh, num_encoded_points);
 
   if (num_encoded_faces == 0) {
     primitive.mode = 0;  // POINTS mode.
@@ -1198,6 +1410,18 @@ bool GltfAsset::AddDracoMesh(
                                    &primitive.compressed_mesh_info);
     }
   }
+  for (const auto &gaussian_accessor : gaussian_accessors) {
+    GeometryAttribute::Type type;
+    int chunk;
+    if (!GaussianAttributeUtils::ParseGltfAttributeName(
+            gaussian_accessor.first, &type, &chunk)) {
+      return false;
+    }
+    primitive.attributes.insert(gaussian_accessor);
+    AddAttributeToDracoExtension(mesh, type, std::max(chunk, 0),
+                                 gaussian_accessor.first,
+                                 &primitive.compressed_mesh_info);
+  }
 
   meshes_.back().primitives.push_back(primitive);
   return true;
@@ -1457,6 +1681,42 @@ std::vector<std::pair<std::string, int>> GltfAsset::AddDracoGenerics(
   return attrs;
 }
 
+std::vector<std::pair<std::string, int>> GltfAsset::AddDracoGaussians(
+    const Mesh &mesh, int num_encoded_points) {
+  std::vector<std::pair<std::string, int>> attrs;
+  for (int t = 0; t < GeometryAttribute::NAMED_ATTRIBUTES_COUNT; ++t) {
+    const GeometryAttribute::Type type =
+        static_cast<GeometryAttribute::Type>(t);
+    if (!GaussianAttributeUtils::IsGaussianAttribute(type)) {
+      continue;
+    }
+    const int num_attributes = mesh.NumNamedAttributes(type);
+    for (int i = 0; i < num_attributes; ++i) {
+      const PointAttribute *const att = mesh.GetNamedAttribute(type, i);
+      int accessor = -1;
+      if (att->data_type() == DT_UINT32) {
+        // VQ indices may not fit into 16 bits.
+        accessor =
+            AddAttribute<uint32_t>(*att, mesh.num_points(), num_encoded_points,
+                                   mesh.IsCompressionEnabled());
+      } else {
+        accessor = AddAttribute(*att, mesh.num_points(), num_encoded_points,
+                                mesh.IsCompressionEnabled());
+      }
+      if (accessor == -1) {
+        continue;
+      }
+      // Attributes split into multiple chunks are named like "_SH_REST_3".
+      const std::string attr_name =
+          num_attributes == 1
+              ? GaussianAttributeUtils::GetGltfAttributeName(type)
+              : GaussianAttributeUtils::GetGltfAttributeName(type, i);
+      attrs.emplace_back(attr_name, accessor);
+    }
+  }
+  return attrs;
+}
+
 void GltfAsset::AddMaterials(const Mesh &mesh) {
   if (mesh.GetMaterialLibrary().NumMaterials()) {
     material_library_.Copy(mesh.GetMaterialLibrary());
@@ -1590,6 +1850,7 @@ Status GltfAsset::AddScene(const Scene &scene) {
   // Initialize base mesh transforms that may be needed when the base meshes are
   // compressed with Draco.
   base_mesh_transforms_ = SceneUtils::FindLargestBaseMeshTransforms(scene);
+  DRACO_RETURN_IF_ERROR(PrecompressSceneMeshes(scene));
   for (SceneNodeIndex i(0); i < scene.NumNodes(); ++i) {
     DRACO_RETURN_IF_ERROR(AddSceneNode(scene, i));
   }
@@ -3522,7 +3783,10 @@ void GltfAsset::SetCopyrightFromMesh(const Mesh &mesh) {
 const char GltfEncoder::kDracoMetadataGltfAttributeName[] =
     "//GLTF/ApplicationSpecificAttributeName";
 
-GltfEncoder::GltfEncoder() : out_buffer_(nullptr), output_type_(COMPACT) {}
+GltfEncoder::GltfEncoder()
+    : out_buffer_(nullptr),
+      output_type_(COMPACT),
+      num_threads_(ThreadPool::GetDefaultNumThreads()) {}
 
 template <typename T>
 bool GltfEncoder::EncodeToFile(const T &geometry, const std::string &file_name,
@@ -3574,6 +3838,7 @@ Status GltfEncoder::EncodeFile(const T &geometry, const std::string &filename,
   GltfAsset gltf_asset;
   gltf_asset.set_copyright(copyright_);
   gltf_asset.set_output_type(output_type_);
+  gltf_asset.set_num_threads(num_threads_);
 
   if (extension == "gltf") {
     std::string bin_path;
@@ -3600,6 +3865,7 @@ Status GltfEncoder::EncodeToBuffer(const T &geometry,
                                    EncoderBuffer *out_buffer) {
   GltfAsset gltf_asset;
   gltf_asset.set_output_type(output_type_);
+  gltf_asset.set_num_threads(num_threads_);
   gltf_asset.buffer_name("");
   gltf_asset.set_add_images_to_buffer(true);
   gltf_asset.set_copyright(copyright_);
@@ -87,6 +87,12 @@ class GltfEncoder {
   void set_copyright(const std::string &copyright) { copyright_ = copyright; }
   std::string copyright() const { return copyright_; }
 
+  // Sets the maximum number of threads used for compressing independent meshes
+  // with Draco. The output does not depend on the number of threads. Values
+  // less than two disable multithreading.
+  void set_num_threads(int num_threads) { num_threads_ = num_threads; }
+  int num_threads() const { return num_threads_; }
+
   // The name of the attribute metadata that contains the glTF attribute
   // name. For application-specific generic attributes, if the metadata for
   // an attribute contains this key, then the value will be used as the
@@ -130,6 +136,7 @@ class GltfEncoder {
   EncoderBuffer *out_buffer_;
   OutputType output_type_;
   std::string copyright_;
+  int num_threads_;
 };
 
 }  // namespace draco
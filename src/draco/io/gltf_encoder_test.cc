@@ -16,6 +16,7 @@
 
 #ifdef DRACO_TRANSCODER_SUPPORTED
 #include <array>
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -36,6 +37,7 @@
 #include "draco/io/texture_io.h"
 #include "draco/material/material_utils.h"
 #include "draco/mesh/mesh_utils.h"
+#include "draco/point_cloud/point_cloud_builder.h"
 #include "draco/scene/mesh_group.h"
 #include "draco/scene/scene.h"
 #include "draco/scene/scene_utils.h"
@@ -1828,6 +1830,161 @@ TEST_F(GltfEncoderTest, EncodePointCloudWithMaterials) {
   ASSERT_EQ(mesh_from_gltf->GetMaterialLibrary().NumMaterials(), 2);
 }
 
+// Creates a point cloud with Gaussian splat attributes stored as draco::Mesh.
+std::unique_ptr<Mesh> CreateGaussianPointCloud(int num_points, float offset) {
+  PointCloudBuilder builder;
+  builder.Start(num_points);
+  const int pos_att_id =
+      builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+  const int sh_dc_att_id =
+      builder.AddAttribute(GeometryAttribute::SH_DC, 3, DT_FLOAT32);
+  const int sh_rest_att_id =
+      builder.AddAttribute(GeometryAttribute::SH_REST, 45, DT_FLOAT32);
+  const int opacity_att_id =
+      builder.AddAttribute(GeometryAttribute::OPACITY, 1, DT_FLOAT32);
+  const int rotation_att_id =
+      builder.AddAttribute(GeometryAttribute::ROTATION, 4, DT_FLOAT32);
+  for (PointIndex i(0); i < num_points; ++i) {
+    const float t = offset + static_cast<float>(i.value()) / num_points;
+    const float pos[3] = {t, 2.f * t, -t};
+    const float sh_dc[3] = {t, 0.5f, -0.5f};
+    std::array<float, 45> sh_rest;
+    for (int c = 0; c < 45; ++c) {
+      sh_rest[c] = t * (c % 5);
+    }
+    const float opacity = t;
+    const float rotation[4] = {1.f, 0.f, 0.f, 0.f};
+    builder.SetAttributeValueForPoint(pos_att_id, i, pos);
+    builder.SetAttributeValueForPoint(sh_dc_att_id, i, sh_dc);
+    builder.SetAttributeValueForPoint(sh_rest_att_id, i, sh_rest.data());
+    builder.SetAttributeValueForPoint(opacity_att_id, i, &opacity);
+    builder.SetAttributeValueForPoint(rotation_att_id, i, rotation);
+  }
+  std::unique_ptr<PointCloud> pc = builder.Finalize(false);
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  PointCloud *const mesh_pc = mesh.get();
+  mesh_pc->Copy(*pc);
+  mesh->SetCompressionEnabled(true);
+  return mesh;
+}
+
+// Tests encoding of Gaussian splats compressed as Draco point clouds.
+TEST_F(GltfEncoderTest, EncodeGaussianPointCloudWithDraco) {
+  constexpr int kNumPoints = 500;
+  const std::unique_ptr<Mesh> mesh = CreateGaussianPointCloud(kNumPoints, 0.f);
+  GltfEncoder encoder;
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(*mesh, &buffer));
+
+  // The attributes are stored as Draco compressed application-specific glTF
+  // attributes. SH_REST is split into 12 attributes.
+  const std::string glb(buffer.data(), buffer.size());
+  ASSERT_NE(glb.find("KHR_draco_mesh_compression"), std::string::npos);
+  ASSERT_NE(glb.find("\"_SH_DC\""), std::string::npos);
+  ASSERT_NE(glb.find("\"_SH_REST_11\""), std::string::npos);
+  ASSERT_NE(glb.find("\"_OPACITY\""), std::string::npos);
+
+  DecoderBuffer decoder_buffer;
+  decoder_buffer.Init(buffer.data(), buffer.size());
+  GltfDecoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<Mesh> decoded_mesh,
+                         decoder.DecodeFromBuffer(&decoder_buffer));
+  ASSERT_EQ(decoded_mesh->num_faces(), 0);
+  ASSERT_EQ(decoded_mesh->num_points(), kNumPoints);
+  const PointAttribute *const sh_rest_att =
+      decoded_mesh->GetNamedAttribute(GeometryAttribute::SH_REST);
+  ASSERT_NE(sh_rest_att, nullptr);
+  ASSERT_EQ(decoded_mesh->NumNamedAttributes(GeometryAttribute::SH_REST), 1);
+  ASSERT_EQ(sh_rest_att->num_components(), 45);
+  ASSERT_NE(decoded_mesh->GetNamedAttribute(GeometryAttribute::SH_DC), nullptr);
+  ASSERT_NE(decoded_mesh->GetNamedAttribute(GeometryAttribute::ROTATION),
+            nullptr);
+
+  // Points may be reordered by the encoder so the values are compared per
+  // point through the opacity that is equal to the first coordinate.
+  const PointAttribute *const pos_att =
+      decoded_mesh->GetNamedAttribute(GeometryAttribute::POSITION);
+  const PointAttribute *const opacity_att =
+      decoded_mesh->GetNamedAttribute(GeometryAttribute::OPACITY);
+  ASSERT_NE(opacity_att, nullptr);
+  for (PointIndex i(0); i < kNumPoints; ++i) {
+    float pos[3];
+    float opacity;
+    std::array<float, 45> sh_rest;
+    pos_att->GetMappedValue(i, pos);
+    opacity_att->GetMappedValue(i, &opacity);
+    sh_rest_att->GetMappedValue(i, sh_rest.data());
+    ASSERT_NEAR(opacity, pos[0], 1e-2);
+    ASSERT_NEAR(sh_rest[4], 4.f * pos[0], 1e-2);
+  }
+}
+
+// Tests that a scene with multiple Gaussian splat frames is stored as Draco
+// compressed point clouds in a single glTF file.
+TEST_F(GltfEncoderTest, EncodeGaussianFramesWithDraco) {
+  constexpr int kNumFrames = 3;
+  constexpr int kNumPoints = 100;
+  Scene scene;
+  scene.GetMaterialLibrary().MutableMaterial(0);
+  for (int f = 0; f < kNumFrames; ++f) {
+    const MeshIndex mesh_index =
+        scene.AddMesh(CreateGaussianPointCloud(kNumPoints, f));
+    const MeshGroupIndex mesh_group_index = scene.AddMeshGroup();
+    scene.GetMeshGroup(mesh_group_index)
+        ->AddMeshInstance(MeshGroup::MeshInstance(mesh_index, 0));
+    const SceneNodeIndex node_index = scene.AddNode();
+    scene.GetNode(node_index)->SetMeshGroupIndex(mesh_group_index);
+    scene.AddRootNodeIndex(node_index);
+  }
+
+  GltfEncoder encoder;
+  EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(scene, &buffer));
+  DecoderBuffer decoder_buffer;
+  decoder_buffer.Init(buffer.data(), buffer.size());
+  GltfDecoder decoder;
+  DRACO_ASSIGN_OR_ASSERT(std::unique_ptr<Scene> decoded_scene,
+                         decoder.DecodeFromBufferToScene(&decoder_buffer));
+  ASSERT_EQ(decoded_scene->NumMeshes(), kNumFrames);
+  for (MeshIndex i(0); i < kNumFrames; ++i) {
+    const Mesh &frame = decoded_scene->GetMesh(i);
+    ASSERT_EQ(frame.num_points(), kNumPoints);
+    ASSERT_EQ(frame.GetNamedAttribute(GeometryAttribute::SH_REST)
+                  ->num_components(),
+              45);
+  }
+}
+
+// Tests that the output does not depend on the number of threads used for
+// compressing the meshes.
+TEST_F(GltfEncoderTest, EncodeMeshesWithMultipleThreads) {
+  constexpr int kNumFrames = 5;
+  Scene scene;
+  scene.GetMaterialLibrary().MutableMaterial(0);
+  for (int f = 0; f < kNumFrames; ++f) {
+    const MeshIndex mesh_index =
+        scene.AddMesh(CreateGaussianPointCloud(50 + 10 * f, f));
+    const MeshGroupIndex mesh_group_index = scene.AddMeshGroup();
+    scene.GetMeshGroup(mesh_group_index)
+        ->AddMeshInstance(MeshGroup::MeshInstance(mesh_index, 0));
+    const SceneNodeIndex node_index = scene.AddNode();
+    scene.GetNode(node_index)->SetMeshGroupIndex(mesh_group_index);
+    scene.AddRootNodeIndex(node_index);
+  }
+
+  GltfEncoder encoder;
+  encoder.set_num_threads(1);
+  EncoderBuffer single_thread_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(scene, &single_thread_buffer));
+  encoder.set_num_threads(4);
+  EncoderBuffer multi_thread_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeToBuffer(scene, &multi_thread_buffer));
+  ASSERT_EQ(single_thread_buffer.size(), multi_thread_buffer.size());
+  ASSERT_EQ(memcmp(single_thread_buffer.data(), multi_thread_buffer.data(),
+                   single_thread_buffer.size()),
+            0);
+}
+
 }  // namespace draco
 
 #endif  // DRACO_TRANSCODER_SUPPORTED
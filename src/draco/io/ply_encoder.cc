@@ -17,6 +17,7 @@
 #include <memory>
 #include <sstream>
 
+#include "draco/core/trace.h"
 #include "draco/io/file_writer_factory.h"
 #include "draco/io/file_writer_interface.h"
 
@@ -49,6 +50,7 @@ bool PlyEncoder::EncodeToFile(const Mesh &mesh, const std::string &file_name) {
 
 bool PlyEncoder::EncodeToBuffer(const PointCloud &pc,
                                 EncoderBuffer *out_buffer) {
+  DRACO_TRACE_SPAN("PlyEncoder::EncodeToBuffer");
   in_point_cloud_ = &pc;
   out_buffer_ = out_buffer;
   if (!EncodeInternal()) {
@@ -20,7 +20,7 @@
 #include "draco/core/status.h"
 #include "draco/core/status_or.h"
 #include "draco/io/file_utils.h"
-#include "draco/mesh/triangle_soup_mesh_builder.h"
+#include "draco/mesh/streaming_triangle_soup_mesh_builder.h"
 
 namespace draco {
 
@@ -45,7 +45,9 @@ StatusOr<std::unique_ptr<Mesh>> StlDecoder::DecodeFromBuffer(
   uint32_t face_count;
   buffer->Decode(&face_count, 4);
 
-  TriangleSoupMeshBuilder builder;
+  // The face count from the header is only used as a hint for sizing the
+  // deduplication tables. Values are deduplicated as the faces are read.
+  StreamingTriangleSoupMeshBuilder builder;
   builder.Start(face_count);
 
   const int32_t pos_att_id =
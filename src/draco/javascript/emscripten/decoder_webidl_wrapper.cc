@@ -247,22 +247,16 @@ bool Decoder::GetAttributeFloatArrayForAllPoints(const PointCloud &pc,
   if (data_size != out_size) {
     return false;
   }
-  const bool requested_type_is_float = pa.data_type() == draco::DT_FLOAT32;
-  std::vector<float> values(components, -2.f);
-  int entry_id = 0;
+  if (pa.data_type() == draco::DT_FLOAT32) {
+    // Float values don't need any conversion and can be copied directly.
+    return GetAttributeDataArrayForAllPoints<float>(
+        pc, pa, draco::DT_FLOAT32, out_size, out_values);
+  }
   float *const floats = reinterpret_cast<float *>(out_values);
-
   for (draco::PointIndex i(0); i < num_points; ++i) {
-    const draco::AttributeValueIndex val_index = pa.mapped_index(i);
-    if (requested_type_is_float) {
-      pa.GetValue(val_index, &values[0]);
-    } else {
-      if (!pa.ConvertValue<float>(val_index, &values[0])) {
-        return false;
-      }
-    }
-    for (int j = 0; j < components; ++j) {
-      floats[entry_id++] = values[j];
+    if (!pa.ConvertValue<float>(pa.mapped_index(i),
+                                floats + i.value() * components)) {
+      return false;
     }
   }
   return true;
@@ -347,6 +341,69 @@ bool Decoder::GetAttributeDataArrayForAllPoints(const draco::PointCloud &pc,
   }
 }
 
+namespace {
+
+// Returns the size in bytes of |data_type| values of |pa| for all points of
+// |pc|.
+int GetAttributeDataSize(const PointCloud &pc, const PointAttribute &pa,
+                         draco::DataType data_type) {
+  return pc.num_points() * pa.num_components() *
+         draco::DataTypeLength(data_type);
+}
+
+// Returns |size| rounded up to a multiple of four bytes.
+int GetPaddedSize(int size) { return (size + 3) & ~3; }
+
+}  // namespace
+
+long Decoder::GetAttributesDataArraySize(const PointCloud &pc,
+                                         const int32_t *att_ids,
+                                         int num_att_ids,
+                                         draco_DataType data_type) {
+  if (num_att_ids < 0 || draco::DataTypeLength(data_type) == 0) {
+    return 0;
+  }
+  long size = sizeof(uint32_t) * (num_att_ids + 1);
+  for (int i = 0; i < num_att_ids; ++i) {
+    if (att_ids[i] < 0 || att_ids[i] >= pc.num_attributes()) {
+      return 0;
+    }
+    const PointAttribute &pa = *pc.attribute(att_ids[i]);
+    size += GetPaddedSize(GetAttributeDataSize(pc, pa, data_type));
+  }
+  return size;
+}
+
+bool Decoder::GetAttributesDataArrayForAllPoints(const PointCloud &pc,
+                                                 const int32_t *att_ids,
+                                                 int num_att_ids,
+                                                 draco_DataType data_type,
+                                                 int out_size,
+                                                 void *out_values) {
+  const long size =
+      GetAttributesDataArraySize(pc, att_ids, num_att_ids, data_type);
+  if (size == 0 || size != out_size) {
+    return false;
+  }
+  uint8_t *const bytes = reinterpret_cast<uint8_t *>(out_values);
+  uint32_t offset = sizeof(uint32_t) * (num_att_ids + 1);
+  for (int i = 0; i < num_att_ids; ++i) {
+    const PointAttribute &pa = *pc.attribute(att_ids[i]);
+    const int data_size = GetAttributeDataSize(pc, pa, data_type);
+    ::memcpy(bytes + sizeof(uint32_t) * i, &offset, sizeof(offset));
+    if (!GetAttributeDataArrayForAllPoints(pc, pa, data_type, data_size,
+                                           bytes + offset)) {
+      return false;
+    }
+    // Clear the padding so that the whole block is deterministic.
+    const int padded_size = GetPaddedSize(data_size);
+    ::memset(bytes + offset + data_size, 0, padded_size - data_size);
+    offset += padded_size;
+  }
+  ::memcpy(bytes + sizeof(uint32_t) * num_att_ids, &offset, sizeof(offset));
+  return true;
+}
+
 void Decoder::SkipAttributeTransform(draco_GeometryAttribute_Type att_type) {
   decoder_.SetSkipAttributeTransform(att_type);
 }
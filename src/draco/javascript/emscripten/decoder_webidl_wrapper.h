@@ -236,6 +236,30 @@ class Decoder {
                                                 draco_DataType data_type,
                                                 int out_size, void *out_values);
 
+  // Returns the size in bytes of the memory needed by
+  // GetAttributesDataArrayForAllPoints() for attributes |att_ids| of |pc|
+  // converted to |data_type|. Returns 0 when some attribute doesn't exist.
+  static long GetAttributesDataArraySize(const draco::PointCloud &pc,
+                                         const int32_t *att_ids,
+                                         int num_att_ids,
+                                         draco_DataType data_type);
+
+  // Returns |data_type| values of attributes |att_ids| for all point ids of
+  // the point cloud in a single contiguous memory block |out_values|. The
+  // block starts with a table of |num_att_ids| + 1 uint32_t byte offsets.
+  // Entry i of the table is the offset of the values of attribute |att_ids[i]|
+  // and the last entry is the total size of the block. Values of each
+  // attribute are tightly packed and start at an offset aligned to four
+  // bytes, so typed array views can be created directly on top of the block.
+  // |out_size| is the size in bytes of |out_values| and it must be equal to
+  // the value returned by GetAttributesDataArraySize().
+  static bool GetAttributesDataArrayForAllPoints(const draco::PointCloud &pc,
+                                                 const int32_t *att_ids,
+                                                 int num_att_ids,
+                                                 draco_DataType data_type,
+                                                 int out_size,
+                                                 void *out_values);
+
   // Tells the decoder to skip an attribute transform (e.g. dequantization) for
   // an attribute of a given type.
   void SkipAttributeTransform(draco_GeometryAttribute_Type att_type);
@@ -302,22 +326,23 @@ class Decoder {
       return true;
     }
 
-    // Copy values one by one.
-    std::vector<T> values(components);
-    int entry_id = 0;
+    if (requested_type_matches) {
+      // Copy values of mapped entries directly to the output.
+      const int value_size = components * sizeof(T);
+      uint8_t *const bytes = reinterpret_cast<uint8_t *>(out_values);
+      for (draco::PointIndex i(0); i < num_points; ++i) {
+        ::memcpy(bytes + i.value() * value_size,
+                 pa.GetAddressOfMappedIndex(i), value_size);
+      }
+      return true;
+    }
 
+    // Convert values one by one.
     T *const typed_output = reinterpret_cast<T *>(out_values);
     for (draco::PointIndex i(0); i < num_points; ++i) {
-      const draco::AttributeValueIndex val_index = pa.mapped_index(i);
-      if (requested_type_matches) {
-        pa.GetValue(val_index, values.data());
-      } else {
-        if (!pa.ConvertValue<T>(val_index, values.data())) {
-          return false;
-        }
-      }
-      for (int j = 0; j < components; ++j) {
-        typed_output[entry_id++] = values[j];
+      if (!pa.ConvertValue<T>(pa.mapped_index(i),
+                              typed_output + i.value() * components)) {
+        return false;
       }
     }
     return true;
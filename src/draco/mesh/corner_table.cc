@@ -14,10 +14,13 @@
 //
 #include "draco/mesh/corner_table.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "draco/attributes/geometry_indices.h"
+#include "draco/core/thread_pool.h"
 #include "draco/mesh/corner_table_iterators.h"
 
 namespace draco {
@@ -30,24 +33,38 @@ CornerTable::CornerTable()
 
 std::unique_ptr<CornerTable> CornerTable::Create(
     const IndexTypeVector<FaceIndex, FaceType> &faces) {
+  return Create(faces, 1);
+}
+
+std::unique_ptr<CornerTable> CornerTable::Create(
+    const IndexTypeVector<FaceIndex, FaceType> &faces, int num_threads) {
   std::unique_ptr<CornerTable> ct(new CornerTable());
-  if (!ct->Init(faces)) {
+  if (!ct->Init(faces, num_threads)) {
     return nullptr;
   }
   return ct;
 }
 
 bool CornerTable::Init(const IndexTypeVector<FaceIndex, FaceType> &faces) {
+  return Init(faces, 1);
+}
+
+bool CornerTable::Init(const IndexTypeVector<FaceIndex, FaceType> &faces,
+                       int num_threads) {
   valence_cache_.ClearValenceCache();
   valence_cache_.ClearValenceCacheInaccurate();
-  corner_to_vertex_map_.resize(faces.size() * 3);
+  corners_.assign(faces.size() * 3, Corner());
   for (FaceIndex fi(0); fi < static_cast<uint32_t>(faces.size()); ++fi) {
     for (int i = 0; i < 3; ++i) {
-      corner_to_vertex_map_[FirstCorner(fi) + i] = faces[fi][i];
+      corners_[FirstCorner(fi) + i].vertex = faces[fi][i];
     }
   }
   int num_vertices = -1;
-  if (!ComputeOppositeCorners(&num_vertices)) {
+  if (num_threads > 1) {
+    if (!ComputeOppositeCornersParallel(num_threads, &num_vertices)) {
+      return false;
+    }
+  } else if (!ComputeOppositeCorners(&num_vertices)) {
     return false;
   }
   if (!BreakNonManifoldEdges()) {
@@ -72,8 +89,7 @@ bool CornerTable::Reset(int num_faces, int num_vertices) {
       std::numeric_limits<CornerIndex::ValueType>::max() / 3) {
     return false;
   }
-  corner_to_vertex_map_.assign(num_faces_unsigned * 3, kInvalidVertexIndex);
-  opposite_corners_.assign(num_faces_unsigned * 3, kInvalidCornerIndex);
+  corners_.assign(num_faces_unsigned * 3, Corner());
   vertex_corners_.reserve(num_vertices);
   valence_cache_.ClearValenceCache();
   valence_cache_.ClearValenceCacheInaccurate();
@@ -85,8 +101,6 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
   if (num_vertices == nullptr) {
     return false;
   }
-  opposite_corners_.resize(num_corners(), kInvalidCornerIndex);
-
   // Out implementation for finding opposite corners is based on keeping track
   // of outgoing half-edges for each vertex of the mesh. Half-edges (defined by
   // their opposite corners) are processed one by one and whenever a new
@@ -201,14 +215,126 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
       }
     } else {
       // Opposite corner found.
-      opposite_corners_[c] = opposite_c;
-      opposite_corners_[opposite_c] = c;
+      corners_[c].opposite = opposite_c;
+      corners_[opposite_c].opposite = c;
     }
   }
   *num_vertices = static_cast<int>(num_corners_on_vertices.size());
   return true;
 }
 
+bool CornerTable::ComputeOppositeCornersParallel(int num_threads,
+                                                 int *num_vertices) {
+  DRACO_DCHECK(GetValenceCache().IsCacheEmpty());
+  if (num_vertices == nullptr) {
+    return false;
+  }
+  // Half-edge defined by its opposite corner and the sorted indices of its
+  // vertices.
+  struct HalfEdge {
+    uint32_t min_vert;
+    uint32_t max_vert;
+    CornerIndex corner;
+    bool operator<(const HalfEdge &other) const {
+      if (min_vert != other.min_vert) {
+        return min_vert < other.min_vert;
+      }
+      if (max_vert != other.max_vert) {
+        return max_vert < other.max_vert;
+      }
+      return corner < other.corner;
+    }
+  };
+
+  // Each task processes a continuous range of faces and distributes their
+  // half-edges into buckets. All half-edges of one edge end up in the same
+  // bucket.
+  const int num_faces = this->num_faces();
+  const int num_tasks = std::max(std::min(num_threads, num_faces), 1);
+  const int num_buckets = 4 * num_tasks;
+  std::vector<std::vector<std::vector<HalfEdge>>> task_buckets(
+      num_tasks, std::vector<std::vector<HalfEdge>>(num_buckets));
+  std::vector<int> task_num_vertices(num_tasks, 0);
+  std::vector<int> task_num_degenerated_faces(num_tasks, 0);
+  ParallelFor(num_tasks, num_threads, [&](int t) {
+    const FaceIndex first_face(static_cast<uint32_t>(
+        static_cast<int64_t>(num_faces) * t / num_tasks));
+    const FaceIndex last_face(static_cast<uint32_t>(
+        static_cast<int64_t>(num_faces) * (t + 1) / num_tasks));
+    std::vector<std::vector<HalfEdge>> &buckets = task_buckets[t];
+    for (FaceIndex f = first_face; f < last_face; ++f) {
+      const CornerIndex first_c = FirstCorner(f);
+      for (int i = 0; i < 3; ++i) {
+        task_num_vertices[t] = std::max(
+            task_num_vertices[t],
+            static_cast<int>(Vertex(first_c + i).value()) + 1);
+      }
+      if (IsDegenerated(f)) {
+        ++task_num_degenerated_faces[t];
+        continue;
+      }
+      for (int i = 0; i < 3; ++i) {
+        const CornerIndex c = first_c + i;
+        const uint32_t source_v = Vertex(Next(c)).value();
+        const uint32_t sink_v = Vertex(Previous(c)).value();
+        HalfEdge edge;
+        edge.min_vert = std::min(source_v, sink_v);
+        edge.max_vert = std::max(source_v, sink_v);
+        edge.corner = c;
+        const uint64_t key =
+            (static_cast<uint64_t>(edge.min_vert) << 32) | edge.max_vert;
+        const uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+        buckets[(hash >> 32) % num_buckets].push_back(edge);
+      }
+    }
+  });
+
+  ParallelFor(num_buckets, num_threads, [&](int b) {
+    std::vector<HalfEdge> edges;
+    for (int t = 0; t < num_tasks; ++t) {
+      edges.insert(edges.end(), task_buckets[t][b].begin(),
+                   task_buckets[t][b].end());
+      std::vector<HalfEdge>().swap(task_buckets[t][b]);
+    }
+    std::sort(edges.begin(), edges.end());
+
+    // Unmatched half-edges of the current edge going from the smaller to the
+    // larger vertex and in the opposite direction.
+    std::vector<CornerIndex> unmatched[2];
+    for (size_t i = 0; i < edges.size(); ++i) {
+      if (i == 0 || edges[i].min_vert != edges[i - 1].min_vert ||
+          edges[i].max_vert != edges[i - 1].max_vert) {
+        unmatched[0].clear();
+        unmatched[1].clear();
+      }
+      const CornerIndex c = edges[i].corner;
+      const VertexIndex tip_v = Vertex(c);
+      const int direction = Vertex(Next(c)) < Vertex(Previous(c)) ? 0 : 1;
+      // Connect the half-edge with the first unmatched half-edge in the
+      // opposite direction, same as in ComputeOppositeCorners().
+      std::vector<CornerIndex> &candidates = unmatched[1 - direction];
+      auto it = candidates.begin();
+      while (it != candidates.end() && Vertex(*it) == tip_v) {
+        ++it;  // Don't connect mirrored faces.
+      }
+      if (it == candidates.end()) {
+        unmatched[direction].push_back(c);
+      } else {
+        corners_[c].opposite = *it;
+        corners_[*it].opposite = c;
+        candidates.erase(it);
+      }
+    }
+  });
+
+  *num_vertices = 0;
+  for (int t = 0; t < num_tasks; ++t) {
+    *num_vertices = std::max(*num_vertices, task_num_vertices[t]);
+    num_degenerated_faces_ += task_num_degenerated_faces[t];
+  }
+  return true;
+}
+
 bool CornerTable::BreakNonManifoldEdges() {
   // This function detects and breaks non-manifold edges that are caused by
   // folds in 1-ring neighborhood around a vertex. Non-manifold edges can occur
@@ -257,7 +383,7 @@ bool CornerTable::BreakNonManifoldEdges() {
         // currently processed pivot corner. I.e., each edge is uniquely defined
         // by the sink vertex index.
         const CornerIndex sink_c = Next(current_c);
-        const VertexIndex sink_v = corner_to_vertex_map_[sink_c];
+        const VertexIndex sink_v = corners_[sink_c].vertex;
 
         // Corner that defines the edge on the face.
         const CornerIndex edge_corner = Previous(current_c);
@@ -305,7 +431,7 @@ bool CornerTable::BreakNonManifoldEdges() {
         }
         // Insert new sink vertex information <sink vertex index, edge corner>.
         std::pair<VertexIndex, CornerIndex> new_sink_vert;
-        new_sink_vert.first = corner_to_vertex_map_[Previous(current_c)];
+        new_sink_vert.first = corners_[Previous(current_c)].vertex;
         new_sink_vert.second = sink_c;
         sink_vertices.push_back(new_sink_vert);
 
@@ -337,7 +463,7 @@ bool CornerTable::ComputeVertexCorners(int num_vertices) {
       if (visited_corners[c.value()]) {
         continue;
       }
-      VertexIndex v = corner_to_vertex_map_[c];
+      VertexIndex v = corners_[c].vertex;
       // Note that one vertex maps to many corners, but we just keep track
       // of the vertex which has a boundary on the left if the vertex lies on
       // the boundary. This means that all the related corners can be accessed
@@ -365,7 +491,7 @@ bool CornerTable::ComputeVertexCorners(int num_vertices) {
         vertex_corners_[v] = act_c;
         if (is_non_manifold_vertex) {
           // Update vertex index in the corresponding face.
-          corner_to_vertex_map_[act_c] = v;
+          corners_[act_c].vertex = v;
         }
         act_c = SwingLeft(act_c);
         if (act_c == c) {
@@ -380,7 +506,7 @@ bool CornerTable::ComputeVertexCorners(int num_vertices) {
           visited_corners[act_c.value()] = true;
           if (is_non_manifold_vertex) {
             // Update vertex index in the corresponding face.
-            corner_to_vertex_map_[act_c] = v;
+            corners_[act_c].vertex = v;
           }
           act_c = SwingRight(act_c);
         }
@@ -435,7 +561,7 @@ void CornerTable::UpdateFaceToVertexMap(const VertexIndex vertex) {
   VertexCornersIterator<CornerTable> it(this, vertex);
   for (; !it.End(); ++it) {
     const CornerIndex corner = *it;
-    corner_to_vertex_map_[corner] = vertex;
+    corners_[corner].vertex = vertex;
   }
 }
 
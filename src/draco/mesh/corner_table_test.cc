@@ -123,4 +123,44 @@ TEST_F(CornerTableTest, TestNewFace) {
   ASSERT_EQ(ct->Vertex(CornerIndex(3 * 12) + 2), new_vi);
 }
 
+TEST_F(CornerTableTest, TestParallelInit) {
+  // Tests that the corner table constructed on multiple threads is the same as
+  // the one constructed on a single thread. The faces are generated randomly
+  // on a small number of vertices so they contain many non-manifold edges,
+  // mirrored faces and degenerated faces.
+  constexpr int kNumFaces = 3000;
+  constexpr int kNumVertices = 40;
+  IndexTypeVector<FaceIndex, CornerTable::FaceType> faces(kNumFaces);
+  uint32_t seed = 1;
+  for (FaceIndex f(0); f < kNumFaces; ++f) {
+    for (int c = 0; c < 3; ++c) {
+      seed = seed * 1103515245 + 12345;
+      faces[f][c] = VertexIndex((seed >> 16) % kNumVertices);
+    }
+    if (f.value() % 5 == 4) {
+      // Mirrored copy of the previous face.
+      const CornerTable::FaceType &prev = faces[f - 1];
+      faces[f] = {{prev[0], prev[2], prev[1]}};
+    }
+  }
+
+  const std::unique_ptr<CornerTable> ct = CornerTable::Create(faces);
+  ASSERT_NE(ct, nullptr);
+  for (const int num_threads : {2, 3, 8}) {
+    const std::unique_ptr<CornerTable> parallel_ct =
+        CornerTable::Create(faces, num_threads);
+    ASSERT_NE(parallel_ct, nullptr);
+    ASSERT_EQ(parallel_ct->num_vertices(), ct->num_vertices());
+    ASSERT_EQ(parallel_ct->NumDegeneratedFaces(), ct->NumDegeneratedFaces());
+    ASSERT_EQ(parallel_ct->NumNewVertices(), ct->NumNewVertices());
+    for (CornerIndex c(0); c < ct->num_corners(); ++c) {
+      ASSERT_EQ(parallel_ct->Opposite(c), ct->Opposite(c));
+      ASSERT_EQ(parallel_ct->Vertex(c), ct->Vertex(c));
+    }
+    for (VertexIndex v(0); v < ct->num_vertices(); ++v) {
+      ASSERT_EQ(parallel_ct->LeftMostCorner(v), ct->LeftMostCorner(v));
+    }
+  }
+}
+
 }  // namespace draco
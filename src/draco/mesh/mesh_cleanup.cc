@@ -21,12 +21,14 @@
 #include <vector>
 
 #include "draco/core/hash_utils.h"
+#include "draco/mesh/mesh_misc_functions.h"
 
 namespace draco {
 
 Status MeshCleanup::Cleanup(Mesh *mesh, const MeshCleanupOptions &options) {
   if (!options.remove_degenerated_faces && !options.remove_unused_attributes &&
-      !options.remove_duplicate_faces && !options.make_geometry_manifold) {
+      !options.remove_duplicate_faces && !options.make_geometry_manifold &&
+      !options.reorder_for_locality) {
     return OkStatus();  // Nothing to cleanup.
   }
   const PointAttribute *const pos_att =
@@ -47,6 +49,10 @@ Status MeshCleanup::Cleanup(Mesh *mesh, const MeshCleanupOptions &options) {
     RemoveUnusedAttributes(mesh);
   }
 
+  if (options.reorder_for_locality) {
+    DRACO_RETURN_IF_ERROR(ReorderForLocality(mesh));
+  }
+
   return OkStatus();
 }
 
@@ -245,4 +251,122 @@ Status MeshCleanup::MakeGeometryManifold(Mesh *mesh) {
   return Status(Status::DRACO_ERROR, "Unsupported function.");
 }
 
+Status MeshCleanup::ReorderForLocality(Mesh *mesh) {
+  const FaceIndex::ValueType num_faces = mesh->num_faces();
+  if (num_faces == 0) {
+    return OkStatus();
+  }
+  const std::unique_ptr<CornerTable> corner_table =
+      CreateCornerTableFromPositionAttribute(mesh);
+  if (corner_table == nullptr) {
+    return Status(Status::DRACO_ERROR, "Failed to compute mesh connectivity.");
+  }
+
+  // Order the faces of each connected component in a breadth-first traversal
+  // starting from the first face of the component. Neighboring faces end up
+  // close to each other in the new order.
+  std::vector<FaceIndex> new_to_old_face;
+  new_to_old_face.reserve(num_faces);
+  std::vector<bool> is_face_visited(num_faces, false);
+  for (FaceIndex f(0); f < num_faces; ++f) {
+    if (is_face_visited[f.value()]) {
+      continue;
+    }
+    is_face_visited[f.value()] = true;
+    size_t queue_start = new_to_old_face.size();
+    new_to_old_face.push_back(f);
+    while (queue_start < new_to_old_face.size()) {
+      const FaceIndex act_face = new_to_old_face[queue_start++];
+      for (const CornerIndex &c : corner_table->AllCorners(act_face)) {
+        const FaceIndex opp_face =
+            corner_table->Face(corner_table->Opposite(c));
+        if (opp_face == kInvalidFaceIndex ||
+            is_face_visited[opp_face.value()]) {
+          continue;
+        }
+        is_face_visited[opp_face.value()] = true;
+        new_to_old_face.push_back(opp_face);
+      }
+    }
+  }
+
+  // Number the points in the order in which they are referenced by the
+  // reordered faces. Unreferenced points are moved to the end.
+  const PointIndex::ValueType num_points = mesh->num_points();
+  IndexTypeVector<PointIndex, PointIndex> old_to_new_point(num_points,
+                                                           kInvalidPointIndex);
+  IndexTypeVector<PointIndex, PointIndex> new_to_old_point(num_points);
+  PointIndex::ValueType num_new_points = 0;
+  IndexTypeVector<FaceIndex, Mesh::Face> new_faces(num_faces);
+  for (FaceIndex f(0); f < num_faces; ++f) {
+    const Mesh::Face &face = mesh->face(new_to_old_face[f.value()]);
+    for (int c = 0; c < 3; ++c) {
+      if (old_to_new_point[face[c]] == kInvalidPointIndex) {
+        new_to_old_point[PointIndex(num_new_points)] = face[c];
+        old_to_new_point[face[c]] = PointIndex(num_new_points++);
+      }
+      new_faces[f][c] = old_to_new_point[face[c]];
+    }
+  }
+  for (PointIndex p(0); p < num_points; ++p) {
+    if (old_to_new_point[p] == kInvalidPointIndex) {
+      new_to_old_point[PointIndex(num_new_points)] = p;
+      old_to_new_point[p] = PointIndex(num_new_points++);
+    }
+  }
+  for (FaceIndex f(0); f < num_faces; ++f) {
+    mesh->SetFace(f, new_faces[f]);
+  }
+
+  // Reorder the values of all attributes in the order in which they are
+  // referenced by the reordered points. For attributes with identity mapping
+  // this is the same order as the new point order so the mapping stays
+  // identity.
+  IndexTypeVector<AttributeValueIndex, AttributeValueIndex> old_to_new_value;
+  IndexTypeVector<PointIndex, AttributeValueIndex> old_mapping;
+  std::vector<uint8_t> old_values;
+  for (int a = 0; a < mesh->num_attributes(); ++a) {
+    PointAttribute *const att = mesh->attribute(a);
+    const AttributeValueIndex::ValueType num_values =
+        static_cast<AttributeValueIndex::ValueType>(att->size());
+    if (num_values == 0) {
+      continue;
+    }
+    old_to_new_value.assign(num_values, kInvalidAttributeValueIndex);
+    AttributeValueIndex::ValueType num_new_values = 0;
+    old_mapping.resize(num_points);
+    for (PointIndex p(0); p < num_points; ++p) {
+      old_mapping[p] = att->mapped_index(p);
+    }
+    for (PointIndex p(0); p < num_points; ++p) {
+      const AttributeValueIndex avi = old_mapping[new_to_old_point[p]];
+      if (avi < num_values &&
+          old_to_new_value[avi] == kInvalidAttributeValueIndex) {
+        old_to_new_value[avi] = AttributeValueIndex(num_new_values++);
+      }
+    }
+    for (AttributeValueIndex avi(0); avi < num_values; ++avi) {
+      if (old_to_new_value[avi] == kInvalidAttributeValueIndex) {
+        old_to_new_value[avi] = AttributeValueIndex(num_new_values++);
+      }
+    }
+
+    const int64_t stride = att->byte_stride();
+    const uint8_t *const data = att->GetAddress(AttributeValueIndex(0));
+    old_values.assign(data, data + stride * num_values);
+    for (AttributeValueIndex avi(0); avi < num_values; ++avi) {
+      att->SetAttributeValue(old_to_new_value[avi],
+                             old_values.data() + stride * avi.value());
+    }
+    if (!att->is_mapping_identity()) {
+      for (PointIndex p(0); p < num_points; ++p) {
+        const AttributeValueIndex avi = old_mapping[new_to_old_point[p]];
+        att->SetPointMapEntry(
+            p, avi < num_values ? old_to_new_value[avi] : avi);
+      }
+    }
+  }
+  return OkStatus();
+}
+
 }  // namespace draco
@@ -41,6 +41,13 @@ struct MeshCleanupOptions {
   // vertices. This ensures that the connectivity defined by position indices
   // is manifold.
   bool make_geometry_manifold = false;
+
+  // If true, the cleanup tool reorders faces along the surface of the mesh and
+  // then points and attribute values in the order in which they are first
+  // referenced by the faces. This improves memory locality of algorithms that
+  // traverse the mesh connectivity, such as the construction and traversal of
+  // CornerTable, on large meshes. No data is removed.
+  bool reorder_for_locality = false;
 };
 
 // Tool that can be used for removing bad or unused data from draco::Meshes.
@@ -54,6 +61,7 @@ class MeshCleanup {
   static void RemoveDuplicateFaces(Mesh *mesh);
   static void RemoveUnusedAttributes(Mesh *mesh);
   static Status MakeGeometryManifold(Mesh *mesh);
+  static Status ReorderForLocality(Mesh *mesh);
 };
 
 }  // namespace draco
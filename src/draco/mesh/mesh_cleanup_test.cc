@@ -17,6 +17,7 @@
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
 #include "draco/core/vector_d.h"
+#include "draco/mesh/mesh_are_equivalent.h"
 #include "draco/mesh/triangle_soup_mesh_builder.h"
 
 namespace draco {
@@ -207,4 +208,82 @@ TEST_F(MeshCleanupTest, TestDuplicateFaces) {
   ASSERT_EQ(mesh->num_faces(), 3);
 }
 
+TEST_F(MeshCleanupTest, TestReorderForLocality) {
+  // This test verifies that the mesh cleanup tool can reorder faces and points
+  // of a mesh without changing its geometry.
+  constexpr int kSize = 8;
+  constexpr int kNumFaces = 2 * kSize * kSize;
+  const auto create_mesh = [&]() {
+    TriangleSoupMeshBuilder mb;
+    mb.Start(kNumFaces);
+    const int pos_att_id =
+        mb.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+    const int int_att_id =
+        mb.AddAttribute(GeometryAttribute::GENERIC, 1, DT_INT32);
+    // Faces of a regular grid are added in a scattered order.
+    for (int i = 0; i < kNumFaces; ++i) {
+      const int face = (i * 37) % kNumFaces;
+      const int x = (face / 2) % kSize;
+      const int y = (face / 2) / kSize;
+      const int corners[2][3][2] = {{{x, y}, {x + 1, y}, {x + 1, y + 1}},
+                                    {{x, y}, {x + 1, y + 1}, {x, y + 1}}};
+      Vector3f pos[3];
+      int32_t value[3];
+      for (int c = 0; c < 3; ++c) {
+        const int cx = corners[face % 2][c][0];
+        const int cy = corners[face % 2][c][1];
+        pos[c] = Vector3f(cx, cy, 0.f);
+        value[c] = cy * (kSize + 1) + cx;
+      }
+      mb.SetAttributeValuesForFace(pos_att_id, FaceIndex(i), pos[0].data(),
+                                   pos[1].data(), pos[2].data());
+      mb.SetAttributeValuesForFace(int_att_id, FaceIndex(i), &value[0],
+                                   &value[1], &value[2]);
+    }
+    return mb.Finalize();
+  };
+  const std::unique_ptr<Mesh> original_mesh = create_mesh();
+  ASSERT_NE(original_mesh, nullptr);
+  std::unique_ptr<Mesh> mesh = create_mesh();
+  ASSERT_NE(mesh, nullptr);
+
+  MeshCleanupOptions cleanup_options;
+  cleanup_options.remove_degenerated_faces = false;
+  cleanup_options.remove_duplicate_faces = false;
+  cleanup_options.remove_unused_attributes = false;
+  cleanup_options.reorder_for_locality = true;
+  DRACO_ASSERT_OK(MeshCleanup::Cleanup(mesh.get(), cleanup_options));
+  ASSERT_EQ(mesh->num_faces(), original_mesh->num_faces());
+  ASSERT_EQ(mesh->num_points(), original_mesh->num_points());
+  MeshAreEquivalent equiv;
+  ASSERT_TRUE(equiv(*mesh, *original_mesh));
+
+  // Each face after the first one must share an edge with one of the previous
+  // faces and points must be numbered in the order of their first use.
+  int num_used_points = 0;
+  for (FaceIndex f(0); f < mesh->num_faces(); ++f) {
+    const Mesh::Face &face = mesh->face(f);
+    int num_new_points = 0;
+    for (int c = 0; c < 3; ++c) {
+      if (face[c].value() >= num_used_points) {
+        ASSERT_EQ(face[c].value(), num_used_points);
+        ++num_used_points;
+        ++num_new_points;
+      }
+    }
+    ASSERT_LE(num_new_points, f == 0 ? 3 : 1);
+  }
+  // Values of all attributes are stored in the order of their first use.
+  const PointAttribute *const pos_att =
+      mesh->GetNamedAttribute(GeometryAttribute::POSITION);
+  int num_used_values = 0;
+  for (PointIndex p(0); p < mesh->num_points(); ++p) {
+    const int value = pos_att->mapped_index(p).value();
+    ASSERT_LE(value, num_used_values);
+    if (value == num_used_values) {
+      ++num_used_values;
+    }
+  }
+}
+
 }  // namespace draco
@@ -18,11 +18,22 @@ namespace draco {
 
 std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
     const Mesh *mesh) {
-  return CreateCornerTableFromAttribute(mesh, GeometryAttribute::POSITION);
+  return CreateCornerTableFromAttribute(mesh, GeometryAttribute::POSITION, 1);
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
+    const Mesh *mesh, int num_threads) {
+  return CreateCornerTableFromAttribute(mesh, GeometryAttribute::POSITION,
+                                        num_threads);
 }
 
 std::unique_ptr<CornerTable> CreateCornerTableFromAttribute(
     const Mesh *mesh, GeometryAttribute::Type type) {
+  return CreateCornerTableFromAttribute(mesh, type, 1);
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromAttribute(
+    const Mesh *mesh, GeometryAttribute::Type type, int num_threads) {
   typedef CornerTable::FaceType FaceType;
 
   const PointAttribute *const att = mesh->GetNamedAttribute(type);
@@ -40,11 +51,16 @@ std::unique_ptr<CornerTable> CreateCornerTableFromAttribute(
     faces[FaceIndex(i)] = new_face;
   }
   // Build the corner table.
-  return CornerTable::Create(faces);
+  return CornerTable::Create(faces, num_threads);
 }
 
 std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
     const Mesh *mesh) {
+  return CreateCornerTableFromAllAttributes(mesh, 1);
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
+    const Mesh *mesh, int num_threads) {
   typedef CornerTable::FaceType FaceType;
   IndexTypeVector<FaceIndex, FaceType> faces(mesh->num_faces());
   FaceType new_face;
@@ -58,6 +74,6 @@ std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
     faces[i] = new_face;
   }
   // Build the corner table.
-  return CornerTable::Create(faces);
+  return CornerTable::Create(faces, num_threads);
 }
 }  // namespace draco
@@ -0,0 +1,201 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/streaming_triangle_soup_mesh_builder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "draco/core/hash_utils.h"
+
+namespace draco {
+
+void StreamingTriangleSoupMeshBuilder::Start(int num_faces_hint) {
+  mesh_ = std::unique_ptr<Mesh>(new Mesh());
+  num_faces_hint_ = std::max(num_faces_hint, 0);
+  mesh_->SetNumFaces(num_faces_hint_);
+  num_faces_ = 0;
+  attributes_.clear();
+  point_values_.clear();
+  // Closed manifold meshes have about half as many vertices as faces while
+  // attributes with seams can have a few values per face. Start with one
+  // point per face and let the table grow when needed.
+  point_table_.Init(num_faces_hint_);
+  for (std::vector<AttributeValueIndex> &values : corner_values_) {
+    values.clear();
+  }
+  current_face_ = kInvalidFaceIndex;
+  num_points_ = 0;
+  valid_ = true;
+}
+
+int StreamingTriangleSoupMeshBuilder::AddAttribute(
+    GeometryAttribute::Type attribute_type, int8_t num_components,
+    DataType data_type) {
+  return AddAttribute(attribute_type, num_components, data_type, false);
+}
+
+int StreamingTriangleSoupMeshBuilder::AddAttribute(
+    GeometryAttribute::Type attribute_type, int8_t num_components,
+    DataType data_type, bool normalized) {
+  if (current_face_ != kInvalidFaceIndex) {
+    // Points of the added faces would not have a value of this attribute.
+    valid_ = false;
+  }
+  AttributeData data;
+  data.capacity = num_faces_hint_ / 2 + 1;
+  data.value_table.Init(data.capacity);
+  std::unique_ptr<PointAttribute> att(new PointAttribute());
+  att->Init(attribute_type, num_components, data_type, normalized,
+            data.capacity);
+  attributes_.push_back(std::move(data));
+  for (std::vector<AttributeValueIndex> &values : corner_values_) {
+    values.push_back(kInvalidAttributeValueIndex);
+  }
+  return mesh_->AddAttribute(std::move(att));
+}
+
+void StreamingTriangleSoupMeshBuilder::SetAttributeValuesForFace(
+    int att_id, FaceIndex face_id, const void *corner_value_0,
+    const void *corner_value_1, const void *corner_value_2) {
+  StartFace(face_id);
+  corner_values_[0][att_id] = AddValue(att_id, corner_value_0);
+  corner_values_[1][att_id] = AddValue(att_id, corner_value_1);
+  corner_values_[2][att_id] = AddValue(att_id, corner_value_2);
+  attributes_[att_id].element_type = MESH_CORNER_ATTRIBUTE;
+}
+
+void StreamingTriangleSoupMeshBuilder::SetPerFaceAttributeValueForFace(
+    int att_id, FaceIndex face_id, const void *value) {
+  StartFace(face_id);
+  const AttributeValueIndex avi = AddValue(att_id, value);
+  corner_values_[0][att_id] = avi;
+  corner_values_[1][att_id] = avi;
+  corner_values_[2][att_id] = avi;
+  int8_t &element_type = attributes_[att_id].element_type;
+  if (element_type < 0) {
+    element_type = MESH_FACE_ATTRIBUTE;
+  }
+}
+
+void StreamingTriangleSoupMeshBuilder::SetAttributeUniqueId(
+    int att_id, uint32_t unique_id) {
+  mesh_->attribute(att_id)->set_unique_id(unique_id);
+}
+
+std::unique_ptr<Mesh> StreamingTriangleSoupMeshBuilder::Finalize() {
+  if (current_face_ != kInvalidFaceIndex && !FinishFace()) {
+    valid_ = false;
+  }
+  if (!valid_) {
+    return nullptr;
+  }
+  const int num_attributes = static_cast<int>(attributes_.size());
+  mesh_->SetNumFaces(num_faces_);
+  mesh_->set_num_points(num_points_);
+  for (int a = 0; a < num_attributes; ++a) {
+    PointAttribute *const att = mesh_->attribute(a);
+    att->Resize(attributes_[a].num_values);
+    // Attributes whose values are all unique per point keep the identity
+    // mapping, which is what DeduplicatePointIds() leaves for them as well.
+    bool is_identity = attributes_[a].num_values == num_points_;
+    for (uint32_t p = 0; is_identity && p < num_points_; ++p) {
+      is_identity = point_values_[p * num_attributes + a].value() == p;
+    }
+    if (!is_identity) {
+      att->SetExplicitMapping(num_points_);
+      for (uint32_t p = 0; p < num_points_; ++p) {
+        att->SetPointMapEntry(PointIndex(p),
+                              point_values_[p * num_attributes + a]);
+      }
+    }
+    if (attributes_[a].element_type >= 0) {
+      mesh_->SetAttributeElementType(
+          a, static_cast<MeshAttributeElementType>(
+                 attributes_[a].element_type));
+    }
+  }
+  attributes_.clear();
+  std::vector<AttributeValueIndex>().swap(point_values_);
+  point_table_ = FlatHashIndexTable();
+  valid_ = false;
+  return std::move(mesh_);
+}
+
+AttributeValueIndex StreamingTriangleSoupMeshBuilder::AddValue(
+    int att_id, const void *value) {
+  AttributeData &data = attributes_[att_id];
+  PointAttribute *const att = mesh_->attribute(att_id);
+  const size_t size = att->byte_stride();
+  const uint8_t *const bytes = static_cast<const uint8_t *>(value);
+  const uint32_t index = data.value_table.FindOrInsert(
+      HashBytes(bytes, size), data.num_values, [&](uint32_t i) {
+        return memcmp(att->GetAddress(AttributeValueIndex(i)), bytes, size) ==
+               0;
+      });
+  if (index == data.num_values) {
+    if (data.num_values == data.capacity) {
+      data.capacity = std::max<uint32_t>(2 * data.capacity, 16);
+      att->Resize(data.capacity);
+    }
+    att->SetAttributeValue(AttributeValueIndex(index), value);
+    ++data.num_values;
+  }
+  return AttributeValueIndex(index);
+}
+
+void StreamingTriangleSoupMeshBuilder::StartFace(FaceIndex face_id) {
+  if (face_id == current_face_) {
+    return;
+  }
+  if (current_face_ != kInvalidFaceIndex && !FinishFace()) {
+    valid_ = false;
+  }
+  // Faces are appended to the mesh so they must be set in order.
+  if (face_id.value() != num_faces_) {
+    valid_ = false;
+  }
+  current_face_ = face_id;
+}
+
+bool StreamingTriangleSoupMeshBuilder::FinishFace() {
+  const size_t num_attributes = attributes_.size();
+  Mesh::Face face;
+  for (int c = 0; c < 3; ++c) {
+    std::vector<AttributeValueIndex> &values = corner_values_[c];
+    uint64_t hash = num_attributes;
+    for (const AttributeValueIndex &avi : values) {
+      if (avi == kInvalidAttributeValueIndex) {
+        return false;
+      }
+      hash = (hash ^ avi.value()) * 0x9e3779b97f4a7c15ull;
+    }
+    const uint32_t point =
+        point_table_.FindOrInsert(MixHash(hash), num_points_, [&](uint32_t p) {
+          return std::equal(values.begin(), values.end(),
+                            point_values_.begin() + p * num_attributes);
+        });
+    if (point == num_points_) {
+      point_values_.insert(point_values_.end(), values.begin(), values.end());
+      ++num_points_;
+    }
+    face[c] = PointIndex(point);
+    std::fill(values.begin(), values.end(), kInvalidAttributeValueIndex);
+  }
+  mesh_->SetFace(FaceIndex(num_faces_++), face);
+  return true;
+}
+
+}  // namespace draco
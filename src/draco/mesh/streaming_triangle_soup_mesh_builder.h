@@ -0,0 +1,117 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_MESH_STREAMING_TRIANGLE_SOUP_MESH_BUILDER_H_
+#define DRACO_MESH_STREAMING_TRIANGLE_SOUP_MESH_BUILDER_H_
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "draco/core/flat_hash_index_table.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Class for building meshes from attribute values specified for each face
+// corner, similar to TriangleSoupMeshBuilder. Unlike TriangleSoupMeshBuilder
+// that stores three copies of every attribute value per face and deduplicates
+// them in Finalize(), this builder deduplicates attribute values and points as
+// the faces are added. Only the unique values are written to the attribute
+// buffers of the output mesh, so the peak memory is bounded by the size of the
+// final mesh. This makes the builder suitable for ingesting large triangle
+// soups such as STL scans.
+//
+// Values are deduplicated by their bit patterns. All attributes must be added
+// before the first face is set, faces must be set in increasing order, and
+// each attribute must be set for each face.
+class StreamingTriangleSoupMeshBuilder {
+ public:
+  // Index type of the inserted element.
+  typedef FaceIndex ElementIndex;
+
+  // Starts mesh building. |num_faces_hint| is the expected number of faces
+  // that is used to size the attribute buffers and the hash tables. It doesn't
+  // need to be exact.
+  void Start(int num_faces_hint);
+
+  // Adds an empty attribute to the mesh. Returns the new attribute's id.
+  int AddAttribute(GeometryAttribute::Type attribute_type,
+                   int8_t num_components, DataType data_type);
+  int AddAttribute(GeometryAttribute::Type attribute_type,
+                   int8_t num_components, DataType data_type, bool normalized);
+
+  // Sets values for a given attribute on all corners of a given face.
+  void SetAttributeValuesForFace(int att_id, FaceIndex face_id,
+                                 const void *corner_value_0,
+                                 const void *corner_value_1,
+                                 const void *corner_value_2);
+
+  // Sets value for a per-face attribute. If all faces of a given attribute are
+  // set with this method, the attribute will be marked as per-face, otherwise
+  // it will be marked as per-corner attribute.
+  void SetPerFaceAttributeValueForFace(int att_id, FaceIndex face_id,
+                                       const void *value);
+
+  // Sets the unique ID for an attribute created with AddAttribute().
+  void SetAttributeUniqueId(int att_id, uint32_t unique_id);
+
+  // Finalizes the mesh or returns nullptr on error.
+  // Once this function is called, the builder becomes invalid and cannot be
+  // used until the method Start() is called again.
+  std::unique_ptr<Mesh> Finalize();
+
+ private:
+  struct AttributeData {
+    FlatHashIndexTable value_table;
+    // Number of unique values written to the attribute buffer.
+    uint32_t num_values = 0;
+    // Number of values the attribute buffer can hold.
+    uint32_t capacity = 0;
+    int8_t element_type = -1;
+  };
+
+  // Returns the index of |value| in attribute |att_id|, adding it to the
+  // attribute when it is not there yet.
+  AttributeValueIndex AddValue(int att_id, const void *value);
+
+  // Switches to face |face_id|. Adds the previous face to the mesh when
+  // |face_id| is a new face.
+  void StartFace(FaceIndex face_id);
+
+  // Deduplicates the points of the current face and adds the face to the
+  // mesh. Returns false when some attribute was not set for the face.
+  bool FinishFace();
+
+  std::unique_ptr<Mesh> mesh_;
+  std::vector<AttributeData> attributes_;
+
+  // Attribute value indices of all unique points, |num_attributes| entries per
+  // point.
+  std::vector<AttributeValueIndex> point_values_;
+  FlatHashIndexTable point_table_;
+
+  // Attribute value indices of the three corners of the face being built,
+  // |num_attributes| entries per corner.
+  std::array<std::vector<AttributeValueIndex>, 3> corner_values_;
+  FaceIndex current_face_;
+  uint32_t num_faces_ = 0;
+  uint32_t num_points_ = 0;
+  int num_faces_hint_ = 0;
+  bool valid_ = false;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_MESH_STREAMING_TRIANGLE_SOUP_MESH_BUILDER_H_
@@ -0,0 +1,136 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/streaming_triangle_soup_mesh_builder.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/vector_d.h"
+#include "draco/mesh/triangle_soup_mesh_builder.h"
+
+namespace draco {
+
+namespace {
+
+// Adds faces of a triangulated grid to |builder| with per-corner positions,
+// per-face normals and per-corner colors that have a seam in the middle of
+// the grid.
+template <typename BuilderT>
+std::unique_ptr<Mesh> BuildGrid(BuilderT *builder, int num_faces_hint) {
+  constexpr int kGridSize = 20;
+  builder->Start(num_faces_hint);
+  const int pos_att_id =
+      builder->AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+  const int norm_att_id =
+      builder->AddAttribute(GeometryAttribute::NORMAL, 3, DT_FLOAT32);
+  const int color_att_id =
+      builder->AddAttribute(GeometryAttribute::COLOR, 3, DT_UINT8, true);
+  const auto pos = [](int x, int y) {
+    return Vector3f(static_cast<float>(x), static_cast<float>(y), 0.f);
+  };
+  const auto color = [](int x, int y, bool left) {
+    return VectorD<uint8_t, 3>(x, y, left ? 0 : 255);
+  };
+  FaceIndex face(0);
+  for (int y = 0; y < kGridSize; ++y) {
+    for (int x = 0; x < kGridSize; ++x) {
+      const bool left = x < kGridSize / 2;
+      builder->SetAttributeValuesForFace(pos_att_id, face,
+                                         pos(x, y).data(),
+                                         pos(x + 1, y).data(),
+                                         pos(x, y + 1).data());
+      builder->SetPerFaceAttributeValueForFace(
+          norm_att_id, face, Vector3f(0.f, 0.f, 1.f).data());
+      builder->SetAttributeValuesForFace(color_att_id, face,
+                                         color(x, y, left).data(),
+                                         color(x + 1, y, left).data(),
+                                         color(x, y + 1, left).data());
+      ++face;
+      builder->SetAttributeValuesForFace(pos_att_id, face,
+                                         pos(x + 1, y).data(),
+                                         pos(x + 1, y + 1).data(),
+                                         pos(x, y + 1).data());
+      builder->SetPerFaceAttributeValueForFace(
+          norm_att_id, face, Vector3f(0.f, 0.f, 1.f).data());
+      builder->SetAttributeValuesForFace(color_att_id, face,
+                                         color(x + 1, y, left).data(),
+                                         color(x + 1, y + 1, left).data(),
+                                         color(x, y + 1, left).data());
+      ++face;
+    }
+  }
+  return builder->Finalize();
+}
+
+}  // namespace
+
+class StreamingTriangleSoupMeshBuilderTest : public ::testing::Test {};
+
+TEST_F(StreamingTriangleSoupMeshBuilderTest, TestMatchesTriangleSoupBuilder) {
+  // Tests that the streaming builder produces the same mesh as the
+  // TriangleSoupMeshBuilder regardless of the face count hint.
+  TriangleSoupMeshBuilder soup_builder;
+  const std::unique_ptr<Mesh> expected = BuildGrid(&soup_builder, 800);
+  ASSERT_NE(expected, nullptr);
+
+  for (const int hint : {0, 10, 800, 5000}) {
+    StreamingTriangleSoupMeshBuilder builder;
+    const std::unique_ptr<Mesh> mesh = BuildGrid(&builder, hint);
+    ASSERT_NE(mesh, nullptr);
+    ASSERT_EQ(mesh->num_faces(), expected->num_faces());
+    ASSERT_EQ(mesh->num_points(), expected->num_points());
+    ASSERT_EQ(mesh->num_attributes(), expected->num_attributes());
+    for (FaceIndex f(0); f < mesh->num_faces(); ++f) {
+      ASSERT_EQ(mesh->face(f), expected->face(f));
+    }
+    for (int a = 0; a < mesh->num_attributes(); ++a) {
+      const PointAttribute *const att = mesh->attribute(a);
+      const PointAttribute *const expected_att = expected->attribute(a);
+      ASSERT_EQ(att->size(), expected_att->size());
+      ASSERT_EQ(mesh->GetAttributeElementType(a),
+                expected->GetAttributeElementType(a));
+      for (PointIndex p(0); p < mesh->num_points(); ++p) {
+        ASSERT_EQ(att->mapped_index(p), expected_att->mapped_index(p));
+        ASSERT_EQ(memcmp(att->GetAddressOfMappedIndex(p),
+                         expected_att->GetAddressOfMappedIndex(p),
+                         att->byte_stride()),
+                  0);
+      }
+    }
+  }
+}
+
+TEST_F(StreamingTriangleSoupMeshBuilderTest, TestMissingAttributeValues) {
+  // Tests that the builder fails when an attribute is not set for a face.
+  StreamingTriangleSoupMeshBuilder builder;
+  builder.Start(2);
+  const int pos_att_id =
+      builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+  const int norm_att_id =
+      builder.AddAttribute(GeometryAttribute::NORMAL, 3, DT_FLOAT32);
+  const Vector3f value(1.f, 2.f, 3.f);
+  builder.SetAttributeValuesForFace(pos_att_id, FaceIndex(0), value.data(),
+                                    value.data(), value.data());
+  builder.SetPerFaceAttributeValueForFace(norm_att_id, FaceIndex(0),
+                                          value.data());
+  builder.SetAttributeValuesForFace(pos_att_id, FaceIndex(1), value.data(),
+                                    value.data(), value.data());
+  ASSERT_EQ(builder.Finalize(), nullptr);
+}
+
+}  // namespace draco
@@ -15,9 +15,10 @@
 #include "draco/point_cloud/point_cloud.h"
 
 #include <algorithm>
-#include <unordered_map>
 #include <utility>
 
+#include "draco/core/flat_hash_index_table.h"
+
 #ifdef DRACO_TRANSCODER_SUPPORTED
 #include "draco/attributes/point_attribute.h"
 #endif
@@ -215,15 +216,16 @@ void PointCloud::DeleteAttribute(int att_id) {
 
 #ifdef DRACO_ATTRIBUTE_INDICES_DEDUPLICATION_SUPPORTED
 void PointCloud::DeduplicatePointIds() {
-  // Hashing function for a single vertex.
-  auto point_hash = [this](PointIndex p) {
-    PointIndex::ValueType hash = 0;
-    for (int32_t i = 0; i < this->num_attributes(); ++i) {
-      const AttributeValueIndex att_id = attribute(i)->mapped_index(p);
-      hash = static_cast<uint32_t>(HashCombine(att_id.value(), hash));
+  // Hashes of all points are computed upfront one attribute at a time, so the
+  // hash table doesn't need to read the attribute mappings to hash a point.
+  std::vector<uint64_t> point_hashes(num_points_, num_attributes());
+  for (int32_t i = 0; i < num_attributes(); ++i) {
+    const PointAttribute *const att = attribute(i);
+    for (PointIndex p(0); p < num_points_; ++p) {
+      uint64_t &hash = point_hashes[p.value()];
+      hash = (hash ^ att->mapped_index(p).value()) * 0x9e3779b97f4a7c15ull;
     }
-    return hash;
-  };
+  }
   // Comparison function between two vertices.
   auto point_compare = [this](PointIndex p0, PointIndex p1) {
     for (int32_t i = 0; i < this->num_attributes(); ++i) {
@@ -236,21 +238,23 @@ void PointCloud::DeduplicatePointIds() {
     return true;
   };
 
-  std::unordered_map<PointIndex, PointIndex, decltype(point_hash),
-                     decltype(point_compare)>
-      unique_point_map(num_points_, point_hash, point_compare);
-  int32_t num_unique_points = 0;
+  // Hash table storing indices of the unique points.
+  FlatHashIndexTable unique_point_table;
+  unique_point_table.Init(num_points_);
+  uint32_t num_unique_points = 0;
   IndexTypeVector<PointIndex, PointIndex> index_map(num_points_);
   std::vector<PointIndex> unique_points;
   // Go through all vertices and find their duplicates.
   for (PointIndex i(0); i < num_points_; ++i) {
-    const auto it = unique_point_map.find(i);
-    if (it != unique_point_map.end()) {
-      index_map[i] = it->second;
-    } else {
-      unique_point_map.insert(std::make_pair(i, PointIndex(num_unique_points)));
-      index_map[i] = num_unique_points++;
+    const uint32_t unique_point = unique_point_table.FindOrInsert(
+        MixHash(point_hashes[i.value()]), num_unique_points,
+        [&](uint32_t index) {
+          return point_compare(i, unique_points[index]);
+        });
+    index_map[i] = unique_point;
+    if (unique_point == num_unique_points) {
       unique_points.push_back(i);
+      ++num_unique_points;
     }
   }
   if (num_unique_points == num_points_) {
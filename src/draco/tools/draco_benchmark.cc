@@ -0,0 +1,868 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmark harness measuring throughput of the individual encoding and
+// decoding stages on a set of point clouds (PLY or DRC files). Each stage is
+// run several times and the fastest run is reported.
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "draco/attributes/attribute_quantization_transform.h"
+#include "draco/compression/attributes/point_d_vector.h"
+#include "draco/compression/decode.h"
+#include "draco/compression/entropy/symbol_decoding.h"
+#include "draco/compression/entropy/symbol_encoding.h"
+#include "draco/compression/expert_encode.h"
+#include "draco/compression/point_cloud/algorithms/dynamic_integer_points_kd_tree_decoder.h"
+#include "draco/compression/point_cloud/algorithms/dynamic_integer_points_kd_tree_encoder.h"
+#include "draco/core/bit_utils.h"
+#include "draco/core/thread_pool.h"
+#include "draco/io/file_utils.h"
+#include "draco/io/mesh_io.h"
+#include "draco/io/ply_encoder.h"
+#include "draco/io/point_cloud_io.h"
+#include "draco/mesh/mesh_cleanup.h"
+#include "draco/mesh/mesh_connected_components.h"
+#include "draco/mesh/mesh_misc_functions.h"
+
+namespace {
+
+struct Options {
+  Options();
+
+  std::vector<std::string> inputs;
+  std::vector<int> compression_levels;
+  int pos_quantization_bits;
+  int attribute_quantization_bits;
+  int num_iterations;
+  // Number of threads used by stages that support multithreading.
+  int num_threads;
+  std::string json_output;
+};
+
+Options::Options()
+    : compression_levels({0, 7, 10}),
+      pos_quantization_bits(12),
+      attribute_quantization_bits(10),
+      num_iterations(3),
+      num_threads(draco::ThreadPool::GetDefaultNumThreads()) {}
+
+void Usage() {
+  printf("Usage: draco_benchmark [options] input [input ...]\n");
+  printf("\n");
+  printf("Inputs can be PLY or DRC files. Mesh connectivity stages are run\n");
+  printf("for inputs containing faces.\n");
+  printf("\n");
+  printf("Main options:\n");
+  printf("  -h | -?               show help.\n");
+  printf(
+      "  -cl <list>            comma separated compression levels, "
+      "default=0,7,10.\n");
+  printf(
+      "  -qp <value>           quantization bits for the position "
+      "attribute, default=12.\n");
+  printf(
+      "  -qa <value>           quantization bits for other floating point "
+      "attributes, default=10.\n");
+  printf(
+      "  -iterations <value>   number of runs of each stage, the fastest "
+      "run\n"
+      "                        is reported, default=3.\n");
+  printf(
+      "  -threads <value>      number of threads used by multithreaded "
+      "stages,\n"
+      "                        default=number of hardware threads.\n");
+  printf("  -json <file>          write results in JSON format to a file.\n");
+}
+
+// Timing of a single benchmark stage.
+struct StageResult {
+  std::string name;
+  double seconds;
+  int64_t num_points;
+  // Number of processed bytes, used for computing the throughput.
+  int64_t num_bytes;
+};
+
+struct AttributeResult {
+  std::string type;
+  int num_components;
+  int quantization_bits;
+  int64_t raw_bytes;
+  int64_t encoded_bytes;
+  std::vector<StageResult> stages;
+};
+
+struct MethodResult {
+  std::string encoding_method;
+  int compression_level;
+  int64_t raw_bytes;
+  int64_t encoded_bytes;
+  std::vector<StageResult> stages;
+};
+
+struct FileResult {
+  std::string file;
+  int64_t file_size;
+  int num_points;
+  std::vector<StageResult> stages;
+  std::vector<AttributeResult> attributes;
+  std::vector<MethodResult> methods;
+  int64_t peak_rss_kb;
+};
+
+// Runs |func| |num_iterations| times and returns the fastest time in seconds.
+// |func| returns false on error, in which case a negative time is returned.
+double TimeStage(int num_iterations, const std::function<bool()> &func) {
+  double best_seconds = -1.0;
+  for (int i = 0; i < std::max(num_iterations, 1); ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    if (!func()) {
+      return -1.0;
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (best_seconds < 0.0 || elapsed.count() < best_seconds) {
+      best_seconds = elapsed.count();
+    }
+  }
+  return best_seconds;
+}
+
+int64_t GetPeakRssKb() {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024;  // Reported in bytes.
+#else
+  return usage.ru_maxrss;  // Reported in kilobytes.
+#endif
+#else
+  return 0;
+#endif
+}
+
+int64_t GetRawSize(const draco::PointCloud &pc) {
+  int64_t size = 0;
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    size += static_cast<int64_t>(pc.num_points()) *
+            pc.attribute(i)->byte_stride();
+  }
+  return size;
+}
+
+bool EndsWith(const std::string &str, const std::string &suffix) {
+  return str.size() >= suffix.size() &&
+         str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Output iterator storing decoded kd-tree points into a flat array.
+class FlatPointOutputIterator {
+ public:
+  explicit FlatPointOutputIterator(std::vector<uint32_t> *out) : out_(out) {}
+  FlatPointOutputIterator &operator++() { return *this; }
+  FlatPointOutputIterator &operator*() { return *this; }
+  FlatPointOutputIterator &operator=(const std::vector<uint32_t> &point) {
+    out_->insert(out_->end(), point.begin(), point.end());
+    return *this;
+  }
+
+ private:
+  std::vector<uint32_t> *out_;
+};
+
+template <int compression_level_t>
+bool BenchmarkKdTree(const draco::PointAttribute &quantized_att,
+                     int num_points, int num_iterations,
+                     std::vector<StageResult> *stages) {
+  const int num_components = quantized_att.num_components();
+  draco::PointDVector<uint32_t> point_vector(num_points, num_components);
+  int num_bits = 0;
+  for (draco::PointIndex pi(0); pi < num_points; ++pi) {
+    const draco::AttributeValueIndex avi = quantized_att.mapped_index(pi);
+    point_vector.CopyAttribute(num_components, 0, pi.value(),
+                               quantized_att.GetAddress(avi));
+    const uint32_t *const point = point_vector[pi.value()];
+    for (int c = 0; c < num_components; ++c) {
+      if (point[c] > 0) {
+        num_bits = std::max(num_bits, draco::MostSignificantBit(point[c]) + 1);
+      }
+    }
+  }
+  const int64_t num_bytes =
+      static_cast<int64_t>(num_points) * num_components * sizeof(uint32_t);
+  draco::EncoderBuffer buffer;
+  const double encode_seconds = TimeStage(num_iterations, [&]() {
+    // The encoder reorders the points so it needs a fresh copy each time.
+    draco::PointDVector<uint32_t> points(num_points, num_components);
+    std::copy(point_vector[0], point_vector[0] + num_points * num_components,
+              points[0]);
+    buffer.Clear();
+    draco::DynamicIntegerPointsKdTreeEncoder<compression_level_t> encoder(
+        num_components);
+    return encoder.EncodePoints(points.begin(), points.end(), num_bits,
+                                &buffer);
+  });
+  stages->push_back(
+      {"kd_tree_encode", encode_seconds, num_points, num_bytes});
+  std::vector<uint32_t> decoded_points;
+  decoded_points.reserve(static_cast<size_t>(num_points) * num_components);
+  const double decode_seconds = TimeStage(num_iterations, [&]() {
+    draco::DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    dec_buffer.set_bitstream_version(draco::kDracoPointCloudBitstreamVersion);
+    decoded_points.clear();
+    draco::DynamicIntegerPointsKdTreeDecoder<compression_level_t> decoder(
+        num_components);
+    return decoder.DecodePoints(&dec_buffer,
+                                FlatPointOutputIterator(&decoded_points));
+  });
+  stages->push_back(
+      {"kd_tree_decode", decode_seconds, num_points, num_bytes});
+  return encode_seconds >= 0.0 && decode_seconds >= 0.0;
+}
+
+bool BenchmarkKdTreeTraversal(const draco::PointAttribute &quantized_att,
+                              int num_points, int compression_level,
+                              int num_iterations,
+                              std::vector<StageResult> *stages) {
+  // Same mapping as in KdTreeAttributesEncoder.
+  switch (std::min(compression_level, 6)) {
+    case 0:
+      return BenchmarkKdTree<0>(quantized_att, num_points, num_iterations,
+                                stages);
+    case 1:
+      return BenchmarkKdTree<1>(quantized_att, num_points, num_iterations,
+                                stages);
+    case 2:
+      return BenchmarkKdTree<2>(quantized_att, num_points, num_iterations,
+                                stages);
+    case 3:
+      return BenchmarkKdTree<3>(quantized_att, num_points, num_iterations,
+                                stages);
+    case 4:
+      return BenchmarkKdTree<4>(quantized_att, num_points, num_iterations,
+                                stages);
+    case 5:
+      return BenchmarkKdTree<5>(quantized_att, num_points, num_iterations,
+                                stages);
+    default:
+      return BenchmarkKdTree<6>(quantized_att, num_points, num_iterations,
+                                stages);
+  }
+}
+
+// Benchmarks quantization, delta prediction and entropy coding of a single
+// floating point attribute together with the mirror decoding stages. These
+// are the stages used by the sequential point cloud encoder.
+bool BenchmarkAttribute(const draco::PointCloud &pc,
+                        const draco::PointAttribute &att,
+                        int quantization_bits, int num_iterations,
+                        AttributeResult *result) {
+  const int num_points = pc.num_points();
+  const int num_components = att.num_components();
+  const int num_values = num_points * num_components;
+  result->type = draco::GeometryAttribute::TypeToString(att.attribute_type());
+  result->num_components = num_components;
+  result->quantization_bits = quantization_bits;
+  result->raw_bytes = static_cast<int64_t>(num_points) * att.byte_stride();
+  const int64_t raw_bytes = result->raw_bytes;
+  const int64_t symbol_bytes =
+      static_cast<int64_t>(num_values) * sizeof(uint32_t);
+
+  draco::AttributeQuantizationTransform transform;
+  std::unique_ptr<draco::PointAttribute> quantized_att;
+  const double quantization_seconds = TimeStage(num_iterations, [&]() {
+    transform = draco::AttributeQuantizationTransform();
+    if (!transform.ComputeParameters(att, quantization_bits)) {
+      return false;
+    }
+    quantized_att = transform.InitTransformedAttribute(att, num_points);
+    return transform.TransformAttribute(att, {}, quantized_att.get());
+  });
+  result->stages.push_back(
+      {"quantization", quantization_seconds, num_points, raw_bytes});
+  if (quantization_seconds < 0.0) {
+    return false;
+  }
+  const uint32_t *const quantized_values =
+      reinterpret_cast<const uint32_t *>(quantized_att->GetAddress(
+          draco::AttributeValueIndex(0)));
+
+  std::vector<int32_t> residuals(num_values);
+  std::vector<uint32_t> symbols(num_values);
+  const double prediction_seconds = TimeStage(num_iterations, [&]() {
+    for (int i = num_values - 1; i >= num_components; --i) {
+      residuals[i] = static_cast<int32_t>(quantized_values[i]) -
+                     static_cast<int32_t>(quantized_values[i - num_components]);
+    }
+    for (int i = 0; i < std::min(num_components, num_values); ++i) {
+      residuals[i] = static_cast<int32_t>(quantized_values[i]);
+    }
+    draco::ConvertSignedIntsToSymbols(residuals.data(), num_values,
+                                      symbols.data());
+    return true;
+  });
+  result->stages.push_back(
+      {"prediction", prediction_seconds, num_points, symbol_bytes});
+
+  draco::EncoderBuffer buffer;
+  const double entropy_seconds = TimeStage(num_iterations, [&]() {
+    buffer.Clear();
+    return draco::EncodeSymbols(symbols.data(), num_values, num_components,
+                                nullptr, &buffer);
+  });
+  result->stages.push_back(
+      {"entropy_encode", entropy_seconds, num_points, symbol_bytes});
+  result->encoded_bytes = buffer.size();
+
+  std::vector<uint32_t> decoded_symbols(num_values);
+  const double entropy_decode_seconds = TimeStage(num_iterations, [&]() {
+    draco::DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    dec_buffer.set_bitstream_version(draco::kDracoPointCloudBitstreamVersion);
+    return draco::DecodeSymbols(num_values, num_components, &dec_buffer,
+                                decoded_symbols.data());
+  });
+  result->stages.push_back(
+      {"entropy_decode", entropy_decode_seconds, num_points, symbol_bytes});
+
+  std::vector<int32_t> decoded_values(num_values);
+  const double prediction_inverse_seconds = TimeStage(num_iterations, [&]() {
+    draco::ConvertSymbolsToSignedInts(decoded_symbols.data(), num_values,
+                                      decoded_values.data());
+    for (int i = num_components; i < num_values; ++i) {
+      decoded_values[i] += decoded_values[i - num_components];
+    }
+    return true;
+  });
+  result->stages.push_back({"prediction_inverse", prediction_inverse_seconds,
+                            num_points, symbol_bytes});
+
+  draco::GeometryAttribute dequantized_ga;
+  dequantized_ga.Init(att.attribute_type(), nullptr, num_components,
+                      draco::DT_FLOAT32, false, sizeof(float) * num_components,
+                      0);
+  std::unique_ptr<draco::PointAttribute> dequantized_att(
+      new draco::PointAttribute(dequantized_ga));
+  dequantized_att->Reset(num_points);
+  const double dequantization_seconds = TimeStage(num_iterations, [&]() {
+    return transform.InverseTransformAttribute(*quantized_att,
+                                               dequantized_att.get());
+  });
+  result->stages.push_back(
+      {"dequantization", dequantization_seconds, num_points, raw_bytes});
+  return prediction_seconds >= 0.0 && entropy_seconds >= 0.0 &&
+         entropy_decode_seconds >= 0.0 && dequantization_seconds >= 0.0;
+}
+
+bool BenchmarkMethod(const draco::PointCloud &pc, const Options &options,
+                     int encoding_method, int compression_level,
+                     MethodResult *result) {
+  const int num_points = pc.num_points();
+  result->encoding_method =
+      encoding_method == draco::POINT_CLOUD_KD_TREE_ENCODING ? "kd_tree"
+                                                             : "sequential";
+  result->compression_level = compression_level;
+  result->raw_bytes = GetRawSize(pc);
+
+  draco::ExpertEncoder encoder(pc);
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    const draco::PointAttribute *const att = pc.attribute(i);
+    if (att->data_type() != draco::DT_FLOAT32) {
+      continue;
+    }
+    encoder.SetAttributeQuantization(
+        i, att->attribute_type() == draco::GeometryAttribute::POSITION
+               ? options.pos_quantization_bits
+               : options.attribute_quantization_bits);
+  }
+  const int speed = 10 - compression_level;
+  encoder.SetSpeedOptions(speed, speed);
+  encoder.SetEncodingMethod(encoding_method);
+
+  draco::EncoderBuffer buffer;
+  const double encode_seconds =
+      TimeStage(options.num_iterations, [&]() {
+        buffer.Clear();
+        return encoder.EncodeToBuffer(&buffer).ok();
+      });
+  result->stages.push_back(
+      {"encode", encode_seconds, num_points, result->raw_bytes});
+  if (encode_seconds < 0.0) {
+    return false;
+  }
+  result->encoded_bytes = buffer.size();
+
+  const double decode_seconds =
+      TimeStage(options.num_iterations, [&]() {
+        draco::DecoderBuffer dec_buffer;
+        dec_buffer.Init(buffer.data(), buffer.size());
+        draco::Decoder decoder;
+        return decoder.DecodePointCloudFromBuffer(&dec_buffer).ok();
+      });
+  result->stages.push_back(
+      {"decode", decode_seconds, num_points, result->raw_bytes});
+
+  if (encoding_method == draco::POINT_CLOUD_KD_TREE_ENCODING) {
+    // Kd-tree traversal of the quantized positions alone.
+    const draco::PointAttribute *const pos_att =
+        pc.GetNamedAttribute(draco::GeometryAttribute::POSITION);
+    if (pos_att != nullptr && pos_att->data_type() == draco::DT_FLOAT32) {
+      draco::AttributeQuantizationTransform transform;
+      if (!transform.ComputeParameters(*pos_att,
+                                       options.pos_quantization_bits)) {
+        return false;
+      }
+      std::unique_ptr<draco::PointAttribute> quantized_att =
+          transform.InitTransformedAttribute(*pos_att, num_points);
+      transform.TransformAttribute(*pos_att, {}, quantized_att.get());
+      if (!BenchmarkKdTreeTraversal(*quantized_att, num_points,
+                                    compression_level, options.num_iterations,
+                                    &result->stages)) {
+        return false;
+      }
+    }
+  }
+  return decode_seconds >= 0.0;
+}
+
+// Benchmarks algorithms that traverse the connectivity of |mesh|. The number
+// of faces is reported as the number of processed points. |suffix| is appended
+// to the names of the stages.
+bool BenchmarkConnectivity(const draco::Mesh &mesh, const Options &options,
+                           const std::string &suffix,
+                           std::vector<StageResult> *stages) {
+  const int64_t num_faces = mesh.num_faces();
+  const int64_t num_bytes = num_faces * sizeof(draco::Mesh::Face);
+  std::unique_ptr<draco::CornerTable> corner_table;
+  const double init_seconds = TimeStage(options.num_iterations, [&]() {
+    corner_table = draco::CreateCornerTableFromPositionAttribute(&mesh);
+    return corner_table != nullptr;
+  });
+  stages->push_back(
+      {"corner_table_init" + suffix, init_seconds, num_faces, num_bytes});
+  if (init_seconds < 0.0) {
+    return false;
+  }
+  if (options.num_threads > 1) {
+    const double parallel_init_seconds =
+        TimeStage(options.num_iterations, [&]() {
+          return draco::CreateCornerTableFromPositionAttribute(
+                     &mesh, options.num_threads) != nullptr;
+        });
+    stages->push_back({"corner_table_init_threads" + suffix,
+                       parallel_init_seconds, num_faces, num_bytes});
+    if (parallel_init_seconds < 0.0) {
+      return false;
+    }
+  }
+
+  // Swings around all vertices of the mesh.
+  const double traversal_seconds = TimeStage(options.num_iterations, [&]() {
+    int64_t valence_sum = 0;
+    for (draco::VertexIndex v(0); v < corner_table->num_vertices(); ++v) {
+      valence_sum += corner_table->Valence(v);
+    }
+    return valence_sum >= 0;
+  });
+  stages->push_back({"corner_table_traversal" + suffix, traversal_seconds,
+                     num_faces, num_bytes});
+
+  const double components_seconds = TimeStage(options.num_iterations, [&]() {
+    draco::MeshConnectedComponents components;
+    components.FindConnectedComponents(corner_table.get());
+    return true;
+  });
+  stages->push_back({"connected_components" + suffix, components_seconds,
+                     num_faces, num_bytes});
+
+  draco::ExpertEncoder encoder(mesh);
+  for (int i = 0; i < mesh.num_attributes(); ++i) {
+    const draco::PointAttribute *const att = mesh.attribute(i);
+    if (att->data_type() == draco::DT_FLOAT32) {
+      encoder.SetAttributeQuantization(
+          i, att->attribute_type() == draco::GeometryAttribute::POSITION
+                 ? options.pos_quantization_bits
+                 : options.attribute_quantization_bits);
+    }
+  }
+  encoder.SetEncodingMethod(draco::MESH_EDGEBREAKER_ENCODING);
+  draco::EncoderBuffer buffer;
+  const double edgebreaker_seconds = TimeStage(options.num_iterations, [&]() {
+    buffer.Clear();
+    return encoder.EncodeToBuffer(&buffer).ok();
+  });
+  stages->push_back({"edgebreaker_encode" + suffix, edgebreaker_seconds,
+                     num_faces, num_bytes});
+  return traversal_seconds >= 0.0 && components_seconds >= 0.0 &&
+         edgebreaker_seconds >= 0.0;
+}
+
+// Loads |file| as a mesh. Returns nullptr when the file does not contain a
+// mesh.
+std::unique_ptr<draco::Mesh> LoadMesh(const std::string &file,
+                                      const std::vector<char> &data) {
+  if (EndsWith(file, ".drc")) {
+    draco::DecoderBuffer buffer;
+    buffer.Init(data.data(), data.size());
+    const auto type_statusor = draco::Decoder::GetEncodedGeometryType(&buffer);
+    if (!type_statusor.ok() ||
+        type_statusor.value() != draco::TRIANGULAR_MESH) {
+      return nullptr;
+    }
+    draco::Decoder decoder;
+    auto maybe_mesh = decoder.DecodeMeshFromBuffer(&buffer);
+    return maybe_mesh.ok() ? std::move(maybe_mesh).value() : nullptr;
+  }
+  auto maybe_mesh = draco::ReadMeshFromFile(file);
+  return maybe_mesh.ok() ? std::move(maybe_mesh).value() : nullptr;
+}
+
+bool BenchmarkFile(const std::string &file, const Options &options,
+                   FileResult *result) {
+  result->file = file;
+  std::vector<char> data;
+  if (!draco::ReadFileToBuffer(file, &data)) {
+    printf("Failed opening %s.\n", file.c_str());
+    return false;
+  }
+  result->file_size = data.size();
+
+  std::unique_ptr<draco::PointCloud> pc;
+  if (EndsWith(file, ".drc")) {
+    const double seconds = TimeStage(options.num_iterations, [&]() {
+      draco::DecoderBuffer buffer;
+      buffer.Init(data.data(), data.size());
+      draco::Decoder decoder;
+      auto maybe_pc = decoder.DecodePointCloudFromBuffer(&buffer);
+      if (!maybe_pc.ok()) {
+        return false;
+      }
+      pc = std::move(maybe_pc).value();
+      return true;
+    });
+    if (seconds < 0.0) {
+      printf("Failed decoding %s.\n", file.c_str());
+      return false;
+    }
+    result->stages.push_back(
+        {"drc_decode", seconds, pc->num_points(), GetRawSize(*pc)});
+  } else {
+    const double seconds = TimeStage(options.num_iterations, [&]() {
+      auto maybe_pc = draco::ReadPointCloudFromFile(file);
+      if (!maybe_pc.ok()) {
+        return false;
+      }
+      pc = std::move(maybe_pc).value();
+      return true;
+    });
+    if (seconds < 0.0) {
+      printf("Failed loading %s.\n", file.c_str());
+      return false;
+    }
+    result->stages.push_back(
+        {"ply_parse", seconds, pc->num_points(), result->file_size});
+  }
+  result->num_points = pc->num_points();
+
+  draco::EncoderBuffer ply_buffer;
+  const double ply_write_seconds = TimeStage(options.num_iterations, [&]() {
+    ply_buffer.Clear();
+    draco::PlyEncoder ply_encoder;
+    return ply_encoder.EncodeToBuffer(*pc, &ply_buffer);
+  });
+  result->stages.push_back({"ply_write", ply_write_seconds, pc->num_points(),
+                            static_cast<int64_t>(ply_buffer.size())});
+
+  for (int i = 0; i < pc->num_attributes(); ++i) {
+    const draco::PointAttribute *const att = pc->attribute(i);
+    if (att->data_type() != draco::DT_FLOAT32) {
+      continue;
+    }
+    AttributeResult att_result;
+    const int bits =
+        att->attribute_type() == draco::GeometryAttribute::POSITION
+            ? options.pos_quantization_bits
+            : options.attribute_quantization_bits;
+    if (!BenchmarkAttribute(*pc, *att, bits, options.num_iterations,
+                            &att_result)) {
+      printf("Failed benchmarking attribute %d of %s.\n", i, file.c_str());
+      return false;
+    }
+    result->attributes.push_back(att_result);
+  }
+
+  for (const int method : {draco::POINT_CLOUD_SEQUENTIAL_ENCODING,
+                           draco::POINT_CLOUD_KD_TREE_ENCODING}) {
+    for (const int level : options.compression_levels) {
+      MethodResult method_result;
+      if (!BenchmarkMethod(*pc, options, method, level, &method_result)) {
+        // Not all methods can encode all inputs (e.g. kd-tree without
+        // quantization). Such combinations are skipped.
+        continue;
+      }
+      result->methods.push_back(method_result);
+    }
+  }
+
+  // Mesh inputs are also benchmarked on algorithms working with the mesh
+  // connectivity, both in the original and in the locality optimized order.
+  std::unique_ptr<draco::Mesh> mesh = LoadMesh(file, data);
+  if (mesh != nullptr && mesh->num_faces() > 0) {
+    if (!BenchmarkConnectivity(*mesh, options, "", &result->stages)) {
+      printf("Failed benchmarking connectivity of %s.\n", file.c_str());
+      return false;
+    }
+    draco::MeshCleanupOptions cleanup_options;
+    cleanup_options.remove_degenerated_faces = false;
+    cleanup_options.remove_duplicate_faces = false;
+    cleanup_options.remove_unused_attributes = false;
+    cleanup_options.reorder_for_locality = true;
+    // The reordering is done once because it modifies the mesh.
+    const double reorder_seconds = TimeStage(1, [&]() {
+      return draco::MeshCleanup::Cleanup(mesh.get(), cleanup_options).ok();
+    });
+    const int64_t num_faces = mesh->num_faces();
+    const int64_t num_bytes = num_faces * sizeof(draco::Mesh::Face);
+    result->stages.push_back(
+        {"locality_reorder", reorder_seconds, num_faces, num_bytes});
+    if (reorder_seconds < 0.0 ||
+        !BenchmarkConnectivity(*mesh, options, "_reordered", &result->stages)) {
+      printf("Failed benchmarking connectivity of %s.\n", file.c_str());
+      return false;
+    }
+  }
+  result->peak_rss_kb = GetPeakRssKb();
+  return true;
+}
+
+double PointsPerSecond(const StageResult &stage) {
+  return stage.seconds > 0.0 ? stage.num_points / stage.seconds : 0.0;
+}
+
+double MegabytesPerSecond(const StageResult &stage) {
+  return stage.seconds > 0.0 ? stage.num_bytes / stage.seconds / 1e6 : 0.0;
+}
+
+double CompressionRatio(int64_t raw_bytes, int64_t encoded_bytes) {
+  return encoded_bytes > 0 ? static_cast<double>(raw_bytes) / encoded_bytes
+                           : 0.0;
+}
+
+void PrintStages(const std::vector<StageResult> &stages,
+                 const char *indent) {
+  for (const StageResult &stage : stages) {
+    printf("%s%-20s %10.3f ms %14.0f points/s %10.2f MB/s\n", indent,
+           stage.name.c_str(), stage.seconds * 1e3, PointsPerSecond(stage),
+           MegabytesPerSecond(stage));
+  }
+}
+
+void PrintResult(const FileResult &result) {
+  printf("%s (%d points, peak RSS %" PRId64 " kB)\n", result.file.c_str(),
+         result.num_points, result.peak_rss_kb);
+  PrintStages(result.stages, "  ");
+  for (const AttributeResult &att : result.attributes) {
+    printf("  %s: %d bits, %" PRId64 " -> %" PRId64 " bytes (ratio %.2f)\n",
+           att.type.c_str(), att.quantization_bits, att.raw_bytes,
+           att.encoded_bytes,
+           CompressionRatio(att.raw_bytes, att.encoded_bytes));
+    PrintStages(att.stages, "    ");
+  }
+  for (const MethodResult &method : result.methods) {
+    printf("  %s -cl %d: %" PRId64 " -> %" PRId64 " bytes (ratio %.2f)\n",
+           method.encoding_method.c_str(), method.compression_level,
+           method.raw_bytes, method.encoded_bytes,
+           CompressionRatio(method.raw_bytes, method.encoded_bytes));
+    PrintStages(method.stages, "    ");
+  }
+  printf("\n");
+}
+
+std::string EscapeJsonString(const std::string &str) {
+  std::string escaped;
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char code[8];
+      snprintf(code, sizeof(code), "\\u%04x", c);
+      escaped += code;
+    } else {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+void WriteJsonStages(const std::vector<StageResult> &stages, FILE *file) {
+  fprintf(file, "\"stages\": [");
+  for (int i = 0; i < stages.size(); ++i) {
+    const StageResult &stage = stages[i];
+    fprintf(file,
+            "%s{\"name\": \"%s\", \"seconds\": %.9g, \"points_per_second\": "
+            "%.9g, \"mb_per_second\": %.9g}",
+            i == 0 ? "" : ", ", stage.name.c_str(), stage.seconds,
+            PointsPerSecond(stage), MegabytesPerSecond(stage));
+  }
+  fprintf(file, "]");
+}
+
+bool WriteJson(const std::vector<FileResult> &results,
+               const std::string &file_name) {
+  FILE *const file = fopen(file_name.c_str(), "w");
+  if (file == nullptr) {
+    return false;
+  }
+  fprintf(file, "{\"files\": [\n");
+  for (int f = 0; f < results.size(); ++f) {
+    const FileResult &result = results[f];
+    fprintf(file,
+            "  {\"file\": \"%s\", \"file_size\": %" PRId64
+            ", \"num_points\": %d, \"peak_rss_kb\": %" PRId64 ",\n   ",
+            EscapeJsonString(result.file).c_str(), result.file_size,
+            result.num_points, result.peak_rss_kb);
+    WriteJsonStages(result.stages, file);
+    fprintf(file, ",\n   \"attributes\": [");
+    for (int i = 0; i < result.attributes.size(); ++i) {
+      const AttributeResult &att = result.attributes[i];
+      fprintf(file,
+              "%s\n    {\"type\": \"%s\", \"num_components\": %d, "
+              "\"quantization_bits\": %d, \"raw_bytes\": %" PRId64
+              ", \"encoded_bytes\": %" PRId64 ", \"compression_ratio\": %.9g, ",
+              i == 0 ? "" : ",", att.type.c_str(), att.num_components,
+              att.quantization_bits, att.raw_bytes, att.encoded_bytes,
+              CompressionRatio(att.raw_bytes, att.encoded_bytes));
+      WriteJsonStages(att.stages, file);
+      fprintf(file, "}");
+    }
+    fprintf(file, "],\n   \"methods\": [");
+    for (int i = 0; i < result.methods.size(); ++i) {
+      const MethodResult &method = result.methods[i];
+      fprintf(file,
+              "%s\n    {\"encoding_method\": \"%s\", \"compression_level\": "
+              "%d, \"raw_bytes\": %" PRId64 ", \"encoded_bytes\": %" PRId64
+              ", \"compression_ratio\": %.9g, ",
+              i == 0 ? "" : ",", method.encoding_method.c_str(),
+              method.compression_level, method.raw_bytes, method.encoded_bytes,
+              CompressionRatio(method.raw_bytes, method.encoded_bytes));
+      WriteJsonStages(method.stages, file);
+      fprintf(file, "}");
+    }
+    fprintf(file, "]}%s\n", f + 1 < results.size() ? "," : "");
+  }
+  fprintf(file, "]}\n");
+  return fclose(file) == 0;
+}
+
+bool ParseCompressionLevels(const std::string &list, std::vector<int> *levels) {
+  levels->clear();
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t end = list.find(',', start);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    const std::string item = list.substr(start, end - start);
+    char *item_end;
+    const long level = strtol(item.c_str(), &item_end, 10);  // NOLINT
+    if (item.empty() || *item_end != '\0' || level < 0 || level > 10) {
+      return false;
+    }
+    levels->push_back(static_cast<int>(level));
+    start = end + 1;
+  }
+  return !levels->empty();
+}
+
+}  // anonymous namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  const int argc_check = argc - 1;
+
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp("-h", argv[i]) || !strcmp("-?", argv[i])) {
+      Usage();
+      return 0;
+    } else if (!strcmp("-cl", argv[i]) && i < argc_check) {
+      if (!ParseCompressionLevels(argv[++i], &options.compression_levels)) {
+        printf("Error: Invalid list of compression levels.\n");
+        return -1;
+      }
+    } else if (!strcmp("-qp", argv[i]) && i < argc_check) {
+      options.pos_quantization_bits = atoi(argv[++i]);
+    } else if (!strcmp("-qa", argv[i]) && i < argc_check) {
+      options.attribute_quantization_bits = atoi(argv[++i]);
+    } else if (!strcmp("-iterations", argv[i]) && i < argc_check) {
+      options.num_iterations = atoi(argv[++i]);
+    } else if (!strcmp("-threads", argv[i]) && i < argc_check) {
+      options.num_threads = atoi(argv[++i]);
+    } else if (!strcmp("-json", argv[i]) && i < argc_check) {
+      options.json_output = argv[++i];
+    } else if (argv[i][0] == '-') {
+      printf("Error: Unknown option %s.\n", argv[i]);
+      Usage();
+      return -1;
+    } else {
+      options.inputs.push_back(argv[i]);
+    }
+  }
+  if (options.inputs.empty()) {
+    Usage();
+    return -1;
+  }
+  if (options.pos_quantization_bits < 1 ||
+      options.pos_quantization_bits > 30 ||
+      options.attribute_quantization_bits < 1 ||
+      options.attribute_quantization_bits > 30) {
+    printf("Error: Quantization bits must be in range [1, 30].\n");
+    return -1;
+  }
+
+  std::vector<FileResult> results;
+  for (const std::string &input : options.inputs) {
+    FileResult result;
+    if (!BenchmarkFile(input, options, &result)) {
+      return -1;
+    }
+    PrintResult(result);
+    results.push_back(result);
+  }
+  if (!options.json_output.empty()) {
+    if (!WriteJson(results, options.json_output)) {
+      printf("Failed to write %s.\n", options.json_output.c_str());
+      return -1;
+    }
+    printf("Results saved to %s.\n", options.json_output.c_str());
+  }
+  return 0;
+}
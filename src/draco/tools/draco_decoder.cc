@@ -13,9 +13,13 @@
 // limitations under the License.
 //
 #include <cinttypes>
+#include <cstdlib>
 
 #include "draco/compression/decode.h"
+#include "draco/compression/sequence/persistent_segment.h"
+#include "draco/compression/sequence/sequence_header.h"
 #include "draco/core/cycle_timer.h"
+#include "draco/core/trace.h"
 #include "draco/io/file_utils.h"
 #include "draco/io/obj_encoder.h"
 #include "draco/io/parser_utils.h"
@@ -29,9 +33,16 @@ struct Options {
 
   std::string input;
   std::string output;
+  std::string sequence_header;
+  // Output file for the Chrome trace of the decoding.
+  std::string trace;
+  // Maximum number of threads used for decoding the attributes.
+  int num_threads;
+  // Frame extracted from a persistent segment or -1 to output all points.
+  int frame;
 };
 
-Options::Options() {}
+Options::Options() : num_threads(1), frame(-1) {}
 
 void Usage() {
   printf("Usage: draco_decoder [options] -i input\n");
@@ -39,6 +50,21 @@ void Usage() {
   printf("Main options:\n");
   printf("  -h | -?               show help.\n");
   printf("  -o <output>           output file name.\n");
+  printf(
+      "  -seq_header <file>    sequence header used to encode the input "
+      "frame.\n");
+  printf(
+      "  -trace <file>         write Chrome trace events of the decoding. "
+      "Requires\n"
+      "                        a build with DRACO_TRACING enabled.\n");
+  printf(
+      "  -threads <value>      maximum number of threads used for decoding "
+      "the\n"
+      "                        attributes, default=1.\n");
+  printf(
+      "  -frame <value>        output only the points of a persistent segment "
+      "that\n"
+      "                        are visible in the given frame.\n");
 }
 
 int ReturnError(const draco::Status &status) {
@@ -60,6 +86,14 @@ int main(int argc, char **argv) {
       options.input = argv[++i];
     } else if (!strcmp("-o", argv[i]) && i < argc_check) {
       options.output = argv[++i];
+    } else if (!strcmp("-seq_header", argv[i]) && i < argc_check) {
+      options.sequence_header = argv[++i];
+    } else if (!strcmp("-trace", argv[i]) && i < argc_check) {
+      options.trace = argv[++i];
+    } else if (!strcmp("-threads", argv[i]) && i < argc_check) {
+      options.num_threads = atoi(argv[++i]);
+    } else if (!strcmp("-frame", argv[i]) && i < argc_check) {
+      options.frame = atoi(argv[++i]);
     }
   }
   if (argc < 3 || options.input.empty()) {
@@ -67,6 +101,14 @@ int main(int argc, char **argv) {
     return -1;
   }
 
+  draco::ChromeTraceWriter trace_writer;
+  if (!options.trace.empty()) {
+#ifndef DRACO_TRACING_SUPPORTED
+    printf("Warning: Tracing is not enabled in this build.\n");
+#endif
+    draco::SetTraceSink(&trace_writer);
+  }
+
   std::vector<char> data;
   if (!draco::ReadFileToBuffer(options.input, &data)) {
     printf("Failed opening the input file.\n");
@@ -82,6 +124,24 @@ int main(int argc, char **argv) {
   draco::DecoderBuffer buffer;
   buffer.Init(data.data(), data.size());
 
+  draco::Decoder decoder;
+  decoder.SetNumDecodingThreads(options.num_threads);
+  if (!options.sequence_header.empty()) {
+    std::vector<char> header_data;
+    if (!draco::ReadFileToBuffer(options.sequence_header, &header_data)) {
+      printf("Failed opening the sequence header.\n");
+      return -1;
+    }
+    draco::DecoderBuffer header_buffer;
+    header_buffer.Init(header_data.data(), header_data.size());
+    draco::SequenceHeader header;
+    const draco::Status status = header.Decode(&header_buffer);
+    if (!status.ok()) {
+      return ReturnError(status);
+    }
+    header.ApplyToDecoderOptions(decoder.options());
+  }
+
   draco::CycleTimer timer;
   // Decode the input data into a geometry.
   std::unique_ptr<draco::PointCloud> pc;
@@ -93,7 +153,6 @@ int main(int argc, char **argv) {
   const draco::EncodedGeometryType geom_type = type_statusor.value();
   if (geom_type == draco::TRIANGULAR_MESH) {
     timer.Start();
-    draco::Decoder decoder;
     auto statusor = decoder.DecodeMeshFromBuffer(&buffer);
     if (!statusor.ok()) {
       return ReturnError(statusor.status());
@@ -107,7 +166,6 @@ int main(int argc, char **argv) {
   } else if (geom_type == draco::POINT_CLOUD) {
     // Failed to decode it as mesh, so let's try to decode it as a point cloud.
     timer.Start();
-    draco::Decoder decoder;
     auto statusor = decoder.DecodePointCloudFromBuffer(&buffer);
     if (!statusor.ok()) {
       return ReturnError(statusor.status());
@@ -121,6 +179,23 @@ int main(int argc, char **argv) {
     return -1;
   }
 
+  if (options.frame >= 0) {
+    if (mesh) {
+      printf("Frames can be extracted only from point clouds.\n");
+      return -1;
+    }
+    draco::PersistentSegment segment;
+    draco::Status status = segment.Init(std::move(pc));
+    if (!status.ok()) {
+      return ReturnError(status);
+    }
+    auto statusor = segment.ExtractFrame(options.frame);
+    if (!statusor.ok()) {
+      return ReturnError(statusor.status());
+    }
+    pc = std::move(statusor).value();
+  }
+
   if (options.output.empty()) {
     // Save the output model into a ply file.
     options.output = options.input + ".ply";
@@ -174,6 +249,14 @@ int main(int argc, char **argv) {
     printf("Invalid output file extension. Use .obj .ply or .stl.\n");
     return -1;
   }
+  if (!options.trace.empty()) {
+    draco::SetTraceSink(nullptr);
+    const std::string json = trace_writer.ToJson();
+    if (!draco::WriteBufferToFile(json.data(), json.size(), options.trace)) {
+      printf("Failed to write the trace file.\n");
+      return -1;
+    }
+  }
   // printf("Decoded geometry saved to %s (%" PRId64 " ms to decode)\n",
   //        options.output.c_str(), timer.GetInMs());
   return 0;
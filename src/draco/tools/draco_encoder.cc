@@ -17,11 +17,16 @@
 
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/encode.h"
+#include "draco/compression/encoding_stats.h"
 #include "draco/compression/expert_encode.h"
+#include "draco/compression/rate_control.h"
+#include "draco/compression/sequence/persistent_segment_builder.h"
+#include "draco/compression/sequence/sequence_quantization_analyzer.h"
 #include "draco/core/cycle_timer.h"
 #include "draco/io/file_utils.h"
 #include "draco/io/mesh_io.h"
 #include "draco/io/point_cloud_io.h"
+#include "draco/mesh/mesh_cleanup.h"
 
 namespace {
 
@@ -50,6 +55,34 @@ struct Options {
   bool use_metadata;
   std::string input;
   std::string output;
+  // Sequence header with quantization grids shared by all frames.
+  std::string sequence_header;
+  // List of all frames of a sequence used to compute |sequence_header|.
+  std::string sequence_frames;
+  // List of consecutive frames encoded as a single persistent segment and the
+  // index of the first of them.
+  std::string segment_frames;
+  int segment_first_frame;
+  // Rate control. Quantization bits of all floating point attributes are
+  // selected automatically when any of these is set.
+  int64_t target_size;
+  float max_error;
+  // Format of the encoding stats printed after encoding, empty when the stats
+  // are not collected.
+  std::string stats_format;
+  // Maximum number of threads used for encoding the attributes.
+  int num_threads;
+  // Whether VQ index attributes are coded with the index attribute codec.
+  bool vq_index_coding;
+  // Whether float attributes that are not quantized are compressed losslessly.
+  bool lossless_float_coding;
+  // Whether wide integer symbols are coded as buckets with raw extra bits.
+  bool bucketed_symbol_coding;
+  // Whether each attribute is stored in a separate chunk for streaming.
+  bool attribute_chunks;
+  // Whether faces and points of the input mesh are reordered for memory
+  // locality before encoding.
+  bool reorder_for_locality;
 };
 
 Options::Options()
@@ -70,7 +103,16 @@ Options::Options()
       vq_idx_deleted(false),
       compression_level(7),
       preserve_polygons(false),
-      use_metadata(false) {}
+      use_metadata(false),
+      segment_first_frame(0),
+      target_size(0),
+      max_error(0.f),
+      num_threads(1),
+      vq_index_coding(false),
+      lossless_float_coding(false),
+      bucketed_symbol_coding(false),
+      attribute_chunks(false),
+      reorder_for_locality(false) {}
 
 void Usage() {
   printf("Usage: draco_encoder [options] -i input\n");
@@ -122,6 +164,68 @@ void Usage() {
   // mesh and polygon reconstruction information is encoded into a new generic
   // attribute.
   printf("  -preserve_polygons    encode polygon info as an attribute.\n");
+  printf(
+      "  -seq_header <file>    sequence header with quantization grids shared "
+      "by all frames.\n");
+  printf(
+      "  -seq_frames <file>    text file listing all frames of a sequence "
+      "(one per\n"
+      "                        line). Computes shared quantization grids and "
+      "stores\n"
+      "                        them to the file given by -seq_header.\n");
+  printf(
+      "  -segment_frames <file> text file listing consecutive frames with INS "
+      "and\n"
+      "                        OUTS attributes. Each Gaussian is encoded once "
+      "for\n"
+      "                        all frames in which it is visible.\n");
+  printf(
+      "  -segment_start <value> index of the first frame of the segment, "
+      "default=0.\n");
+  printf(
+      "  -target_size <bytes>  select quantization bits of all floating point\n"
+      "                        attributes except normals to fit the given "
+      "encoded\n"
+      "                        size.\n");
+  printf(
+      "  -max_error <value>    select quantization bits of all floating point\n"
+      "                        attributes except normals to keep the absolute\n"
+      "                        error below the given value. Can be combined "
+      "with\n"
+      "                        -target_size.\n");
+  printf(
+      "  --stats json          print per-attribute sizes and timings of the "
+      "encoder.\n");
+  printf(
+      "  -threads <value>      maximum number of threads used for encoding "
+      "the\n"
+      "                        attributes, default=1.\n");
+  printf(
+      "  -vq_index_coding      code VQ index attributes with a frequency "
+      "ranked\n"
+      "                        context model. Requires an up to date "
+      "decoder.\n");
+  printf(
+      "  -bucketed_symbols     code wide integer symbols as buckets with raw "
+      "extra\n"
+      "                        bits. Requires an up to date decoder.\n");
+  printf(
+      "  -lossless_float       compress float attributes with quantization "
+      "0\n"
+      "                        losslessly instead of storing them raw. "
+      "Requires\n"
+      "                        an up to date decoder.\n");
+  printf(
+      "  -attribute_chunks     store each attribute in a separate chunk so "
+      "that\n"
+      "                        it can be decoded while the rest of the data "
+      "is\n"
+      "                        still being received. Requires an up to date\n"
+      "                        decoder.\n");
+  printf(
+      "  -reorder              reorder faces and points of the input mesh "
+      "for\n"
+      "                        faster encoding of large meshes.\n");
 
   printf(
       "\nUse negative quantization values to skip the specified attribute\n");
@@ -287,13 +391,179 @@ void PrintOptions(const draco::PointCloud &pc, const Options &options) {
   printf("\n");
 }
 
+// Sets quantization bits of all attribute types to the analyzer. The bits are
+// the same as the ones used for the regular (per-frame) quantization.
+void SetSequenceQuantizationBits(
+    const Options &options, draco::SequenceQuantizationAnalyzer *analyzer) {
+  analyzer->SetAttributeQuantizationBits(draco::GeometryAttribute::POSITION,
+                                         options.pos_quantization_bits);
+  analyzer->SetAttributeQuantizationBits(draco::GeometryAttribute::TEX_COORD,
+                                         options.tex_coords_quantization_bits);
+  analyzer->SetAttributeQuantizationBits(draco::GeometryAttribute::GENERIC,
+                                         options.generic_quantization_bits);
+  for (const auto type :
+       {draco::GeometryAttribute::SH_DC, draco::GeometryAttribute::SH_REST,
+        draco::GeometryAttribute::OPACITY, draco::GeometryAttribute::SCALE,
+        draco::GeometryAttribute::ROTATION, draco::GeometryAttribute::AUX}) {
+    analyzer->SetAttributeQuantizationBits(type,
+                                           options.gaussian_quantization_bits);
+  }
+  // Normals are encoded with the octahedral transform and vector quantization
+  // indices are integers, neither of them uses the quantization grid.
+}
+
+// Reads a text file listing one frame file per line into |frame_files|.
+bool ReadFrameList(const std::string &list_file,
+                   std::vector<std::string> *frame_files) {
+  std::vector<char> list_data;
+  if (!draco::ReadFileToBuffer(list_file, &list_data)) {
+    return false;
+  }
+  const std::string list(list_data.begin(), list_data.end());
+  size_t line_start = 0;
+  while (line_start < list.size()) {
+    size_t line_end = list.find('\n', line_start);
+    if (line_end == std::string::npos) {
+      line_end = list.size();
+    }
+    std::string frame_file = list.substr(line_start, line_end - line_start);
+    line_start = line_end + 1;
+    if (!frame_file.empty() && frame_file.back() == '\r') {
+      frame_file.pop_back();
+    }
+    if (!frame_file.empty()) {
+      frame_files->push_back(frame_file);
+    }
+  }
+  return true;
+}
+
+// Loads all frames listed in |options.segment_frames| and merges them into a
+// single segment point cloud.
+draco::StatusOr<std::unique_ptr<draco::PointCloud>> BuildSegment(
+    const Options &options) {
+  std::vector<std::string> frame_files;
+  if (!ReadFrameList(options.segment_frames, &frame_files)) {
+    return draco::Status(draco::Status::IO_ERROR,
+                         "Failed opening the list of frames.");
+  }
+  draco::PersistentSegmentBuilder builder;
+  builder.Start(options.segment_first_frame);
+  for (const std::string &frame_file : frame_files) {
+    DRACO_ASSIGN_OR_RETURN(std::unique_ptr<draco::PointCloud> frame,
+                           draco::ReadPointCloudFromFile(frame_file));
+    DRACO_RETURN_IF_ERROR(builder.AddFrame(*frame));
+  }
+  return builder.Finalize();
+}
+
+// First pass of the sequence encoding. Loads all frames listed in
+// |options.sequence_frames| and stores the computed sequence header.
+int AnalyzeSequence(const Options &options) {
+  if (options.sequence_header.empty()) {
+    printf("Error: -seq_frames requires -seq_header.\n");
+    return -1;
+  }
+  std::vector<std::string> frame_files;
+  if (!ReadFrameList(options.sequence_frames, &frame_files)) {
+    printf("Failed opening the list of frames.\n");
+    return -1;
+  }
+  draco::SequenceQuantizationAnalyzer analyzer;
+  SetSequenceQuantizationBits(options, &analyzer);
+  for (const std::string &frame_file : frame_files) {
+    auto maybe_pc = draco::ReadPointCloudFromFile(frame_file);
+    if (!maybe_pc.ok()) {
+      printf("Failed loading frame %s: %s.\n", frame_file.c_str(),
+             maybe_pc.status().error_msg());
+      return -1;
+    }
+    const draco::Status status = analyzer.AddFrame(*maybe_pc.value());
+    if (!status.ok()) {
+      printf("Failed analyzing frame %s: %s.\n", frame_file.c_str(),
+             status.error_msg());
+      return -1;
+    }
+  }
+  draco::SequenceHeader header;
+  draco::Status status = analyzer.ComputeSequenceHeader(&header);
+  draco::EncoderBuffer buffer;
+  if (status.ok()) {
+    status = header.Encode(&buffer);
+  }
+  if (!status.ok()) {
+    printf("Failed to compute the sequence header: %s.\n", status.error_msg());
+    return -1;
+  }
+  if (!draco::WriteBufferToFile(buffer.data(), buffer.size(),
+                                options.sequence_header)) {
+    printf("Failed to write the sequence header.\n");
+    return -1;
+  }
+  printf("Sequence header with %d shared grids over %d frames saved to %s.\n",
+         header.num_quantization_grids(), analyzer.num_frames(),
+         options.sequence_header.c_str());
+  return 0;
+}
+
+// Encodes the geometry either with the options set on the |encoder| or with
+// quantization selected by the rate control when it is enabled in |options|.
+draco::Status EncodeWithRateControl(const draco::PointCloud &pc,
+                                    const Options &options,
+                                    draco::ExpertEncoder *encoder,
+                                    draco::EncoderBuffer *buffer) {
+  if (options.target_size <= 0 && options.max_error <= 0.f) {
+    return encoder->EncodeToBuffer(buffer);
+  }
+  draco::RateControlOptions rate_control_options;
+  rate_control_options.target_size = options.target_size;
+  rate_control_options.max_error = options.max_error;
+  DRACO_RETURN_IF_ERROR(
+      encoder->EncodeToBufferWithRateControl(rate_control_options, buffer));
+  printf("Rate control selected quantization:\n");
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    const int bits =
+        encoder->options().GetAttributeInt(i, "quantization_bits", -1);
+    if (pc.attribute(i)->data_type() == draco::DT_FLOAT32 && bits > 0) {
+      printf("  %s: Quantization = %d bits\n",
+             draco::GeometryAttribute::TypeToString(
+                 pc.attribute(i)->attribute_type())
+                 .c_str(),
+             bits);
+    }
+  }
+  printf("\n");
+  return draco::OkStatus();
+}
+
+// Encodes the geometry and prints the encoding stats when requested in
+// |options|.
+draco::Status EncodeToBuffer(const draco::PointCloud &pc,
+                             const Options &options,
+                             draco::ExpertEncoder *encoder,
+                             draco::EncoderBuffer *buffer) {
+  draco::EncodingStats stats;
+  if (!options.stats_format.empty()) {
+    encoder->SetEncodingStats(&stats);
+  }
+  const draco::Status status =
+      EncodeWithRateControl(pc, options, encoder, buffer);
+  encoder->SetEncodingStats(nullptr);
+  DRACO_RETURN_IF_ERROR(status);
+  if (!options.stats_format.empty()) {
+    printf("%s\n", draco::EncodingStatsToJson(stats).c_str());
+  }
+  return draco::OkStatus();
+}
+
 int EncodePointCloudToFile(const draco::PointCloud &pc, const std::string &file,
+                           const Options &options,
                            draco::ExpertEncoder *encoder) {
   draco::CycleTimer timer;
   // Encode the geometry.
   draco::EncoderBuffer buffer;
   timer.Start();
-  const draco::Status status = encoder->EncodeToBuffer(&buffer);
+  const draco::Status status = EncodeToBuffer(pc, options, encoder, &buffer);
   if (!status.ok()) {
     printf("Failed to encode the point cloud.\n");
     printf("%s\n", status.error_msg());
@@ -312,12 +582,12 @@ int EncodePointCloudToFile(const draco::PointCloud &pc, const std::string &file,
 }
 
 int EncodeMeshToFile(const draco::Mesh &mesh, const std::string &file,
-                     draco::ExpertEncoder *encoder) {
+                     const Options &options, draco::ExpertEncoder *encoder) {
   draco::CycleTimer timer;
   // Encode the geometry.
   draco::EncoderBuffer buffer;
   timer.Start();
-  const draco::Status status = encoder->EncodeToBuffer(&buffer);
+  const draco::Status status = EncodeToBuffer(mesh, options, encoder, &buffer);
   if (!status.ok()) {
     printf("Failed to encode the mesh.\n");
     printf("%s\n", status.error_msg());
@@ -442,8 +712,47 @@ int main(int argc, char **argv) {
       options.use_metadata = true;
     } else if (!strcmp("-preserve_polygons", argv[i])) {
       options.preserve_polygons = true;
+    } else if (!strcmp("-seq_header", argv[i]) && i < argc_check) {
+      options.sequence_header = argv[++i];
+    } else if (!strcmp("-seq_frames", argv[i]) && i < argc_check) {
+      options.sequence_frames = argv[++i];
+    } else if (!strcmp("-segment_frames", argv[i]) && i < argc_check) {
+      options.segment_frames = argv[++i];
+      options.is_point_cloud = true;
+    } else if (!strcmp("-segment_start", argv[i]) && i < argc_check) {
+      options.segment_first_frame = StringToInt(argv[++i]);
+    } else if (!strcmp("-target_size", argv[i]) && i < argc_check) {
+      options.target_size = strtoll(argv[++i], nullptr, 10);  // NOLINT
+    } else if (!strcmp("-max_error", argv[i]) && i < argc_check) {
+      options.max_error = strtof(argv[++i], nullptr);
+    } else if (!strcmp("--stats", argv[i]) && i < argc_check) {
+      options.stats_format = argv[++i];
+      if (options.stats_format != "json") {
+        printf("Error: Unsupported stats format %s.\n",
+               options.stats_format.c_str());
+        return -1;
+      }
+    } else if (!strcmp("-threads", argv[i]) && i < argc_check) {
+      options.num_threads = StringToInt(argv[++i]);
+    } else if (!strcmp("-vq_index_coding", argv[i])) {
+      options.vq_index_coding = true;
+    } else if (!strcmp("-lossless_float", argv[i])) {
+      options.lossless_float_coding = true;
+    } else if (!strcmp("-bucketed_symbols", argv[i])) {
+      options.bucketed_symbol_coding = true;
+    } else if (!strcmp("-attribute_chunks", argv[i])) {
+      options.attribute_chunks = true;
+    } else if (!strcmp("-reorder", argv[i])) {
+      options.reorder_for_locality = true;
     }
   }
+  if (!options.sequence_frames.empty()) {
+    return AnalyzeSequence(options);
+  }
+  if (!options.segment_frames.empty()) {
+    // The segment replaces the input file.
+    options.input = options.segment_frames;
+  }
   if (argc < 3 || options.input.empty()) {
     Usage();
     return -1;
@@ -464,6 +773,14 @@ int main(int argc, char **argv) {
     // mesh inherits from PointCloud
     mesh = maybe_mesh.value().get();
     pc = std::move(maybe_mesh).value();
+  } else if (!options.segment_frames.empty()) {
+    auto maybe_pc = BuildSegment(options);
+    if (!maybe_pc.ok()) {
+      printf("Failed building the segment: %s.\n",
+             maybe_pc.status().error_msg());
+      return -1;
+    }
+    pc = std::move(maybe_pc).value();
   } else {
     auto maybe_pc = draco::ReadPointCloudFromFile(options.input);
     if (!maybe_pc.ok()) {
@@ -645,6 +962,11 @@ int main(int argc, char **argv) {
                                      options.gaussian_rot_idx_bits);
   }
   encoder.SetSpeedOptions(speed, speed);
+  encoder.SetNumEncodingThreads(options.num_threads);
+  encoder.SetVqIndexCoding(options.vq_index_coding);
+  encoder.SetLosslessFloatCoding(options.lossless_float_coding);
+  encoder.SetBucketedSymbolCoding(options.bucketed_symbol_coding);
+  encoder.SetAttributeChunks(options.attribute_chunks);
 
   if (options.output.empty()) {
     // Create a default output file by attaching .drc to the input file name.
@@ -656,6 +978,21 @@ int main(int argc, char **argv) {
   // no face in point cloud
   const bool input_is_mesh = mesh && mesh->num_faces() > 0;
 
+  if (input_is_mesh && options.reorder_for_locality) {
+    // Only reorder the mesh, no data is removed.
+    draco::MeshCleanupOptions cleanup_options;
+    cleanup_options.remove_degenerated_faces = false;
+    cleanup_options.remove_duplicate_faces = false;
+    cleanup_options.remove_unused_attributes = false;
+    cleanup_options.reorder_for_locality = true;
+    const draco::Status status =
+        draco::MeshCleanup::Cleanup(mesh, cleanup_options);
+    if (!status.ok()) {
+      printf("Failed to reorder the mesh: %s.\n", status.error_msg());
+      return -1;
+    }
+  }
+
   // Convert to ExpertEncoder that allows us to set per-attribute options.
   // src/draco/compression/expert_encode.h
   std::unique_ptr<draco::ExpertEncoder> expert_encoder;
@@ -667,6 +1004,26 @@ int main(int argc, char **argv) {
   // create option settings from the previous processed options
   expert_encoder->Reset(encoder.CreateExpertEncoderOptions(*pc));
 
+  if (!options.sequence_header.empty()) {
+    // Quantize attributes on the grids shared by all frames of the sequence.
+    std::vector<char> header_data;
+    if (!draco::ReadFileToBuffer(options.sequence_header, &header_data)) {
+      printf("Failed opening the sequence header.\n");
+      return -1;
+    }
+    draco::DecoderBuffer header_buffer;
+    header_buffer.Init(header_data.data(), header_data.size());
+    draco::SequenceHeader header;
+    draco::Status status = header.Decode(&header_buffer);
+    if (status.ok()) {
+      status = header.ApplyToEncoderOptions(*pc, &expert_encoder->options());
+    }
+    if (!status.ok()) {
+      printf("Failed to apply the sequence header: %s.\n", status.error_msg());
+      return -1;
+    }
+  }
+
   // Check if there is an attribute that stores polygon edges. If so, we disable
   // the default prediction scheme for the attribute as it actually makes the
   // compression worse.
@@ -680,9 +1037,11 @@ int main(int argc, char **argv) {
   int ret = -1;
 
   if (input_is_mesh) {
-    ret = EncodeMeshToFile(*mesh, options.output, expert_encoder.get());
+    ret = EncodeMeshToFile(*mesh, options.output, options,
+                           expert_encoder.get());
   } else {
-    ret = EncodePointCloudToFile(*pc, options.output, expert_encoder.get());
+    ret = EncodePointCloudToFile(*pc, options.output, options,
+                                 expert_encoder.get());
   }
 
   if (ret != -1 && options.compression_level < 10) {
@@ -45,6 +45,10 @@ void Usage() {
   printf("default=8.\n");
   printf("  -qg <value>     quantization bits for any generic attribute, ");
   printf("default=8.\n");
+  printf("  -qgs <value>    quantization bits for gaussian attributes, ");
+  printf("default=10.\n");
+  printf("  -threads <value> maximum number of threads used for compressing ");
+  printf("meshes, default=number of hardware threads.\n");
 
   printf("\nBoolean options may be negated by prefixing 'no'.\n");
 }
@@ -112,6 +116,11 @@ int main(int argc, char **argv) {
     } else if (!strcmp("-qg", argv[i]) && i < argc_check) {
       transcode_options.geometry.quantization_bits_generic =
           StringToInt(argv[++i]);
+    } else if (!strcmp("-qgs", argv[i]) && i < argc_check) {
+      transcode_options.geometry.quantization_bits_gaussian =
+          StringToInt(argv[++i]);
+    } else if (!strcmp("-threads", argv[i]) && i < argc_check) {
+      transcode_options.num_threads = StringToInt(argv[++i]);
     }
   }
   if (argc < 3 || file_options.input_filename.empty() ||
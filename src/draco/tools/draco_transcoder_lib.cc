@@ -30,6 +30,9 @@ StatusOr<std::unique_ptr<DracoTranscoder>> DracoTranscoder::Create(
   DRACO_RETURN_IF_ERROR(options.geometry.Check());
   std::unique_ptr<DracoTranscoder> dt(new DracoTranscoder());
   dt->transcoding_options_ = options;
+  if (options.num_threads >= 0) {
+    dt->gltf_encoder_.set_num_threads(options.num_threads);
+  }
   return dt;
 }
 
@@ -29,10 +29,14 @@ namespace draco {
 
 // Struct to hold Draco transcoding options.
 struct DracoTranscodingOptions {
-  DracoTranscodingOptions() {}
+  DracoTranscodingOptions() : num_threads(-1) {}
 
   // Options used when geometry compression optimization is disabled.
   DracoCompressionOptions geometry;
+
+  // Maximum number of threads used for compressing the meshes. Negative value
+  // selects the number of hardware threads.
+  int num_threads;
 };
 
 // Class that supports input of glTF (and some simple USD) files, encodes
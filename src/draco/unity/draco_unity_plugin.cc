@@ -88,6 +88,41 @@ void *ConvertAttributeData(int num_points, const draco::PointAttribute *attr) {
       return nullptr;
   }
 }
+
+// Writes values of |attr| converted to |num_components| components of type T
+// to |data| with a byte |stride| between consecutive points.
+template <typename T>
+bool FillTypedAttributeData(int num_points, const draco::PointAttribute *attr,
+                            int num_components, int stride, uint8_t *data) {
+  // Values are converted into a local buffer first because |data| does not
+  // need to be aligned for T when the values are interleaved.
+  T value[127];
+  const size_t value_size = sizeof(T) * num_components;
+  for (draco::PointIndex i(0); i < num_points; ++i) {
+    if (!attr->ConvertValue<T>(attr->mapped_index(i), num_components, value)) {
+      return false;
+    }
+    memcpy(data + static_cast<size_t>(stride) * i.value(), value, value_size);
+  }
+  return true;
+}
+
+// Writes values of |attr| to |data| without conversion. |value_size| is the
+// size of a single value in bytes.
+void CopyRawAttributeData(int num_points, const draco::PointAttribute *attr,
+                          int value_size, int stride, uint8_t *data) {
+  if (attr->is_mapping_identity() && attr->byte_stride() == value_size &&
+      stride == value_size) {
+    // Values of all points are stored contiguously in the attribute buffer.
+    memcpy(data, attr->GetAddress(draco::AttributeValueIndex(0)),
+           static_cast<size_t>(value_size) * num_points);
+    return;
+  }
+  for (draco::PointIndex i(0); i < num_points; ++i) {
+    memcpy(data + static_cast<size_t>(stride) * i.value(),
+           attr->GetAddressOfMappedIndex(i), value_size);
+  }
+}
 }  // namespace
 
 namespace draco {
@@ -270,6 +305,103 @@ bool EXPORT_API GetAttributeData(const DracoMesh *mesh,
   return true;
 }
 
+bool EXPORT_API FillMeshIndices(const DracoMesh *mesh, DataType data_type,
+                                void *indices, int indices_size) {
+  if (mesh == nullptr || indices == nullptr || indices_size < 0) {
+    return false;
+  }
+  const Mesh *const m = static_cast<const Mesh *>(mesh->private_mesh);
+  const int64_t num_indices = static_cast<int64_t>(m->num_faces()) * 3;
+  if (data_type == DT_UINT16) {
+    if (m->num_points() > 0xffff ||
+        num_indices * static_cast<int64_t>(sizeof(uint16_t)) > indices_size) {
+      return false;
+    }
+    uint16_t *const out = static_cast<uint16_t *>(indices);
+    for (FaceIndex face_id(0); face_id < m->num_faces(); ++face_id) {
+      const Mesh::Face &face = m->face(face_id);
+      for (int c = 0; c < 3; ++c) {
+        out[face_id.value() * 3 + c] = static_cast<uint16_t>(face[c].value());
+      }
+    }
+    return true;
+  }
+  if (data_type != DT_UINT32 && data_type != DT_INT32) {
+    return false;
+  }
+  if (num_indices * static_cast<int64_t>(sizeof(uint32_t)) > indices_size) {
+    return false;
+  }
+  // Faces are stored as consecutive 32-bit point indices.
+  if (m->num_faces() > 0) {
+    memcpy(indices, m->face(FaceIndex(0)).data(),
+           sizeof(uint32_t) * num_indices);
+  }
+  return true;
+}
+
+bool EXPORT_API FillAttributeData(const DracoMesh *mesh,
+                                  const DracoAttribute *attribute,
+                                  DataType data_type, int num_components,
+                                  int stride, void *data, int data_size) {
+  if (mesh == nullptr || attribute == nullptr || data == nullptr ||
+      num_components < 1 || num_components > 127 || stride < 0 ||
+      data_size < 0) {
+    return false;
+  }
+  const Mesh *const m = static_cast<const Mesh *>(mesh->private_mesh);
+  const PointAttribute *const attr =
+      static_cast<const PointAttribute *>(attribute->private_attribute);
+  const int value_size = DataTypeLength(data_type) * num_components;
+  if (value_size == 0) {
+    return false;
+  }
+  if (stride == 0) {
+    stride = value_size;
+  } else if (stride < value_size) {
+    return false;
+  }
+  const int num_points = m->num_points();
+  if (num_points == 0) {
+    return true;
+  }
+  if (static_cast<int64_t>(stride) * (num_points - 1) + value_size >
+      data_size) {
+    return false;
+  }
+  uint8_t *const out = static_cast<uint8_t *>(data);
+  if (data_type == attr->data_type() &&
+      num_components == attr->num_components()) {
+    CopyRawAttributeData(num_points, attr, value_size, stride, out);
+    return true;
+  }
+  switch (data_type) {
+    case DT_INT8:
+      return FillTypedAttributeData<int8_t>(num_points, attr, num_components,
+                                            stride, out);
+    case DT_UINT8:
+      return FillTypedAttributeData<uint8_t>(num_points, attr, num_components,
+                                             stride, out);
+    case DT_INT16:
+      return FillTypedAttributeData<int16_t>(num_points, attr, num_components,
+                                             stride, out);
+    case DT_UINT16:
+      return FillTypedAttributeData<uint16_t>(num_points, attr,
+                                              num_components, stride, out);
+    case DT_INT32:
+      return FillTypedAttributeData<int32_t>(num_points, attr, num_components,
+                                             stride, out);
+    case DT_UINT32:
+      return FillTypedAttributeData<uint32_t>(num_points, attr,
+                                              num_components, stride, out);
+    case DT_FLOAT32:
+      return FillTypedAttributeData<float>(num_points, attr, num_components,
+                                           stride, out);
+    default:
+      return false;
+  }
+}
+
 void ReleaseUnityMesh(DracoToUnityMesh **mesh_ptr) {
   DracoToUnityMesh *mesh = *mesh_ptr;
   if (!mesh) {
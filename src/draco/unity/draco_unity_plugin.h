@@ -111,6 +111,31 @@ bool EXPORT_API GetAttributeData(const DracoMesh *mesh,
                                  const DracoAttribute *attribute,
                                  DracoData **data);
 
+// Functions below write decoded data directly into caller-owned buffers such
+// as the memory of Unity NativeArrays, without any intermediate allocations.
+// They only read from |mesh|, so they can be called concurrently on the same
+// mesh, e.g. from several jobs of the Unity Job System. DecodeDracoMesh uses a
+// separate decoder instance for each call and it can be called concurrently as
+// well.
+
+// Writes the indices of all faces in |mesh| to |indices|. |data_type| is the
+// type of the written indices and it must be DT_UINT16, DT_UINT32 or DT_INT32.
+// |indices_size| is the size of |indices| in bytes. Returns false when the
+// indices do not fit into |indices| or into |data_type|.
+bool EXPORT_API FillMeshIndices(const DracoMesh *mesh, DataType data_type,
+                                void *indices, int indices_size);
+// Writes the values of |attribute| for all vertices of |mesh| to |data|. Each
+// value is converted to |num_components| components of |data_type|. Missing
+// components are set to zero. Consecutive values are written |stride| bytes
+// apart, which allows writing into interleaved vertex buffers. When |stride|
+// is zero, the values are tightly packed. |data_size| is the size of |data|
+// in bytes. Returns false when the values do not fit into |data| or when the
+// conversion fails.
+bool EXPORT_API FillAttributeData(const DracoMesh *mesh,
+                                  const DracoAttribute *attribute,
+                                  DataType data_type, int num_components,
+                                  int stride, void *data, int data_size);
+
 // DracoToUnityMesh is deprecated.
 struct EXPORT_API DracoToUnityMesh {
   DracoToUnityMesh()
@@ -199,6 +199,81 @@ TEST(DracoUnityPluginTest, TestAttributeUniqueId) {
   draco::ReleaseDracoMesh(&draco_mesh);
 }
 
+TEST(DracoUnityPluginTest, TestFillData) {
+  // Tests that data written into caller-owned buffers matches the data
+  // returned by GetMeshIndices and GetAttributeData.
+  draco::DracoMesh *draco_mesh =
+      DecodeToDracoMesh("test_nm.obj.edgebreaker.cl4.2.2.drc");
+  ASSERT_NE(draco_mesh, nullptr);
+  const int num_indices = draco_mesh->num_faces * 3;
+
+  draco::DracoData *indices = nullptr;
+  ASSERT_TRUE(GetMeshIndices(draco_mesh, &indices));
+  std::vector<uint16_t> indices_16(num_indices);
+  ASSERT_FALSE(draco::FillMeshIndices(draco_mesh, draco::DT_UINT16,
+                                      indices_16.data(),
+                                      2 * (num_indices - 1)));
+  ASSERT_TRUE(draco::FillMeshIndices(draco_mesh, draco::DT_UINT16,
+                                     indices_16.data(), 2 * num_indices));
+  std::vector<int32_t> indices_32(num_indices);
+  ASSERT_TRUE(draco::FillMeshIndices(draco_mesh, draco::DT_INT32,
+                                     indices_32.data(), 4 * num_indices));
+  const int32_t *const expected_indices =
+      static_cast<const int32_t *>(indices->data);
+  for (int i = 0; i < num_indices; ++i) {
+    ASSERT_EQ(indices_16[i], expected_indices[i]);
+    ASSERT_EQ(indices_32[i], expected_indices[i]);
+  }
+  draco::ReleaseDracoData(&indices);
+
+  draco::DracoAttribute *pos_attribute = nullptr;
+  ASSERT_TRUE(draco::GetAttributeByType(
+      draco_mesh, draco::GeometryAttribute::POSITION, 0, &pos_attribute));
+  ASSERT_EQ(pos_attribute->data_type, draco::DT_FLOAT32);
+  ASSERT_EQ(pos_attribute->num_components, 3);
+  draco::DracoData *pos_data = nullptr;
+  ASSERT_TRUE(
+      draco::GetAttributeData(draco_mesh, pos_attribute, &pos_data));
+  const float *const expected_pos = static_cast<const float *>(pos_data->data);
+
+  // Tightly packed values.
+  const int num_vertices = draco_mesh->num_vertices;
+  std::vector<float> pos(num_vertices * 3);
+  ASSERT_TRUE(draco::FillAttributeData(draco_mesh, pos_attribute,
+                                       draco::DT_FLOAT32, 3, 0, pos.data(),
+                                       sizeof(float) * pos.size()));
+  for (int i = 0; i < num_vertices * 3; ++i) {
+    ASSERT_EQ(pos[i], expected_pos[i]);
+  }
+
+  // Values interleaved with another attribute and padded to four components.
+  const int stride = sizeof(float) * 6;
+  std::vector<float> vertices(num_vertices * 6, -1.f);
+  ASSERT_FALSE(draco::FillAttributeData(
+      draco_mesh, pos_attribute, draco::DT_FLOAT32, 4, stride,
+      vertices.data(), sizeof(float) * (vertices.size() - 3)));
+  ASSERT_TRUE(draco::FillAttributeData(
+      draco_mesh, pos_attribute, draco::DT_FLOAT32, 4, stride,
+      vertices.data(), sizeof(float) * vertices.size()));
+  for (int i = 0; i < num_vertices; ++i) {
+    for (int c = 0; c < 3; ++c) {
+      ASSERT_EQ(vertices[i * 6 + c], expected_pos[i * 3 + c]);
+    }
+    ASSERT_EQ(vertices[i * 6 + 3], 0.f);
+    ASSERT_EQ(vertices[i * 6 + 4], -1.f);
+    ASSERT_EQ(vertices[i * 6 + 5], -1.f);
+  }
+
+  // Stride smaller than the size of the converted value.
+  ASSERT_FALSE(draco::FillAttributeData(
+      draco_mesh, pos_attribute, draco::DT_FLOAT32, 3, 8, pos.data(),
+      sizeof(float) * pos.size()));
+
+  draco::ReleaseDracoData(&pos_data);
+  draco::ReleaseDracoAttribute(&pos_attribute);
+  draco::ReleaseDracoMesh(&draco_mesh);
+}
+
 class DeprecatedDracoUnityPluginTest : public ::testing::Test {
  protected:
   DeprecatedDracoUnityPluginTest() : unity_mesh_(nullptr) {}
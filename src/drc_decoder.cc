@@ -15,11 +15,21 @@
 // #include <emscripten/emscripten.h>
 
 #include <cinttypes>
+#include <limits>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/pytypes.h>
 #include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/compression/encoding_stats.h"
+#include "draco/compression/expert_encode.h"
+#include "draco/compression/sequence/sequence_reader.h"
+#include "draco/compression/sequence/sequence_writer.h"
+#include "draco/core/thread_pool.h"
+#include "draco/io/ply_decoder.h"
 #include "draco/io/ply_encoder.h"
+#include "draco/point_cloud/point_cloud_builder.h"
 
 // int main(int argc, char **argv) {
 //   printf("wasm decoder loaded\n");
@@ -107,6 +117,554 @@ pybind11::bytes drc2ply(pybind11::bytes input) {
 }
 #endif
 
+// Converts encoding stats to a Python dictionary with the same keys as the
+// JSON output of EncodingStatsToJson().
+pybind11::dict EncodingStatsToDict(const draco::EncodingStats &stats) {
+  pybind11::list attributes;
+  for (const draco::AttributeEncodingStats &att : stats.attributes) {
+    pybind11::dict a;
+    a["attribute_id"] = att.attribute_id;
+    a["type"] = draco::GeometryAttribute::TypeToString(att.attribute_type);
+    a["num_components"] = att.num_components;
+    a["encoder"] = att.encoder;
+    a["quantization_bits"] = att.quantization_bits;
+    a["prediction_scheme"] =
+        draco::PredictionSchemeToString(att.prediction_scheme);
+    a["prediction_transform"] =
+        draco::PredictionTransformToString(att.prediction_transform);
+    a["symbol_coding_method"] =
+        draco::SymbolCodingMethodToString(att.symbol_coding_method);
+    a["num_values"] = att.num_values;
+    a["raw_size"] = att.raw_size;
+    a["entropy_input_size"] = att.entropy_input_size;
+    a["entropy_coded_size"] = att.entropy_coded_size;
+    a["entropy_estimate_bits"] = att.entropy_estimate_bits;
+    a["encoded_size"] = att.encoded_size;
+    a["joint_attribute_id"] = att.joint_attribute_id;
+    a["transform_time"] = att.transform_time;
+    a["prediction_time"] = att.prediction_time;
+    a["entropy_coding_time"] = att.entropy_coding_time;
+    attributes.append(a);
+  }
+  pybind11::dict d;
+  d["geometry_type"] = draco::EncodedGeometryTypeToString(stats.geometry_type);
+  d["encoding_method"] = stats.encoding_method;
+  d["header_size"] = stats.header_size;
+  d["geometry_size"] = stats.geometry_size;
+  d["total_size"] = stats.total_size;
+  d["geometry_time"] = stats.geometry_time;
+  d["total_time"] = stats.total_time;
+  d["attributes"] = attributes;
+  return d;
+}
+
+// Encodes a PLY point cloud to Draco. Positions are quantized with |qp| bits
+// and all other floating point attributes with |qa| bits. When |stats| is
+// true, a tuple (bytes, dict) with the encoding stats is returned.
+pybind11::object ply2drc(pybind11::bytes input, int qp, int qa,
+                         int compression_level, bool stats) {
+  const std::string input_str = input;
+  draco::DecoderBuffer buffer;
+  buffer.Init(input_str.data(), input_str.size());
+  draco::PointCloud pc;
+  draco::PlyDecoder ply_decoder;
+  const draco::Status status = ply_decoder.DecodeFromBuffer(&buffer, &pc);
+  if (!status.ok()) {
+    throw std::runtime_error(status.error_msg_string());
+  }
+
+  draco::ExpertEncoder encoder(pc);
+  const int speed = 10 - compression_level;
+  encoder.SetSpeedOptions(speed, speed);
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    const draco::PointAttribute *const att = pc.attribute(i);
+    if (att->data_type() != draco::DT_FLOAT32) {
+      continue;
+    }
+    encoder.SetAttributeQuantization(
+        i, att->attribute_type() == draco::GeometryAttribute::POSITION ? qp
+                                                                        : qa);
+  }
+  draco::EncodingStats encoding_stats;
+  if (stats) {
+    encoder.SetEncodingStats(&encoding_stats);
+  }
+  draco::EncoderBuffer out_buffer;
+  const draco::Status encode_status = encoder.EncodeToBuffer(&out_buffer);
+  if (!encode_status.ok()) {
+    throw std::runtime_error(encode_status.error_msg_string());
+  }
+  pybind11::bytes result(out_buffer.data(), out_buffer.size());
+  if (!stats) {
+    return std::move(result);
+  }
+  return pybind11::make_tuple(result, EncodingStatsToDict(encoding_stats));
+}
+
+// Returns Draco encoder options that quantize positions with |qp| bits and all
+// other floating point attributes of |pc| with |qa| bits.
+draco::EncoderOptions CreateEncoderOptions(const draco::PointCloud &pc, int qp,
+                                           int qa, int compression_level) {
+  draco::EncoderOptions options = draco::EncoderOptions::CreateDefaultOptions();
+  const int speed = 10 - compression_level;
+  options.SetSpeed(speed, speed);
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    const draco::PointAttribute *const att = pc.attribute(i);
+    if (att->data_type() != draco::DT_FLOAT32) {
+      continue;
+    }
+    options.SetAttributeInt(
+        i, "quantization_bits",
+        att->attribute_type() == draco::GeometryAttribute::POSITION ? qp : qa);
+  }
+  return options;
+}
+
+// Quantization options of EncodeGaussians(). The names and defaults match the
+// options of draco_encoder.
+struct GaussianEncodeOptions {
+  int qp = 12;
+  int qgs = 10;
+  int qgsdci = 12;
+  int qgsshi = 9;
+  int qgsscalei = 12;
+  int qgsroti = 12;
+  int compression_level = 7;
+  bool vq_index_coding = false;
+  bool lossless_float = false;
+};
+
+// Describes the values of one attribute stored in a NumPy array. The array
+// must be kept alive while the attribute is used.
+struct GaussianAttributeArray {
+  draco::GeometryAttribute::Type attribute_type;
+  draco::DataType data_type;
+  int num_components;
+  const void *data;
+  // Distance between values of consecutive points in bytes.
+  int64_t stride;
+};
+
+// Attributes of one Gaussian point cloud given as NumPy arrays.
+struct GaussianArrays {
+  int num_points = 0;
+  std::vector<GaussianAttributeArray> attributes;
+  // References to the arrays that hold the attribute values.
+  std::vector<pybind11::array> arrays;
+};
+
+// Returns the attribute type of a Gaussian attribute array named the same as
+// the corresponding PLY property.
+draco::GeometryAttribute::Type GaussianAttributeType(const std::string &name) {
+  static const std::pair<const char *, draco::GeometryAttribute::Type>
+      kAttributeTypes[] = {
+          {"positions", draco::GeometryAttribute::POSITION},
+          {"f_dc", draco::GeometryAttribute::SH_DC},
+          {"f_rest", draco::GeometryAttribute::SH_REST},
+          {"opacity", draco::GeometryAttribute::OPACITY},
+          {"scale", draco::GeometryAttribute::SCALE},
+          {"rotation", draco::GeometryAttribute::ROTATION},
+          {"segment", draco::GeometryAttribute::AUX},
+          {"dc_idx", draco::GeometryAttribute::SH_DC_IDX},
+          {"rest_idx", draco::GeometryAttribute::SH_REST_IDX},
+          {"scale_idx", draco::GeometryAttribute::SCALE_IDX},
+          {"rotation_idx", draco::GeometryAttribute::ROTATION_IDX},
+          {"ins", draco::GeometryAttribute::INS},
+          {"outs", draco::GeometryAttribute::OUTS},
+      };
+  for (const auto &entry : kAttributeTypes) {
+    if (name == entry.first) {
+      return entry.second;
+    }
+  }
+  throw pybind11::key_error("Unknown Gaussian attribute: " + name);
+}
+
+draco::DataType NumpyToDracoDataType(const pybind11::dtype &dtype) {
+  const int size = static_cast<int>(dtype.itemsize());
+  switch (dtype.kind()) {
+    case 'f':
+      if (size == 4) {
+        return draco::DT_FLOAT32;
+      }
+      break;
+    case 'u':
+      if (size == 1) {
+        return draco::DT_UINT8;
+      } else if (size == 2) {
+        return draco::DT_UINT16;
+      } else if (size == 4) {
+        return draco::DT_UINT32;
+      }
+      break;
+    case 'i':
+      if (size == 1) {
+        return draco::DT_INT8;
+      } else if (size == 2) {
+        return draco::DT_INT16;
+      } else if (size == 4) {
+        return draco::DT_INT32;
+      }
+      break;
+  }
+  throw pybind11::type_error(
+      "Attribute arrays must be float32 or integers of at most 4 bytes.");
+}
+
+// Collects the arrays of |attributes| that map attribute names to arrays of
+// shape (num_points,) or (num_points, num_components). The values are not
+// copied. Only arrays whose components are not contiguous or whose rows
+// overlap are converted to a C-contiguous copy, other arrays are read with
+// their row stride.
+GaussianArrays GetGaussianArrays(const pybind11::dict &attributes) {
+  GaussianArrays out;
+  bool has_points = false;
+  for (const auto &item : attributes) {
+    const std::string name = pybind11::cast<std::string>(item.first);
+    GaussianAttributeArray att;
+    att.attribute_type = GaussianAttributeType(name);
+    pybind11::array array = pybind11::array::ensure(item.second);
+    if (!array || array.ndim() < 1 || array.ndim() > 2) {
+      throw pybind11::value_error("Attribute " + name +
+                                  " must be a 1D or 2D array.");
+    }
+    att.data_type = NumpyToDracoDataType(array.dtype());
+    att.num_components = array.ndim() == 2 ? array.shape(1) : 1;
+    if (att.num_components < 1 || att.num_components > 127) {
+      throw pybind11::value_error("Invalid number of components of " + name);
+    }
+    // Rows must not overlap, e.g. broadcast arrays have a zero row stride.
+    const int64_t packed_stride =
+        static_cast<int64_t>(att.num_components) * array.itemsize();
+    att.stride = array.strides(0);
+    if (att.stride < packed_stride ||
+        (array.ndim() == 2 && array.strides(1) != array.itemsize())) {
+      array = pybind11::array::ensure(array, pybind11::array::c_style);
+      att.stride = packed_stride;
+    }
+    if (att.stride > std::numeric_limits<int>::max()) {
+      throw pybind11::value_error("Row stride of " + name + " is too large.");
+    }
+    if (!has_points) {
+      out.num_points = array.shape(0);
+      has_points = true;
+    } else if (array.shape(0) != out.num_points) {
+      throw pybind11::value_error("Attribute " + name +
+                                  " has a different number of points.");
+    }
+    att.data = array.data();
+    out.attributes.push_back(att);
+    out.arrays.push_back(std::move(array));
+  }
+  if (out.num_points == 0) {
+    throw pybind11::value_error("Point cloud has no points.");
+  }
+  return out;
+}
+
+// Builds a point cloud from |arrays| and encodes it into |out_buffer|. Does
+// not access any Python objects so it can run without the GIL.
+draco::Status EncodeGaussianArrays(const GaussianArrays &arrays,
+                                   const GaussianEncodeOptions &options,
+                                   draco::EncoderBuffer *out_buffer) {
+  draco::PointCloudBuilder builder;
+  builder.Start(arrays.num_points);
+  for (const GaussianAttributeArray &att : arrays.attributes) {
+    const int att_id = builder.AddAttribute(att.attribute_type,
+                                            att.num_components, att.data_type);
+    // A single copy is made when the array is contiguous.
+    builder.SetAttributeValuesForAllPoints(att_id, att.data,
+                                           static_cast<int>(att.stride));
+  }
+  std::unique_ptr<draco::PointCloud> pc = builder.Finalize(false);
+  if (pc == nullptr) {
+    return draco::Status(draco::Status::DRACO_ERROR,
+                         "Failed to build the point cloud.");
+  }
+
+  draco::Encoder encoder;
+  const std::pair<draco::GeometryAttribute::Type, int> kQuantization[] = {
+      {draco::GeometryAttribute::POSITION, options.qp},
+      {draco::GeometryAttribute::SH_DC, options.qgs},
+      {draco::GeometryAttribute::SH_REST, options.qgs},
+      {draco::GeometryAttribute::OPACITY, options.qgs},
+      {draco::GeometryAttribute::SCALE, options.qgs},
+      {draco::GeometryAttribute::ROTATION, options.qgs},
+      {draco::GeometryAttribute::AUX, options.qgs},
+      {draco::GeometryAttribute::SH_DC_IDX, options.qgsdci},
+      {draco::GeometryAttribute::SH_REST_IDX, options.qgsshi},
+      {draco::GeometryAttribute::SCALE_IDX, options.qgsscalei},
+      {draco::GeometryAttribute::ROTATION_IDX, options.qgsroti},
+  };
+  for (const auto &entry : kQuantization) {
+    if (entry.second > 0) {
+      encoder.SetAttributeQuantization(entry.first, entry.second);
+    }
+  }
+  const int speed = 10 - options.compression_level;
+  encoder.SetSpeedOptions(speed, speed);
+  encoder.SetVqIndexCoding(options.vq_index_coding);
+  encoder.SetLosslessFloatCoding(options.lossless_float);
+  return encoder.EncodePointCloudToBuffer(*pc, out_buffer);
+}
+
+// Encodes a Gaussian point cloud given as a dictionary of NumPy arrays, see
+// GaussianAttributeType() for the supported names. The GIL is released while
+// the point cloud is encoded.
+pybind11::bytes EncodeGaussians(const pybind11::dict &attributes,
+                                const GaussianEncodeOptions &options) {
+  const GaussianArrays arrays = GetGaussianArrays(attributes);
+  draco::EncoderBuffer buffer;
+  draco::Status status;
+  {
+    pybind11::gil_scoped_release release;
+    status = EncodeGaussianArrays(arrays, options, &buffer);
+  }
+  if (!status.ok()) {
+    throw std::runtime_error(status.error_msg_string());
+  }
+  return pybind11::bytes(buffer.data(), buffer.size());
+}
+
+// Encodes multiple Gaussian point clouds in parallel using |num_threads|
+// threads (all hardware threads when zero). Returns the encoded data in the
+// order of |clouds|.
+std::vector<pybind11::bytes> EncodeGaussiansBatch(
+    const std::vector<pybind11::dict> &clouds,
+    const GaussianEncodeOptions &options, int num_threads) {
+  std::vector<GaussianArrays> arrays;
+  arrays.reserve(clouds.size());
+  for (const pybind11::dict &attributes : clouds) {
+    arrays.push_back(GetGaussianArrays(attributes));
+  }
+  const int num_clouds = static_cast<int>(arrays.size());
+  std::vector<draco::EncoderBuffer> buffers(num_clouds);
+  std::vector<draco::Status> statuses(num_clouds);
+  if (num_threads <= 0) {
+    num_threads = draco::ThreadPool::GetDefaultNumThreads();
+  }
+  {
+    pybind11::gil_scoped_release release;
+    draco::ParallelFor(num_clouds, num_threads, [&](int i) {
+      statuses[i] = EncodeGaussianArrays(arrays[i], options, &buffers[i]);
+    });
+  }
+  std::vector<pybind11::bytes> result;
+  result.reserve(num_clouds);
+  for (int i = 0; i < num_clouds; ++i) {
+    if (!statuses[i].ok()) {
+      throw std::runtime_error("Failed to encode point cloud " +
+                               std::to_string(i) + ": " +
+                               statuses[i].error_msg_string());
+    }
+    result.push_back(pybind11::bytes(buffers[i].data(), buffers[i].size()));
+  }
+  return result;
+}
+
+// Writes Draco frames into a seekable sequence container. The sequence header
+// with the shared quantization grids is stored once for all frames.
+class SequenceWriter {
+ public:
+  explicit SequenceWriter(pybind11::bytes header) {
+    const std::string header_str = header;
+    if (!header_str.empty()) {
+      draco::DecoderBuffer buffer;
+      buffer.Init(header_str.data(), header_str.size());
+      ThrowIfError(header_.Decode(&buffer));
+    }
+    ThrowIfError(writer_.Start(header_, &buffer_));
+  }
+
+  // Appends a frame that was already encoded with the sequence header.
+  void AddFrame(pybind11::bytes frame, bool keyframe) {
+    const std::string frame_str = frame;
+    ThrowIfError(
+        writer_.AddEncodedFrame(frame_str.data(), frame_str.size(), keyframe));
+  }
+
+  // Encodes a PLY point cloud with the shared quantization grids of the
+  // sequence header and appends it as a new frame.
+  void AddPlyFrame(pybind11::bytes input, bool keyframe, int qp, int qa,
+                   int compression_level) {
+    const std::string input_str = input;
+    draco::DecoderBuffer buffer;
+    buffer.Init(input_str.data(), input_str.size());
+    draco::PointCloud pc;
+    draco::PlyDecoder ply_decoder;
+    ThrowIfError(ply_decoder.DecodeFromBuffer(&buffer, &pc));
+    ThrowIfError(writer_.EncodeFrame(
+        pc, CreateEncoderOptions(pc, qp, qa, compression_level), keyframe));
+  }
+
+  // Encodes a PLY point cloud with the points shared by all frames as the
+  // static layer of the sequence.
+  void SetPlyStaticLayer(pybind11::bytes input, int qp, int qa,
+                         int compression_level) {
+    const std::string input_str = input;
+    draco::DecoderBuffer buffer;
+    buffer.Init(input_str.data(), input_str.size());
+    draco::PointCloud pc;
+    draco::PlyDecoder ply_decoder;
+    ThrowIfError(ply_decoder.DecodeFromBuffer(&buffer, &pc));
+    ThrowIfError(writer_.EncodeStaticLayer(
+        pc, CreateEncoderOptions(pc, qp, qa, compression_level)));
+  }
+
+  // Completes the container and returns its bytes.
+  pybind11::bytes Finish() {
+    ThrowIfError(writer_.Finish());
+    return pybind11::bytes(buffer_.data(), buffer_.size());
+  }
+
+  int num_frames() const { return writer_.num_frames(); }
+
+ private:
+  static void ThrowIfError(const draco::Status &status) {
+    if (!status.ok()) {
+      throw std::runtime_error(status.error_msg_string());
+    }
+  }
+
+  draco::SequenceHeader header_;
+  draco::EncoderBuffer buffer_;
+  draco::SequenceWriter writer_;
+};
+
+// Reads frames of a sequence container from any object supporting the buffer
+// protocol, e.g. bytes or mmap.mmap. The data is not copied.
+class SequenceReader {
+ public:
+  explicit SequenceReader(pybind11::buffer data)
+      : data_(data), info_(data.request()) {
+    const draco::Status status =
+        reader_.Init(static_cast<const char *>(info_.ptr),
+                     info_.size * info_.itemsize);
+    if (!status.ok()) {
+      throw std::runtime_error(status.error_msg_string());
+    }
+  }
+
+  int num_frames() const { return reader_.num_frames(); }
+
+  bool IsKeyframe(int frame_id) const {
+    CheckFrameId(frame_id);
+    return reader_.IsKeyframe(frame_id);
+  }
+
+  int GetKeyframe(int frame_id) const {
+    CheckFrameId(frame_id);
+    return reader_.GetKeyframe(frame_id);
+  }
+
+  // Returns a memoryview of the Draco bitstream of |frame_id|. The view is a
+  // slice of a view of the original data, so it keeps the data alive after
+  // the reader is destroyed.
+  pybind11::memoryview GetFrame(int frame_id) const {
+    CheckFrameId(frame_id);
+    const pybind11::ssize_t offset =
+        reader_.GetFrameData(frame_id) - static_cast<const char *>(info_.ptr);
+    const pybind11::ssize_t size = reader_.GetFrameSize(frame_id);
+    const pybind11::object bytes =
+        pybind11::memoryview(data_).attr("cast")("B");
+    return bytes[pybind11::slice(offset, offset + size, 1)]
+        .cast<pybind11::memoryview>();
+  }
+
+  bool has_static_layer() const { return reader_.has_static_layer(); }
+
+  // Decodes |frame_id| and returns it as PLY bytes. When |merge_static| is
+  // set, the frame is merged with the static layer of the sequence, which is
+  // decoded only once and kept for the following frames.
+  pybind11::bytes DecodeFrameToPly(int frame_id, bool merge_static) {
+    CheckFrameId(frame_id);
+    draco::Decoder decoder;
+    merge_static = merge_static && reader_.has_static_layer();
+    if (merge_static && static_layer_ == nullptr) {
+      auto statusor = reader_.DecodeStaticLayer(&decoder);
+      if (!statusor.ok()) {
+        throw std::runtime_error(statusor.status().error_msg_string());
+      }
+      static_layer_ = std::move(statusor).value();
+    }
+    auto statusor =
+        merge_static ? reader_.DecodeFrame(frame_id, *static_layer_, &decoder)
+                     : reader_.DecodeFrame(frame_id, &decoder);
+    if (!statusor.ok()) {
+      throw std::runtime_error(statusor.status().error_msg_string());
+    }
+    draco::PlyEncoder ply_encoder;
+    draco::EncoderBuffer buffer;
+    if (!ply_encoder.EncodeToBuffer(*statusor.value(), &buffer)) {
+      throw std::runtime_error("Failed to store the frame as PLY.");
+    }
+    return pybind11::bytes(buffer.data(), buffer.size());
+  }
+
+ private:
+  void CheckFrameId(int frame_id) const {
+    if (frame_id < 0 || frame_id >= reader_.num_frames()) {
+      throw pybind11::index_error("Invalid frame id.");
+    }
+  }
+
+  // Keeps the underlying data alive.
+  pybind11::buffer data_;
+  pybind11::buffer_info info_;
+  draco::SequenceReader reader_;
+  // Decoded static layer shared by all frames.
+  std::unique_ptr<draco::PointCloud> static_layer_;
+};
+
 PYBIND11_MODULE(drc_decoder, m) {
   m.def("drc2ply", &drc2ply);
+  m.def("ply2drc", &ply2drc, pybind11::arg("input"), pybind11::arg("qp") = 12,
+        pybind11::arg("qa") = 10, pybind11::arg("compression_level") = 7,
+        pybind11::arg("stats") = false);
+
+  pybind11::class_<GaussianEncodeOptions>(m, "GaussianEncodeOptions")
+      .def(pybind11::init<>())
+      .def_readwrite("qp", &GaussianEncodeOptions::qp)
+      .def_readwrite("qgs", &GaussianEncodeOptions::qgs)
+      .def_readwrite("qgsdci", &GaussianEncodeOptions::qgsdci)
+      .def_readwrite("qgsshi", &GaussianEncodeOptions::qgsshi)
+      .def_readwrite("qgsscalei", &GaussianEncodeOptions::qgsscalei)
+      .def_readwrite("qgsroti", &GaussianEncodeOptions::qgsroti)
+      .def_readwrite("compression_level",
+                     &GaussianEncodeOptions::compression_level)
+      .def_readwrite("vq_index_coding",
+                     &GaussianEncodeOptions::vq_index_coding)
+      .def_readwrite("lossless_float", &GaussianEncodeOptions::lossless_float);
+  m.def("encode_gaussians", &EncodeGaussians, pybind11::arg("attributes"),
+        pybind11::arg("options") = GaussianEncodeOptions());
+  m.def("encode_gaussians_batch", &EncodeGaussiansBatch,
+        pybind11::arg("clouds"),
+        pybind11::arg("options") = GaussianEncodeOptions(),
+        pybind11::arg("num_threads") = 0);
+
+  pybind11::class_<SequenceWriter>(m, "SequenceWriter")
+      .def(pybind11::init<pybind11::bytes>(),
+           pybind11::arg("header") = pybind11::bytes())
+      .def("add_frame", &SequenceWriter::AddFrame, pybind11::arg("frame"),
+           pybind11::arg("keyframe") = false)
+      .def("add_ply_frame", &SequenceWriter::AddPlyFrame,
+           pybind11::arg("input"), pybind11::arg("keyframe") = false,
+           pybind11::arg("qp") = 12, pybind11::arg("qa") = 10,
+           pybind11::arg("compression_level") = 7)
+      .def("set_ply_static_layer", &SequenceWriter::SetPlyStaticLayer,
+           pybind11::arg("input"), pybind11::arg("qp") = 12,
+           pybind11::arg("qa") = 10, pybind11::arg("compression_level") = 7)
+      .def("finish", &SequenceWriter::Finish)
+      .def_property_readonly("num_frames", &SequenceWriter::num_frames);
+
+  pybind11::class_<SequenceReader>(m, "SequenceReader")
+      .def(pybind11::init<pybind11::buffer>(), pybind11::arg("data"))
+      .def_property_readonly("num_frames", &SequenceReader::num_frames)
+      .def("is_keyframe", &SequenceReader::IsKeyframe)
+      .def("keyframe", &SequenceReader::GetKeyframe)
+      .def("frame", &SequenceReader::GetFrame)
+      .def_property_readonly("has_static_layer",
+                             &SequenceReader::has_static_layer)
+      .def("decode_frame_to_ply", &SequenceReader::DecodeFrameToPly,
+           pybind11::arg("frame_id"), pybind11::arg("merge_static") = true);
 }
@@ -14,11 +14,59 @@
 //
 #include <emscripten/emscripten.h>
 
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 #include "draco/compression/decode.h"
+#include "draco/core/thread_pool.h"
 #include "draco/io/ply_encoder.h"
 
+// Number of pre-started workers of the pthread pool, see PTHREAD_POOL_SIZE in
+// the Makefile. Starting more workers would need the event loop of the calling
+// thread, which is blocked while it waits for the decoding threads.
+#ifndef DRACO_WASM_MAX_THREADS
+#define DRACO_WASM_MAX_THREADS 1
+#endif
+
+namespace {
+
+int ClampNumThreads(int num_threads) {
+  return std::max(1, std::min(num_threads, DRACO_WASM_MAX_THREADS));
+}
+
+std::unique_ptr<draco::PointCloud> DecodePointCloud(const char *input,
+                                                    int input_length,
+                                                    int num_threads) {
+  if (input == nullptr || input_length <= 0) {
+    return nullptr;
+  }
+  // The decoder reads the caller's memory directly, no data is copied.
+  draco::DecoderBuffer buffer;
+  buffer.Init(input, input_length);
+  draco::Decoder decoder;
+  decoder.SetNumDecodingThreads(ClampNumThreads(num_threads));
+  auto statusor = decoder.DecodePointCloudFromBuffer(&buffer);
+  if (!statusor.ok()) {
+    printf("Failed to decode the input data %s\n",
+           statusor.status().error_msg());
+    return nullptr;
+  }
+  return std::move(statusor).value();
+}
+
+const draco::PointAttribute *GetAttribute(const draco::PointCloud *pc,
+                                          int att_id) {
+  if (pc == nullptr || att_id < 0 || att_id >= pc->num_attributes()) {
+    return nullptr;
+  }
+  return pc->attribute(att_id);
+}
+
+}  // namespace
+
 int main(int argc, char **argv) {
   printf("wasm decoder loaded\n");
   return 0;
@@ -86,6 +134,128 @@ int EMSCRIPTEN_KEEPALIVE drc2ply(const char *input, const int inputLength,
   return resBuffer.size();
 }
 
+
+// Typed array API. A decoded point cloud is returned as an opaque handle that
+// must be released with drc_release(). The values of an attribute are copied
+// for all points into a caller-allocated buffer of drc_attribute_byte_size()
+// bytes, so JS can view it as a typed array of the attribute's data type, e.g.
+//   const size = Module._drc_attribute_byte_size(pc, att_id);
+//   const ptr = Module._malloc(size);
+//   Module._drc_copy_attribute(pc, att_id, ptr, size);
+//   const values = new Float32Array(Module.HEAPU8.buffer, ptr, size / 4);
+
+// Decodes a point cloud (or the points of a mesh) from |input|. Independent
+// attributes are decoded on up to |num_threads| threads, limited by the size
+// of the worker pool. Returns nullptr on failure.
+draco::PointCloud *EMSCRIPTEN_KEEPALIVE drc_decode(const char *input,
+                                                   int input_length,
+                                                   int num_threads) {
+  return DecodePointCloud(input, input_length, num_threads).release();
+}
+
+// Decodes |num_frames| point clouds, e.g. the frames of a sequence, on up to
+// |num_threads| threads of the worker pool, limited by its size. The handles
+// are stored in |out_frames|. Returns the number of frames that failed to
+// decode, their handles are set to nullptr.
+int EMSCRIPTEN_KEEPALIVE drc_decode_frames(const char *const *inputs,
+                                           const int *input_lengths,
+                                           int num_frames, int num_threads,
+                                           draco::PointCloud **out_frames) {
+  if (num_frames <= 0) {
+    return 0;
+  }
+  // Each frame is decoded on a single thread so that the number of running
+  // threads never exceeds the size of the worker pool.
+  const auto decode_frame = [&](int i) {
+    out_frames[i] = DecodePointCloud(inputs[i], input_lengths[i], 1).release();
+  };
+  draco::ParallelFor(num_frames, ClampNumThreads(num_threads), decode_frame);
+  int num_failed = 0;
+  for (int i = 0; i < num_frames; ++i) {
+    if (out_frames[i] == nullptr) {
+      ++num_failed;
+    }
+  }
+  return num_failed;
+}
+
+void EMSCRIPTEN_KEEPALIVE drc_release(draco::PointCloud *pc) { delete pc; }
+
+int EMSCRIPTEN_KEEPALIVE drc_num_points(const draco::PointCloud *pc) {
+  return pc == nullptr ? 0 : pc->num_points();
+}
+
+int EMSCRIPTEN_KEEPALIVE drc_num_attributes(const draco::PointCloud *pc) {
+  return pc == nullptr ? 0 : pc->num_attributes();
+}
+
+// Returns the id of the first attribute of GeometryAttribute::Type
+// |attribute_type| or -1 if there is no such attribute.
+int EMSCRIPTEN_KEEPALIVE drc_find_attribute(const draco::PointCloud *pc,
+                                            int attribute_type) {
+  if (pc == nullptr || attribute_type < 0 ||
+      attribute_type >= draco::GeometryAttribute::NAMED_ATTRIBUTES_COUNT) {
+    return -1;
+  }
+  return pc->GetNamedAttributeId(
+      static_cast<draco::GeometryAttribute::Type>(attribute_type));
+}
+
+// Returns the GeometryAttribute::Type of an attribute or -1.
+int EMSCRIPTEN_KEEPALIVE drc_attribute_type(const draco::PointCloud *pc,
+                                            int att_id) {
+  const draco::PointAttribute *const att = GetAttribute(pc, att_id);
+  return att == nullptr ? -1 : att->attribute_type();
+}
+
+// Returns the draco::DataType of the values of an attribute or -1.
+int EMSCRIPTEN_KEEPALIVE drc_attribute_data_type(const draco::PointCloud *pc,
+                                                 int att_id) {
+  const draco::PointAttribute *const att = GetAttribute(pc, att_id);
+  return att == nullptr ? -1 : att->data_type();
+}
+
+int EMSCRIPTEN_KEEPALIVE drc_attribute_num_components(
+    const draco::PointCloud *pc, int att_id) {
+  const draco::PointAttribute *const att = GetAttribute(pc, att_id);
+  return att == nullptr ? 0 : att->num_components();
+}
+
+// Returns the number of bytes needed to store the values of an attribute for
+// all points or 0 for an invalid attribute.
+int EMSCRIPTEN_KEEPALIVE drc_attribute_byte_size(const draco::PointCloud *pc,
+                                                 int att_id) {
+  const draco::PointAttribute *const att = GetAttribute(pc, att_id);
+  if (att == nullptr) {
+    return 0;
+  }
+  return pc->num_points() * static_cast<int>(att->byte_stride());
+}
+
+// Copies the values of an attribute for all points to |out|. |out_size| must
+// be equal to drc_attribute_byte_size(). Returns the number of written bytes
+// or -1 on failure.
+int EMSCRIPTEN_KEEPALIVE drc_copy_attribute(const draco::PointCloud *pc,
+                                            int att_id, void *out,
+                                            int out_size) {
+  const int size = drc_attribute_byte_size(pc, att_id);
+  if (size == 0 || out == nullptr || out_size != size) {
+    return -1;
+  }
+  const draco::PointAttribute *const att = pc->attribute(att_id);
+  const size_t stride = att->byte_stride();
+  uint8_t *const bytes = static_cast<uint8_t *>(out);
+  if (att->is_mapping_identity()) {
+    memcpy(bytes, att->GetAddress(draco::AttributeValueIndex(0)), size);
+  } else {
+    for (draco::PointIndex i(0); i < pc->num_points(); ++i) {
+      memcpy(bytes + i.value() * stride, att->GetAddressOfMappedIndex(i),
+             stride);
+    }
+  }
+  return size;
+}
+
 #ifdef __cplusplus
 }
-#endif
\ No newline at end of file
+#endif
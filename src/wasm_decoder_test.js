@@ -0,0 +1,136 @@
+// Copyright 2024 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Decodes a .drc file with the typed array API of the WebAssembly decoder and
+// checks that the frame decoder returns the same values on all threads.
+//
+// Usage: node wasm_decoder_test.js <module.js> <file.drc> [num_threads]
+'use strict';
+
+const fs = require('fs');
+const path = require('path');
+
+// Typed array constructors indexed by draco::DataType.
+const kTypedArrays = [
+  null, Int8Array, Uint8Array, Int16Array, Uint16Array, Int32Array,
+  Uint32Array, BigInt64Array, BigUint64Array, Float32Array, Float64Array,
+  Uint8Array,
+];
+
+function copyToHeap(module, data) {
+  const ptr = module._malloc(data.length);
+  module.HEAPU8.set(data, ptr);
+  return ptr;
+}
+
+// Returns the values of all attributes of the decoded point cloud |pc| as
+// typed arrays.
+function getAttributes(module, pc) {
+  const attributes = [];
+  const numAttributes = module._drc_num_attributes(pc);
+  for (let i = 0; i < numAttributes; ++i) {
+    const size = module._drc_attribute_byte_size(pc, i);
+    const ptr = module._malloc(size);
+    if (module._drc_copy_attribute(pc, i, ptr, size) !== size) {
+      throw new Error('Failed to copy attribute ' + i);
+    }
+    const TypedArray = kTypedArrays[module._drc_attribute_data_type(pc, i)];
+    // The heap may have grown during decoding, so the view is created after
+    // the copy. slice() keeps the values after the memory is freed.
+    const values = new TypedArray(
+        module.HEAPU8.buffer, ptr, size / TypedArray.BYTES_PER_ELEMENT)
+                       .slice();
+    module._free(ptr);
+    attributes.push({
+      type: module._drc_attribute_type(pc, i),
+      numComponents: module._drc_attribute_num_components(pc, i),
+      values: values,
+    });
+  }
+  return attributes;
+}
+
+function sameValues(a, b) {
+  return a.length === b.length && a.every((value, i) => value === b[i]);
+}
+
+async function main() {
+  if (process.argv.length < 4) {
+    console.log(
+        'Usage: node wasm_decoder_test.js <module.js> <file.drc> ' +
+        '[num_threads]');
+    process.exit(1);
+  }
+  const createModule = require(path.resolve(process.argv[2]));
+  const data = fs.readFileSync(process.argv[3]);
+  const numThreads = Number(process.argv[4] || 4);
+  const module = await createModule();
+
+  const input = copyToHeap(module, data);
+  let start = performance.now();
+  const pc = module._drc_decode(input, data.length, numThreads);
+  if (pc === 0) {
+    throw new Error('Failed to decode ' + process.argv[3]);
+  }
+  console.log(
+      'Decoded ' + module._drc_num_points(pc) + ' points in ' +
+      (performance.now() - start).toFixed(2) + ' ms');
+  const expected = getAttributes(module, pc);
+  for (const att of expected) {
+    console.log(
+        '  type ' + att.type + ': ' + att.numComponents + ' x ' +
+        att.values.constructor.name);
+  }
+  module._drc_release(pc);
+
+  // Decode the same data as several frames on the worker pool.
+  const numFrames = 2 * numThreads;
+  const inputs = module._malloc(4 * numFrames);
+  const lengths = module._malloc(4 * numFrames);
+  const frames = module._malloc(4 * numFrames);
+  for (let i = 0; i < numFrames; ++i) {
+    module.HEAPU32[inputs / 4 + i] = input;
+    module.HEAPU32[lengths / 4 + i] = data.length;
+  }
+  start = performance.now();
+  const numFailed = module._drc_decode_frames(
+      inputs, lengths, numFrames, numThreads, frames);
+  console.log(
+      'Decoded ' + numFrames + ' frames on ' + numThreads + ' threads in ' +
+      (performance.now() - start).toFixed(2) + ' ms');
+  if (numFailed !== 0) {
+    throw new Error(numFailed + ' frames failed to decode');
+  }
+  for (let i = 0; i < numFrames; ++i) {
+    const frame = module.HEAPU32[frames / 4 + i];
+    const attributes = getAttributes(module, frame);
+    module._drc_release(frame);
+    if (attributes.length !== expected.length ||
+        !attributes.every((att, a) => sameValues(att.values,
+                                                 expected[a].values))) {
+      throw new Error('Frame ' + i + ' differs from the decoded data');
+    }
+  }
+  module._free(frames);
+  module._free(lengths);
+  module._free(inputs);
+  module._free(input);
+  console.log('OK');
+  process.exit(0);
+}
+
+main().catch((error) => {
+  console.error(error.message);
+  process.exit(1);
+});